@@ -0,0 +1,161 @@
+/**
+ * @file    hal_atomic.h
+ * @brief   HAL Atomic Operation Wrappers
+ * @details Maps the few atomic operations the HAL needs to compiler builtins.
+ *          Compilers without builtins run each operation with interrupts
+ *          masked through a port hook (see HAL_ATOMIC_IRQ_SAVE), which is
+ *          atomic against ISRs on single-core targets only.
+ *          64-bit operations on 32-bit MCUs go through libatomic (GCC) and
+ *          are not lock-free there. HAL_ATOMIC_EXCHANGE_U32 is a full barrier
+ *          (sequentially consistent); loads acquire and stores release.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#ifndef HAL_ATOMIC_H
+#define HAL_ATOMIC_H
+
+#include "yolpiya.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+
+#define HAL_ATOMIC_FETCH_ADD_U32(ptr, val)  __atomic_fetch_add((ptr), (val), __ATOMIC_RELAXED)
+#define HAL_ATOMIC_LOAD_U32(ptr)            __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define HAL_ATOMIC_STORE_U32(ptr, val)      __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#define HAL_ATOMIC_EXCHANGE_U32(ptr, val)   __atomic_exchange_n((ptr), (val), __ATOMIC_SEQ_CST)
+#define HAL_ATOMIC_CAS_U32(ptr, expected, desired) \
+    __atomic_compare_exchange_n((ptr), (expected), (desired), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#define HAL_ATOMIC_FETCH_ADD_U64(ptr, val)  __atomic_fetch_add((ptr), (val), __ATOMIC_RELAXED)
+#define HAL_ATOMIC_LOAD_U64(ptr)            __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define HAL_ATOMIC_STORE_U64(ptr, val)      __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#define HAL_ATOMIC_TEST_AND_SET(ptr)        __atomic_exchange_n((ptr), true, __ATOMIC_ACQUIRE)
+#define HAL_ATOMIC_CLEAR(ptr)               __atomic_store_n((ptr), false, __ATOMIC_RELEASE)
+
+#elif defined(_MSC_VER)
+
+#include <intrin.h>
+#define HAL_ATOMIC_FETCH_ADD_U32(ptr, val)  ((uint32_t)_InterlockedExchangeAdd((volatile long*)(ptr), (long)(val)))
+#define HAL_ATOMIC_LOAD_U32(ptr)            (*(volatile uint32_t*)(ptr))
+#define HAL_ATOMIC_STORE_U32(ptr, val)      ((void)_InterlockedExchange((volatile long*)(ptr), (long)(val)))
+#define HAL_ATOMIC_EXCHANGE_U32(ptr, val)   ((uint32_t)_InterlockedExchange((volatile long*)(ptr), (long)(val)))
+#define HAL_ATOMIC_FETCH_ADD_U64(ptr, val)  ((uint64_t)_InterlockedExchangeAdd64((volatile long long*)(ptr), (long long)(val)))
+#define HAL_ATOMIC_LOAD_U64(ptr)            ((uint64_t)_InterlockedCompareExchange64((volatile long long*)(ptr), 0, 0))
+#define HAL_ATOMIC_STORE_U64(ptr, val)      ((void)_InterlockedExchange64((volatile long long*)(ptr), (long long)(val)))
+#define HAL_ATOMIC_TEST_AND_SET(ptr)        (_InterlockedExchange8((volatile char*)(ptr), 1) != 0)
+#define HAL_ATOMIC_CLEAR(ptr)               ((void)_InterlockedExchange8((volatile char*)(ptr), 0))
+
+static __inline bool hal_atomic_cas_u32(volatile uint32_t* ptr, uint32_t* expected, uint32_t desired)
+{
+    uint32_t old = (uint32_t)_InterlockedCompareExchange((volatile long*)ptr, (long)desired, (long)*expected);
+    bool swapped = (old == *expected);
+    *expected = old;
+    return swapped;
+}
+#define HAL_ATOMIC_CAS_U32(ptr, expected, desired)  hal_atomic_cas_u32((ptr), (expected), (desired))
+
+#else
+
+/*
+ * No atomic builtins: every read-modify-write runs with interrupts masked,
+ * which makes it atomic against ISRs on a single core. The port provides
+ * HAL_ATOMIC_IRQ_SAVE(), returning the previous interrupt mask, and
+ * HAL_ATOMIC_IRQ_RESTORE(state); CC-RH (RH850) and IAR (Cortex-M) have them
+ * built in.
+ */
+#if !defined(HAL_ATOMIC_IRQ_SAVE) || !defined(HAL_ATOMIC_IRQ_RESTORE)
+#if defined(__CCRH__)
+static inline uint32_t hal_atomic_irq_save(void)
+{
+    uint32_t psw = (uint32_t)__stsr(5, 0);  /* PSW */
+    __DI();
+    return psw;
+}
+#define HAL_ATOMIC_IRQ_SAVE()               hal_atomic_irq_save()
+#define HAL_ATOMIC_IRQ_RESTORE(state)       do { if (((state) & 0x20U) == 0U) { __EI(); } } while (0)  /* PSW.ID was clear */
+#elif defined(__ICCARM__)
+#include <intrinsics.h>
+static inline uint32_t hal_atomic_irq_save(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_interrupt();
+    return primask;
+}
+#define HAL_ATOMIC_IRQ_SAVE()               hal_atomic_irq_save()
+#define HAL_ATOMIC_IRQ_RESTORE(state)       __set_PRIMASK(state)
+#else
+#error "hal_atomic.h: no atomic builtins, define HAL_ATOMIC_IRQ_SAVE() and HAL_ATOMIC_IRQ_RESTORE(state)"
+#endif
+#endif
+
+static inline uint32_t hal_atomic_fetch_add_u32(volatile uint32_t* ptr, uint32_t val)
+{
+    uint32_t state = HAL_ATOMIC_IRQ_SAVE();
+    uint32_t old = *ptr;
+    *ptr = old + val;
+    HAL_ATOMIC_IRQ_RESTORE(state);
+    return old;
+}
+static inline uint32_t hal_atomic_exchange_u32(volatile uint32_t* ptr, uint32_t val)
+{
+    uint32_t state = HAL_ATOMIC_IRQ_SAVE();
+    uint32_t old = *ptr;
+    *ptr = val;
+    HAL_ATOMIC_IRQ_RESTORE(state);
+    return old;
+}
+static inline bool hal_atomic_cas_u32(volatile uint32_t* ptr, uint32_t* expected, uint32_t desired)
+{
+    uint32_t state = HAL_ATOMIC_IRQ_SAVE();
+    bool swapped = (*ptr == *expected);
+    
+    if (swapped) {
+        *ptr = desired;
+    } else {
+        *expected = *ptr;
+    }
+    HAL_ATOMIC_IRQ_RESTORE(state);
+    return swapped;
+}
+static inline bool hal_atomic_test_and_set(volatile bool* ptr)
+{
+    uint32_t state = HAL_ATOMIC_IRQ_SAVE();
+    bool old = *ptr;
+    *ptr = true;
+    HAL_ATOMIC_IRQ_RESTORE(state);
+    return old;
+}
+static inline uint64_t hal_atomic_fetch_add_u64(volatile uint64_t* ptr, uint64_t val)
+{
+    uint32_t state = HAL_ATOMIC_IRQ_SAVE();
+    uint64_t old = *ptr;
+    *ptr = old + val;
+    HAL_ATOMIC_IRQ_RESTORE(state);
+    return old;
+}
+static inline uint64_t hal_atomic_load_u64(volatile uint64_t* ptr)
+{
+    uint32_t state = HAL_ATOMIC_IRQ_SAVE();
+    uint64_t value = *ptr;  /* Two accesses on 32-bit cores */
+    HAL_ATOMIC_IRQ_RESTORE(state);
+    return value;
+}
+static inline void hal_atomic_store_u64(volatile uint64_t* ptr, uint64_t val)
+{
+    uint32_t state = HAL_ATOMIC_IRQ_SAVE();
+    *ptr = val;
+    HAL_ATOMIC_IRQ_RESTORE(state);
+}
+#define HAL_ATOMIC_FETCH_ADD_U32(ptr, val)  hal_atomic_fetch_add_u32((ptr), (val))
+#define HAL_ATOMIC_LOAD_U32(ptr)            (*(volatile uint32_t*)(ptr))
+#define HAL_ATOMIC_STORE_U32(ptr, val)      (*(volatile uint32_t*)(ptr) = (val))
+#define HAL_ATOMIC_EXCHANGE_U32(ptr, val)   hal_atomic_exchange_u32((ptr), (val))
+#define HAL_ATOMIC_CAS_U32(ptr, expected, desired)  hal_atomic_cas_u32((ptr), (expected), (desired))
+#define HAL_ATOMIC_FETCH_ADD_U64(ptr, val)  hal_atomic_fetch_add_u64((ptr), (val))
+#define HAL_ATOMIC_LOAD_U64(ptr)            hal_atomic_load_u64((volatile uint64_t*)(ptr))
+#define HAL_ATOMIC_STORE_U64(ptr, val)      hal_atomic_store_u64((volatile uint64_t*)(ptr), (val))
+#define HAL_ATOMIC_TEST_AND_SET(ptr)        hal_atomic_test_and_set((ptr))
+#define HAL_ATOMIC_CLEAR(ptr)               (*(volatile bool*)(ptr) = false)
+
+#endif
+
+#endif /* HAL_ATOMIC_H */
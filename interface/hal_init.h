@@ -8,12 +8,18 @@
 #ifndef HAL_INIT_H
 #define HAL_INIT_H
 
-#include "hal_types.h"
+#include "hal_spi.h"
 
 /**
  * @brief Initialize HAL subsystem
- * @details Registers the appropriate HAL implementation based on build configuration
- * @return HAL_OK on success, error code otherwise
+ * @details Registers the appropriate HAL implementation based on build configuration.
+ *          Devices named in a device map use another linked implementation:
+ *          the build map (HAL_SPI_DEVICE_MAP, from HAL_DEVICE_MAP in
+ *          m_module.mak) applies first, then $HAL_SPI_DEVICE_MAP on hosts.
+ *          Format "ID=IMPL[,ID=IMPL...]" with ID a device or a range, e.g.
+ *          "0=stm32,1-6=sim".
+ * @return HAL_OK on success, HAL_ERROR_INVALID_PARAM for a malformed map or
+ *         an implementation that is not linked, error code otherwise
  */
 hal_status_t hal_init(void);
 
@@ -23,4 +29,11 @@ hal_status_t hal_init(void);
  */
 const char* hal_get_implementation_name(void);
 
+/**
+ * @brief Get the name of the implementation a device uses
+ * @param device SPI device identifier
+ * @return String describing the implementation, "None" if none is registered
+ */
+const char* hal_get_device_implementation_name(hal_spi_device_t device);
+
 #endif /* HAL_INIT_H */
@@ -0,0 +1,63 @@
+/**
+ * @file    hal_log.h
+ * @brief   HAL Logging Macros
+ * @details Levelled logging with a compile-time threshold. Messages above
+ *          HAL_LOG_LEVEL expand to nothing, so hot paths pay no cost when
+ *          logging is disabled.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#ifndef HAL_LOG_H
+#define HAL_LOG_H
+
+#include "yolpiya.h"
+
+/**
+ * @brief Log levels
+ */
+#define HAL_LOG_LEVEL_NONE      0   /**< No output */
+#define HAL_LOG_LEVEL_ERROR     1   /**< Errors only */
+#define HAL_LOG_LEVEL_WARN      2   /**< Errors and warnings */
+#define HAL_LOG_LEVEL_INFO      3   /**< Init/deinit/configuration events */
+#define HAL_LOG_LEVEL_DEBUG     4   /**< Every transfer (hot path) */
+
+/**
+ * @brief Compile-time log threshold (set from m_module.mak)
+ */
+#ifndef HAL_LOG_LEVEL
+#define HAL_LOG_LEVEL           HAL_LOG_LEVEL_INFO
+#endif
+
+/**
+ * @brief Output function, can be redirected (e.g. to a UART writer)
+ */
+#ifndef HAL_LOG_PRINTF
+#define HAL_LOG_PRINTF          printf
+#endif
+
+#if HAL_LOG_LEVEL >= HAL_LOG_LEVEL_ERROR
+#define HAL_LOG_ERROR(...)      HAL_LOG_PRINTF(__VA_ARGS__)
+#else
+#define HAL_LOG_ERROR(...)      ((void)0)
+#endif
+
+#if HAL_LOG_LEVEL >= HAL_LOG_LEVEL_WARN
+#define HAL_LOG_WARN(...)       HAL_LOG_PRINTF(__VA_ARGS__)
+#else
+#define HAL_LOG_WARN(...)       ((void)0)
+#endif
+
+#if HAL_LOG_LEVEL >= HAL_LOG_LEVEL_INFO
+#define HAL_LOG_INFO(...)       HAL_LOG_PRINTF(__VA_ARGS__)
+#else
+#define HAL_LOG_INFO(...)       ((void)0)
+#endif
+
+#if HAL_LOG_LEVEL >= HAL_LOG_LEVEL_DEBUG
+#define HAL_LOG_DEBUG(...)      HAL_LOG_PRINTF(__VA_ARGS__)
+#else
+#define HAL_LOG_DEBUG(...)      ((void)0)
+#endif
+
+#endif /* HAL_LOG_H */
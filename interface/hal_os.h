@@ -0,0 +1,187 @@
+/**
+ * @file    hal_os.h
+ * @brief   HAL Operating System Primitives
+ * @details Minimal mutex, condition variable and thread wrappers for the host
+ *          builds (Win32 SRW locks, POSIX threads). Locks can be initialized
+ *          statically with HAL_MUTEX_INIT / HAL_COND_INIT. Threads exist on
+ *          the hosts only.
+ *          On bare-metal targets (STM32_TARGET, RH850_TARGET, or HAL_OS_NONE)
+ *          the locks compile to nothing; there the busy flag claimed with an
+ *          atomic compare-and-swap is the only arbitration, against ISRs.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#ifndef HAL_OS_H
+#define HAL_OS_H
+
+#include "hal_types.h"
+
+#if defined(STM32_TARGET) || defined(RH850_TARGET)
+    #ifndef HAL_OS_NONE
+    #define HAL_OS_NONE
+    #endif
+#endif
+
+/*============================================================================*/
+/* Bare metal: no scheduler, nothing to lock against                          */
+/*============================================================================*/
+#if defined(HAL_OS_NONE)
+
+typedef uint8_t hal_mutex_t;
+typedef uint8_t hal_cond_t;
+
+#define HAL_MUTEX_INIT  0U
+#define HAL_COND_INIT   0U
+
+static inline void hal_mutex_lock(hal_mutex_t* mutex)   { (void)mutex; }
+static inline void hal_mutex_unlock(hal_mutex_t* mutex) { (void)mutex; }
+static inline void hal_cond_broadcast(hal_cond_t* cond) { (void)cond; }
+
+static inline bool hal_cond_wait_ms(hal_cond_t* cond, hal_mutex_t* mutex, uint32_t timeout_ms)
+{
+    (void)cond;
+    (void)mutex;
+    (void)timeout_ms;
+    return true;
+}
+
+/*============================================================================*/
+/* Windows                                                                    */
+/*============================================================================*/
+#elif defined(_WIN32)
+
+#include <windows.h>
+
+typedef SRWLOCK hal_mutex_t;
+typedef CONDITION_VARIABLE hal_cond_t;
+
+#define HAL_MUTEX_INIT  SRWLOCK_INIT
+#define HAL_COND_INIT   CONDITION_VARIABLE_INIT
+
+static inline void hal_mutex_lock(hal_mutex_t* mutex)   { AcquireSRWLockExclusive(mutex); }
+static inline void hal_mutex_unlock(hal_mutex_t* mutex) { ReleaseSRWLockExclusive(mutex); }
+static inline void hal_cond_broadcast(hal_cond_t* cond) { WakeAllConditionVariable(cond); }
+
+/**
+ * @brief Wait for a broadcast with the mutex held
+ * @return false if the timeout expired
+ */
+static inline bool hal_cond_wait_ms(hal_cond_t* cond, hal_mutex_t* mutex, uint32_t timeout_ms)
+{
+    return SleepConditionVariableSRW(cond, mutex, (timeout_ms > 0) ? timeout_ms : INFINITE, 0) != 0;
+}
+
+/**
+ * @brief Thread running entry(arg), must stay valid until joined
+ */
+typedef struct {
+    HANDLE      handle;
+    void        (*entry)(void* arg);
+    void*       arg;
+} hal_thread_t;
+
+static inline DWORD WINAPI hal_thread_start(LPVOID thread)
+{
+    ((hal_thread_t*)thread)->entry(((hal_thread_t*)thread)->arg);
+    return 0;
+}
+
+/**
+ * @brief Start a thread
+ * @return false if the system has no thread to spare
+ */
+static inline bool hal_thread_create(hal_thread_t* thread, void (*entry)(void* arg), void* arg)
+{
+    thread->entry = entry;
+    thread->arg = arg;
+    thread->handle = CreateThread(NULL, 0, hal_thread_start, thread, 0, NULL);
+    return thread->handle != NULL;
+}
+
+/**
+ * @brief Wait for a thread to return
+ */
+static inline void hal_thread_join(hal_thread_t* thread)
+{
+    (void)WaitForSingleObject(thread->handle, INFINITE);
+    (void)CloseHandle(thread->handle);
+}
+
+/*============================================================================*/
+/* POSIX                                                                      */
+/*============================================================================*/
+#else
+
+#include <pthread.h>
+#include <time.h>
+
+typedef pthread_mutex_t hal_mutex_t;
+typedef pthread_cond_t hal_cond_t;
+
+#define HAL_MUTEX_INIT  PTHREAD_MUTEX_INITIALIZER
+#define HAL_COND_INIT   PTHREAD_COND_INITIALIZER
+
+static inline void hal_mutex_lock(hal_mutex_t* mutex)   { (void)pthread_mutex_lock(mutex); }
+static inline void hal_mutex_unlock(hal_mutex_t* mutex) { (void)pthread_mutex_unlock(mutex); }
+static inline void hal_cond_broadcast(hal_cond_t* cond) { (void)pthread_cond_broadcast(cond); }
+
+/**
+ * @brief Wait for a broadcast with the mutex held
+ * @return false if the timeout expired
+ */
+static inline bool hal_cond_wait_ms(hal_cond_t* cond, hal_mutex_t* mutex, uint32_t timeout_ms)
+{
+    if (timeout_ms == 0) {
+        return pthread_cond_wait(cond, mutex) == 0;
+    }
+    
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += (time_t)(timeout_ms / 1000U);
+    deadline.tv_nsec += (long)(timeout_ms % 1000U) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    
+    return pthread_cond_timedwait(cond, mutex, &deadline) == 0;
+}
+
+/**
+ * @brief Thread running entry(arg), must stay valid until joined
+ */
+typedef struct {
+    pthread_t   handle;
+    void        (*entry)(void* arg);
+    void*       arg;
+} hal_thread_t;
+
+static inline void* hal_thread_start(void* thread)
+{
+    ((hal_thread_t*)thread)->entry(((hal_thread_t*)thread)->arg);
+    return NULL;
+}
+
+/**
+ * @brief Start a thread
+ * @return false if the system has no thread to spare
+ */
+static inline bool hal_thread_create(hal_thread_t* thread, void (*entry)(void* arg), void* arg)
+{
+    thread->entry = entry;
+    thread->arg = arg;
+    return pthread_create(&thread->handle, NULL, hal_thread_start, thread) == 0;
+}
+
+/**
+ * @brief Wait for a thread to return
+ */
+static inline void hal_thread_join(hal_thread_t* thread)
+{
+    (void)pthread_join(thread->handle, NULL);
+}
+
+#endif
+
+#endif /* HAL_OS_H */
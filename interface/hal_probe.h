@@ -0,0 +1,98 @@
+/**
+ * @file    hal_probe.h
+ * @brief   HAL Instrumentation Probes
+ * @details Fixed probe points on the hot paths for external profilers. Each
+ *          probe takes a hal_time_now_cycles() timestamp and hands it to the
+ *          platform sink: the ITM stimulus port on STM32 (SWO), a RAM ring
+ *          read by the debugger on RH850, and USDT probes for perf, LTTng or
+ *          bpftrace on Linux. hal_probe_set_hook() routes them anywhere else.
+ *          The points of one operation give the breakdown:
+ *          - OP_ENTER to OP_DISPATCH: bridge, including the device lock wait
+ *          - OP_DISPATCH to OP_EXIT: backend
+ *          - WIRE_SEND to WIRE_SENT, WIRE_RECV to WIRE_RECEIVED: wire (socket)
+ *          Without HAL_PROBE_ENABLE the HAL_PROBE() macro expands to nothing.
+ * @author  EswPla HAL Team
+ * @date    2026-10-15
+ */
+
+#ifndef HAL_PROBE_H
+#define HAL_PROBE_H
+
+#include "hal_types.h"
+
+/**
+ * @brief Device of probes that concern no single device (shared connection)
+ */
+#define HAL_PROBE_NO_DEVICE     0xFFU
+
+/**
+ * @brief ITM stimulus port the STM32 sink writes to
+ */
+#ifndef HAL_PROBE_ITM_PORT
+#define HAL_PROBE_ITM_PORT      1U
+#endif
+
+/**
+ * @brief Number of records kept by the RH850 sink (must be a power of two)
+ */
+#ifndef HAL_PROBE_RING_SIZE
+#define HAL_PROBE_RING_SIZE     256U
+#endif
+
+/**
+ * @brief Probe points
+ */
+typedef enum {
+    HAL_PROBE_OP_ENTER          = 0x01,  /**< Bridge entered, arg = hal_probe_op_t */
+    HAL_PROBE_OP_DISPATCH       = 0x02,  /**< Device lock held, backend called, arg = bytes (batch: count) */
+    HAL_PROBE_OP_EXIT           = 0x03,  /**< Backend returned, arg = hal_status_t */
+    HAL_PROBE_QUEUE_SUBMIT      = 0x10,  /**< Request queued for completion later, arg = sequence (simulation: length) */
+    HAL_PROBE_QUEUE_COMPLETE    = 0x11,  /**< Queued request completed, arg as for the submit */
+    HAL_PROBE_WIRE_SEND         = 0x20,  /**< Socket send started, arg = buffers in the I/O vector */
+    HAL_PROBE_WIRE_SENT         = 0x21,  /**< Socket send done, arg = hal_status_t */
+    HAL_PROBE_WIRE_RECV         = 0x22,  /**< Socket readable, response being read */
+    HAL_PROBE_WIRE_RECEIVED     = 0x23   /**< Response read, arg = payload bytes */
+} hal_probe_point_t;
+
+/**
+ * @brief Operations reported by HAL_PROBE_OP_ENTER
+ */
+typedef enum {
+    HAL_PROBE_ID_TRANSFER       = 0,
+    HAL_PROBE_ID_SEND           = 1,
+    HAL_PROBE_ID_RECEIVE        = 2,
+    HAL_PROBE_ID_BATCH          = 3,
+    HAL_PROBE_ID_SG             = 4,    /**< hal_spi_transfer_sg() */
+    HAL_PROBE_ID_LARGE          = 5,    /**< hal_spi_transfer_large() */
+    HAL_PROBE_ID_ASYNC          = 6,    /**< hal_spi_transfer_async() submission */
+    HAL_PROBE_ID_WORDS          = 7     /**< hal_spi_transfer16() / hal_spi_transfer32(), length in bytes */
+} hal_probe_op_t;
+
+/**
+ * @brief Probe sink
+ * @param point hal_probe_point_t
+ * @param device SPI device identifier, or HAL_PROBE_NO_DEVICE
+ * @param arg Point-specific argument
+ * @param cycles hal_time_now_cycles() at the probe
+ */
+typedef void (*hal_probe_hook_t)(uint16_t point, uint8_t device, uint32_t arg, uint32_t cycles);
+
+/**
+ * @brief Record a probe (ISR-safe as long as the sink is)
+ */
+void hal_probe_emit(uint16_t point, uint8_t device, uint32_t arg);
+
+/**
+ * @brief Route probes to a sink of the application instead of the platform sink
+ * @param hook Sink, NULL for the platform sink again
+ * @note Set before the probed code runs
+ */
+void hal_probe_set_hook(hal_probe_hook_t hook);
+
+#ifdef HAL_PROBE_ENABLE
+#define HAL_PROBE(point, device, arg)   hal_probe_emit((uint16_t)(point), (uint8_t)(device), (uint32_t)(arg))
+#else
+#define HAL_PROBE(point, device, arg)   ((void)0)
+#endif
+
+#endif /* HAL_PROBE_H */
@@ -0,0 +1,78 @@
+/**
+ * @file    hal_sim_model.h
+ * @brief   SPI Device Models for Simulation
+ * @details A device model stands in for the chip behind one SPI device. The
+ *          simulation backend (hal_spi_sim.c) runs an attached model in-process
+ *          for every transfer, send and receive; the native simulator server
+ *          (tools/spi_sim_server) runs the same models behind the socket and
+ *          shared-memory backends. Models own no memory: the caller supplies
+ *          the state through context. Depends on <stdint.h> only.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#ifndef HAL_SIM_MODEL_H
+#define HAL_SIM_MODEL_H
+
+#include <stdint.h>
+
+/**
+ * @brief Smallest piece of a frame handed to a model (even, keeps 16-bit words whole)
+ */
+#define HAL_SIM_MODEL_CHUNK         256U
+
+/**
+ * @brief Device model instance
+ */
+typedef struct {
+    const char* name;           /**< For logs */
+    void*       context;        /**< Model state, passed to every callback */
+    
+    /**
+     * @brief Put the device into its power-on state (optional, may be NULL)
+     */
+    void (*reset)(void* context);
+    
+    /**
+     * @brief Clock length bytes of one chip-select frame through the device
+     * @details A frame longer than HAL_SIM_MODEL_CHUNK may be clocked in
+     *          several calls, split at multiples of HAL_SIM_MODEL_CHUNK.
+     * @param tx Bytes sent by the master, NULL for a receive (dummy bytes)
+     * @param rx Bytes returned by the device, NULL for a send (discarded)
+     */
+    void (*transfer)(void* context, const uint8_t* tx, uint8_t* rx, uint16_t length);
+} hal_sim_model_t;
+
+/*============================================================================*/
+/* TLE92104 Model (hal_sim_model_tle92104.c)                                  */
+/*============================================================================*/
+
+#define HAL_SIM_TLE92104_REG_COUNT  16U
+
+/**
+ * @brief State of one simulated Infineon TLE92104 4-channel high-side switch
+ */
+typedef struct {
+    uint8_t     registers[HAL_SIM_TLE92104_REG_COUNT];
+    uint32_t    wdg_count;          /**< Watchdog writes */
+    uint8_t     last_data;          /**< Returned with the next frame */
+    uint8_t     last_addr;
+} hal_sim_tle92104_t;
+
+void hal_sim_tle92104_reset(void* context);
+void hal_sim_tle92104_transfer(void* context, const uint8_t* tx, uint8_t* rx, uint16_t length);
+
+/**
+ * @brief Initializer of a TLE92104 model instance
+ * @param state hal_sim_tle92104_t holding the device state
+ *
+ * @code
+ * static hal_sim_tle92104_t tle_state;
+ * static const hal_sim_model_t tle = HAL_SIM_MODEL_TLE92104(&tle_state);
+ * hal_sim_attach_model(HAL_SPI_DEV_0, &tle);
+ * @endcode
+ */
+#define HAL_SIM_MODEL_TLE92104(state) \
+    { "tle92104", (state), hal_sim_tle92104_reset, hal_sim_tle92104_transfer }
+
+#endif /* HAL_SIM_MODEL_H */
@@ -3,6 +3,12 @@
  * @brief   SPI Hardware Abstraction Layer - Abstract Interface
  * @details This file defines the abstract interface for SPI HAL using Bridge pattern.
  *          Supports STM32-Nucleo, RH850, simulation, and socket-based implementations.
+ *          Thread safety: calls on different devices may run in parallel from
+ *          different threads. Calls on the same device are serialized by a
+ *          per-device lock in the bridge. hal_spi_transfer_async() and
+ *          hal_spi_poll() take no lock (callbacks may resubmit); there, and on
+ *          bare-metal targets, a concurrent caller gets HAL_ERROR_BUSY.
+ *          Register the implementation (hal_init()) before starting threads.
  * @author  EswPla HAL Team
  * @date    2026-02-21
  */
@@ -14,8 +20,38 @@
 
 /**
  * @brief Maximum number of SPI interfaces (limited to 7 as per requirements)
+ * @details Every backend reserves its device state for this many devices, so
+ *          a build that uses fewer sets it lower (1 to 7, e.g.
+ *          -DHAL_SPI_MAX_INTERFACES=2 for DEV_0 and DEV_1); higher device IDs
+ *          are then rejected with HAL_ERROR_INVALID_PARAM.
  */
+#ifndef HAL_SPI_MAX_INTERFACES
 #define HAL_SPI_MAX_INTERFACES  7
+#endif
+
+#if (HAL_SPI_MAX_INTERFACES < 1) || (HAL_SPI_MAX_INTERFACES > 7)
+#error "HAL_SPI_MAX_INTERFACES must be 1 to 7"
+#endif
+
+/**
+ * @brief Initializer list with the first HAL_SPI_MAX_INTERFACES of seven
+ *        per-device elements, for static tables that cannot start zeroed
+ */
+#if HAL_SPI_MAX_INTERFACES == 1
+#define HAL_SPI_PER_DEVICE(d0, d1, d2, d3, d4, d5, d6)  d0
+#elif HAL_SPI_MAX_INTERFACES == 2
+#define HAL_SPI_PER_DEVICE(d0, d1, d2, d3, d4, d5, d6)  d0, d1
+#elif HAL_SPI_MAX_INTERFACES == 3
+#define HAL_SPI_PER_DEVICE(d0, d1, d2, d3, d4, d5, d6)  d0, d1, d2
+#elif HAL_SPI_MAX_INTERFACES == 4
+#define HAL_SPI_PER_DEVICE(d0, d1, d2, d3, d4, d5, d6)  d0, d1, d2, d3
+#elif HAL_SPI_MAX_INTERFACES == 5
+#define HAL_SPI_PER_DEVICE(d0, d1, d2, d3, d4, d5, d6)  d0, d1, d2, d3, d4
+#elif HAL_SPI_MAX_INTERFACES == 6
+#define HAL_SPI_PER_DEVICE(d0, d1, d2, d3, d4, d5, d6)  d0, d1, d2, d3, d4, d5
+#else
+#define HAL_SPI_PER_DEVICE(d0, d1, d2, d3, d4, d5, d6)  d0, d1, d2, d3, d4, d5, d6
+#endif
 
 /**
  * @brief SPI device identifier
@@ -69,6 +105,86 @@ typedef struct {
     bool         is_busy;         /**< Busy flag */
 } hal_spi_status_t;
 
+/**
+ * @brief Number of latency histogram buckets
+ * @details Bucket 0 counts operations under 1 us, bucket i (i > 0) counts
+ *          latencies in [2^(i-1), 2^i) us, the last bucket everything above.
+ */
+#define HAL_SPI_STATS_BUCKETS   20
+
+/**
+ * @brief Operation classes tracked by the extended statistics
+ */
+typedef enum {
+    HAL_SPI_OP_TRANSFER = 0,    /**< Full-duplex transfer (sync or async) */
+    HAL_SPI_OP_SEND     = 1,    /**< Transmit only */
+    HAL_SPI_OP_RECEIVE  = 2,    /**< Receive only */
+    HAL_SPI_OP_BATCH    = 3,    /**< Whole batch submission */
+    HAL_SPI_OP_COUNT
+} hal_spi_op_t;
+
+/**
+ * @brief Extended SPI statistics
+ * @details Counters are 64-bit and updated atomically, so they can be read
+ *          from another thread or an ISR while transfers are running. Each
+ *          field is read atomically, the structure as a whole is not a
+ *          consistent snapshot.
+ */
+typedef struct {
+    uint64_t     tx_bytes;                                  /**< Total transmitted bytes */
+    uint64_t     rx_bytes;                                  /**< Total received bytes */
+    uint64_t     op_count[HAL_SPI_OP_COUNT];                /**< Completed operations per class */
+    uint64_t     error_count;                               /**< Failed operations (including timeouts) */
+    uint64_t     timeout_count;                             /**< Operations failed with HAL_ERROR_TIMEOUT */
+    uint32_t     latency_max_us[HAL_SPI_OP_COUNT];          /**< Worst latency per class */
+    uint32_t     latency_hist[HAL_SPI_OP_COUNT][HAL_SPI_STATS_BUCKETS];  /**< Log2 latency histogram */
+} hal_spi_stats_t;
+
+/**
+ * @brief Transfer descriptor for batch submission and scatter-gather segments
+ * @details The buffers select the operation: both set = full-duplex transfer,
+ *          only tx_data = send, only rx_data = receive. As a segment of
+ *          hal_spi_transfer_sg() only tx_data = received bytes are dropped,
+ *          only rx_data = dummy bytes are clocked out.
+ */
+typedef struct {
+    const uint8_t*  tx_data;    /**< Data to transmit (NULL for receive) */
+    uint8_t*        rx_data;    /**< Buffer for received data (NULL for send) */
+    uint16_t        length;     /**< Number of bytes */
+} hal_spi_xfer_t;
+
+/**
+ * @brief Completion callback for asynchronous operations
+ * @details Called exactly once per accepted asynchronous operation, either from
+ *          hal_spi_poll() or from interrupt context, depending on the backend.
+ * @param device SPI device identifier
+ * @param status Final status of the operation
+ * @param user_data Opaque pointer given at submission
+ */
+typedef void (*hal_spi_callback_t)(hal_spi_device_t device, 
+                                   hal_status_t status, 
+                                   void* user_data);
+
+/**
+ * @brief Callback for continuous receive (streaming)
+ * @details Called each time one half of the stream buffer has been filled,
+ *          either from hal_spi_poll() or from interrupt context, depending on
+ *          the backend. data is only valid until the callback returns; the
+ *          hardware fills the other half meanwhile and comes back to this one
+ *          next. On an error the stream has already been stopped, data is
+ *          NULL and this is the last call.
+ * @param device SPI device identifier
+ * @param status HAL_OK, or the error that ended the stream
+ * @param data Half of the stream buffer just filled
+ * @param length Number of bytes in data (half the stream buffer)
+ * @param user_data Opaque pointer given to hal_spi_stream_start()
+ */
+typedef void (*hal_spi_stream_callback_t)(hal_spi_device_t device, 
+                                          hal_status_t status, 
+                                          const uint8_t* data, 
+                                          uint16_t length, 
+                                          void* user_data);
+
 /**
  * @brief Forward declaration of operations structure
  */
@@ -152,6 +268,138 @@ struct hal_spi_ops {
      */
     hal_status_t (*get_status)(hal_spi_device_t device, 
                                hal_spi_status_t* status);
+    
+    /*------------------------------------------------------------------------*/
+    /* Optional operations (may be NULL, the bridge provides a fallback)      */
+    /*------------------------------------------------------------------------*/
+    
+    /**
+     * @brief Start a full-duplex transfer without waiting for completion
+     * @details Buffers must stay valid until the callback has been called.
+     *          The device stays busy until then.
+     * @param device SPI device identifier
+     * @param tx_data Data to transmit
+     * @param rx_data Buffer for received data
+     * @param length Number of bytes to transfer
+     * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+     * @param callback Completion callback
+     * @param user_data Opaque pointer passed to the callback
+     * @return HAL_OK if the transfer was started, error code otherwise
+     */
+    hal_status_t (*transfer_async)(hal_spi_device_t device, 
+                                   const uint8_t* tx_data, 
+                                   uint8_t* rx_data, 
+                                   uint16_t length, 
+                                   uint32_t timeout_ms,
+                                   hal_spi_callback_t callback,
+                                   void* user_data);
+    
+    /**
+     * @brief Drive pending asynchronous work of a device
+     * @param device SPI device identifier
+     * @return HAL_OK if nothing is pending, HAL_ERROR_BUSY while an operation is in flight
+     */
+    hal_status_t (*poll)(hal_spi_device_t device);
+    
+    /**
+     * @brief Run a list of transfers back to back
+     * @details Descriptors have been validated by the bridge. The backend should
+     *          pay its per-call overhead (locking, messages, DMA setup) once per batch.
+     * @param device SPI device identifier
+     * @param xfers Array of transfer descriptors
+     * @param count Number of descriptors
+     * @param timeout_ms Timeout for the whole batch in milliseconds (0 = no timeout)
+     * @return HAL_OK if all transfers succeeded, error code of the first failure otherwise
+     */
+    hal_status_t (*submit_batch)(hal_spi_device_t device, 
+                                 const hal_spi_xfer_t* xfers, 
+                                 uint16_t count, 
+                                 uint32_t timeout_ms);
+    
+    /**
+     * @brief Run one transfer whose data is spread over several buffers
+     * @details Segments have been validated by the bridge and add up to at most
+     *          0xFFFF bytes. The backend should move them as one frame without
+     *          staging copies (vectored send, linked DMA descriptors).
+     * @param device SPI device identifier
+     * @param segs Array of segments, in bus order
+     * @param count Number of segments
+     * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+     * @return HAL_OK on success, error code otherwise
+     */
+    hal_status_t (*transfer_sg)(hal_spi_device_t device, 
+                                const hal_spi_xfer_t* segs, 
+                                uint16_t count, 
+                                uint32_t timeout_ms);
+    
+    /**
+     * @brief Start continuous receive into a double buffer (circular DMA)
+     * @details Arguments have been validated by the bridge (length is even).
+     *          The device stays busy until stream_stop. There is no fallback:
+     *          without this op hal_spi_stream_start() fails with HAL_ERROR.
+     * @param device SPI device identifier
+     * @param buffer Stream buffer, both halves
+     * @param length Size of buffer in bytes
+     * @param callback Called for every filled half
+     * @param user_data Opaque pointer passed to the callback
+     * @return HAL_OK if the stream was started, error code otherwise
+     */
+    hal_status_t (*stream_start)(hal_spi_device_t device, 
+                                 uint8_t* buffer, 
+                                 uint16_t length, 
+                                 hal_spi_stream_callback_t callback, 
+                                 void* user_data);
+    
+    /**
+     * @brief Stop continuous receive, may be called from the stream callback
+     * @param device SPI device identifier
+     * @return HAL_OK on success (also if no stream was running)
+     */
+    hal_status_t (*stream_stop)(hal_spi_device_t device);
+    
+    /**
+     * @brief Run one frame longer than a 16-bit length allows
+     * @details Arguments have been validated by the bridge: at least one buffer
+     *          is set (see hal_spi_xfer_t), length is not 0. Chip select stays
+     *          asserted for the whole frame; the backend splits it into chunks
+     *          internally (pipelined requests, chained DMA) and moves the data
+     *          straight from and into the caller's buffers. Without this op
+     *          hal_spi_transfer_large() handles frames of up to 0xFFFF bytes
+     *          with transfer/send/receive and fails with HAL_ERROR above.
+     * @param device SPI device identifier
+     * @param tx_data Data to transmit (NULL for receive)
+     * @param rx_data Buffer for received data (NULL for send)
+     * @param length Number of bytes
+     * @param timeout_ms Timeout for the whole frame in milliseconds (0 = no timeout)
+     * @return HAL_OK on success, error code otherwise
+     */
+    hal_status_t (*transfer_large)(hal_spi_device_t device, 
+                                   const uint8_t* tx_data, 
+                                   uint8_t* rx_data, 
+                                   uint32_t length, 
+                                   uint32_t timeout_ms);
+    
+    /**
+     * @brief Transfer, send or receive 16- or 32-bit words
+     * @details Arguments have been validated by the bridge: at least one buffer
+     *          is set, count is not 0. Each word is shifted out whole in the
+     *          device's bit order, one access of the peripheral data register
+     *          per frame of data_bits. Without this op the bridge runs the
+     *          words as one byte frame in bus order (see hal_spi_transfer16()).
+     * @param device SPI device identifier
+     * @param tx_words uint16_t or uint32_t words to transmit (NULL for receive)
+     * @param rx_words Buffer for received words of the same type (NULL for send)
+     * @param count Number of words
+     * @param word_size Bytes per word, 2 or 4
+     * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+     * @return HAL_OK on success, error code otherwise
+     */
+    hal_status_t (*transfer_words)(hal_spi_device_t device, 
+                                   const void* tx_words, 
+                                   void* rx_words, 
+                                   uint16_t count, 
+                                   uint8_t word_size, 
+                                   uint32_t timeout_ms);
 };
 
 /*============================================================================*/
@@ -161,12 +409,33 @@ struct hal_spi_ops {
 /**
  * @brief Register SPI operations implementation
  * @details This function allows runtime selection of the SPI implementation
- *          (hardware, simulation, socket, etc.)
+ *          (hardware, simulation, socket, etc.) for all devices. With
+ *          HAL_SPI_STATIC_DISPATCH the implementation is fixed at build time
+ *          and only that one is accepted.
  * @param ops Pointer to operations structure
  * @return HAL_OK on success, error code otherwise
  */
 hal_status_t hal_spi_register_ops(const hal_spi_ops_t* ops);
 
+/**
+ * @brief Register the SPI operations implementation of one device
+ * @details Devices may use different implementations, e.g. DEV_0 on hardware
+ *          and the others simulated. Call while the device is deinitialized.
+ *          With HAL_SPI_STATIC_DISPATCH only the implementation bound to the
+ *          device at build time (HAL_SPI_DEV<n>_OPS) is accepted.
+ * @param device SPI device identifier
+ * @param ops Pointer to operations structure
+ * @return HAL_OK on success, error code otherwise
+ */
+hal_status_t hal_spi_register_device_ops(hal_spi_device_t device, const hal_spi_ops_t* ops);
+
+/**
+ * @brief Get the SPI operations implementation of a device
+ * @param device SPI device identifier
+ * @return Registered operations, NULL if none (or device out of range)
+ */
+const hal_spi_ops_t* hal_spi_get_device_ops(hal_spi_device_t device);
+
 /**
  * @brief Initialize SPI device
  * @param device SPI device identifier (0-6)
@@ -225,6 +494,11 @@ hal_status_t hal_spi_receive(hal_spi_device_t device,
 
 /**
  * @brief Set SPI configuration
+ * @details A configuration equal to the one the device runs with (as last
+ *          applied by hal_spi_init() or this function) returns HAL_OK without
+ *          reaching the backend. STM32 and RH850 keep the register images of
+ *          recent configurations, so switching between them is a few register
+ *          writes.
  * @param device SPI device identifier
  * @param config New configuration parameters
  * @return HAL_OK on success, error code otherwise
@@ -241,4 +515,190 @@ hal_status_t hal_spi_set_config(hal_spi_device_t device,
 hal_status_t hal_spi_get_status(hal_spi_device_t device, 
                                 hal_spi_status_t* status);
 
+/**
+ * @brief Get extended SPI device statistics
+ * @details Lock-free; safe to call from another thread or an ISR.
+ * @param device SPI device identifier
+ * @param stats Pointer to statistics structure to fill
+ * @return HAL_OK on success, error code otherwise
+ */
+hal_status_t hal_spi_get_stats(hal_spi_device_t device, 
+                               hal_spi_stats_t* stats);
+
+/**
+ * @brief Clear extended SPI device statistics
+ * @details The counters in hal_spi_status_t are not affected.
+ * @param device SPI device identifier
+ * @return HAL_OK on success, error code otherwise
+ */
+hal_status_t hal_spi_reset_stats(hal_spi_device_t device);
+
+/**
+ * @brief Run a list of transfers back to back
+ * @details Each descriptor is a transfer, send or receive depending on which
+ *          buffers are set. Processing stops at the first failing descriptor.
+ *          Backends without native batch support run the descriptors one by one.
+ * @param device SPI device identifier
+ * @param xfers Array of transfer descriptors
+ * @param count Number of descriptors
+ * @param timeout_ms Timeout for the whole batch in milliseconds
+ * @return HAL_OK if all transfers succeeded, error code of the first failure otherwise
+ */
+hal_status_t hal_spi_submit_batch(hal_spi_device_t device, 
+                                  const hal_spi_xfer_t* xfers, 
+                                  uint16_t count, 
+                                  uint32_t timeout_ms);
+
+/**
+ * @brief Scatter-gather transfer: one frame built from several buffers
+ * @details Use instead of copying a command header and a payload into one
+ *          staging buffer. The segments go out back to back as one
+ *          transfer; each one sends from tx_data and/or receives into rx_data
+ *          (see hal_spi_xfer_t). If no segment has rx_data this is a send,
+ *          if none has tx_data a receive, and it is counted as such in the
+ *          statistics. Backends without native support run the segments one
+ *          by one.
+ * @param device SPI device identifier
+ * @param segs Array of segments, in bus order
+ * @param count Number of segments
+ * @param timeout_ms Timeout in milliseconds
+ * @return HAL_OK on success, error code otherwise
+ */
+hal_status_t hal_spi_transfer_sg(hal_spi_device_t device, 
+                                 const hal_spi_xfer_t* segs, 
+                                 uint16_t count, 
+                                 uint32_t timeout_ms);
+
+/**
+ * @brief Transfer, send or receive one frame of up to 4 GiB
+ * @details For frames beyond the 16-bit length of hal_spi_transfer() (flash
+ *          images, display frames, sensor dumps). The buffers select the
+ *          operation as in hal_spi_xfer_t: both set = full-duplex transfer,
+ *          only tx_data = send, only rx_data = receive. Chip select stays
+ *          asserted for the whole frame; backends split it into chunks
+ *          internally without copying the caller's data. The frame is one
+ *          operation in the statistics.
+ * @param device SPI device identifier
+ * @param tx_data Data to transmit (NULL for receive)
+ * @param rx_data Buffer for received data (NULL for send)
+ * @param length Number of bytes
+ * @param timeout_ms Timeout for the whole frame in milliseconds
+ * @return HAL_OK on success, HAL_ERROR if the backend offers no large
+ *         transfers and length exceeds 0xFFFF, error code otherwise
+ */
+hal_status_t hal_spi_transfer_large(hal_spi_device_t device, 
+                                    const uint8_t* tx_data, 
+                                    uint8_t* rx_data, 
+                                    uint32_t length, 
+                                    uint32_t timeout_ms);
+
+/**
+ * @brief Transfer, send or receive 16-bit words
+ * @details For devices with 16-bit frames (TLE92104 and alike): the words go
+ *          out whole, most significant bit first or last as set by bit_order,
+ *          so the caller neither splits them into bytes nor swaps them. The
+ *          buffers select the operation as in hal_spi_xfer_t. MCU backends
+ *          write one word per access of the data register (with data_bits 16).
+ *          Elsewhere the bridge turns the words into one byte frame, the most
+ *          significant byte first for MSB-first devices, the least significant
+ *          first otherwise, with at most HAL_SPI_WORD_STAGE_SIZE (256) bytes
+ *          of TX data.
+ * @param device SPI device identifier
+ * @param tx_data Words to transmit (NULL for receive)
+ * @param rx_data Buffer for received words (NULL for send)
+ * @param count Number of words
+ * @param timeout_ms Timeout in milliseconds
+ * @return HAL_OK on success, HAL_ERROR if the frame exceeds what the backend
+ *         can carry, error code otherwise
+ */
+hal_status_t hal_spi_transfer16(hal_spi_device_t device, 
+                                const uint16_t* tx_data, 
+                                uint16_t* rx_data, 
+                                uint16_t count, 
+                                uint32_t timeout_ms);
+
+/**
+ * @brief Transfer, send or receive 32-bit words
+ * @details As hal_spi_transfer16(). Peripherals whose frames end at 16 bits
+ *          move each word as two frames under the same chip select.
+ * @param device SPI device identifier
+ * @param tx_data Words to transmit (NULL for receive)
+ * @param rx_data Buffer for received words (NULL for send)
+ * @param count Number of words
+ * @param timeout_ms Timeout in milliseconds
+ * @return HAL_OK on success, HAL_ERROR if the frame exceeds what the backend
+ *         can carry, error code otherwise
+ */
+hal_status_t hal_spi_transfer32(hal_spi_device_t device, 
+                                const uint32_t* tx_data, 
+                                uint32_t* rx_data, 
+                                uint16_t count, 
+                                uint32_t timeout_ms);
+
+/**
+ * @brief Start a full-duplex SPI transfer without blocking
+ * @details On HAL_OK the callback reports the result once the transfer has
+ *          finished; both buffers must stay valid until then. Any other return
+ *          value means the transfer was rejected and the callback is not called.
+ *          Backends without native support complete the transfer synchronously
+ *          and call the callback before returning.
+ * @param device SPI device identifier
+ * @param tx_data Data to transmit
+ * @param rx_data Buffer for received data
+ * @param length Number of bytes to transfer
+ * @param timeout_ms Timeout in milliseconds
+ * @param callback Completion callback (must not be NULL)
+ * @param user_data Opaque pointer passed to the callback
+ * @return HAL_OK if the transfer was accepted, error code otherwise
+ */
+hal_status_t hal_spi_transfer_async(hal_spi_device_t device, 
+                                    const uint8_t* tx_data, 
+                                    uint8_t* rx_data, 
+                                    uint16_t length, 
+                                    uint32_t timeout_ms,
+                                    hal_spi_callback_t callback,
+                                    void* user_data);
+
+/**
+ * @brief Poll a device for completion of asynchronous operations
+ * @details Backends that complete from the main loop (simulation, socket)
+ *          call pending callbacks from here. Interrupt-driven backends only
+ *          report whether an operation is still in flight.
+ * @param device SPI device identifier
+ * @return HAL_OK if no operation is pending, HAL_ERROR_BUSY if one is in flight
+ */
+hal_status_t hal_spi_poll(hal_spi_device_t device);
+
+/**
+ * @brief Start continuous receive (double-buffered streaming)
+ * @details The device receives without gaps into buffer, treated as two
+ *          halves: while the application handles one half, the other one is
+ *          being filled. MCU backends use circular DMA and call the callback
+ *          from the half/full transfer interrupts; the simulation and socket
+ *          backends deliver filled halves from hal_spi_poll(), which returns
+ *          HAL_ERROR_BUSY while the stream runs. Other operations on the
+ *          device fail with HAL_ERROR_BUSY until hal_spi_stream_stop().
+ *          Every half is counted as one HAL_SPI_OP_RECEIVE in the statistics.
+ * @param device SPI device identifier
+ * @param buffer Stream buffer, must stay valid until the stream is stopped
+ * @param length Size of buffer in bytes (even, at least 2)
+ * @param callback Called for every filled half (must not be NULL)
+ * @param user_data Opaque pointer passed to the callback
+ * @return HAL_OK if the stream was started, error code otherwise
+ */
+hal_status_t hal_spi_stream_start(hal_spi_device_t device, 
+                                  uint8_t* buffer, 
+                                  uint16_t length, 
+                                  hal_spi_stream_callback_t callback, 
+                                  void* user_data);
+
+/**
+ * @brief Stop continuous receive
+ * @details Call from the thread that polls the device or from the stream
+ *          callback. No callback is made after this returns.
+ * @param device SPI device identifier
+ * @return HAL_OK on success (also if no stream was running), error code otherwise
+ */
+hal_status_t hal_spi_stream_stop(hal_spi_device_t device);
+
 #endif /* HAL_SPI_H */
@@ -0,0 +1,275 @@
+/**
+ * @file    hal_spi_backend.h
+ * @brief   SPI HAL Backend Helpers
+ * @details Services shared by the SPI implementations (hal_spi_sim.c,
+ *          hal_spi_socket.c, ...). Not part of the application API.
+ *          Backends account every completed operation through
+ *          hal_spi_stats_record() instead of updating hal_spi_status_t
+ *          counters themselves, so all implementations report alike.
+ *          Operations claim a device with hal_spi_claim() and give it back
+ *          with hal_spi_release(); a single atomic exchange decides between
+ *          concurrent callers (threads or ISRs). Large per-device buffers
+ *          come from a hal_spi_pool_t, taken at init.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#ifndef HAL_SPI_BACKEND_H
+#define HAL_SPI_BACKEND_H
+
+#include "hal_spi.h"
+#include "hal_time.h"
+#include "hal_atomic.h"
+
+/**
+ * @brief Backend parameter check that repeats a check of the bridge
+ * @details hal_spi.c validates every argument before it calls an operation.
+ *          With the runtime bridge a backend keeps its own checks, since an
+ *          ops table may also be called or registered by other code. With
+ *          HAL_SPI_STATIC_DISPATCH the bridge is bound to one backend at
+ *          build time and is its only caller, so the repeated checks compile
+ *          out and each argument is validated once.
+ */
+#ifdef HAL_SPI_STATIC_DISPATCH
+#define HAL_SPI_PARAM_INVALID(cond)     (false)
+#else
+#define HAL_SPI_PARAM_INVALID(cond)     (cond)
+#endif
+
+/**
+ * @brief Mark a device busy for the calling operation
+ * @param status Backend status structure of the device
+ * @return true if the caller now owns the device, false if it was already busy
+ */
+static inline bool hal_spi_claim(hal_spi_status_t* status)
+{
+    return !HAL_ATOMIC_TEST_AND_SET(&status->is_busy);
+}
+
+/**
+ * @brief Give a device claimed with hal_spi_claim() back
+ * @param status Backend status structure of the device
+ */
+static inline void hal_spi_release(hal_spi_status_t* status)
+{
+    HAL_ATOMIC_CLEAR(&status->is_busy);
+}
+
+/**
+ * @brief Wait for an operation that an interrupt completes
+ * @details Interrupt- and DMA-driven backends start the hardware and wait here
+ *          until their interrupt sets *done. The timeout is measured on the
+ *          hardware counter behind hal_time_now_us(), not by counting loop
+ *          iterations, so it does not depend on the CPU clock. With sleep set
+ *          the core waits for interrupts in between (WFI on STM32, HALT on
+ *          RH850). The check and the sleep run with interrupts masked, so a
+ *          completion between them still ends the sleep. Any interrupt wakes
+ *          the core, at the latest the system tick, which bounds how late a
+ *          timeout is noticed.
+ * @param done Set to non-zero by the interrupt when the operation is done
+ * @param start_us hal_time_now_us() taken when the operation started
+ * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+ * @param sleep false for frames shorter than a sleep and wake-up
+ * @return HAL_OK once *done is set, HAL_ERROR_TIMEOUT (the caller then stops
+ *         the hardware before it gives the buffers back)
+ */
+static inline hal_status_t hal_spi_wait_done(const volatile uint8_t* done,
+                                             uint32_t start_us,
+                                             uint32_t timeout_ms,
+                                             bool sleep)
+{
+    while (*done == 0U) {
+        uint32_t elapsed_ms = (hal_time_now_us() - start_us) / 1000U;
+        if (timeout_ms != 0U && elapsed_ms >= timeout_ms) {
+            return (*done != 0U) ? HAL_OK : HAL_ERROR_TIMEOUT;
+        }
+        if (sleep) {
+#if defined(STM32_TARGET)
+            /* __disable_irq();
+             * if (*done == 0U) {
+             *     __WFI();  // A pending interrupt ends WFI even while masked
+             * }
+             * __enable_irq();
+             */
+#elif defined(RH850_TARGET)
+            /* __DI();
+             * if (*done == 0U) {
+             *     __halt();  // A pending interrupt releases HALT even with PSW.ID set
+             * }
+             * __EI();
+             */
+#endif
+        }
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief Buffer pool shared by the devices of a backend
+ * @details The backend reserves slots * slot_size bytes once; a device takes
+ *          a slot at init and gives it back at deinit. RAM then follows the
+ *          number of devices open at once instead of HAL_SPI_MAX_INTERFACES.
+ *          Slots are taken with a compare-and-swap on a bit mask, so inits of
+ *          different devices may run in parallel.
+ */
+typedef struct {
+    uint8_t*            storage;    /**< slots * slot_size bytes */
+    uint32_t            slot_size;
+    uint32_t            slots;      /**< At most 32 */
+    volatile uint32_t   used;       /**< Bit n set: slot n is taken */
+} hal_spi_pool_t;
+
+/**
+ * @brief Static initializer of a pool over a two-dimensional array
+ */
+#define HAL_SPI_POOL_INIT(storage, slots, slot_size) \
+    { (uint8_t*)(storage), (slot_size), (slots), 0U }
+
+/**
+ * @brief Take a free slot
+ * @return Start of the slot, NULL if all are taken
+ */
+static inline uint8_t* hal_spi_pool_take(hal_spi_pool_t* pool)
+{
+    uint32_t used = HAL_ATOMIC_LOAD_U32(&pool->used);
+    
+    for (;;) {
+        uint32_t slot = 0;
+        while (slot < pool->slots && (used & (1UL << slot)) != 0U) {
+            slot++;
+        }
+        if (slot == pool->slots) {
+            return NULL;
+        }
+        if (HAL_ATOMIC_CAS_U32(&pool->used, &used, used | (1UL << slot))) {
+            return &pool->storage[slot * pool->slot_size];
+        }
+    }
+}
+
+/**
+ * @brief Return a slot taken with hal_spi_pool_take()
+ */
+static inline void hal_spi_pool_give(hal_spi_pool_t* pool, const uint8_t* buffer)
+{
+    uint32_t bit = 1UL << ((uint32_t)(buffer - pool->storage) / pool->slot_size);
+    uint32_t used = HAL_ATOMIC_LOAD_U32(&pool->used);
+    
+    for (;;) {
+        if (HAL_ATOMIC_CAS_U32(&pool->used, &used, used & ~bit)) {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Compare two configurations field by field (padding may differ)
+ * @return true if a device configured with one runs the same with the other
+ */
+static inline bool hal_spi_config_equal(const hal_spi_config_t* a, const hal_spi_config_t* b)
+{
+    return a->baudrate == b->baudrate && 
+           a->mode == b->mode && 
+           a->bit_order == b->bit_order && 
+           a->data_bits == b->data_bits;
+}
+
+/**
+ * @brief Classify a scatter-gather frame and count its bytes
+ * @details A frame without RX segments is a send, one without TX segments a
+ *          receive, anything else a transfer.
+ * @param segs Segments, validated by the bridge
+ * @param count Number of segments
+ * @param frame_bytes Receives the length of the whole frame
+ * @param tx_bytes Receives the bytes of all segments with tx_data
+ * @param rx_bytes Receives the bytes of all segments with rx_data
+ * @return Operation class of the frame
+ */
+static inline hal_spi_op_t hal_spi_sg_classify(const hal_spi_xfer_t* segs, 
+                                               uint16_t count, 
+                                               uint32_t* frame_bytes, 
+                                               uint32_t* tx_bytes, 
+                                               uint32_t* rx_bytes)
+{
+    *frame_bytes = 0;
+    *tx_bytes = 0;
+    *rx_bytes = 0;
+    
+    for (uint16_t i = 0; i < count; i++) {
+        *frame_bytes += segs[i].length;
+        if (segs[i].tx_data != NULL) {
+            *tx_bytes += segs[i].length;
+        }
+        if (segs[i].rx_data != NULL) {
+            *rx_bytes += segs[i].length;
+        }
+    }
+    
+    if (*rx_bytes == 0U) {
+        return HAL_SPI_OP_SEND;
+    }
+    return (*tx_bytes == 0U) ? HAL_SPI_OP_RECEIVE : HAL_SPI_OP_TRANSFER;
+}
+
+/**
+ * @brief Chunk size backends split a hal_spi_transfer_large() frame into
+ * @details Fits the 16-bit lengths of the protocol and of DMA counters, and
+ *          is a multiple of 256 so device models and FIFOs see aligned pieces.
+ */
+#ifndef HAL_SPI_LARGE_CHUNK
+#define HAL_SPI_LARGE_CHUNK     0xFF00U
+#endif
+
+/**
+ * @brief Classify a large frame by its buffers (see hal_spi_xfer_t)
+ * @param tx_data Data to transmit, may be NULL
+ * @param rx_data Buffer for received data, may be NULL
+ * @return Operation class of the frame
+ */
+static inline hal_spi_op_t hal_spi_large_classify(const uint8_t* tx_data, const uint8_t* rx_data)
+{
+    if (rx_data == NULL) {
+        return HAL_SPI_OP_SEND;
+    }
+    return (tx_data == NULL) ? HAL_SPI_OP_RECEIVE : HAL_SPI_OP_TRANSFER;
+}
+
+/**
+ * @brief Clear the statistics of a device
+ * @details Called by backends from init. Clears the extended statistics and,
+ *          if status is not NULL, the counters in hal_spi_status_t.
+ * @param device SPI device identifier
+ * @param status Backend status structure of the device (may be NULL)
+ */
+void hal_spi_stats_reset(hal_spi_device_t device, hal_spi_status_t* status);
+
+/**
+ * @brief Account one completed operation
+ * @details Adds tx_bytes/rx_bytes to both the extended statistics and
+ *          status, then counts a completed operation on success or an error
+ *          (and a timeout for HAL_ERROR_TIMEOUT) on failure. The latency since
+ *          start_us goes into the histogram of op either way.
+ * @param device SPI device identifier
+ * @param status Backend status structure of the device
+ * @param op Operation class
+ * @param result Result of the operation
+ * @param tx_bytes Bytes actually transmitted
+ * @param rx_bytes Bytes actually received
+ * @param start_us hal_time_now_us() taken when the operation started
+ */
+void hal_spi_stats_record(hal_spi_device_t device, 
+                          hal_spi_status_t* status, 
+                          hal_spi_op_t op, 
+                          hal_status_t result, 
+                          uint32_t tx_bytes, 
+                          uint32_t rx_bytes, 
+                          uint32_t start_us);
+
+/**
+ * @brief Copy the extended statistics of a device
+ * @param device SPI device identifier
+ * @param stats Destination
+ */
+void hal_spi_stats_read(hal_spi_device_t device, hal_spi_stats_t* stats);
+
+#endif /* HAL_SPI_BACKEND_H */
@@ -0,0 +1,184 @@
+/**
+ * @file    hal_spi_bus.h
+ * @brief   Shared SPI Bus Arbitration
+ * @details Several slaves (a TLE92104, sensors, a display) on one physical
+ *          bus, i.e. one hal_spi_device_t, each with its own chip select and
+ *          configuration. A slave owns the bus between hal_spi_bus_begin()
+ *          and hal_spi_bus_end(); its configuration is applied on begin, 
+ *          unless the bus already runs with an identical one. Requests queued
+ *          with hal_spi_bus_submit() are run by hal_spi_bus_process() in
+ *          priority order, consecutive requests of one slave as one batch.
+ *          All traffic of a shared bus has to go through this module; a
+ *          direct hal_spi_set_config() on the device is not seen by it.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#ifndef HAL_SPI_BUS_H
+#define HAL_SPI_BUS_H
+
+#include "hal_spi.h"
+
+/*============================================================================*/
+/* Configuration                                                              */
+/*============================================================================*/
+
+/**
+ * @brief Descriptors of queued requests run as one batch
+ * @details Bounds both the stack staging of hal_spi_bus_process() and how long
+ *          a higher-priority request waits behind a merged batch.
+ */
+#ifndef HAL_SPI_BUS_MERGE_MAX
+#define HAL_SPI_BUS_MERGE_MAX   16U
+#endif
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief Slave priority (lower value is served first)
+ */
+typedef enum {
+    HAL_SPI_BUS_PRIO_HIGH   = 0,    /**< E.g. watchdog service */
+    HAL_SPI_BUS_PRIO_NORMAL = 1,
+    HAL_SPI_BUS_PRIO_BULK   = 2,    /**< E.g. display pushes */
+    HAL_SPI_BUS_PRIO_COUNT
+} hal_spi_bus_prio_t;
+
+/**
+ * @brief Drive a chip select line
+ * @param cs_context Opaque pointer of the slave (e.g. a GPIO pin)
+ * @param asserted true to select the slave
+ */
+typedef void (*hal_spi_cs_fn_t)(void* cs_context, bool asserted);
+
+/**
+ * @brief Slave flags
+ */
+#define HAL_SPI_SLAVE_FLAG_SHARE_CS 0x01U   /**< Queued requests may share one chip select window */
+
+/**
+ * @brief Slave on a shared bus
+ * @details Owned by the application, must stay valid while in use.
+ */
+typedef struct {
+    hal_spi_device_t        device;     /**< Bus the slave sits on */
+    hal_spi_config_t        config;     /**< Applied when the slave takes the bus */
+    hal_spi_bus_prio_t      priority;
+    hal_spi_cs_fn_t         cs;         /**< Chip select, asserted from begin to end;
+                                             NULL = the device's own per-frame chip select */
+    void*                   cs_context; /**< Passed to cs */
+    uint8_t                 flags;      /**< HAL_SPI_SLAVE_FLAG_* */
+} hal_spi_slave_t;
+
+/**
+ * @brief Queued request, one chip select window of a slave
+ * @details Owned by the caller, must stay valid (with its descriptors and
+ *          their buffers) until the callback has been called.
+ */
+typedef struct hal_spi_bus_request {
+    const hal_spi_slave_t*      slave;
+    const hal_spi_xfer_t*       xfers;      /**< Run as hal_spi_submit_batch() */
+    uint16_t                    count;
+    uint32_t                    timeout_ms;
+    hal_spi_callback_t          callback;   /**< Completion (may be NULL) */
+    void*                       user_data;
+    struct hal_spi_bus_request* next;       /**< Internal */
+} hal_spi_bus_request_t;
+
+/**
+ * @brief Bus counters
+ */
+typedef struct {
+    uint32_t    transactions;   /**< Chip select windows (begin/end and batches) */
+    uint32_t    requests;       /**< Queued requests completed */
+    uint32_t    merged;         /**< Requests that joined the batch of the one before */
+    uint32_t    config_applied; /**< set_config calls made */
+    uint32_t    config_skipped; /**< set_config calls saved by an identical configuration */
+} hal_spi_bus_info_t;
+
+/*============================================================================*/
+/* Public API Functions                                                       */
+/*============================================================================*/
+
+/**
+ * @brief Initialize a device as a shared bus
+ * @param device SPI device identifier
+ * @param config Initial configuration (e.g. that of the most used slave)
+ * @return HAL_OK, error code of hal_spi_init() otherwise
+ */
+hal_status_t hal_spi_bus_open(hal_spi_device_t device, const hal_spi_config_t* config);
+
+/**
+ * @brief Deinitialize a shared bus
+ * @param device SPI device identifier
+ * @return HAL_OK, HAL_ERROR_BUSY while a slave owns the bus or requests are
+ *         queued, error code of hal_spi_deinit() otherwise
+ */
+hal_status_t hal_spi_bus_close(hal_spi_device_t device);
+
+/**
+ * @brief Take the bus for a slave
+ * @details Waits until the bus is free and no slave of higher priority waits
+ *          for it, applies the slave's configuration if it differs from the
+ *          current one and asserts its chip select. Transfer with the
+ *          hal_spi_* functions on slave->device until hal_spi_bus_end(). With
+ *          a per-frame chip select (cs NULL) every call is its own frame, but
+ *          no other slave gets in between. On bare-metal targets there is no
+ *          waiting: a busy bus gives HAL_ERROR_BUSY.
+ * @param slave Slave to select
+ * @param timeout_ms Time to wait for the bus in milliseconds (0 = no timeout)
+ * @return HAL_OK, HAL_ERROR_TIMEOUT, HAL_ERROR_BUSY, HAL_ERROR_NOT_INIT if the
+ *         bus is not open, error code of hal_spi_set_config() otherwise
+ */
+hal_status_t hal_spi_bus_begin(const hal_spi_slave_t* slave, uint32_t timeout_ms);
+
+/**
+ * @brief Deassert the chip select and give the bus back
+ * @param slave Slave given to hal_spi_bus_begin()
+ * @return HAL_OK, HAL_ERROR_INVALID_PARAM if the slave does not own the bus
+ */
+hal_status_t hal_spi_bus_end(const hal_spi_slave_t* slave);
+
+/**
+ * @brief Queue a request for hal_spi_bus_process()
+ * @details May be called from a completion callback. On bare-metal targets
+ *          call it from the same context as hal_spi_bus_process().
+ * @param request Request to queue
+ * @return HAL_OK, HAL_ERROR_INVALID_PARAM, HAL_ERROR_NOT_INIT if the bus is
+ *         not open
+ */
+hal_status_t hal_spi_bus_submit(hal_spi_bus_request_t* request);
+
+/**
+ * @brief Run queued requests of a bus
+ * @details Highest priority first, in submission order within a priority.
+ *          Consecutive requests of one slave run as one hal_spi_submit_batch()
+ *          of up to HAL_SPI_BUS_MERGE_MAX descriptors if the slave uses the
+ *          per-frame chip select or sets HAL_SPI_SLAVE_FLAG_SHARE_CS (then
+ *          in one chip select window). A merged batch completes all its
+ *          requests with its status. Before every batch the queue is looked
+ *          at again, and the bus is handed to a hal_spi_bus_begin() waiter of
+ *          higher priority. Callbacks run on the caller's thread; they may
+ *          submit but not begin. One call runs at most as many requests as
+ *          were queued when it started, so callbacks that resubmit cannot
+ *          keep it going.
+ *          A bulk transfer should be queued in pieces (e.g. display lines) so
+ *          urgent requests can go between them.
+ * @param device SPI device identifier
+ * @return HAL_OK when done, HAL_ERROR_BUSY if the bus is owned or was
+ *         handed to a waiter (requests remain queued),
+ *         HAL_ERROR_INVALID_PARAM or HAL_ERROR_NOT_INIT
+ */
+hal_status_t hal_spi_bus_process(hal_spi_device_t device);
+
+/**
+ * @brief Read the counters of a bus
+ * @param device SPI device identifier
+ * @param info Receives the counters
+ * @return HAL_OK, HAL_ERROR_INVALID_PARAM
+ */
+hal_status_t hal_spi_bus_get_info(hal_spi_device_t device, hal_spi_bus_info_t* info);
+
+#endif /* HAL_SPI_BUS_H */
@@ -0,0 +1,188 @@
+/**
+ * @file    hal_spi_capture.h
+ * @brief   SPI Traffic Capture and Replay
+ * @details Capture wraps any hal_spi_ops_t and appends every operation
+ *          (device, type, result, configuration, TX and RX data, timestamp)
+ *          to a binary trace file. The replay backend (hal_spi_replay.c) maps
+ *          such a file and answers the same sequence of operations with the
+ *          recorded RX data and results, at memory speed: a session captured
+ *          once against the socket server or hardware reruns in CI without
+ *          either.
+ *
+ *          File layout (host byte order, every record 4-byte aligned):
+ *            hal_spi_capture_file_t
+ *            { hal_spi_rec_header_t, TX section, RX section, padding }...
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#ifndef HAL_SPI_CAPTURE_H
+#define HAL_SPI_CAPTURE_H
+
+#include "hal_spi.h"
+
+/*============================================================================*/
+/* File Format                                                                */
+/*============================================================================*/
+
+#define HAL_SPI_CAPTURE_MAGIC       0x5450534DU     /* "MSPT" */
+#define HAL_SPI_CAPTURE_VERSION     1U
+#define HAL_SPI_CAPTURE_ALIGN       4U
+
+/**
+ * @brief File used when no path is given (hal_init(), replay)
+ */
+#define HAL_SPI_CAPTURE_DEFAULT_FILE    "hal_spi_capture.spt"
+
+/**
+ * @brief Record types (values follow the simulator message types)
+ * @details TX and RX sections per type:
+ *          - INIT, SET_CONFIG: hal_spi_rec_config_t / empty
+ *          - DEINIT: empty / empty
+ *          - TRANSFER: TX data / RX data (empty unless status is HAL_OK)
+ *          - SEND: TX data / empty
+ *          - RECEIVE: empty / RX data
+ *          - hal_spi_transfer_large() frames are TRANSFER, SEND or RECEIVE
+ *            records with sections beyond 0xFFFF bytes
+ *          - hal_spi_transfer16()/32() frames are TRANSFER, SEND or RECEIVE
+ *            records of the words in bus byte order (as the bridge would
+ *            stage them without a transfer_words op)
+ *          - BATCH, SG: count hal_spi_rec_seg_t, then the TX data of all
+ *            segments that have it / the RX data of all segments that have it
+ *          - STREAM: empty / one filled stream half
+ */
+typedef enum {
+    HAL_SPI_REC_INIT        = 0x01,
+    HAL_SPI_REC_DEINIT      = 0x02,
+    HAL_SPI_REC_TRANSFER    = 0x03,
+    HAL_SPI_REC_SEND        = 0x04,
+    HAL_SPI_REC_RECEIVE     = 0x05,
+    HAL_SPI_REC_SET_CONFIG  = 0x06,
+    HAL_SPI_REC_BATCH       = 0x08,
+    HAL_SPI_REC_SG          = 0x09,
+    HAL_SPI_REC_STREAM      = 0x0A
+} hal_spi_rec_type_t;
+
+/**
+ * @brief Record flags
+ */
+#define HAL_SPI_REC_FLAG_ASYNC      0x01U   /**< TRANSFER completed through a callback */
+
+/**
+ * @brief File header
+ */
+typedef struct {
+    uint32_t    magic;          /**< HAL_SPI_CAPTURE_MAGIC */
+    uint16_t    version;        /**< HAL_SPI_CAPTURE_VERSION */
+    uint16_t    header_size;    /**< sizeof(hal_spi_capture_file_t) */
+    uint32_t    reserved[2];
+} hal_spi_capture_file_t;
+
+/**
+ * @brief Record header (20 bytes)
+ */
+typedef struct {
+    uint32_t    timestamp_us;   /**< Start of the operation, since capture start */
+    uint8_t     type;           /**< hal_spi_rec_type_t */
+    uint8_t     device;         /**< SPI device identifier */
+    int8_t      status;         /**< hal_status_t of the operation */
+    uint8_t     flags;          /**< HAL_SPI_REC_FLAG_* */
+    uint16_t    count;          /**< Segments (BATCH, SG) */
+    uint16_t    reserved;
+    uint32_t    tx_length;      /**< Bytes of the TX section */
+    uint32_t    rx_length;      /**< Bytes of the RX section */
+} hal_spi_rec_header_t;
+
+/**
+ * @brief Device configuration as recorded (no padding, compares bytewise)
+ */
+typedef struct {
+    uint32_t    baudrate;
+    uint8_t     mode;
+    uint8_t     bit_order;
+    uint8_t     data_bits;
+    uint8_t     reserved;
+} hal_spi_rec_config_t;
+
+/**
+ * @brief Segment of a BATCH or SG record
+ */
+typedef struct {
+    uint8_t     type;           /**< HAL_SPI_REC_TRANSFER, _SEND or _RECEIVE */
+    uint8_t     reserved;
+    uint16_t    length;
+} hal_spi_rec_seg_t;
+
+/*============================================================================*/
+/* Capture (hal_spi_capture.c)                                                */
+/*============================================================================*/
+
+/**
+ * @brief Start capturing the traffic of an implementation
+ * @details Register the returned table instead of inner. It offers the same
+ *          optional operations as inner, so the bridge fallbacks stay the
+ *          same. Not available with HAL_SPI_STATIC_DISPATCH.
+ *          Built with HAL_SPI_CAPTURE, hal_init() does this itself, writing
+ *          to $HAL_SPI_CAPTURE_FILE or HAL_SPI_CAPTURE_DEFAULT_FILE.
+ * @param inner Implementation to capture (e.g. &hal_spi_socket_ops)
+ * @param path Trace file, created or truncated
+ * @return Operations to register, NULL if the file cannot be created or a
+ *         capture is already running
+ *
+ * @code
+ * hal_spi_register_ops(hal_spi_capture_start(&hal_spi_socket_ops, "session.spt"));
+ * @endcode
+ */
+const hal_spi_ops_t* hal_spi_capture_start(const hal_spi_ops_t* inner, const char* path);
+
+/**
+ * @brief Flush and close the trace file
+ * @details The capture table keeps forwarding to inner, without recording.
+ * @return HAL_OK, HAL_ERROR_NOT_INIT if no capture runs, HAL_ERROR if
+ *         writing failed at any point
+ */
+hal_status_t hal_spi_capture_stop(void);
+
+/*============================================================================*/
+/* Replay (hal_spi_replay.c, HAL_IMPLEMENTATION=REPLAY)                       */
+/*============================================================================*/
+
+/**
+ * @brief Replay state
+ */
+typedef struct {
+    uint32_t    records;        /**< Records in the file */
+    uint32_t    replayed;       /**< Operations answered from the file */
+    uint32_t    mismatches;     /**< Operations that differed from the recording */
+} hal_spi_replay_info_t;
+
+/**
+ * @brief Map a trace file for hal_spi_replay_ops
+ * @details Without it, the first hal_spi_init() maps $HAL_SPI_REPLAY_FILE
+ *          or HAL_SPI_CAPTURE_DEFAULT_FILE. Call with all devices deinitialized.
+ * @param path Trace file written by the capture
+ * @return HAL_OK, HAL_ERROR_INVALID_PARAM, HAL_ERROR if it cannot be mapped
+ *         or is no trace file, HAL_ERROR_BUSY if a device is initialized
+ */
+hal_status_t hal_spi_replay_open(const char* path);
+
+/**
+ * @brief Unmap the trace file
+ */
+void hal_spi_replay_close(void);
+
+/**
+ * @brief Restart from the first record, for the next regression iteration
+ * @details Call with all devices deinitialized. Clears the counters.
+ * @return HAL_OK, HAL_ERROR_NOT_INIT if no file is mapped, HAL_ERROR_BUSY
+ */
+hal_status_t hal_spi_replay_rewind(void);
+
+/**
+ * @brief Read the replay counters
+ * @param info Receives the counters
+ * @return HAL_OK, HAL_ERROR_INVALID_PARAM or HAL_ERROR_NOT_INIT
+ */
+hal_status_t hal_spi_replay_get_info(hal_spi_replay_info_t* info);
+
+#endif /* HAL_SPI_CAPTURE_H */
@@ -0,0 +1,123 @@
+/**
+ * @file    hal_spi_proto.h
+ * @brief   SPI HAL Simulator Wire Protocol
+ * @details Messages exchanged between the host backends (hal_spi_socket.c,
+ *          hal_spi_shm.c) and a device simulator server (tools/). Every
+ *          message is an 8-byte header followed by data_length payload
+ *          bytes; the server answers each request with one
+ *          HAL_SPI_MSG_RESPONSE carrying the request's device_id and
+ *          sequence. Requests may be pipelined, responses come in order.
+ *          Depends on <stdint.h> only, so servers build without the HAL.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#ifndef HAL_SPI_PROTO_H
+#define HAL_SPI_PROTO_H
+
+#include <stdint.h>
+
+/**
+ * @brief Message types
+ * @details Request payloads and their responses:
+ *          - INIT, SET_CONFIG: hal_spi_config_t / empty
+ *          - DEINIT: empty / empty
+ *          - TRANSFER: TX data / as many RX bytes
+ *          - SEND: TX data / empty
+ *          - RECEIVE: length (2 bytes, big-endian) / length RX bytes
+ *          - GET_STATUS: empty / state(1), error(1)
+ *          - BATCH: hal_spi_batch_entry_t list / RX data of all TRANSFER and
+ *            RECEIVE entries, concatenated
+ */
+typedef enum {
+    HAL_SPI_MSG_INIT        = 0x01, 
+    HAL_SPI_MSG_DEINIT      = 0x02, 
+    HAL_SPI_MSG_TRANSFER    = 0x03, 
+    HAL_SPI_MSG_SEND        = 0x04, 
+    HAL_SPI_MSG_RECEIVE     = 0x05, 
+    HAL_SPI_MSG_SET_CONFIG  = 0x06, 
+    HAL_SPI_MSG_GET_STATUS  = 0x07, 
+    HAL_SPI_MSG_BATCH       = 0x08, 
+    HAL_SPI_MSG_RESPONSE    = 0x80
+} hal_spi_msg_type_t;
+
+/**
+ * @brief Flag ORed onto TRANSFER, SEND or RECEIVE: the frame continues
+ * @details Chip select stays asserted into the next TRANSFER, SEND or RECEIVE
+ *          of the same device, so one frame can span many messages
+ *          (hal_spi_transfer_large()). Payload and response are those of the
+ *          plain type; the last message of the frame comes without the flag.
+ */
+#define HAL_SPI_MSG_FLAG_MORE       0x40U
+
+/**
+ * @brief Message header (little-endian)
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t     msg_type;       /**< Message type */
+    uint8_t     device_id;      /**< SPI device ID */
+    uint16_t    data_length;    /**< Payload length */
+    uint32_t    sequence;       /**< Sequence number */
+} hal_spi_msg_header_t;
+
+/**
+ * @brief Largest payload of one message
+ */
+#define HAL_SPI_MSG_MAX_PAYLOAD     0xFFFFU
+
+/**
+ * @brief Per-descriptor header inside a HAL_SPI_MSG_BATCH payload
+ * @details Followed by length bytes of TX data for TRANSFER and SEND entries.
+ *          The response payload is the RX data of all TRANSFER and RECEIVE
+ *          entries, concatenated in order.
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t     msg_type;       /**< HAL_SPI_MSG_TRANSFER, _SEND or _RECEIVE */
+    uint16_t    length;         /**< Transfer length */
+} hal_spi_batch_entry_t;
+
+/*============================================================================*/
+/* Shared-memory transport                                                    */
+/*============================================================================*/
+
+#define HAL_SPI_SHM_DEFAULT_NAME    "m_hal_spi"
+#define HAL_SPI_SHM_MAGIC           0x4D48534DU     /* "MSHM" */
+#define HAL_SPI_SHM_VERSION         1U
+
+/**
+ * @brief Bytes per ring, a power of two above the largest message
+ */
+#define HAL_SPI_SHM_RING_SIZE       (256U * 1024U)
+
+/**
+ * @brief One direction of the shared-memory channel
+ * @details head and tail are free-running byte counters (head - tail bytes
+ *          are pending), each on its own cache line. A consumer about to sleep
+ *          sets head_waiters and sleeps on head; a producer about to sleep for
+ *          space sets tail_waiters and sleeps on tail. A message is published
+ *          with a single store of head, so the consumer never sees half of it.
+ */
+typedef struct {
+    volatile uint32_t   head;           /**< Bytes written (producer) */
+    volatile uint32_t   head_waiters;   /**< Consumer sleeps on head */
+    uint8_t             reserved0[56];
+    volatile uint32_t   tail;           /**< Bytes consumed (consumer) */
+    volatile uint32_t   tail_waiters;   /**< Producer sleeps on tail */
+    uint8_t             reserved1[56];
+    uint8_t             data[HAL_SPI_SHM_RING_SIZE];
+} hal_spi_shm_ring_t;
+
+/**
+ * @brief Layout of the shared region, created by the server
+ * @details magic is stored last, once the rings are set up.
+ */
+typedef struct {
+    volatile uint32_t   magic;
+    uint32_t            version;
+    uint32_t            ring_size;
+    uint8_t             reserved[52];
+    hal_spi_shm_ring_t  request;        /**< Client to server */
+    hal_spi_shm_ring_t  response;       /**< Server to client */
+} hal_spi_shm_region_t;
+
+#endif /* HAL_SPI_PROTO_H */
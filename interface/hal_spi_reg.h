@@ -0,0 +1,133 @@
+/**
+ * @file    hal_spi_reg.h
+ * @brief   SPI Register Device Helper
+ * @details Register access for devices with TLE92104-style 16-bit frames on
+ *          top of hal_spi.h:
+ *            [CMD(2) | ADDR(4) | DATA(8) | PARITY(1) | RESERVED(1)]
+ *            CMD: 00 = Read, 01 = Write; PARITY: even over bits 15:2
+ *          Such a device answers every frame with the address and data of
+ *          the frame before, so a lone read costs two frames. Reads issued
+ *          together are merged into one transfer of N + 1 frames, each
+ *          response carrying the register of the frame before it.
+ *          Registers marked static (device ID, configuration) are kept in a
+ *          write-through shadow: after the first read or a write they cost no
+ *          frame at all. Call hal_spi_reg_invalidate() after a device reset.
+ *          A register device is used by one thread at a time.
+ * @author  EswPla HAL Team
+ * @date    2026-10-15
+ */
+
+#ifndef HAL_SPI_REG_H
+#define HAL_SPI_REG_H
+
+#include "hal_spi.h"
+
+/*============================================================================*/
+/* Configuration                                                              */
+/*============================================================================*/
+
+/**
+ * @brief Reads merged into one transfer
+ * @details Bounds the stack staging (4 bytes per frame); longer lists are
+ *          split, each part costing one frame more than its reads.
+ */
+#ifndef HAL_SPI_REG_MERGE_MAX
+#define HAL_SPI_REG_MERGE_MAX   16U
+#endif
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief Number of register addresses (4-bit address field)
+ */
+#define HAL_SPI_REG_COUNT       16U
+
+/**
+ * @brief Frame commands
+ */
+#define HAL_SPI_REG_CMD_READ    0x00U
+#define HAL_SPI_REG_CMD_WRITE   0x01U
+
+/**
+ * @brief Register device
+ * @details Owned by the application, set up with hal_spi_reg_init().
+ */
+typedef struct {
+    hal_spi_device_t    device;         /**< SPI device, initialized with hal_spi_init() */
+    uint32_t            timeout_ms;     /**< Timeout of every transfer */
+    uint16_t            static_mask;    /**< Bit n: register n only changes through writes */
+    uint16_t            valid_mask;     /**< Bit n: shadow[n] holds the register */
+    uint8_t             shadow[HAL_SPI_REG_COUNT];
+    uint32_t            frames;         /**< Frames sent */
+    uint32_t            cache_hits;     /**< Reads answered from the shadow */
+} hal_spi_reg_dev_t;
+
+/*============================================================================*/
+/* Public API Functions                                                       */
+/*============================================================================*/
+
+/**
+ * @brief Build a frame
+ * @param cmd HAL_SPI_REG_CMD_READ or HAL_SPI_REG_CMD_WRITE
+ * @param addr Register address (0..15)
+ * @param data Data to write (ignored by reads)
+ * @return Frame with even parity over bits 15:2
+ */
+uint16_t hal_spi_reg_frame(uint8_t cmd, uint8_t addr, uint8_t data);
+
+/**
+ * @brief Set up a register device with an empty shadow
+ * @param reg Register device
+ * @param device SPI device the register device sits on
+ * @param static_mask Registers to keep in the shadow (bit n = register n)
+ * @param timeout_ms Timeout of every transfer (0 = no timeout)
+ * @return HAL_OK, HAL_ERROR_INVALID_PARAM
+ */
+hal_status_t hal_spi_reg_init(hal_spi_reg_dev_t* reg,
+                              hal_spi_device_t device,
+                              uint16_t static_mask,
+                              uint32_t timeout_ms);
+
+/**
+ * @brief Read one register
+ * @param reg Register device
+ * @param addr Register address
+ * @param value Receives the register
+ * @return HAL_OK, HAL_ERROR if a response is corrupt (address or parity),
+ *         error code of hal_spi_transfer() otherwise
+ */
+hal_status_t hal_spi_reg_read(hal_spi_reg_dev_t* reg, uint8_t addr, uint8_t* value);
+
+/**
+ * @brief Read several registers with one transfer
+ * @details Shadowed registers are taken from the shadow; the others cost
+ *          one frame each plus one frame per HAL_SPI_REG_MERGE_MAX reads.
+ * @param reg Register device
+ * @param addrs Register addresses (repeats allowed)
+ * @param values Receives the registers, in the order of addrs
+ * @param count Number of registers
+ * @return As hal_spi_reg_read(); on an error no value is valid
+ */
+hal_status_t hal_spi_reg_read_multi(hal_spi_reg_dev_t* reg,
+                                    const uint8_t* addrs,
+                                    uint8_t* values,
+                                    uint16_t count);
+
+/**
+ * @brief Write one register (one frame), updating the shadow
+ * @param reg Register device
+ * @param addr Register address
+ * @param value Value to write
+ * @return HAL_OK, HAL_ERROR_INVALID_PARAM, error code of hal_spi_transfer()
+ */
+hal_status_t hal_spi_reg_write(hal_spi_reg_dev_t* reg, uint8_t addr, uint8_t value);
+
+/**
+ * @brief Forget the shadow, e.g. after a reset of the device
+ * @param reg Register device
+ */
+void hal_spi_reg_invalidate(hal_spi_reg_dev_t* reg);
+
+#endif /* HAL_SPI_REG_H */
@@ -0,0 +1,147 @@
+/**
+ * @file    hal_spi_sim.h
+ * @brief   SPI HAL Simulation Backend Extensions
+ * @details Functions specific to hal_spi_sim.c. Without a model a simulated
+ *          device echoes transfers, loops sent data back to the next receive
+ *          and fills the rest of a receive with random data. With a model
+ *          attached every transfer, send and receive is clocked through the
+ *          model in-process, at function-call cost.
+ *
+ *          Each device has an RX ring, drained by receives before the model or
+ *          the random fill is asked for data. It is single-producer,
+ *          single-consumer and lock-free: one thread may feed it with
+ *          hal_sim_inject_rx() while the application receives. Loopback sends
+ *          feed the same ring, so do not inject while the application sends on
+ *          a device without a model.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#ifndef HAL_SPI_SIM_H
+#define HAL_SPI_SIM_H
+
+#include "hal_spi.h"
+#include "hal_sim_model.h"
+
+/**
+ * @brief RX ring size per device in bytes (must be a power of two)
+ */
+#ifndef HAL_SIM_RX_BUFFER_SIZE
+#define HAL_SIM_RX_BUFFER_SIZE      1024U
+#endif
+
+/**
+ * @brief RX rings for the devices initialized at once
+ * @details The rings come from a pool and are taken at init, so a build
+ *          that opens fewer devices than HAL_SPI_MAX_INTERFACES at a time
+ *          reserves less. An init with no ring left gives HAL_ERROR_BUSY.
+ */
+#ifndef HAL_SIM_RX_POOL_SLOTS
+#define HAL_SIM_RX_POOL_SLOTS       HAL_SPI_MAX_INTERFACES
+#endif
+
+/**
+ * @brief RX ring state of a simulated device
+ */
+typedef struct {
+    uint32_t    pending;        /**< Bytes waiting for a receive */
+    uint32_t    capacity;       /**< HAL_SIM_RX_BUFFER_SIZE */
+    uint32_t    dropped;        /**< Bytes lost to a full ring since init */
+} hal_sim_rx_info_t;
+
+/**
+ * @brief Bus timing modes
+ */
+typedef enum {
+    HAL_SIM_TIMING_OFF      = 0,    /**< Operations take no time (default) */
+    HAL_SIM_TIMING_VIRTUAL  = 1,    /**< Bus time is only accounted (hal_sim_get_bus_time()) */
+    HAL_SIM_TIMING_REALTIME = 2     /**< Operations also last their bus time, paced on the host clock */
+} hal_sim_timing_mode_t;
+
+/**
+ * @brief Bus timing of a simulated device
+ * @details A frame (one chip-select assertion: a transfer, send, receive,
+ *          batch descriptor, scatter-gather frame or stream half) lasts
+ *          cs_setup_ns + bits / baudrate + (words - 1) * word_gap_ns +
+ *          cs_hold_ns, with words of config.data_bits. At least frame_gap_ns
+ *          of idle bus follow each frame.
+ */
+typedef struct {
+    hal_sim_timing_mode_t   mode;
+    uint32_t                cs_setup_ns;    /**< CS asserted to first clock edge */
+    uint32_t                cs_hold_ns;     /**< Last clock edge to CS released */
+    uint32_t                word_gap_ns;    /**< Idle clock between words of a frame */
+    uint32_t                frame_gap_ns;   /**< Minimum CS idle time between frames */
+} hal_sim_timing_t;
+
+/**
+ * @brief Timing with typical MCU values (DMA-fed, no gaps between words)
+ */
+#define HAL_SIM_TIMING_INIT(mode)   { (mode), 50U, 50U, 0U, 500U }
+
+/**
+ * @brief Accumulated bus time of a simulated device since init
+ * @details busy_ns / clock_ns is the bus utilization of back-to-back
+ *          operations; comparing busy_ns with the period of the application
+ *          loop gives the scheduling headroom.
+ */
+typedef struct {
+    uint64_t    clock_ns;       /**< Frames plus the gaps after them */
+    uint64_t    busy_ns;        /**< Chip select asserted */
+    uint64_t    frames;         /**< Frames clocked */
+} hal_sim_bus_time_t;
+
+/**
+ * @brief Attach a device model to a simulated device
+ * @details The model is reset now and on every hal_spi_init() of the device,
+ *          and stays attached across hal_spi_deinit(). The model and its
+ *          context must outlive the attachment.
+ * @param device SPI device identifier
+ * @param model Model instance, NULL to detach (default behaviour)
+ * @return HAL_OK, HAL_ERROR_INVALID_PARAM, or HAL_ERROR_BUSY if an operation
+ *         is in progress on the device
+ */
+hal_status_t hal_sim_attach_model(hal_spi_device_t device, const hal_sim_model_t* model);
+
+/**
+ * @brief Queue data for the next receives of a simulated device
+ * @details Safe to call from one producer thread while the application
+ *          receives. Bytes that do not fit are dropped and counted.
+ * @param device SPI device identifier
+ * @param data Data the device "sends"
+ * @param length Number of bytes
+ * @return HAL_OK, HAL_ERROR_INVALID_PARAM, HAL_ERROR_NOT_INIT, or
+ *         HAL_ERROR_BUSY if the ring was full and bytes were dropped
+ */
+hal_status_t hal_sim_inject_rx(hal_spi_device_t device, const uint8_t* data, uint16_t length);
+
+/**
+ * @brief Read the RX ring state of a simulated device
+ * @param device SPI device identifier
+ * @param info Receives the state
+ * @return HAL_OK, HAL_ERROR_INVALID_PARAM or HAL_ERROR_NOT_INIT
+ */
+hal_status_t hal_sim_get_rx_info(hal_spi_device_t device, hal_sim_rx_info_t* info);
+
+/**
+ * @brief Select the bus timing of a simulated device
+ * @details Kept across hal_spi_deinit(). In real-time mode synchronous
+ *          operations busy-wait for their bus time, and asynchronous
+ *          transfers and stream halves complete from hal_spi_poll() once it
+ *          has passed.
+ * @param device SPI device identifier
+ * @param timing Timing, NULL for HAL_SIM_TIMING_OFF
+ * @return HAL_OK, HAL_ERROR_INVALID_PARAM, or HAL_ERROR_BUSY if an operation
+ *         is in progress on the device
+ */
+hal_status_t hal_sim_set_timing(hal_spi_device_t device, const hal_sim_timing_t* timing);
+
+/**
+ * @brief Read the accumulated bus time of a simulated device
+ * @param device SPI device identifier
+ * @param bus_time Receives the bus time (all zero with HAL_SIM_TIMING_OFF)
+ * @return HAL_OK, HAL_ERROR_INVALID_PARAM or HAL_ERROR_NOT_INIT
+ */
+hal_status_t hal_sim_get_bus_time(hal_spi_device_t device, hal_sim_bus_time_t* bus_time);
+
+#endif /* HAL_SPI_SIM_H */
@@ -0,0 +1,34 @@
+/**
+ * @file    hal_time.h
+ * @brief   HAL Time Base
+ * @details Free-running microsecond counter used to timestamp transfers for
+ *          statistics. The counter wraps after about 71 minutes; only use
+ *          differences of two readings. A cycle counter is available for
+ *          finer measurements.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#ifndef HAL_TIME_H
+#define HAL_TIME_H
+
+#include "hal_types.h"
+
+/**
+ * @brief Read the microsecond counter
+ * @return Monotonic time in microseconds (wrapping)
+ */
+uint32_t hal_time_now_us(void);
+
+/**
+ * @brief Read the cycle counter of the platform
+ * @details Finest time base available, for the probes (hal_probe.h): the
+ *          DWT cycle counter on STM32, the PMCOUNT0 performance counter on
+ *          RH850, the TSC (x86) or the virtual counter (ARM64) on hosts,
+ *          nanoseconds elsewhere. Wraps within seconds; only use differences
+ *          of two readings, in units of the platform counter.
+ * @return Free-running cycle count (wrapping)
+ */
+uint32_t hal_time_now_cycles(void);
+
+#endif /* HAL_TIME_H */
@@ -0,0 +1,91 @@
+/**
+ * @file    hal_trace.h
+ * @brief   HAL Binary Trace Ring
+ * @details Fixed-size in-memory ring of binary trace records. Recording is a
+ *          single atomic index increment plus a 12-byte store, so it can stay
+ *          enabled on hot paths and in interrupts. The ring is read after the
+ *          run with hal_trace_snapshot() or hal_trace_dump().
+ *          Without HAL_TRACE_ENABLE the HAL_TRACE() macro expands to nothing.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#ifndef HAL_TRACE_H
+#define HAL_TRACE_H
+
+#include "hal_types.h"
+#include "hal_time.h"
+
+/**
+ * @brief Number of records kept (must be a power of two)
+ */
+#ifndef HAL_TRACE_RING_SIZE
+#define HAL_TRACE_RING_SIZE     1024U
+#endif
+
+/**
+ * @brief Timestamp source for trace records (microseconds by default)
+ */
+#ifndef HAL_TRACE_TIMESTAMP
+#define HAL_TRACE_TIMESTAMP()   hal_time_now_us()
+#endif
+
+/**
+ * @brief Trace event identifiers (values follow the socket message types)
+ */
+typedef enum {
+    HAL_TRACE_EV_TRANSFER   = 0x03,    /**< arg = length */
+    HAL_TRACE_EV_SEND       = 0x04,    /**< arg = length */
+    HAL_TRACE_EV_RECEIVE    = 0x05,    /**< arg = length */
+    HAL_TRACE_EV_BATCH      = 0x08     /**< arg = descriptor count */
+} hal_trace_event_t;
+
+/**
+ * @brief Trace event of a transfer, send or receive (hal_spi_op_t 0..2)
+ */
+#define HAL_TRACE_EV_FROM_OP(op)    ((hal_trace_event_t)(HAL_TRACE_EV_TRANSFER + (op)))
+
+/**
+ * @brief Trace record (12 bytes)
+ */
+typedef struct {
+    uint32_t    timestamp;      /**< HAL_TRACE_TIMESTAMP() at record time */
+    uint16_t    event;          /**< hal_trace_event_t */
+    uint8_t     device;         /**< SPI device identifier */
+    uint8_t     reserved;
+    uint32_t    arg;            /**< Event-specific argument */
+} hal_trace_record_t;
+
+/**
+ * @brief Append a record to the trace ring (lock-free, ISR-safe)
+ * @param event Event identifier
+ * @param device SPI device identifier
+ * @param arg Event-specific argument
+ */
+void hal_trace_record(uint16_t event, uint8_t device, uint32_t arg);
+
+/**
+ * @brief Copy the most recent records, oldest first
+ * @param records Destination array
+ * @param max_records Capacity of the destination array
+ * @return Number of records copied
+ */
+uint32_t hal_trace_snapshot(hal_trace_record_t* records, uint32_t max_records);
+
+/**
+ * @brief Print the trace ring, oldest record first
+ */
+void hal_trace_dump(void);
+
+/**
+ * @brief Discard all records
+ */
+void hal_trace_clear(void);
+
+#ifdef HAL_TRACE_ENABLE
+#define HAL_TRACE(event, device, arg)   hal_trace_record((uint16_t)(event), (uint8_t)(device), (uint32_t)(arg))
+#else
+#define HAL_TRACE(event, device, arg)   ((void)0)
+#endif
+
+#endif /* HAL_TRACE_H */
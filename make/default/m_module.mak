@@ -14,16 +14,111 @@ PRE_COMPILE_VARIANT     = default
 
 #---------------------------------------------------------------------------------------------------------------------------#
 # Configuration: Select HAL implementation
-# Options: SIM (simulation), STM32 (STM32-Nucleo), RH850 (Renesas RH850), SOCKET (socket server)
+# Options: SIM (simulation), STM32 (STM32-Nucleo), RH850 (Renesas RH850), SOCKET (socket server),
+#          SHM (shared memory with a server on the same host), REPLAY (answer from a capture file)
 #---------------------------------------------------------------------------------------------------------------------------#
 HAL_IMPLEMENTATION ?= SIM
 
+#---------------------------------------------------------------------------------------------------------------------------#
+# Configuration: Logging and tracing
+# HAL_LOG_LEVEL: 0 = none, 1 = error, 2 = warning, 3 = info (default), 4 = debug (logs every transfer)
+# HAL_TRACE:     1 = record hot-path events into the in-memory binary trace ring (hal_trace.h)
+# HAL_PROBE:     1 = cycle-stamped probe points for external profilers: ITM on STM32, RAM ring on RH850, USDT on Linux (hal_probe.h)
+#---------------------------------------------------------------------------------------------------------------------------#
+HAL_LOG_LEVEL ?= 3
+HAL_TRACE     ?= 0
+HAL_PROBE     ?= 0
+
+#---------------------------------------------------------------------------------------------------------------------------#
+# Configuration: Benchmark
+# HAL_BENCHMARK: 1 = include the benchmark suite (hal_spi_bench_main(), writes hal_spi_bench.csv)
+#---------------------------------------------------------------------------------------------------------------------------#
+HAL_BENCHMARK ?= 0
+
+#---------------------------------------------------------------------------------------------------------------------------#
+# Configuration: Capture
+# HAL_CAPTURE: 1 = record all SPI traffic of HAL_IMPLEMENTATION (host builds) to $HAL_SPI_CAPTURE_FILE (default hal_spi_capture.spt),
+#              for replay with HAL_IMPLEMENTATION=REPLAY (hal_spi_capture.h; not with HAL_STATIC_DISPATCH)
+#---------------------------------------------------------------------------------------------------------------------------#
+HAL_CAPTURE ?= 0
+
+#---------------------------------------------------------------------------------------------------------------------------#
+# Configuration: Shared buses
+# HAL_BUS: 1 = include the shared bus layer (hal_spi_bus.h): several slaves with their own chip select and configuration
+#          on one device, with begin/end transactions and a priority queue
+#---------------------------------------------------------------------------------------------------------------------------#
+HAL_BUS ?= 0
+
+#---------------------------------------------------------------------------------------------------------------------------#
+# Configuration: Register devices
+# HAL_REG: 1 = include the register device helper (hal_spi_reg.h): TLE92104-style 16-bit register frames with merged
+#          reads and a shadow of static registers
+#---------------------------------------------------------------------------------------------------------------------------#
+HAL_REG ?= 0
+
+#---------------------------------------------------------------------------------------------------------------------------#
+# Configuration: Device map
+# HAL_DEVICE_MAP: devices that use another implementation than HAL_IMPLEMENTATION, as ID=IMPL entries,
+#                 e.g. HAL_DEVICE_MAP="1=SIM 2=SIM 3=SOCKET" with HAL_IMPLEMENTATION=STM32 (DEV_0 on hardware).
+#                 Links the named implementations; hosts can override it at run time with $HAL_SPI_DEVICE_MAP
+#---------------------------------------------------------------------------------------------------------------------------#
+HAL_DEVICE_MAP ?=
+
+#---------------------------------------------------------------------------------------------------------------------------#
+# Configuration: Dispatch
+# HAL_STATIC_DISPATCH: 1 = bind hal_spi_* to HAL_IMPLEMENTATION at build time instead of registering ops at run time
+#                      (combine with -flto so calls into the backend become direct and can be inlined)
+#---------------------------------------------------------------------------------------------------------------------------#
+HAL_STATIC_DISPATCH ?= 0
+
+#---------------------------------------------------------------------------------------------------------------------------#
+# Configuration: RAM footprint
+# HAL_DEVICES: number of SPI devices (1-7, DEV_0 up to DEV_<n-1>), sizes every per-device table (HAL_SPI_MAX_INTERFACES)
+#---------------------------------------------------------------------------------------------------------------------------#
+HAL_DEVICES ?= 7
+
+COMPILER_DEFINE_PROJECT += -DHAL_LOG_LEVEL=$(HAL_LOG_LEVEL)
+COMPILER_DEFINE_PROJECT += -DHAL_SPI_MAX_INTERFACES=$(HAL_DEVICES)
+
 #---------------------------------------------------------------------------------------------------------------------------#
 # Objects - Core HAL files (always compiled)
 #---------------------------------------------------------------------------------------------------------------------------#
 OBJ_QAC   	 = hal_spi.o \
+               hal_spi_stats.o \
+               hal_time.o \
                hal_init.o
 
+ifeq ($(HAL_TRACE),1)
+    OBJ_QAC += hal_trace.o
+    COMPILER_DEFINE_PROJECT += -DHAL_TRACE_ENABLE
+endif
+
+ifeq ($(HAL_PROBE),1)
+    OBJ_QAC += hal_probe.o
+    COMPILER_DEFINE_PROJECT += -DHAL_PROBE_ENABLE
+endif
+
+ifeq ($(HAL_STATIC_DISPATCH),1)
+    COMPILER_DEFINE_PROJECT += -DHAL_SPI_STATIC_DISPATCH
+endif
+
+ifeq ($(HAL_BENCHMARK),1)
+    OBJ_QAC += hal_spi_bench.o
+endif
+
+ifeq ($(HAL_CAPTURE),1)
+    OBJ_QAC += hal_spi_capture.o
+    COMPILER_DEFINE_PROJECT += -DHAL_SPI_CAPTURE
+endif
+
+ifeq ($(HAL_BUS),1)
+    OBJ_QAC += hal_spi_bus.o
+endif
+
+ifeq ($(HAL_REG),1)
+    OBJ_QAC += hal_spi_reg.o
+endif
+
 # Uncomment to include example code
 # OBJ_QAC += hal_spi_example.o
 
@@ -39,12 +134,34 @@ else ifeq ($(HAL_IMPLEMENTATION),RH850)
 else ifeq ($(HAL_IMPLEMENTATION),SOCKET)
     OBJ_QAC += hal_spi_socket.o
     COMPILER_DEFINE_PROJECT += -DHAL_USE_SOCKET
+else ifeq ($(HAL_IMPLEMENTATION),SHM)
+    OBJ_QAC += hal_spi_shm.o
+    COMPILER_DEFINE_PROJECT += -DHAL_USE_SHM
+else ifeq ($(HAL_IMPLEMENTATION),REPLAY)
+    OBJ_QAC += hal_spi_replay.o
+    COMPILER_DEFINE_PROJECT += -DHAL_USE_REPLAY
 else
-    # Default to simulation
-    OBJ_QAC += hal_spi_sim.o
+    # Default to simulation, with the in-process device models (hal_sim_model.h)
+    OBJ_QAC += hal_spi_sim.o \
+               hal_sim_model_tle92104.o
     COMPILER_DEFINE_PROJECT += -DHAL_USE_SIM
 endif
 
+ifneq ($(strip $(HAL_DEVICE_MAP)),)
+    hal_lc    = $(subst SIM,sim,$(subst STM32,stm32,$(subst RH850,rh850,$(subst SOCKET,socket,$(subst SHM,shm,$(subst REPLAY,replay,$(1)))))))
+    hal_empty :=
+    hal_space := $(hal_empty) $(hal_empty)
+    hal_comma := ,
+    HAL_DEVICE_IMPLS := $(sort $(foreach m,$(HAL_DEVICE_MAP),$(lastword $(subst =, ,$(m)))))
+    HAL_DEVICE_OBJS  := $(filter-out $(OBJ_QAC),$(foreach i,$(HAL_DEVICE_IMPLS),hal_spi_$(call hal_lc,$(i)).o) \
+                        $(if $(filter SIM,$(HAL_DEVICE_IMPLS)),hal_sim_model_tle92104.o))
+    OBJ_QAC += $(HAL_DEVICE_OBJS)
+    # Runtime map for hal_init(), availability of each implementation, and the bindings for HAL_STATIC_DISPATCH
+    COMPILER_DEFINE_PROJECT += -DHAL_SPI_DEVICE_MAP=\"$(subst $(hal_space),$(hal_comma),$(strip $(call hal_lc,$(HAL_DEVICE_MAP))))\"
+    COMPILER_DEFINE_PROJECT += $(foreach i,$(HAL_DEVICE_IMPLS),-DHAL_WITH_$(i))
+    COMPILER_DEFINE_PROJECT += $(foreach m,$(HAL_DEVICE_MAP),-DHAL_SPI_DEV$(firstword $(subst =, ,$(m)))_OPS=hal_spi_$(call hal_lc,$(lastword $(subst =, ,$(m))))_ops)
+endif
+
 #---------------------------------------------------------------------------------------------------------------------------#
 # Assembly objects (none for now)
 #---------------------------------------------------------------------------------------------------------------------------#
@@ -60,3 +177,9 @@ OBJ_NOQAC 	 =
 #---------------------------------------------------------------------------------------------------------------------------#
 # Uncomment for Windows socket support
 # LINKER_ADDITIONAL_OPTIONS += -lws2_32
+
+# Uncomment for POSIX hosts (per-device locks and the socket I/O thread use pthreads)
+# LINKER_ADDITIONAL_OPTIONS += -lpthread
+
+# Uncomment for SHM on glibc older than 2.34 (shm_open lives in librt)
+# LINKER_ADDITIONAL_OPTIONS += -lrt
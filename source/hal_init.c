@@ -8,6 +8,13 @@
 
 #include "yolpiya.h"
 #include "hal_spi.h"
+#include "hal_os.h"
+#include "hal_log.h"
+#include <stdlib.h>
+
+#ifdef HAL_SPI_CAPTURE
+    #include "hal_spi_capture.h"
+#endif
 
 /*============================================================================*/
 /* External Operations Declarations                                           */
@@ -18,6 +25,150 @@ extern const hal_spi_ops_t hal_spi_stm32_ops;
 extern const hal_spi_ops_t hal_spi_rh850_ops;
 extern const hal_spi_ops_t hal_spi_sim_ops;
 extern const hal_spi_ops_t hal_spi_socket_ops;
+extern const hal_spi_ops_t hal_spi_shm_ops;
+extern const hal_spi_ops_t hal_spi_replay_ops;
+
+/*============================================================================*/
+/* Device Map                                                                 */
+/*============================================================================*/
+
+/*
+ * Implementations linked into this build: the selected one, plus those named
+ * in the build's device map (HAL_WITH_<IMPL>, set by m_module.mak).
+ */
+#if defined(STM32_TARGET)
+    #define HAL_WITH_STM32
+    #define HAL_SELECTED_IMPL   "stm32"
+#elif defined(RH850_TARGET)
+    #define HAL_WITH_RH850
+    #define HAL_SELECTED_IMPL   "rh850"
+#elif defined(HAL_USE_SOCKET)
+    #define HAL_WITH_SOCKET
+    #define HAL_SELECTED_IMPL   "socket"
+#elif defined(HAL_USE_SHM)
+    #define HAL_WITH_SHM
+    #define HAL_SELECTED_IMPL   "shm"
+#elif defined(HAL_USE_REPLAY)
+    #define HAL_WITH_REPLAY
+    #define HAL_SELECTED_IMPL   "replay"
+#else
+    /* Default to simulation */
+    #define HAL_WITH_SIM
+    #define HAL_SELECTED_IMPL   "sim"
+#endif
+
+/**
+ * @brief Implementation a device map can name
+ */
+typedef struct {
+    const char*             key;        /**< Name in a device map */
+    const char*             name;       /**< Name in logs */
+    const hal_spi_ops_t*    ops;
+} hal_impl_entry_t;
+
+static const hal_impl_entry_t g_hal_impls[] = {
+#ifdef HAL_WITH_STM32
+    { "stm32",  "STM32-Nucleo", &hal_spi_stm32_ops },
+#endif
+#ifdef HAL_WITH_RH850
+    { "rh850",  "RH850",        &hal_spi_rh850_ops },
+#endif
+#ifdef HAL_WITH_SIM
+    { "sim",    "Simulation",   &hal_spi_sim_ops },
+#endif
+#ifdef HAL_WITH_SOCKET
+    { "socket", "Socket",       &hal_spi_socket_ops },
+#endif
+#ifdef HAL_WITH_SHM
+    { "shm",    "SharedMemory", &hal_spi_shm_ops },
+#endif
+#ifdef HAL_WITH_REPLAY
+    { "replay", "Replay",       &hal_spi_replay_ops },
+#endif
+};
+
+#define HAL_IMPL_COUNT  (sizeof(g_hal_impls) / sizeof(g_hal_impls[0]))
+
+/**
+ * @brief Find a linked implementation by its map key
+ * @param key Start of the key
+ * @param length Key length
+ * @return Entry, NULL if the implementation is not linked
+ */
+static const hal_impl_entry_t* hal_find_impl(const char* key, size_t length)
+{
+    for (size_t i = 0; i < HAL_IMPL_COUNT; i++) {
+        if (strlen(g_hal_impls[i].key) == length && strncmp(g_hal_impls[i].key, key, length) == 0) {
+            return &g_hal_impls[i];
+        }
+    }
+    return NULL;
+}
+
+#if defined(HAL_SPI_DEVICE_MAP) || !defined(HAL_OS_NONE)
+/**
+ * @brief Apply a device map to the per-device implementation table
+ * @details Format: "ID=IMPL[,ID=IMPL...]", ID a device number or a range
+ *          "FIRST-LAST", IMPL one of the linked implementations (stm32, 
+ *          rh850, sim, socket, shm, replay). Example: "0=stm32,1-6=sim".
+ * @param map Device map
+ * @param impls Per-device table to update
+ * @return HAL_OK, HAL_ERROR_INVALID_PARAM on a malformed map or an
+ *         implementation that is not linked
+ */
+static hal_status_t hal_apply_device_map(const char* map, const hal_impl_entry_t* impls[])
+{
+    const char* p = map;
+    
+    while (*p != '\0') {
+        char* end;
+        unsigned long first = strtoul(p, &end, 10);
+        unsigned long last = first;
+        
+        if (end == p) {
+            break;
+        }
+        p = end;
+        if (*p == '-') {
+            last = strtoul(p + 1, &end, 10);
+            if (end == p + 1) {
+                break;
+            }
+            p = end;
+        }
+        if (*p != '=' || last < first || last >= HAL_SPI_MAX_INTERFACES) {
+            break;
+        }
+        p++;
+        
+        size_t length = strcspn(p, ",");
+        const hal_impl_entry_t* impl = hal_find_impl(p, length);
+        if (impl == NULL) {
+            HAL_LOG_ERROR("[HAL] ERROR: Device map \"%s\": implementation \"%.*s\" is not built in\n", 
+                          map, (int)length, p);
+            return HAL_ERROR_INVALID_PARAM;
+        }
+        for (unsigned long device = first; device <= last; device++) {
+            impls[device] = impl;
+        }
+        
+        p += length;
+        if (*p == ',') {
+            p++;
+        }
+        if (*p == '\0') {
+            return HAL_OK;
+        }
+    }
+    
+    if (*p == '\0' && p == map) {
+        return HAL_OK;  /* Empty map */
+    }
+    
+    HAL_LOG_ERROR("[HAL] ERROR: Malformed device map \"%s\" (expected e.g. \"0=stm32,1-6=sim\")\n", map);
+    return HAL_ERROR_INVALID_PARAM;
+}
+#endif
 
 /*============================================================================*/
 /* Public Functions                                                           */
@@ -30,32 +181,62 @@ extern const hal_spi_ops_t hal_spi_socket_ops;
  */
 hal_status_t hal_init(void)
 {
-    hal_status_t status;
-    const char* impl_name = "Unknown";
+    hal_status_t status = HAL_OK;
+    const hal_impl_entry_t* impls[HAL_SPI_MAX_INTERFACES];
+    const hal_spi_ops_t* ops[HAL_SPI_MAX_INTERFACES];
     
     /* Select implementation based on compile-time configuration */
-#if defined(STM32_TARGET)
-    status = hal_spi_register_ops(&hal_spi_stm32_ops);
-    impl_name = "STM32-Nucleo";
+    const hal_impl_entry_t* selected = hal_find_impl(HAL_SELECTED_IMPL, sizeof(HAL_SELECTED_IMPL) - 1U);
     
-#elif defined(RH850_TARGET)
-    status = hal_spi_register_ops(&hal_spi_rh850_ops);
-    impl_name = "RH850";
+    for (uint8_t device = 0; device < HAL_SPI_MAX_INTERFACES; device++) {
+        impls[device] = selected;
+    }
     
-#elif defined(HAL_USE_SOCKET)
-    status = hal_spi_register_ops(&hal_spi_socket_ops);
-    impl_name = "Socket";
+    /* Devices on other implementations: build map first, then the environment */
+#ifdef HAL_SPI_DEVICE_MAP
+    status = hal_apply_device_map(HAL_SPI_DEVICE_MAP, impls);
+#endif
+#ifndef HAL_OS_NONE
+    const char* device_map = getenv("HAL_SPI_DEVICE_MAP");
+    if (status == HAL_OK && device_map != NULL) {
+        status = hal_apply_device_map(device_map, impls);
+    }
+#endif
+    if (status != HAL_OK) {
+        return status;
+    }
     
-#else
-    /* Default to simulation */
-    status = hal_spi_register_ops(&hal_spi_sim_ops);
-    impl_name = "Simulation";
+    for (uint8_t device = 0; device < HAL_SPI_MAX_INTERFACES; device++) {
+        ops[device] = impls[device]->ops;
+    }
+    
+#ifdef HAL_SPI_CAPTURE
+    /* Record everything the selected implementation does (devices mapped elsewhere are not recorded) */
+    const char* capture_file = getenv("HAL_SPI_CAPTURE_FILE");
+    const hal_spi_ops_t* captured = hal_spi_capture_start(selected->ops, 
+                                                          (capture_file != NULL) ? capture_file : HAL_SPI_CAPTURE_DEFAULT_FILE);
+    if (captured == NULL) {
+        HAL_LOG_ERROR("[HAL] ERROR: Failed to start the capture\n");
+        return HAL_ERROR;
+    }
+    for (uint8_t device = 0; device < HAL_SPI_MAX_INTERFACES; device++) {
+        if (impls[device] == selected) {
+            ops[device] = captured;
+        }
+    }
 #endif
     
+    for (uint8_t device = 0; device < HAL_SPI_MAX_INTERFACES && status == HAL_OK; device++) {
+        status = hal_spi_register_device_ops((hal_spi_device_t)device, ops[device]);
+        if (status == HAL_OK && impls[device] != selected) {
+            HAL_LOG_INFO("[HAL] Device %d uses %s implementation\n", device, impls[device]->name);
+        }
+    }
+    
     if (status == HAL_OK) {
-        printf("[HAL] Initialized with %s implementation\n", impl_name);
+        HAL_LOG_INFO("[HAL] Initialized with %s implementation\n", selected->name);
     } else {
-        printf("[HAL] ERROR: Failed to initialize HAL\n");
+        HAL_LOG_ERROR("[HAL] ERROR: Failed to initialize HAL\n");
     }
     
     return status;
@@ -73,7 +254,27 @@ const char* hal_get_implementation_name(void)
     return "RH850";
 #elif defined(HAL_USE_SOCKET)
     return "Socket";
+#elif defined(HAL_USE_SHM)
+    return "SharedMemory";
+#elif defined(HAL_USE_REPLAY)
+    return "Replay";
 #else
     return "Simulation";
 #endif
 }
+
+/**
+ * @brief Get the name of the implementation a device uses
+ * @details "Custom" for a table registered by the application or the capture.
+ */
+const char* hal_get_device_implementation_name(hal_spi_device_t device)
+{
+    const hal_spi_ops_t* ops = hal_spi_get_device_ops(device);
+    
+    for (size_t i = 0; i < HAL_IMPL_COUNT; i++) {
+        if (g_hal_impls[i].ops == ops) {
+            return g_hal_impls[i].name;
+        }
+    }
+    return (ops != NULL) ? "Custom" : "None";
+}
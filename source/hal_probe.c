@@ -0,0 +1,121 @@
+/**
+ * @file    hal_probe.c
+ * @brief   HAL Instrumentation Probes Implementation
+ * @details Platform sinks:
+ *          - STM32: two words per probe on ITM stimulus port HAL_PROBE_ITM_PORT,
+ *            (point << 24 | device << 16 | arg & 0xFFFF) then the cycle count,
+ *            decoded from SWO by the debug probe
+ *          - RH850: a RAM ring of hal_probe_record_t, read by the debugger
+ *            from g_probe_ring / g_probe_head
+ *          - Linux hosts: the USDT probe m_hal:probe(point, device, arg, cycles)
+ *            if <sys/sdt.h> is available, e.g.
+ *            perf probe -x app sdt_m_hal:probe && perf record -e sdt_m_hal:probe
+ *            A disabled USDT probe is a single NOP.
+ * @author  EswPla HAL Team
+ * @date    2026-10-15
+ */
+
+#include "yolpiya.h"
+#include "hal_probe.h"
+#include "hal_time.h"
+
+#if !defined(STM32_TARGET) && !defined(RH850_TARGET) && defined(__linux__) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+    #include <sys/sdt.h>
+    #define HAL_PROBE_USDT
+#endif
+#endif
+
+#ifdef RH850_TARGET
+#include "hal_atomic.h"
+#endif
+
+/*============================================================================*/
+/* Private Definitions                                                        */
+/*============================================================================*/
+
+#ifdef RH850_TARGET
+#if (HAL_PROBE_RING_SIZE & (HAL_PROBE_RING_SIZE - 1U)) != 0U
+#error "HAL_PROBE_RING_SIZE must be a power of two"
+#endif
+
+/**
+ * @brief Probe record in the RH850 RAM ring (12 bytes)
+ */
+typedef struct {
+    uint32_t    cycles;
+    uint16_t    point;
+    uint8_t     device;
+    uint8_t     reserved;
+    uint32_t    arg;
+} hal_probe_record_t;
+#endif
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static hal_probe_hook_t g_probe_hook = NULL;
+
+#ifdef RH850_TARGET
+hal_probe_record_t g_probe_ring[HAL_PROBE_RING_SIZE];
+uint32_t g_probe_head = 0;      /**< Total number of records ever written */
+#endif
+
+/*============================================================================*/
+/* Public API Implementation                                                  */
+/*============================================================================*/
+
+/**
+ * @brief Record a probe
+ */
+void hal_probe_emit(uint16_t point, uint8_t device, uint32_t arg)
+{
+    uint32_t cycles = hal_time_now_cycles();
+    hal_probe_hook_t hook = g_probe_hook;
+    
+    if (hook != NULL) {
+        hook(point, device, arg, cycles);
+        return;
+    }
+    
+#if defined(STM32_TARGET)
+    /* STM32: ITM stimulus port, enabled by the debugger (ITM->TER bit)
+     *
+     * if ((ITM->TCR & ITM_TCR_ITMENA_Msk) != 0U && (ITM->TER & (1UL << HAL_PROBE_ITM_PORT)) != 0U) {
+     *     while (ITM->PORT[HAL_PROBE_ITM_PORT].u32 == 0U) {}
+     *     ITM->PORT[HAL_PROBE_ITM_PORT].u32 = ((uint32_t)point << 24) | ((uint32_t)device << 16) | (arg & 0xFFFFU);
+     *     while (ITM->PORT[HAL_PROBE_ITM_PORT].u32 == 0U) {}
+     *     ITM->PORT[HAL_PROBE_ITM_PORT].u32 = cycles;
+     * }
+     */
+    (void)point;
+    (void)device;
+    (void)arg;
+    (void)cycles;
+#elif defined(RH850_TARGET)
+    uint32_t index = HAL_ATOMIC_FETCH_ADD_U32(&g_probe_head, 1U);
+    hal_probe_record_t* record = &g_probe_ring[index & (HAL_PROBE_RING_SIZE - 1U)];
+    
+    record->cycles = cycles;
+    record->point = point;
+    record->device = device;
+    record->reserved = 0;
+    record->arg = arg;
+#elif defined(HAL_PROBE_USDT)
+    DTRACE_PROBE4(m_hal, probe, point, device, arg, cycles);
+#else
+    (void)point;
+    (void)device;
+    (void)arg;
+    (void)cycles;
+#endif
+}
+
+/**
+ * @brief Route probes to a sink of the application
+ */
+void hal_probe_set_hook(hal_probe_hook_t hook)
+{
+    g_probe_hook = hook;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file    hal_sim_model_tle92104.c
+ * @brief   TLE92104 Device Model
+ * @details Port of TLE92104Simulator (spi_socket_server.py): Infineon TLE92104
+ *          4-channel high-side switch with its register file, the read-only
+ *          device ID (0x5A) and the one-frame response pipeline.
+ *
+ *          SPI frame format (16-bit, MSB first):
+ *            [CMD(2) | ADDR(4) | DATA(8) | PARITY(1) | RESERVED(1)]
+ *            CMD: 00 = Read, 01 = Write; PARITY: even over bits 15:2
+ *          Each response carries the address and data of the previous frame.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#include "hal_sim_model.h"
+#include <string.h>
+
+/*============================================================================*/
+/* Private Definitions                                                        */
+/*============================================================================*/
+
+#define TLE_REG_WDG             0x05U
+#define TLE_REG_DEVID           0x08U
+
+#define TLE_DEVICE_ID           0x5AU
+
+#define TLE_CMD_SHIFT           14U
+#define TLE_ADDR_SHIFT          10U
+#define TLE_DATA_SHIFT          2U
+#define TLE_PARITY_BIT          1U
+
+#define TLE_CMD_READ            0x00U
+#define TLE_CMD_WRITE           0x01U
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+/**
+ * @brief Process one 16-bit frame, return the response frame
+ */
+static uint16_t tle_process_frame(hal_sim_tle92104_t* tle, uint16_t frame)
+{
+    uint8_t cmd = (uint8_t)((frame >> TLE_CMD_SHIFT) & 0x03U);
+    uint8_t addr = (uint8_t)((frame >> TLE_ADDR_SHIFT) & 0x0FU);
+    uint8_t data = (uint8_t)((frame >> TLE_DATA_SHIFT) & 0xFFU);
+    
+    uint8_t response_data = tle->last_data;
+    uint8_t response_addr = tle->last_addr;
+    
+    if (cmd == TLE_CMD_READ) {
+        tle->last_data = tle->registers[addr];
+        tle->last_addr = addr;
+    } else if (cmd == TLE_CMD_WRITE) {
+        if (addr != TLE_REG_DEVID) {
+            tle->registers[addr] = data;
+            if (addr == TLE_REG_WDG) {
+                tle->wdg_count++;
+            }
+        }
+        tle->last_data = tle->registers[addr];
+        tle->last_addr = addr;
+    } else {
+        tle->last_data = 0;
+        tle->last_addr = 0;
+    }
+    
+    /* Response frame with even parity over bits 15:2 */
+    uint16_t response = (uint16_t)(((response_addr & 0x0FU) << TLE_ADDR_SHIFT) |
+                                   ((uint16_t)response_data << TLE_DATA_SHIFT));
+    uint16_t bits = (uint16_t)(response >> 2);
+    uint16_t parity = 0;
+    
+    while (bits != 0) {
+        parity ^= (uint16_t)(bits & 1U);
+        bits >>= 1;
+    }
+    return (uint16_t)(response | (parity << TLE_PARITY_BIT));
+}
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+void hal_sim_tle92104_reset(void* context)
+{
+    hal_sim_tle92104_t* tle = (hal_sim_tle92104_t*)context;
+    
+    memset(tle, 0, sizeof(*tle));
+    tle->registers[TLE_REG_DEVID] = TLE_DEVICE_ID;
+}
+
+void hal_sim_tle92104_transfer(void* context, const uint8_t* tx, uint8_t* rx, uint16_t length)
+{
+    hal_sim_tle92104_t* tle = (hal_sim_tle92104_t*)context;
+    
+    /* Clocking in nothing but dummy bytes reads zeros, as in the Python model */
+    if (tx == NULL) {
+        if (rx != NULL) {
+            memset(rx, 0, length);
+        }
+        return;
+    }
+    
+    /* A lone byte is no frame: echoed */
+    if (length < 2U) {
+        if (rx != NULL) {
+            memcpy(rx, tx, length);
+        }
+        return;
+    }
+    
+    uint16_t i = 0;
+    for (; (uint16_t)(i + 1U) < length; i = (uint16_t)(i + 2U)) {
+        uint16_t response = tle_process_frame(tle, (uint16_t)((tx[i] << 8) | tx[i + 1U]));
+        if (rx != NULL) {
+            rx[i] = (uint8_t)(response >> 8);
+            rx[i + 1U] = (uint8_t)(response & 0xFFU);
+        }
+    }
+    
+    if (i < length && rx != NULL) {
+        rx[i] = 0x00;  /* Trailing half frame */
+    }
+}
@@ -8,39 +8,341 @@
 
 #include "yolpiya.h"
 #include "hal_spi.h"
+#include "hal_spi_backend.h"
+#include "hal_os.h"
+#include "hal_probe.h"
 
 /*============================================================================*/
 /* Private Variables                                                          */
 /*============================================================================*/
 
+#ifdef HAL_SPI_STATIC_DISPATCH
+
+/**
+ * @brief Implementation bound at build time (same selection as hal_init.c)
+ */
+#ifndef HAL_SPI_STATIC_OPS
+    #if defined(STM32_TARGET)
+        #define HAL_SPI_STATIC_OPS  hal_spi_stm32_ops
+    #elif defined(RH850_TARGET)
+        #define HAL_SPI_STATIC_OPS  hal_spi_rh850_ops
+    #elif defined(HAL_USE_SOCKET)
+        #define HAL_SPI_STATIC_OPS  hal_spi_socket_ops
+    #elif defined(HAL_USE_SHM)
+        #define HAL_SPI_STATIC_OPS  hal_spi_shm_ops
+    #elif defined(HAL_USE_REPLAY)
+        #define HAL_SPI_STATIC_OPS  hal_spi_replay_ops
+    #else
+        #define HAL_SPI_STATIC_OPS  hal_spi_sim_ops
+    #endif
+#endif
+
+/**
+ * @brief Per-device implementations bound at build time
+ * @details Default to HAL_SPI_STATIC_OPS. HAL_SPI_DEV<n>_OPS binds device n
+ *          elsewhere, e.g. -DHAL_SPI_DEV1_OPS=hal_spi_sim_ops (the same build
+ *          map that hal_init.c registers without static dispatch).
+ */
+#ifndef HAL_SPI_DEV0_OPS
+    #define HAL_SPI_DEV0_OPS    HAL_SPI_STATIC_OPS
+#endif
+#ifndef HAL_SPI_DEV1_OPS
+    #define HAL_SPI_DEV1_OPS    HAL_SPI_STATIC_OPS
+#endif
+#ifndef HAL_SPI_DEV2_OPS
+    #define HAL_SPI_DEV2_OPS    HAL_SPI_STATIC_OPS
+#endif
+#ifndef HAL_SPI_DEV3_OPS
+    #define HAL_SPI_DEV3_OPS    HAL_SPI_STATIC_OPS
+#endif
+#ifndef HAL_SPI_DEV4_OPS
+    #define HAL_SPI_DEV4_OPS    HAL_SPI_STATIC_OPS
+#endif
+#ifndef HAL_SPI_DEV5_OPS
+    #define HAL_SPI_DEV5_OPS    HAL_SPI_STATIC_OPS
+#endif
+#ifndef HAL_SPI_DEV6_OPS
+    #define HAL_SPI_DEV6_OPS    HAL_SPI_STATIC_OPS
+#endif
+
+extern const hal_spi_ops_t HAL_SPI_DEV0_OPS;
+extern const hal_spi_ops_t HAL_SPI_DEV1_OPS;
+extern const hal_spi_ops_t HAL_SPI_DEV2_OPS;
+extern const hal_spi_ops_t HAL_SPI_DEV3_OPS;
+extern const hal_spi_ops_t HAL_SPI_DEV4_OPS;
+extern const hal_spi_ops_t HAL_SPI_DEV5_OPS;
+extern const hal_spi_ops_t HAL_SPI_DEV6_OPS;
+
+/**
+ * @brief Fixed SPI operations per device (Bridge Pattern - Implementor resolved at build time)
+ * @details A constant table of constant pointers: the NULL checks below fold
+ *          away, and with link-time optimization every ops->op() call on a
+ *          constant device becomes a direct call into its backend that can be
+ *          inlined.
+ */
+static const hal_spi_ops_t* const g_spi_ops[HAL_SPI_MAX_INTERFACES] = {
+    HAL_SPI_PER_DEVICE(&HAL_SPI_DEV0_OPS, &HAL_SPI_DEV1_OPS, &HAL_SPI_DEV2_OPS, 
+                       &HAL_SPI_DEV3_OPS, &HAL_SPI_DEV4_OPS, &HAL_SPI_DEV5_OPS, 
+                       &HAL_SPI_DEV6_OPS)
+};
+
+#else
+
+/**
+ * @brief Registered SPI operations per device (Bridge Pattern - pointers to Implementors)
+ * @details Dense table indexed by device: one load, like a single global pointer.
+ */
+static const hal_spi_ops_t* g_spi_ops[HAL_SPI_MAX_INTERFACES] = {NULL};
+
+#endif
+
+/**
+ * @brief One lock per device, so different devices never wait for each other
+ */
+static hal_mutex_t g_spi_device_locks[HAL_SPI_MAX_INTERFACES] = {
+    HAL_SPI_PER_DEVICE(HAL_MUTEX_INIT, HAL_MUTEX_INIT, HAL_MUTEX_INIT, HAL_MUTEX_INIT, 
+                       HAL_MUTEX_INIT, HAL_MUTEX_INIT, HAL_MUTEX_INIT)
+};
+
+/**
+ * @brief Configuration of a device as last applied
+ * @details hal_spi_set_config() with an identical configuration returns
+ *          without reaching the backend (no message, no peripheral re-init).
+ *          The word fallback takes the bit order from here.
+ */
+typedef struct {
+    hal_spi_config_t    config;
+    bool                valid;      /**< Device runs with config */
+} spi_config_cache_t;
+
+static spi_config_cache_t g_spi_configs[HAL_SPI_MAX_INTERFACES];
+
 /**
- * @brief Registered SPI operations (Bridge Pattern - pointer to Implementor)
+ * @brief Bytes of TX data a word transfer without native support stages on the stack
  */
-static const hal_spi_ops_t* g_spi_ops = NULL;
+#ifndef HAL_SPI_WORD_STAGE_SIZE
+#define HAL_SPI_WORD_STAGE_SIZE     256U
+#endif
+
+/*============================================================================*/
+/* Private Helper Functions                                                   */
+/*============================================================================*/
+
+/**
+ * @brief Fallback for list operations: dispatch descriptor by descriptor
+ * @note Caller holds the device lock
+ */
+static hal_status_t spi_run_each(const hal_spi_ops_t* ops, 
+                                 hal_spi_device_t device, 
+                                 const hal_spi_xfer_t* xfers, 
+                                 uint16_t count, 
+                                 uint32_t timeout_ms)
+{
+    hal_status_t status = HAL_OK;
+    
+    for (uint16_t i = 0; i < count && status == HAL_OK; i++) {
+        const hal_spi_xfer_t* xfer = &xfers[i];
+        
+        if (xfer->tx_data != NULL && xfer->rx_data != NULL) {
+            status = ops->transfer(device, xfer->tx_data, xfer->rx_data, 
+                                         xfer->length, timeout_ms);
+        } else if (xfer->tx_data != NULL) {
+            status = ops->send(device, xfer->tx_data, xfer->length, timeout_ms);
+        } else {
+            status = ops->receive(device, xfer->rx_data, xfer->length, timeout_ms);
+        }
+    }
+    
+    return status;
+}
+
+/**
+ * @brief Check that an implementation provides all required operations
+ */
+static bool spi_ops_valid(const hal_spi_ops_t* ops)
+{
+    /* Optional operations may be NULL */
+    return ops != NULL && 
+           ops->init != NULL && ops->deinit != NULL && 
+           ops->transfer != NULL && ops->send != NULL && 
+           ops->receive != NULL && ops->set_config != NULL && 
+           ops->get_status != NULL;
+}
+
+/**
+ * @brief Read word i of a uint16_t or uint32_t array
+ */
+static uint32_t spi_word_get(const void* words, uint16_t i, uint8_t word_size)
+{
+    return (word_size == 2U) ? ((const uint16_t*)words)[i] : ((const uint32_t*)words)[i];
+}
+
+/**
+ * @brief Write word i of a uint16_t or uint32_t array
+ */
+static void spi_word_put(void* words, uint16_t i, uint8_t word_size, uint32_t value)
+{
+    if (word_size == 2U) {
+        ((uint16_t*)words)[i] = (uint16_t)value;
+    } else {
+        ((uint32_t*)words)[i] = value;
+    }
+}
+
+/**
+ * @brief Fallback for word transfers: run them as one byte frame
+ * @details Each word becomes word_size bytes in bus order, the most
+ *          significant first for MSB-first devices, the least significant
+ *          first otherwise; the peripheral shifts every byte in the same bit
+ *          order, so the word goes out whole. TX words are staged on the stack
+ *          (up to HAL_SPI_WORD_STAGE_SIZE bytes), received bytes are turned
+ *          back into words in place.
+ * @note Caller holds the device lock
+ */
+static hal_status_t spi_words_fallback(const hal_spi_ops_t* ops, 
+                                       hal_spi_device_t device, 
+                                       const void* tx_words, 
+                                       void* rx_words, 
+                                       uint16_t count, 
+                                       uint8_t word_size, 
+                                       uint32_t timeout_ms)
+{
+    uint8_t stage[HAL_SPI_WORD_STAGE_SIZE];
+    uint32_t length = (uint32_t)count * word_size;
+    uint8_t top_shift = (uint8_t)((word_size - 1U) * 8U);
+    bool msb_first = (g_spi_configs[device].config.bit_order == HAL_SPI_BIT_ORDER_MSB_FIRST);
+    
+    /* One chip-select frame: it cannot be split into several byte transfers */
+    if ((tx_words != NULL && length > sizeof(stage)) || length > 0xFFFFU) {
+        return HAL_ERROR;
+    }
+    
+    if (tx_words != NULL) {
+        for (uint16_t i = 0; i < count; i++) {
+            uint32_t word = spi_word_get(tx_words, i, word_size);
+            for (uint8_t b = 0; b < word_size; b++) {
+                uint8_t shift = msb_first ? (uint8_t)(top_shift - b * 8U) : (uint8_t)(b * 8U);
+                stage[i * word_size + b] = (uint8_t)(word >> shift);
+            }
+        }
+    }
+    
+    hal_status_t status;
+    uint8_t* rx_bytes = (uint8_t*)rx_words;
+    
+    if (tx_words != NULL && rx_words != NULL) {
+        status = ops->transfer(device, stage, rx_bytes, (uint16_t)length, timeout_ms);
+    } else if (tx_words != NULL) {
+        status = ops->send(device, stage, (uint16_t)length, timeout_ms);
+    } else {
+        status = ops->receive(device, rx_bytes, (uint16_t)length, timeout_ms);
+    }
+    
+    /* Word i only covers its own bytes, so this works in place */
+    if (status == HAL_OK && rx_words != NULL) {
+        for (uint16_t i = 0; i < count; i++) {
+            uint32_t word = 0;
+            for (uint8_t b = 0; b < word_size; b++) {
+                uint8_t shift = msb_first ? (uint8_t)(top_shift - b * 8U) : (uint8_t)(b * 8U);
+                word |= (uint32_t)rx_bytes[i * word_size + b] << shift;
+            }
+            spi_word_put(rx_words, i, word_size, word);
+        }
+    }
+    
+    return status;
+}
+
+/**
+ * @brief Common part of hal_spi_transfer16() and hal_spi_transfer32()
+ */
+static hal_status_t spi_transfer_words(hal_spi_device_t device, 
+                                       const void* tx_words, 
+                                       void* rx_words, 
+                                       uint16_t count, 
+                                       uint8_t word_size, 
+                                       uint32_t timeout_ms)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    const hal_spi_ops_t* ops = g_spi_ops[device];
+    if (ops == NULL) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if ((tx_words == NULL && rx_words == NULL) || count == 0) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    hal_status_t status;
+    
+    HAL_PROBE(HAL_PROBE_OP_ENTER, device, HAL_PROBE_ID_WORDS);
+    hal_mutex_lock(&g_spi_device_locks[device]);
+    HAL_PROBE(HAL_PROBE_OP_DISPATCH, device, (uint32_t)count * word_size);
+    if (ops->transfer_words != NULL) {
+        status = ops->transfer_words(device, tx_words, rx_words, count, word_size, timeout_ms);
+    } else {
+        status = spi_words_fallback(ops, device, tx_words, rx_words, count, word_size, timeout_ms);
+    }
+    HAL_PROBE(HAL_PROBE_OP_EXIT, device, status);
+    hal_mutex_unlock(&g_spi_device_locks[device]);
+    
+    return status;
+}
 
 /*============================================================================*/
 /* Public API Implementation                                                  */
 /*============================================================================*/
 
 /**
- * @brief Register SPI operations implementation
+ * @brief Register SPI operations implementation for all devices
  */
 hal_status_t hal_spi_register_ops(const hal_spi_ops_t* ops)
 {
-    if (ops == NULL) {
+    if (!spi_ops_valid(ops)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
-    /* Verify all required operations are implemented */
-    if (ops->init == NULL || ops->deinit == NULL || 
-        ops->transfer == NULL || ops->send == NULL ||
-        ops->receive == NULL || ops->set_config == NULL ||
-        ops->get_status == NULL) {
+    for (uint8_t device = 0; device < HAL_SPI_MAX_INTERFACES; device++) {
+        hal_status_t status = hal_spi_register_device_ops((hal_spi_device_t)device, ops);
+        if (status != HAL_OK) {
+            return status;
+        }
+    }
+    
+    return HAL_OK;
+}
+
+/**
+ * @brief Register the SPI operations implementation of one device
+ */
+hal_status_t hal_spi_register_device_ops(hal_spi_device_t device, const hal_spi_ops_t* ops)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES || !spi_ops_valid(ops)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
-    g_spi_ops = ops;
+#ifdef HAL_SPI_STATIC_DISPATCH
+    /* Only the implementation bound at build time can be "registered" */
+    return (ops == g_spi_ops[device]) ? HAL_OK : HAL_ERROR_INVALID_PARAM;
+#else
+    /* Under the device lock, so no operation of the device is in flight */
+    hal_mutex_lock(&g_spi_device_locks[device]);
+    g_spi_ops[device] = ops;
+    g_spi_configs[device].valid = false;
+    hal_mutex_unlock(&g_spi_device_locks[device]);
     return HAL_OK;
+#endif
+}
+
+/**
+ * @brief Get the SPI operations implementation of a device
+ */
+const hal_spi_ops_t* hal_spi_get_device_ops(hal_spi_device_t device)
+{
+    return (device < HAL_SPI_MAX_INTERFACES) ? g_spi_ops[device] : NULL;
 }
 
 /**
@@ -48,15 +350,28 @@ hal_status_t hal_spi_register_ops(const hal_spi_ops_t* ops)
  */
 hal_status_t hal_spi_init(hal_spi_device_t device, const hal_spi_config_t* config)
 {
-    if (g_spi_ops == NULL) {
+    if (device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    const hal_spi_ops_t* ops = g_spi_ops[device];
+    if (ops == NULL) {
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (device >= HAL_SPI_MAX_INTERFACES || config == NULL) {
+    if (config == NULL) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
-    return g_spi_ops->init(device, config);
+    hal_mutex_lock(&g_spi_device_locks[device]);
+    hal_status_t result = ops->init(device, config);
+    if (result == HAL_OK) {
+        g_spi_configs[device].config = *config;
+        g_spi_configs[device].valid = true;
+    }
+    hal_mutex_unlock(&g_spi_device_locks[device]);
+    
+    return result;
 }
 
 /**
@@ -64,15 +379,23 @@ hal_status_t hal_spi_init(hal_spi_device_t device, const hal_spi_config_t* confi
  */
 hal_status_t hal_spi_deinit(hal_spi_device_t device)
 {
-    if (g_spi_ops == NULL) {
+    if (device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    const hal_spi_ops_t* ops = g_spi_ops[device];
+    if (ops == NULL) {
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (device >= HAL_SPI_MAX_INTERFACES) {
-        return HAL_ERROR_INVALID_PARAM;
+    hal_mutex_lock(&g_spi_device_locks[device]);
+    hal_status_t result = ops->deinit(device);
+    if (result == HAL_OK) {
+        g_spi_configs[device].valid = false;
     }
+    hal_mutex_unlock(&g_spi_device_locks[device]);
     
-    return g_spi_ops->deinit(device);
+    return result;
 }
 
 /**
@@ -84,15 +407,27 @@ hal_status_t hal_spi_transfer(hal_spi_device_t device,
                               uint16_t length, 
                               uint32_t timeout_ms)
 {
-    if (g_spi_ops == NULL) {
+    if (device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    const hal_spi_ops_t* ops = g_spi_ops[device];
+    if (ops == NULL) {
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (device >= HAL_SPI_MAX_INTERFACES || tx_data == NULL || rx_data == NULL || length == 0) {
+    if (tx_data == NULL || rx_data == NULL || length == 0) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
-    return g_spi_ops->transfer(device, tx_data, rx_data, length, timeout_ms);
+    HAL_PROBE(HAL_PROBE_OP_ENTER, device, HAL_PROBE_ID_TRANSFER);
+    hal_mutex_lock(&g_spi_device_locks[device]);
+    HAL_PROBE(HAL_PROBE_OP_DISPATCH, device, length);
+    hal_status_t result = ops->transfer(device, tx_data, rx_data, length, timeout_ms);
+    HAL_PROBE(HAL_PROBE_OP_EXIT, device, result);
+    hal_mutex_unlock(&g_spi_device_locks[device]);
+    
+    return result;
 }
 
 /**
@@ -103,15 +438,27 @@ hal_status_t hal_spi_send(hal_spi_device_t device,
                           uint16_t length, 
                           uint32_t timeout_ms)
 {
-    if (g_spi_ops == NULL) {
+    if (device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    const hal_spi_ops_t* ops = g_spi_ops[device];
+    if (ops == NULL) {
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (device >= HAL_SPI_MAX_INTERFACES || data == NULL || length == 0) {
+    if (data == NULL || length == 0) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
-    return g_spi_ops->send(device, data, length, timeout_ms);
+    HAL_PROBE(HAL_PROBE_OP_ENTER, device, HAL_PROBE_ID_SEND);
+    hal_mutex_lock(&g_spi_device_locks[device]);
+    HAL_PROBE(HAL_PROBE_OP_DISPATCH, device, length);
+    hal_status_t result = ops->send(device, data, length, timeout_ms);
+    HAL_PROBE(HAL_PROBE_OP_EXIT, device, result);
+    hal_mutex_unlock(&g_spi_device_locks[device]);
+    
+    return result;
 }
 
 /**
@@ -122,15 +469,27 @@ hal_status_t hal_spi_receive(hal_spi_device_t device,
                              uint16_t length, 
                              uint32_t timeout_ms)
 {
-    if (g_spi_ops == NULL) {
+    if (device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    const hal_spi_ops_t* ops = g_spi_ops[device];
+    if (ops == NULL) {
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (device >= HAL_SPI_MAX_INTERFACES || data == NULL || length == 0) {
+    if (data == NULL || length == 0) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
-    return g_spi_ops->receive(device, data, length, timeout_ms);
+    HAL_PROBE(HAL_PROBE_OP_ENTER, device, HAL_PROBE_ID_RECEIVE);
+    hal_mutex_lock(&g_spi_device_locks[device]);
+    HAL_PROBE(HAL_PROBE_OP_DISPATCH, device, length);
+    hal_status_t result = ops->receive(device, data, length, timeout_ms);
+    HAL_PROBE(HAL_PROBE_OP_EXIT, device, result);
+    hal_mutex_unlock(&g_spi_device_locks[device]);
+    
+    return result;
 }
 
 /**
@@ -139,15 +498,34 @@ hal_status_t hal_spi_receive(hal_spi_device_t device,
 hal_status_t hal_spi_set_config(hal_spi_device_t device, 
                                 const hal_spi_config_t* config)
 {
-    if (g_spi_ops == NULL) {
+    if (device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    const hal_spi_ops_t* ops = g_spi_ops[device];
+    if (ops == NULL) {
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (device >= HAL_SPI_MAX_INTERFACES || config == NULL) {
+    if (config == NULL) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
-    return g_spi_ops->set_config(device, config);
+    spi_config_cache_t* cache = &g_spi_configs[device];
+    hal_status_t result = HAL_OK;
+    
+    hal_mutex_lock(&g_spi_device_locks[device]);
+    if (!cache->valid || !hal_spi_config_equal(&cache->config, config)) {
+        result = ops->set_config(device, config);
+        /* After a failure the backend state is unknown: the next call goes through */
+        cache->valid = (result == HAL_OK);
+        if (result == HAL_OK) {
+            cache->config = *config;
+        }
+    }
+    hal_mutex_unlock(&g_spi_device_locks[device]);
+    
+    return result;
 }
 
 /**
@@ -156,13 +534,349 @@ hal_status_t hal_spi_set_config(hal_spi_device_t device,
 hal_status_t hal_spi_get_status(hal_spi_device_t device, 
                                 hal_spi_status_t* status)
 {
-    if (g_spi_ops == NULL) {
+    if (device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    const hal_spi_ops_t* ops = g_spi_ops[device];
+    if (ops == NULL) {
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (device >= HAL_SPI_MAX_INTERFACES || status == NULL) {
+    if (status == NULL) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
-    return g_spi_ops->get_status(device, status);
+    hal_mutex_lock(&g_spi_device_locks[device]);
+    hal_status_t result = ops->get_status(device, status);
+    hal_mutex_unlock(&g_spi_device_locks[device]);
+    
+    return result;
+}
+
+/**
+ * @brief Get extended SPI device statistics
+ */
+hal_status_t hal_spi_get_stats(hal_spi_device_t device, 
+                               hal_spi_stats_t* stats)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES || stats == NULL) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    hal_spi_stats_read(device, stats);
+    
+    return HAL_OK;
+}
+
+/**
+ * @brief Clear extended SPI device statistics
+ */
+hal_status_t hal_spi_reset_stats(hal_spi_device_t device)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    hal_spi_stats_reset(device, NULL);
+    
+    return HAL_OK;
+}
+
+/**
+ * @brief Run a list of transfers back to back
+ */
+hal_status_t hal_spi_submit_batch(hal_spi_device_t device, 
+                                  const hal_spi_xfer_t* xfers, 
+                                  uint16_t count, 
+                                  uint32_t timeout_ms)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    const hal_spi_ops_t* ops = g_spi_ops[device];
+    if (ops == NULL) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (xfers == NULL || count == 0) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    /* Validate the whole list up front so backends can run it without checks */
+    for (uint16_t i = 0; i < count; i++) {
+        if (xfers[i].length == 0 || (xfers[i].tx_data == NULL && xfers[i].rx_data == NULL)) {
+            return HAL_ERROR_INVALID_PARAM;
+        }
+    }
+    
+    hal_status_t status = HAL_OK;
+    
+    /* The lock keeps the whole list together, also for the fallback */
+    HAL_PROBE(HAL_PROBE_OP_ENTER, device, HAL_PROBE_ID_BATCH);
+    hal_mutex_lock(&g_spi_device_locks[device]);
+    HAL_PROBE(HAL_PROBE_OP_DISPATCH, device, count);
+    
+    if (ops->submit_batch != NULL) {
+        status = ops->submit_batch(device, xfers, count, timeout_ms);
+    } else {
+        status = spi_run_each(ops, device, xfers, count, timeout_ms);
+    }
+    HAL_PROBE(HAL_PROBE_OP_EXIT, device, status);
+    
+    hal_mutex_unlock(&g_spi_device_locks[device]);
+    
+    return status;
+}
+
+/**
+ * @brief Scatter-gather transfer: one frame built from several buffers
+ */
+hal_status_t hal_spi_transfer_sg(hal_spi_device_t device, 
+                                 const hal_spi_xfer_t* segs, 
+                                 uint16_t count, 
+                                 uint32_t timeout_ms)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    const hal_spi_ops_t* ops = g_spi_ops[device];
+    if (ops == NULL) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (segs == NULL || count == 0) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    /* Same limit as a contiguous transfer, so backends can use 16-bit frame lengths */
+    uint32_t total = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        if (segs[i].length == 0 || (segs[i].tx_data == NULL && segs[i].rx_data == NULL)) {
+            return HAL_ERROR_INVALID_PARAM;
+        }
+        total += segs[i].length;
+    }
+    if (total > 0xFFFFU) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    hal_status_t status;
+    
+    HAL_PROBE(HAL_PROBE_OP_ENTER, device, HAL_PROBE_ID_SG);
+    hal_mutex_lock(&g_spi_device_locks[device]);
+    HAL_PROBE(HAL_PROBE_OP_DISPATCH, device, total);
+    if (ops->transfer_sg != NULL) {
+        status = ops->transfer_sg(device, segs, count, timeout_ms);
+    } else {
+        status = spi_run_each(ops, device, segs, count, timeout_ms);
+    }
+    HAL_PROBE(HAL_PROBE_OP_EXIT, device, status);
+    hal_mutex_unlock(&g_spi_device_locks[device]);
+    
+    return status;
+}
+
+/**
+ * @brief Transfer, send or receive one frame of up to 4 GiB
+ */
+hal_status_t hal_spi_transfer_large(hal_spi_device_t device, 
+                                    const uint8_t* tx_data, 
+                                    uint8_t* rx_data, 
+                                    uint32_t length, 
+                                    uint32_t timeout_ms)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    const hal_spi_ops_t* ops = g_spi_ops[device];
+    if (ops == NULL) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if ((tx_data == NULL && rx_data == NULL) || length == 0) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    /* Without native support only frames the regular ops can carry: chip
+     * select cannot be held across separate calls */
+    if (ops->transfer_large == NULL && length > 0xFFFFU) {
+        return HAL_ERROR;
+    }
+    
+    hal_status_t status;
+    
+    HAL_PROBE(HAL_PROBE_OP_ENTER, device, HAL_PROBE_ID_LARGE);
+    hal_mutex_lock(&g_spi_device_locks[device]);
+    HAL_PROBE(HAL_PROBE_OP_DISPATCH, device, length);
+    if (ops->transfer_large != NULL) {
+        status = ops->transfer_large(device, tx_data, rx_data, length, timeout_ms);
+    } else if (tx_data != NULL && rx_data != NULL) {
+        status = ops->transfer(device, tx_data, rx_data, (uint16_t)length, timeout_ms);
+    } else if (tx_data != NULL) {
+        status = ops->send(device, tx_data, (uint16_t)length, timeout_ms);
+    } else {
+        status = ops->receive(device, rx_data, (uint16_t)length, timeout_ms);
+    }
+    HAL_PROBE(HAL_PROBE_OP_EXIT, device, status);
+    hal_mutex_unlock(&g_spi_device_locks[device]);
+    
+    return status;
+}
+
+/**
+ * @brief Full-duplex transfer, send or receive of 16-bit words
+ */
+hal_status_t hal_spi_transfer16(hal_spi_device_t device, 
+                                const uint16_t* tx_data, 
+                                uint16_t* rx_data, 
+                                uint16_t count, 
+                                uint32_t timeout_ms)
+{
+    return spi_transfer_words(device, tx_data, rx_data, count, 2U, timeout_ms);
+}
+
+/**
+ * @brief Full-duplex transfer, send or receive of 32-bit words
+ */
+hal_status_t hal_spi_transfer32(hal_spi_device_t device, 
+                                const uint32_t* tx_data, 
+                                uint32_t* rx_data, 
+                                uint16_t count, 
+                                uint32_t timeout_ms)
+{
+    return spi_transfer_words(device, tx_data, rx_data, count, 4U, timeout_ms);
+}
+
+/**
+ * @brief Start a full-duplex SPI transfer without blocking
+ */
+hal_status_t hal_spi_transfer_async(hal_spi_device_t device, 
+                                    const uint8_t* tx_data, 
+                                    uint8_t* rx_data, 
+                                    uint16_t length, 
+                                    uint32_t timeout_ms,
+                                    hal_spi_callback_t callback,
+                                    void* user_data)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    const hal_spi_ops_t* ops = g_spi_ops[device];
+    if (ops == NULL) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (tx_data == NULL || rx_data == NULL || 
+        length == 0 || callback == NULL) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    /* No device lock here: the callback may run before this returns and 
+     * submit the next transfer. The backend's busy flag arbitrates. */
+    HAL_PROBE(HAL_PROBE_OP_ENTER, device, HAL_PROBE_ID_ASYNC);
+    if (ops->transfer_async != NULL) {
+        HAL_PROBE(HAL_PROBE_OP_DISPATCH, device, length);
+        hal_status_t submitted = ops->transfer_async(device, tx_data, rx_data, length, 
+                                                     timeout_ms, callback, user_data);
+        HAL_PROBE(HAL_PROBE_OP_EXIT, device, submitted);
+        return submitted;
+    }
+    
+    /* Fallback: complete synchronously, rejections are reported without callback */
+    hal_mutex_lock(&g_spi_device_locks[device]);
+    HAL_PROBE(HAL_PROBE_OP_DISPATCH, device, length);
+    hal_status_t status = ops->transfer(device, tx_data, rx_data, length, timeout_ms);
+    HAL_PROBE(HAL_PROBE_OP_EXIT, device, status);
+    hal_mutex_unlock(&g_spi_device_locks[device]);
+    
+    if (status == HAL_ERROR_BUSY || status == HAL_ERROR_NOT_INIT || 
+        status == HAL_ERROR_INVALID_PARAM) {
+        return status;
+    }
+    
+    callback(device, status, user_data);
+    return HAL_OK;
+}
+
+/**
+ * @brief Poll a device for completion of asynchronous operations
+ */
+hal_status_t hal_spi_poll(hal_spi_device_t device)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    const hal_spi_ops_t* ops = g_spi_ops[device];
+    if (ops == NULL) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (ops->poll == NULL) {
+        return HAL_OK;  /* Synchronous fallback never leaves work pending */
+    }
+    
+    /* Unlocked like transfer_async(), completion callbacks may resubmit */
+    return ops->poll(device);
+}
+
+/**
+ * @brief Start continuous receive (double-buffered streaming)
+ */
+hal_status_t hal_spi_stream_start(hal_spi_device_t device, 
+                                  uint8_t* buffer, 
+                                  uint16_t length, 
+                                  hal_spi_stream_callback_t callback, 
+                                  void* user_data)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    const hal_spi_ops_t* ops = g_spi_ops[device];
+    if (ops == NULL) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (buffer == NULL || callback == NULL || 
+        length < 2U || (length & 1U) != 0U) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    if (ops->stream_start == NULL) {
+        return HAL_ERROR;  /* Gapless receive cannot be emulated with single calls */
+    }
+    
+    hal_mutex_lock(&g_spi_device_locks[device]);
+    hal_status_t result = ops->stream_start(device, buffer, length, callback, user_data);
+    hal_mutex_unlock(&g_spi_device_locks[device]);
+    
+    return result;
+}
+
+/**
+ * @brief Stop continuous receive
+ */
+hal_status_t hal_spi_stream_stop(hal_spi_device_t device)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    const hal_spi_ops_t* ops = g_spi_ops[device];
+    if (ops == NULL) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (ops->stream_stop == NULL) {
+        return HAL_OK;  /* No stream can be running */
+    }
+    
+    /* Unlocked like hal_spi_poll(), the stream callback may stop the stream */
+    return ops->stream_stop(device);
 }
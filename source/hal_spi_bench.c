@@ -0,0 +1,312 @@
+/**
+ * @file    hal_spi_bench.c
+ * @brief   SPI HAL benchmark suite
+ * @details Measures per-call latency (min/p50/p99/max) and throughput of
+ *          hal_spi_transfer(), hal_spi_send() and hal_spi_receive() over a
+ *          sweep of payload sizes and device counts. The backend is the one
+ *          selected at build time (HAL_IMPLEMENTATION), so a backend sweep
+ *          is one run per build. Results are written as CSV, one row per
+ *          (backend, op, size, devices) point; compare two runs with
+ *          tools/spi_bench_compare.py.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#include "hal_spi.h"
+#include "hal_init.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+/*============================================================================*/
+/* Configuration                                                              */
+/*============================================================================*/
+
+/**
+ * @brief File the CSV results are written to
+ */
+#ifndef HAL_BENCH_OUTPUT
+#define HAL_BENCH_OUTPUT            "hal_spi_bench.csv"
+#endif
+
+/**
+ * @brief Bytes moved per measurement point (bounds the iteration count)
+ */
+#ifndef HAL_BENCH_BYTES_PER_POINT
+#define HAL_BENCH_BYTES_PER_POINT   (4UL * 1024UL * 1024UL)
+#endif
+
+/**
+ * @brief Bounds on the number of calls measured per point
+ */
+#ifndef HAL_BENCH_MIN_ITERATIONS
+#define HAL_BENCH_MIN_ITERATIONS    16U
+#endif
+
+#ifndef HAL_BENCH_MAX_ITERATIONS
+#define HAL_BENCH_MAX_ITERATIONS    20000U
+#endif
+
+#define HAL_BENCH_WARMUP            8U
+#define HAL_BENCH_MAX_LENGTH        0xFFFFU     /* Largest length the API accepts */
+#define HAL_BENCH_TIMEOUT_MS        1000U
+
+/**
+ * @brief Payload sizes swept (2 B to 64 KiB, clamped to the uint16_t API limit)
+ */
+static const uint32_t g_bench_sizes[] = {
+    2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 4096, 16384, 65536
+};
+
+#define HAL_BENCH_SIZE_COUNT        (sizeof(g_bench_sizes) / sizeof(g_bench_sizes[0]))
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+typedef enum {
+    BENCH_OP_TRANSFER = 0,
+    BENCH_OP_SEND,
+    BENCH_OP_RECEIVE,
+    BENCH_OP_COUNT
+} bench_op_t;
+
+static const char* const g_bench_op_names[BENCH_OP_COUNT] = {
+    "transfer", "send", "receive"
+};
+
+/**
+ * @brief Result of one measurement point
+ */
+typedef struct {
+    uint32_t    iterations;     /**< Calls measured */
+    uint32_t    errors;         /**< Calls that did not return HAL_OK */
+    uint64_t    min_ns;
+    uint64_t    p50_ns;
+    uint64_t    p99_ns;
+    uint64_t    max_ns;
+    uint64_t    total_ns;       /**< Wall time of the measured loop */
+} bench_result_t;
+
+/*============================================================================*/
+/* Helpers                                                                    */
+/*============================================================================*/
+
+/**
+ * @brief Monotonic timestamp in nanoseconds
+ */
+static uint64_t bench_time_ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER frequency = {0};
+    LARGE_INTEGER counter;
+    
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((counter.QuadPart / frequency.QuadPart) * 1000000000ULL +
+                      ((counter.QuadPart % frequency.QuadPart) * 1000000000ULL) / frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static int bench_compare_u64(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Issue one call of the benchmarked operation
+ */
+static hal_status_t bench_call(bench_op_t op, hal_spi_device_t device,
+                               const uint8_t* tx, uint8_t* rx, uint16_t length)
+{
+    switch (op) {
+        case BENCH_OP_TRANSFER:
+            return hal_spi_transfer(device, tx, rx, length, HAL_BENCH_TIMEOUT_MS);
+        case BENCH_OP_SEND:
+            return hal_spi_send(device, tx, length, HAL_BENCH_TIMEOUT_MS);
+        case BENCH_OP_RECEIVE:
+            return hal_spi_receive(device, rx, length, HAL_BENCH_TIMEOUT_MS);
+        default:
+            return HAL_ERROR_INVALID_PARAM;
+    }
+}
+
+/**
+ * @brief Measure one (op, size, device count) point
+ * @details Calls are issued round-robin over devices 0..device_count-1 so
+ *          that multi-device runs exercise per-device state switching.
+ */
+static hal_status_t bench_run_point(bench_op_t op, uint16_t length, uint8_t device_count,
+                                    const uint8_t* tx, uint8_t* rx,
+                                    uint64_t* samples, bench_result_t* result)
+{
+    uint32_t iterations = (uint32_t)(HAL_BENCH_BYTES_PER_POINT / length);
+    
+    if (iterations < HAL_BENCH_MIN_ITERATIONS) {
+        iterations = HAL_BENCH_MIN_ITERATIONS;
+    }
+    if (iterations > HAL_BENCH_MAX_ITERATIONS) {
+        iterations = HAL_BENCH_MAX_ITERATIONS;
+    }
+    
+    memset(result, 0, sizeof(*result));
+    
+    /* Warm up caches, connections and the server side */
+    for (uint32_t i = 0; i < HAL_BENCH_WARMUP; i++) {
+        (void)bench_call(op, (hal_spi_device_t)(i % device_count), tx, rx, length);
+    }
+    
+    uint64_t loop_start = bench_time_ns();
+    
+    for (uint32_t i = 0; i < iterations; i++) {
+        uint64_t start = bench_time_ns();
+        hal_status_t status = bench_call(op, (hal_spi_device_t)(i % device_count), tx, rx, length);
+        samples[i] = bench_time_ns() - start;
+        
+        if (status != HAL_OK) {
+            result->errors++;
+        }
+    }
+    
+    result->total_ns = bench_time_ns() - loop_start;
+    result->iterations = iterations;
+    
+    qsort(samples, iterations, sizeof(samples[0]), bench_compare_u64);
+    result->min_ns = samples[0];
+    result->p50_ns = samples[iterations / 2U];
+    result->p99_ns = samples[((uint64_t)iterations * 99U) / 100U];
+    result->max_ns = samples[iterations - 1U];
+    
+    return (result->errors == 0U) ? HAL_OK : HAL_ERROR;
+}
+
+/*============================================================================*/
+/* Entry point                                                                */
+/*============================================================================*/
+
+/**
+ * @brief Benchmark entry point
+ * @details Sweeps op x payload size x device count (1 to HAL_SPI_MAX_INTERFACES)
+ *          on the active backend and writes one CSV row per point to
+ *          HAL_BENCH_OUTPUT. For the SOCKET backend, start
+ *          tools/spi_socket_server.py first.
+ * @return 0 on success, -1 if the HAL could not be brought up
+ */
+int hal_spi_bench_main(void)
+{
+    hal_spi_config_t config = {
+        .baudrate = 1000000,
+        .mode = HAL_SPI_MODE_0,
+        .bit_order = HAL_SPI_BIT_ORDER_MSB_FIRST,
+        .data_bits = 8
+    };
+    int result = 0;
+    
+    printf("=================================================\n");
+    printf("SPI HAL Benchmark\n");
+    printf("=================================================\n");
+    
+    if (hal_init() != HAL_OK) {
+        printf("ERROR: Failed to initialize HAL\n");
+        return -1;
+    }
+    
+    const char* backend = hal_get_implementation_name();
+    printf("Using implementation: %s\n", backend);
+    
+    uint8_t* tx = (uint8_t*)malloc(HAL_BENCH_MAX_LENGTH);
+    uint8_t* rx = (uint8_t*)malloc(HAL_BENCH_MAX_LENGTH);
+    uint64_t* samples = (uint64_t*)malloc(HAL_BENCH_MAX_ITERATIONS * sizeof(uint64_t));
+    FILE* out = fopen(HAL_BENCH_OUTPUT, "w");
+    
+    if (tx == NULL || rx == NULL || samples == NULL || out == NULL) {
+        printf("ERROR: Failed to allocate benchmark buffers or open %s\n", HAL_BENCH_OUTPUT);
+        result = -1;
+        goto cleanup;
+    }
+    
+    for (uint32_t i = 0; i < HAL_BENCH_MAX_LENGTH; i++) {
+        tx[i] = (uint8_t)i;
+    }
+    
+    for (uint8_t dev = 0; dev < HAL_SPI_MAX_INTERFACES; dev++) {
+        if (hal_spi_init((hal_spi_device_t)dev, &config) != HAL_OK) {
+            printf("ERROR: Failed to initialize SPI device %d\n", dev);
+            result = -1;
+            goto deinit;
+        }
+    }
+    
+    fprintf(out, "backend,op,size,devices,iterations,errors,"
+                 "min_ns,p50_ns,p99_ns,max_ns,frames_per_s,bytes_per_s\n");
+    printf("%-8s %6s %3s %10s %10s %10s %10s %12s\n",
+           "op", "size", "dev", "min(ns)", "p50(ns)", "p99(ns)", "max(ns)", "MB/s");
+    
+    for (int op = 0; op < BENCH_OP_COUNT; op++) {
+        for (size_t s = 0; s < HAL_BENCH_SIZE_COUNT; s++) {
+            uint16_t length = (uint16_t)((g_bench_sizes[s] > HAL_BENCH_MAX_LENGTH) ?
+                                         HAL_BENCH_MAX_LENGTH : g_bench_sizes[s]);
+            
+            for (uint8_t devices = 1; devices <= HAL_SPI_MAX_INTERFACES; devices++) {
+                bench_result_t r;
+                
+                if (bench_run_point((bench_op_t)op, length, devices, tx, rx, samples, &r) != HAL_OK) {
+                    printf("WARNING: %s size %u devices %u: %lu of %lu calls failed\n",
+                           g_bench_op_names[op], length, devices,
+                           (unsigned long)r.errors, (unsigned long)r.iterations);
+                }
+                
+                double seconds = (double)r.total_ns / 1e9;
+                double frames_per_s = (seconds > 0.0) ? (double)r.iterations / seconds : 0.0;
+                double bytes_per_s = frames_per_s * (double)length;
+                
+                fprintf(out, "%s,%s,%u,%u,%lu,%lu,%llu,%llu,%llu,%llu,%.1f,%.1f\n",
+                        backend, g_bench_op_names[op], length, devices,
+                        (unsigned long)r.iterations, (unsigned long)r.errors,
+                        (unsigned long long)r.min_ns, (unsigned long long)r.p50_ns,
+                        (unsigned long long)r.p99_ns, (unsigned long long)r.max_ns,
+                        frames_per_s, bytes_per_s);
+                
+                /* Console summary: single-device and full-fan-out points only */
+                if (devices == 1U || devices == HAL_SPI_MAX_INTERFACES) {
+                    printf("%-8s %6u %3u %10llu %10llu %10llu %10llu %12.2f\n",
+                           g_bench_op_names[op], length, devices,
+                           (unsigned long long)r.min_ns, (unsigned long long)r.p50_ns,
+                           (unsigned long long)r.p99_ns, (unsigned long long)r.max_ns,
+                           bytes_per_s / 1e6);
+                }
+            }
+        }
+    }
+    
+    printf("Results written to %s\n", HAL_BENCH_OUTPUT);
+
+deinit:
+    for (uint8_t dev = 0; dev < HAL_SPI_MAX_INTERFACES; dev++) {
+        hal_spi_deinit((hal_spi_device_t)dev);
+    }
+
+cleanup:
+    if (out != NULL) {
+        fclose(out);
+    }
+    free(samples);
+    free(rx);
+    free(tx);
+    
+    return result;
+}
@@ -0,0 +1,491 @@
+/**
+ * @file    hal_spi_bus.c
+ * @brief   Shared SPI Bus Arbitration
+ * @details Layer above the bridge: one ownership flag per bus, a FIFO of
+ *          caller-owned requests per priority, and the configuration the
+ *          device currently runs with. Ownership spans several hal_spi_*
+ *          calls, so it is a flag of its own next to the per-call device
+ *          lock of the bridge; hosts wait for it on a condition variable.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#include "yolpiya.h"
+#include "hal_spi.h"
+#include "hal_spi_bus.h"
+#include "hal_spi_backend.h"
+#include "hal_os.h"
+#include "hal_log.h"
+
+/*============================================================================*/
+/* Private Definitions                                                        */
+/*============================================================================*/
+
+/**
+ * @brief State of a shared bus
+ */
+typedef struct {
+    bool                    open;
+    bool                    claimed;    /**< Owned by a slave or hal_spi_bus_process() */
+    const hal_spi_slave_t*  owner;      /**< Slave between begin and end */
+    bool                    config_valid;
+    hal_spi_config_t        config;     /**< Configuration the device runs with */
+    hal_spi_bus_request_t*  head[HAL_SPI_BUS_PRIO_COUNT];
+    hal_spi_bus_request_t*  tail[HAL_SPI_BUS_PRIO_COUNT];
+    uint16_t                waiting[HAL_SPI_BUS_PRIO_COUNT];    /**< Threads in hal_spi_bus_begin() */
+    hal_spi_bus_info_t      info;
+} bus_state_t;
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static bus_state_t g_buses[HAL_SPI_MAX_INTERFACES];
+
+/* Protect the queues, the waiters and the hand-over of ownership */
+static hal_mutex_t g_bus_locks[HAL_SPI_MAX_INTERFACES] = {
+    HAL_SPI_PER_DEVICE(HAL_MUTEX_INIT, HAL_MUTEX_INIT, HAL_MUTEX_INIT, HAL_MUTEX_INIT, 
+                       HAL_MUTEX_INIT, HAL_MUTEX_INIT, HAL_MUTEX_INIT)
+};
+static hal_cond_t g_bus_released[HAL_SPI_MAX_INTERFACES] = {
+    HAL_SPI_PER_DEVICE(HAL_COND_INIT, HAL_COND_INIT, HAL_COND_INIT, HAL_COND_INIT, 
+                       HAL_COND_INIT, HAL_COND_INIT, HAL_COND_INIT)
+};
+
+/*============================================================================*/
+/* Private Helper Functions                                                   */
+/*============================================================================*/
+
+/**
+ * @brief Check a slave descriptor
+ */
+static bool bus_slave_valid(const hal_spi_slave_t* slave)
+{
+    return slave != NULL &&
+           (uint32_t)slave->device < HAL_SPI_MAX_INTERFACES &&
+           (uint32_t)slave->priority < HAL_SPI_BUS_PRIO_COUNT;
+}
+
+#if !defined(HAL_OS_NONE)
+/**
+ * @brief Check whether a thread of higher priority than priority waits
+ * @note Caller holds the bus lock
+ */
+static bool bus_higher_waiting(const bus_state_t* bus, hal_spi_bus_prio_t priority)
+{
+    for (uint32_t p = 0; p < (uint32_t)priority; p++) {
+        if (bus->waiting[p] > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
+/**
+ * @brief Give ownership of a bus back and wake the waiters
+ */
+static void bus_release(hal_spi_device_t device)
+{
+    bus_state_t* bus = &g_buses[device];
+    
+    hal_mutex_lock(&g_bus_locks[device]);
+    bus->owner = NULL;
+    HAL_ATOMIC_CLEAR(&bus->claimed);
+    hal_cond_broadcast(&g_bus_released[device]);
+    hal_mutex_unlock(&g_bus_locks[device]);
+}
+
+/**
+ * @brief Take ownership of a bus
+ * @details Hosts wait while the bus is owned or a higher priority waits.
+ * @param wait false to fail with HAL_ERROR_BUSY instead of waiting
+ * @return HAL_OK, HAL_ERROR_BUSY, HAL_ERROR_TIMEOUT or HAL_ERROR_NOT_INIT
+ */
+static hal_status_t bus_acquire(hal_spi_device_t device, 
+                                hal_spi_bus_prio_t priority, 
+                                bool wait, 
+                                uint32_t timeout_ms)
+{
+    bus_state_t* bus = &g_buses[device];
+    hal_status_t status = HAL_OK;
+    
+    hal_mutex_lock(&g_bus_locks[device]);
+#if defined(HAL_OS_NONE)
+    /* Nobody to wait for: the owner runs in a context this one preempted */
+    (void)priority;
+    (void)wait;
+    (void)timeout_ms;
+    if (!bus->open) {
+        status = HAL_ERROR_NOT_INIT;
+    } else if (HAL_ATOMIC_TEST_AND_SET(&bus->claimed)) {
+        status = HAL_ERROR_BUSY;
+    }
+#else
+    uint32_t start_us = hal_time_now_us();
+    
+    bus->waiting[priority]++;
+    while (status == HAL_OK && bus->open && (bus->claimed || bus_higher_waiting(bus, priority))) {
+        uint32_t wait_ms = 0;
+        
+        if (!wait) {
+            status = HAL_ERROR_BUSY;
+            break;
+        }
+        if (timeout_ms > 0) {
+            uint32_t elapsed_ms = (hal_time_now_us() - start_us) / 1000U;
+            if (elapsed_ms >= timeout_ms) {
+                status = HAL_ERROR_TIMEOUT;
+                break;
+            }
+            wait_ms = timeout_ms - elapsed_ms;
+        }
+        (void)hal_cond_wait_ms(&g_bus_released[device], &g_bus_locks[device], wait_ms);
+    }
+    bus->waiting[priority]--;
+    
+    if (status == HAL_OK && !bus->open) {
+        status = HAL_ERROR_NOT_INIT;
+    }
+    if (status == HAL_OK) {
+        bus->claimed = true;
+    } else {
+        /* A waiter of lower priority may have been held back by this one */
+        hal_cond_broadcast(&g_bus_released[device]);
+    }
+#endif
+    hal_mutex_unlock(&g_bus_locks[device]);
+    
+    return status;
+}
+
+/**
+ * @brief Apply the configuration of a slave unless the device runs with it
+ * @note Caller owns the bus
+ */
+static hal_status_t bus_apply_config(const hal_spi_slave_t* slave)
+{
+    bus_state_t* bus = &g_buses[slave->device];
+    const hal_spi_config_t* config = &slave->config;
+    
+    if (bus->config_valid && hal_spi_config_equal(&bus->config, config)) {
+        bus->info.config_skipped++;
+        return HAL_OK;
+    }
+    
+    hal_status_t status = hal_spi_set_config(slave->device, config);
+    
+    bus->info.config_applied++;
+    bus->config_valid = (status == HAL_OK);
+    if (status == HAL_OK) {
+        bus->config = *config;
+    }
+    return status;
+}
+
+/**
+ * @brief Check whether a queued request can join the batch of the one before
+ */
+static bool bus_can_merge(const hal_spi_bus_request_t* first, 
+                          const hal_spi_bus_request_t* next, 
+                          uint32_t staged)
+{
+    const hal_spi_slave_t* slave = first->slave;
+    
+    return next != NULL &&
+           next->slave == slave &&
+           (slave->cs == NULL || (slave->flags & HAL_SPI_SLAVE_FLAG_SHARE_CS) != 0U) &&
+           staged + next->count <= HAL_SPI_BUS_MERGE_MAX;
+}
+
+/**
+ * @brief Run the next batch of queued requests
+ * @note Caller owns the bus
+ * @return Requests completed, 0 if the queue is empty
+ */
+static uint32_t bus_run_next(hal_spi_device_t device)
+{
+    bus_state_t* bus = &g_buses[device];
+    hal_spi_xfer_t staged[HAL_SPI_BUS_MERGE_MAX];
+    hal_spi_bus_request_t* first = NULL;
+    hal_spi_bus_request_t* last = NULL;
+    const hal_spi_xfer_t* xfers;
+    uint32_t count = 0;
+    uint32_t timeout_ms = 0;
+    bool unbounded = false;
+    
+    /* Take the head of the highest priority, with what it merges with */
+    hal_mutex_lock(&g_bus_locks[device]);
+    for (uint32_t p = 0; p < HAL_SPI_BUS_PRIO_COUNT && first == NULL; p++) {
+        first = bus->head[p];
+        if (first == NULL) {
+            continue;
+        }
+        
+        last = first;
+        count = first->count;
+        while (bus_can_merge(first, last->next, count)) {
+            last = last->next;
+            count += last->count;
+            bus->info.merged++;
+        }
+        bus->head[p] = last->next;
+        if (bus->head[p] == NULL) {
+            bus->tail[p] = NULL;
+        }
+        last->next = NULL;
+    }
+    hal_mutex_unlock(&g_bus_locks[device]);
+    
+    if (first == NULL) {
+        return 0;
+    }
+    
+    /* A request alone runs from its own descriptors */
+    xfers = first->xfers;
+    if (first->next != NULL) {
+        uint32_t n = 0;
+        for (const hal_spi_bus_request_t* r = first; r != NULL; r = r->next) {
+            memcpy(&staged[n], r->xfers, (size_t)r->count * sizeof(hal_spi_xfer_t));
+            n += r->count;
+        }
+        xfers = staged;
+    }
+    for (const hal_spi_bus_request_t* r = first; r != NULL; r = r->next) {
+        unbounded = unbounded || (r->timeout_ms == 0);
+        timeout_ms += r->timeout_ms;
+    }
+    if (unbounded) {
+        timeout_ms = 0;
+    }
+    
+    const hal_spi_slave_t* slave = first->slave;
+    hal_status_t status = bus_apply_config(slave);
+    
+    if (status == HAL_OK) {
+        if (slave->cs != NULL) {
+            slave->cs(slave->cs_context, true);
+        }
+        status = hal_spi_submit_batch(device, xfers, (uint16_t)count, timeout_ms);
+        if (slave->cs != NULL) {
+            slave->cs(slave->cs_context, false);
+        }
+        bus->info.transactions++;
+    }
+    
+    /* The request may be resubmitted from its callback */
+    hal_spi_bus_request_t* r = first;
+    uint32_t completed = 0;
+    while (r != NULL) {
+        hal_spi_bus_request_t* next = r->next;
+        
+        r->next = NULL;
+        completed++;
+        if (r->callback != NULL) {
+            r->callback(device, status, r->user_data);
+        }
+        r = next;
+    }
+    bus->info.requests += completed;
+    
+    return completed;
+}
+
+/*============================================================================*/
+/* Public API Implementation                                                  */
+/*============================================================================*/
+
+hal_status_t hal_spi_bus_open(hal_spi_device_t device, const hal_spi_config_t* config)
+{
+    if ((uint32_t)device >= HAL_SPI_MAX_INTERFACES || config == NULL) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    bus_state_t* bus = &g_buses[device];
+    
+    if (bus->open) {
+        return HAL_ERROR_BUSY;
+    }
+    
+    hal_status_t status = hal_spi_init(device, config);
+    if (status != HAL_OK) {
+        return status;
+    }
+    
+    hal_mutex_lock(&g_bus_locks[device]);
+    memset(bus, 0, sizeof(*bus));
+    bus->config = *config;
+    bus->config_valid = true;
+    bus->open = true;
+    hal_mutex_unlock(&g_bus_locks[device]);
+    
+    HAL_LOG_INFO("[HAL] SPI device %d opened as shared bus\n", device);
+    return HAL_OK;
+}
+
+hal_status_t hal_spi_bus_close(hal_spi_device_t device)
+{
+    if ((uint32_t)device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    bus_state_t* bus = &g_buses[device];
+    hal_status_t status = HAL_OK;
+    
+    hal_mutex_lock(&g_bus_locks[device]);
+    if (!bus->open) {
+        status = HAL_ERROR_NOT_INIT;
+    } else if (bus->claimed) {
+        status = HAL_ERROR_BUSY;
+    } else {
+        for (uint32_t p = 0; p < HAL_SPI_BUS_PRIO_COUNT; p++) {
+            if (bus->head[p] != NULL) {
+                status = HAL_ERROR_BUSY;
+            }
+        }
+    }
+    if (status == HAL_OK) {
+        bus->open = false;
+        hal_cond_broadcast(&g_bus_released[device]);
+    }
+    hal_mutex_unlock(&g_bus_locks[device]);
+    
+    if (status != HAL_OK) {
+        return status;
+    }
+    return hal_spi_deinit(device);
+}
+
+hal_status_t hal_spi_bus_begin(const hal_spi_slave_t* slave, uint32_t timeout_ms)
+{
+    if (!bus_slave_valid(slave)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    hal_status_t status = bus_acquire(slave->device, slave->priority, true, timeout_ms);
+    if (status != HAL_OK) {
+        return status;
+    }
+    
+    status = bus_apply_config(slave);
+    if (status != HAL_OK) {
+        bus_release(slave->device);
+        return status;
+    }
+    
+    g_buses[slave->device].owner = slave;
+    g_buses[slave->device].info.transactions++;
+    if (slave->cs != NULL) {
+        slave->cs(slave->cs_context, true);
+    }
+    return HAL_OK;
+}
+
+hal_status_t hal_spi_bus_end(const hal_spi_slave_t* slave)
+{
+    if (!bus_slave_valid(slave) || g_buses[slave->device].owner != slave) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    if (slave->cs != NULL) {
+        slave->cs(slave->cs_context, false);
+    }
+    bus_release(slave->device);
+    return HAL_OK;
+}
+
+hal_status_t hal_spi_bus_submit(hal_spi_bus_request_t* request)
+{
+    if (request == NULL || !bus_slave_valid(request->slave) ||
+        request->xfers == NULL || request->count == 0) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    hal_spi_device_t device = request->slave->device;
+    bus_state_t* bus = &g_buses[device];
+    hal_spi_bus_prio_t priority = request->slave->priority;
+    hal_status_t status = HAL_OK;
+    
+    hal_mutex_lock(&g_bus_locks[device]);
+    if (!bus->open) {
+        status = HAL_ERROR_NOT_INIT;
+    } else {
+        request->next = NULL;
+        if (bus->tail[priority] != NULL) {
+            bus->tail[priority]->next = request;
+        } else {
+            bus->head[priority] = request;
+        }
+        bus->tail[priority] = request;
+    }
+    hal_mutex_unlock(&g_bus_locks[device]);
+    
+    return status;
+}
+
+hal_status_t hal_spi_bus_process(hal_spi_device_t device)
+{
+    if ((uint32_t)device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    bus_state_t* bus = &g_buses[device];
+    hal_status_t status = bus_acquire(device, HAL_SPI_BUS_PRIO_BULK, false, 0);
+    if (status != HAL_OK) {
+        return status;
+    }
+    
+    /* Requests submitted meanwhile (by callbacks) may be served, up to this many */
+    uint32_t budget = 0;
+    
+    hal_mutex_lock(&g_bus_locks[device]);
+    for (uint32_t p = 0; p < HAL_SPI_BUS_PRIO_COUNT; p++) {
+        for (const hal_spi_bus_request_t* r = bus->head[p]; r != NULL; r = r->next) {
+            budget++;
+        }
+    }
+    hal_mutex_unlock(&g_bus_locks[device]);
+    
+    while (budget > 0) {
+        bool yield = false;
+        
+        /* Hand over to a begin() waiter that outranks the next request */
+        hal_mutex_lock(&g_bus_locks[device]);
+        for (uint32_t p = 0; p < HAL_SPI_BUS_PRIO_COUNT; p++) {
+            if (bus->waiting[p] > 0) {
+                yield = true;
+                break;
+            }
+            if (bus->head[p] != NULL) {
+                break;
+            }
+        }
+        hal_mutex_unlock(&g_bus_locks[device]);
+        
+        if (yield) {
+            status = HAL_ERROR_BUSY;
+            break;
+        }
+        
+        uint32_t completed = bus_run_next(device);
+        if (completed == 0) {
+            break;
+        }
+        budget = (completed < budget) ? budget - completed : 0;
+    }
+    
+    bus_release(device);
+    return status;
+}
+
+hal_status_t hal_spi_bus_get_info(hal_spi_device_t device, hal_spi_bus_info_t* info)
+{
+    if ((uint32_t)device >= HAL_SPI_MAX_INTERFACES || info == NULL) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    hal_mutex_lock(&g_bus_locks[device]);
+    *info = g_buses[device].info;
+    hal_mutex_unlock(&g_bus_locks[device]);
+    return HAL_OK;
+}
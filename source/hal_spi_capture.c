@@ -0,0 +1,614 @@
+/**
+ * @file    hal_spi_capture.c
+ * @brief   SPI Traffic Capture
+ * @details Decorator around a registered implementation: every operation is
+ *          forwarded to it, then appended to the trace file as one record
+ *          (format in hal_spi_capture.h). Records are written through a
+ *          buffered stream under one lock, so the cost per operation is a few
+ *          memcpy calls. Asynchronous transfers and stream halves are recorded
+ *          when their callback arrives, with the data then in the buffers.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#include "yolpiya.h"
+#include "hal_spi.h"
+#include "hal_spi_backend.h"
+#include "hal_spi_capture.h"
+#include "hal_os.h"
+#include "hal_log.h"
+#include <stdio.h>
+
+#ifdef HAL_SPI_STATIC_DISPATCH
+#error "Capture wraps the registered implementation; build without HAL_SPI_STATIC_DISPATCH"
+#endif
+
+/*============================================================================*/
+/* Private Definitions                                                        */
+/*============================================================================*/
+
+/**
+ * @brief stdio buffer of the trace file
+ */
+#ifndef CAPTURE_BUFFER_SIZE
+#define CAPTURE_BUFFER_SIZE     (64U * 1024U)
+#endif
+
+/**
+ * @brief Capture session
+ */
+typedef struct {
+    FILE*                   file;       /**< NULL while not recording */
+    const hal_spi_ops_t*    inner;      /**< Captured implementation */
+    uint32_t                start_us;   /**< hal_time_now_us() at start */
+    bool                    failed;     /**< A write failed */
+    hal_mutex_t             lock;       /**< Serializes records */
+} capture_session_t;
+
+/**
+ * @brief Callbacks of a device, replaced while its operation runs
+ */
+typedef struct {
+    bool                    async_pending;
+    hal_spi_callback_t      async_callback;
+    void*                   async_user_data;
+    const uint8_t*          async_tx;
+    uint8_t*                async_rx;
+    uint16_t                async_length;
+    uint32_t                async_start_us;
+    
+    hal_spi_stream_callback_t stream_callback;
+    void*                   stream_user_data;
+    uint32_t                stream_start_us;    /**< When the current half started */
+    
+    hal_spi_bit_order_t     bit_order;          /**< Byte order of recorded words */
+} capture_device_t;
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static capture_session_t g_capture = {
+    .lock = HAL_MUTEX_INIT
+};
+static capture_device_t g_capture_devices[HAL_SPI_MAX_INTERFACES];
+static hal_spi_ops_t g_capture_ops;
+static char g_capture_buffer[CAPTURE_BUFFER_SIZE];
+
+/*============================================================================*/
+/* Private Helper Functions                                                   */
+/*============================================================================*/
+
+/**
+ * @brief Append bytes to the trace file (zeros if data is NULL)
+ * @note Caller holds g_capture.lock
+ */
+static void capture_put(const void* data, uint32_t length)
+{
+    static const uint8_t zeros[HAL_SPI_CAPTURE_ALIGN] = {0};
+    
+    if (data == NULL) {
+        for (uint32_t i = 0; i < length; i += HAL_SPI_CAPTURE_ALIGN) {
+            uint32_t n = (length - i < HAL_SPI_CAPTURE_ALIGN) ? length - i : HAL_SPI_CAPTURE_ALIGN;
+            capture_put(zeros, n);
+        }
+        return;
+    }
+    
+    if (length > 0 && fwrite(data, 1, length, g_capture.file) != length) {
+        g_capture.failed = true;
+    }
+}
+
+/**
+ * @brief Write a record header
+ * @note Caller holds g_capture.lock and the file is open
+ */
+static void capture_begin(hal_spi_rec_type_t type, 
+                          hal_spi_device_t device, 
+                          hal_status_t status, 
+                          uint8_t flags, 
+                          uint32_t start_us, 
+                          uint16_t count, 
+                          uint32_t tx_length, 
+                          uint32_t rx_length)
+{
+    hal_spi_rec_header_t header;
+    
+    header.timestamp_us = start_us - g_capture.start_us;
+    header.type = (uint8_t)type;
+    header.device = (uint8_t)device;
+    header.status = (int8_t)status;
+    header.flags = flags;
+    header.count = count;
+    header.reserved = 0;
+    header.tx_length = tx_length;
+    header.rx_length = rx_length;
+    
+    capture_put(&header, sizeof(header));
+}
+
+/**
+ * @brief Pad a record of tx_length + rx_length payload bytes to the alignment
+ */
+static void capture_end(uint32_t tx_length, uint32_t rx_length)
+{
+    uint32_t used = (uint32_t)sizeof(hal_spi_rec_header_t) + tx_length + rx_length;
+    
+    capture_put(NULL, (HAL_SPI_CAPTURE_ALIGN - (used % HAL_SPI_CAPTURE_ALIGN)) % HAL_SPI_CAPTURE_ALIGN);
+}
+
+/**
+ * @brief Record an operation with one TX and one RX buffer (either may be empty)
+ */
+static void capture_record(hal_spi_rec_type_t type, 
+                           hal_spi_device_t device, 
+                           hal_status_t status, 
+                           uint8_t flags, 
+                           uint32_t start_us, 
+                           const void* tx, 
+                           uint32_t tx_length, 
+                           const void* rx, 
+                           uint32_t rx_length)
+{
+    if (status == HAL_ERROR_INVALID_PARAM) {
+        return;  /* Rejected before anything happened, arguments may be bogus */
+    }
+    
+    hal_mutex_lock(&g_capture.lock);
+    if (g_capture.file != NULL) {
+        capture_begin(type, device, status, flags, start_us, 0, tx_length, rx_length);
+        capture_put(tx, tx_length);
+        capture_put(rx, rx_length);
+        capture_end(tx_length, rx_length);
+    }
+    hal_mutex_unlock(&g_capture.lock);
+}
+
+/**
+ * @brief Append words in the byte order they take on the bus
+ * @details MSB first puts the most significant byte of each word first, as the
+ *          bridge's word fallback stages them.
+ * @note Caller holds g_capture.lock
+ */
+static void capture_put_words(const void* words, uint16_t count, uint8_t word_size, bool msb_first)
+{
+    uint8_t chunk[64];
+    uint32_t used = 0;
+    
+    for (uint16_t i = 0; i < count; i++) {
+        uint32_t word = (word_size == 2U) ? ((const uint16_t*)words)[i] : ((const uint32_t*)words)[i];
+        
+        for (uint8_t b = 0; b < word_size; b++) {
+            uint8_t shift = msb_first ? (uint8_t)((word_size - 1U - b) * 8U) : (uint8_t)(b * 8U);
+            chunk[used++] = (uint8_t)(word >> shift);
+        }
+        if (used == sizeof(chunk)) {
+            capture_put(chunk, used);
+            used = 0;
+        }
+    }
+    capture_put(chunk, used);
+}
+
+/**
+ * @brief Record a batch or scatter-gather frame
+ * @details RX data is recorded only if the operation succeeded.
+ */
+static void capture_record_list(hal_spi_rec_type_t type, 
+                                hal_spi_device_t device, 
+                                hal_status_t status, 
+                                uint32_t start_us, 
+                                const hal_spi_xfer_t* xfers, 
+                                uint16_t count)
+{
+    if (status == HAL_ERROR_INVALID_PARAM) {
+        return;
+    }
+    
+    uint32_t tx_length = (uint32_t)count * sizeof(hal_spi_rec_seg_t);
+    uint32_t rx_length = 0;
+    
+    for (uint16_t i = 0; i < count; i++) {
+        tx_length += (xfers[i].tx_data != NULL) ? xfers[i].length : 0U;
+        rx_length += (xfers[i].rx_data != NULL && status == HAL_OK) ? xfers[i].length : 0U;
+    }
+    
+    hal_mutex_lock(&g_capture.lock);
+    if (g_capture.file != NULL) {
+        capture_begin(type, device, status, 0, start_us, count, tx_length, rx_length);
+        
+        for (uint16_t i = 0; i < count; i++) {
+            hal_spi_rec_seg_t seg;
+            seg.type = (uint8_t)((xfers[i].rx_data == NULL) ? HAL_SPI_REC_SEND :
+                                 (xfers[i].tx_data == NULL) ? HAL_SPI_REC_RECEIVE : HAL_SPI_REC_TRANSFER);
+            seg.reserved = 0;
+            seg.length = xfers[i].length;
+            capture_put(&seg, sizeof(seg));
+        }
+        for (uint16_t i = 0; i < count; i++) {
+            if (xfers[i].tx_data != NULL) {
+                capture_put(xfers[i].tx_data, xfers[i].length);
+            }
+        }
+        for (uint16_t i = 0; i < count && status == HAL_OK; i++) {
+            if (xfers[i].rx_data != NULL) {
+                capture_put(xfers[i].rx_data, xfers[i].length);
+            }
+        }
+        
+        capture_end(tx_length, rx_length);
+    }
+    hal_mutex_unlock(&g_capture.lock);
+}
+
+/**
+ * @brief Record a configuration
+ */
+static void capture_record_config(hal_spi_rec_type_t type, 
+                                  hal_spi_device_t device, 
+                                  hal_status_t status, 
+                                  uint32_t start_us, 
+                                  const hal_spi_config_t* config)
+{
+    hal_spi_rec_config_t rec;
+    
+    rec.baudrate = config->baudrate;
+    rec.mode = (uint8_t)config->mode;
+    rec.bit_order = (uint8_t)config->bit_order;
+    rec.data_bits = config->data_bits;
+    rec.reserved = 0;
+    
+    capture_record(type, device, status, 0, start_us, &rec, sizeof(rec), NULL, 0);
+}
+
+/*============================================================================*/
+/* SPI Operations Implementation (Capture)                                    */
+/*============================================================================*/
+
+static hal_status_t capture_spi_init(hal_spi_device_t device, const hal_spi_config_t* config)
+{
+    uint32_t start_us = hal_time_now_us();
+    hal_status_t status = g_capture.inner->init(device, config);
+    
+    if (config != NULL) {
+        capture_record_config(HAL_SPI_REC_INIT, device, status, start_us, config);
+        if (status == HAL_OK && device < HAL_SPI_MAX_INTERFACES) {
+            g_capture_devices[device].bit_order = config->bit_order;
+        }
+    }
+    return status;
+}
+
+static hal_status_t capture_spi_deinit(hal_spi_device_t device)
+{
+    uint32_t start_us = hal_time_now_us();
+    hal_status_t status = g_capture.inner->deinit(device);
+    
+    capture_record(HAL_SPI_REC_DEINIT, device, status, 0, start_us, NULL, 0, NULL, 0);
+    return status;
+}
+
+static hal_status_t capture_spi_transfer(hal_spi_device_t device, 
+                                         const uint8_t* tx_data, 
+                                         uint8_t* rx_data, 
+                                         uint16_t length, 
+                                         uint32_t timeout_ms)
+{
+    uint32_t start_us = hal_time_now_us();
+    hal_status_t status = g_capture.inner->transfer(device, tx_data, rx_data, length, timeout_ms);
+    
+    capture_record(HAL_SPI_REC_TRANSFER, device, status, 0, start_us, 
+                   tx_data, length, rx_data, (status == HAL_OK) ? length : 0U);
+    return status;
+}
+
+static hal_status_t capture_spi_send(hal_spi_device_t device, 
+                                     const uint8_t* data, 
+                                     uint16_t length, 
+                                     uint32_t timeout_ms)
+{
+    uint32_t start_us = hal_time_now_us();
+    hal_status_t status = g_capture.inner->send(device, data, length, timeout_ms);
+    
+    capture_record(HAL_SPI_REC_SEND, device, status, 0, start_us, data, length, NULL, 0);
+    return status;
+}
+
+static hal_status_t capture_spi_receive(hal_spi_device_t device, 
+                                        uint8_t* data, 
+                                        uint16_t length, 
+                                        uint32_t timeout_ms)
+{
+    uint32_t start_us = hal_time_now_us();
+    hal_status_t status = g_capture.inner->receive(device, data, length, timeout_ms);
+    
+    capture_record(HAL_SPI_REC_RECEIVE, device, status, 0, start_us, 
+                   NULL, 0, data, (status == HAL_OK) ? length : 0U);
+    return status;
+}
+
+static hal_status_t capture_spi_set_config(hal_spi_device_t device, 
+                                           const hal_spi_config_t* config)
+{
+    uint32_t start_us = hal_time_now_us();
+    hal_status_t status = g_capture.inner->set_config(device, config);
+    
+    if (config != NULL) {
+        capture_record_config(HAL_SPI_REC_SET_CONFIG, device, status, start_us, config);
+        if (status == HAL_OK && device < HAL_SPI_MAX_INTERFACES) {
+            g_capture_devices[device].bit_order = config->bit_order;
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief Completion of a captured asynchronous transfer
+ */
+static void capture_async_done(hal_spi_device_t device, hal_status_t status, void* user_data)
+{
+    capture_device_t* dev = &g_capture_devices[device];
+    hal_spi_callback_t callback = dev->async_callback;
+    void* callback_user_data = dev->async_user_data;
+    (void)user_data;
+    
+    capture_record(HAL_SPI_REC_TRANSFER, device, status, HAL_SPI_REC_FLAG_ASYNC, dev->async_start_us, 
+                   dev->async_tx, dev->async_length, 
+                   dev->async_rx, (status == HAL_OK) ? dev->async_length : 0U);
+    
+    /* The callback may submit the next transfer */
+    HAL_ATOMIC_CLEAR(&dev->async_pending);
+    callback(device, status, callback_user_data);
+}
+
+static hal_status_t capture_spi_transfer_async(hal_spi_device_t device, 
+                                               const uint8_t* tx_data, 
+                                               uint8_t* rx_data, 
+                                               uint16_t length, 
+                                               uint32_t timeout_ms, 
+                                               hal_spi_callback_t callback, 
+                                               void* user_data)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    capture_device_t* dev = &g_capture_devices[device];
+    uint32_t start_us = hal_time_now_us();
+    
+    /* The slot belongs to the transfer in flight until its callback */
+    if (HAL_ATOMIC_TEST_AND_SET(&dev->async_pending)) {
+        capture_record(HAL_SPI_REC_TRANSFER, device, HAL_ERROR_BUSY, 0, start_us, tx_data, length, NULL, 0);
+        return HAL_ERROR_BUSY;
+    }
+    
+    dev->async_callback = callback;
+    dev->async_user_data = user_data;
+    dev->async_tx = tx_data;
+    dev->async_rx = rx_data;
+    dev->async_length = length;
+    dev->async_start_us = start_us;
+    
+    hal_status_t status = g_capture.inner->transfer_async(device, tx_data, rx_data, length, 
+                                                          timeout_ms, capture_async_done, NULL);
+    if (status != HAL_OK) {
+        /* Rejected: no callback will come */
+        HAL_ATOMIC_CLEAR(&dev->async_pending);
+        capture_record(HAL_SPI_REC_TRANSFER, device, status, 0, start_us, tx_data, length, NULL, 0);
+    }
+    return status;
+}
+
+static hal_status_t capture_spi_submit_batch(hal_spi_device_t device, 
+                                             const hal_spi_xfer_t* xfers, 
+                                             uint16_t count, 
+                                             uint32_t timeout_ms)
+{
+    uint32_t start_us = hal_time_now_us();
+    hal_status_t status = g_capture.inner->submit_batch(device, xfers, count, timeout_ms);
+    
+    capture_record_list(HAL_SPI_REC_BATCH, device, status, start_us, xfers, count);
+    return status;
+}
+
+static hal_status_t capture_spi_transfer_sg(hal_spi_device_t device, 
+                                            const hal_spi_xfer_t* segs, 
+                                            uint16_t count, 
+                                            uint32_t timeout_ms)
+{
+    uint32_t start_us = hal_time_now_us();
+    hal_status_t status = g_capture.inner->transfer_sg(device, segs, count, timeout_ms);
+    
+    capture_record_list(HAL_SPI_REC_SG, device, status, start_us, segs, count);
+    return status;
+}
+
+static hal_status_t capture_spi_transfer_large(hal_spi_device_t device, 
+                                               const uint8_t* tx_data, 
+                                               uint8_t* rx_data, 
+                                               uint32_t length, 
+                                               uint32_t timeout_ms)
+{
+    uint32_t start_us = hal_time_now_us();
+    hal_status_t status = g_capture.inner->transfer_large(device, tx_data, rx_data, length, timeout_ms);
+    hal_spi_op_t op = hal_spi_large_classify(tx_data, rx_data);
+    hal_spi_rec_type_t type = (op == HAL_SPI_OP_SEND) ? HAL_SPI_REC_SEND :
+                              (op == HAL_SPI_OP_RECEIVE) ? HAL_SPI_REC_RECEIVE : HAL_SPI_REC_TRANSFER;
+    
+    /* Same records as a 16-bit frame, the sections are 32 bits long */
+    capture_record(type, device, status, 0, start_us, 
+                   tx_data, (tx_data != NULL) ? length : 0U, 
+                   rx_data, (status == HAL_OK && rx_data != NULL) ? length : 0U);
+    return status;
+}
+
+static hal_status_t capture_spi_transfer_words(hal_spi_device_t device, 
+                                               const void* tx_words, 
+                                               void* rx_words, 
+                                               uint16_t count, 
+                                               uint8_t word_size, 
+                                               uint32_t timeout_ms)
+{
+    uint32_t start_us = hal_time_now_us();
+    hal_status_t status = g_capture.inner->transfer_words(device, tx_words, rx_words, count, 
+                                                          word_size, timeout_ms);
+    
+    if (status == HAL_ERROR_INVALID_PARAM || device >= HAL_SPI_MAX_INTERFACES) {
+        return status;
+    }
+    
+    /* The frame the bridge fallback would send, so replay without this op matches it */
+    hal_spi_rec_type_t type = (rx_words == NULL) ? HAL_SPI_REC_SEND :
+                              (tx_words == NULL) ? HAL_SPI_REC_RECEIVE : HAL_SPI_REC_TRANSFER;
+    bool msb_first = (g_capture_devices[device].bit_order == HAL_SPI_BIT_ORDER_MSB_FIRST);
+    uint32_t length = (uint32_t)count * word_size;
+    uint32_t tx_length = (tx_words != NULL) ? length : 0U;
+    uint32_t rx_length = (status == HAL_OK && rx_words != NULL) ? length : 0U;
+    
+    hal_mutex_lock(&g_capture.lock);
+    if (g_capture.file != NULL) {
+        capture_begin(type, device, status, 0, start_us, 0, tx_length, rx_length);
+        if (tx_length > 0U) {
+            capture_put_words(tx_words, count, word_size, msb_first);
+        }
+        if (rx_length > 0U) {
+            capture_put_words(rx_words, count, word_size, msb_first);
+        }
+        capture_end(tx_length, rx_length);
+    }
+    hal_mutex_unlock(&g_capture.lock);
+    
+    return status;
+}
+
+/**
+ * @brief A filled half of a captured stream
+ */
+static void capture_stream_half(hal_spi_device_t device, 
+                                hal_status_t status, 
+                                const uint8_t* data, 
+                                uint16_t length, 
+                                void* user_data)
+{
+    capture_device_t* dev = &g_capture_devices[device];
+    (void)user_data;
+    
+    capture_record(HAL_SPI_REC_STREAM, device, status, 0, dev->stream_start_us, 
+                   NULL, 0, data, (status == HAL_OK) ? length : 0U);
+    dev->stream_start_us = hal_time_now_us();
+    
+    dev->stream_callback(device, status, data, length, dev->stream_user_data);
+}
+
+static hal_status_t capture_spi_stream_start(hal_spi_device_t device, 
+                                             uint8_t* buffer, 
+                                             uint16_t length, 
+                                             hal_spi_stream_callback_t callback, 
+                                             void* user_data)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    capture_device_t* dev = &g_capture_devices[device];
+    hal_spi_stream_callback_t previous_callback = dev->stream_callback;
+    void* previous_user_data = dev->stream_user_data;
+    
+    dev->stream_callback = callback;
+    dev->stream_user_data = user_data;
+    dev->stream_start_us = hal_time_now_us();
+    
+    hal_status_t status = g_capture.inner->stream_start(device, buffer, length, capture_stream_half, NULL);
+    if (status != HAL_OK) {
+        /* A stream may still be running with the previous callback */
+        dev->stream_callback = previous_callback;
+        dev->stream_user_data = previous_user_data;
+    }
+    return status;
+}
+
+/*============================================================================*/
+/* Public API Implementation                                                  */
+/*============================================================================*/
+
+const hal_spi_ops_t* hal_spi_capture_start(const hal_spi_ops_t* inner, const char* path)
+{
+    if (inner == NULL || path == NULL || inner == &g_capture_ops) {
+        return NULL;
+    }
+    
+    hal_mutex_lock(&g_capture.lock);
+    
+    if (g_capture.file != NULL) {
+        hal_mutex_unlock(&g_capture.lock);
+        HAL_LOG_ERROR("[CAPTURE] ERROR: A capture is already running\n");
+        return NULL;
+    }
+    
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {
+        hal_mutex_unlock(&g_capture.lock);
+        HAL_LOG_ERROR("[CAPTURE] ERROR: Cannot create %s\n", path);
+        return NULL;
+    }
+    (void)setvbuf(file, g_capture_buffer, _IOFBF, sizeof(g_capture_buffer));
+    
+    g_capture.file = file;
+    g_capture.inner = inner;
+    g_capture.start_us = hal_time_now_us();
+    g_capture.failed = false;
+    
+    hal_spi_capture_file_t header = {0};
+    header.magic = HAL_SPI_CAPTURE_MAGIC;
+    header.version = HAL_SPI_CAPTURE_VERSION;
+    header.header_size = (uint16_t)sizeof(header);
+    capture_put(&header, sizeof(header));
+    
+    /* Same optional operations as inner, so the bridge falls back the same way */
+    g_capture_ops.init           = capture_spi_init;
+    g_capture_ops.deinit         = capture_spi_deinit;
+    g_capture_ops.transfer       = capture_spi_transfer;
+    g_capture_ops.send           = capture_spi_send;
+    g_capture_ops.receive        = capture_spi_receive;
+    g_capture_ops.set_config     = capture_spi_set_config;
+    g_capture_ops.get_status     = inner->get_status;
+    g_capture_ops.transfer_async = (inner->transfer_async != NULL) ? capture_spi_transfer_async : NULL;
+    g_capture_ops.poll           = inner->poll;
+    g_capture_ops.submit_batch   = (inner->submit_batch != NULL) ? capture_spi_submit_batch : NULL;
+    g_capture_ops.transfer_sg    = (inner->transfer_sg != NULL) ? capture_spi_transfer_sg : NULL;
+    g_capture_ops.stream_start   = (inner->stream_start != NULL) ? capture_spi_stream_start : NULL;
+    g_capture_ops.stream_stop    = inner->stream_stop;
+    g_capture_ops.transfer_large = (inner->transfer_large != NULL) ? capture_spi_transfer_large : NULL;
+    g_capture_ops.transfer_words = (inner->transfer_words != NULL) ? capture_spi_transfer_words : NULL;
+    
+    hal_mutex_unlock(&g_capture.lock);
+    
+    HAL_LOG_INFO("[CAPTURE] Recording to %s\n", path);
+    
+    return &g_capture_ops;
+}
+
+hal_status_t hal_spi_capture_stop(void)
+{
+    hal_mutex_lock(&g_capture.lock);
+    
+    if (g_capture.file == NULL) {
+        hal_mutex_unlock(&g_capture.lock);
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (fclose(g_capture.file) != 0) {
+        g_capture.failed = true;
+    }
+    g_capture.file = NULL;
+    bool failed = g_capture.failed;
+    
+    hal_mutex_unlock(&g_capture.lock);
+    
+    if (failed) {
+        HAL_LOG_ERROR("[CAPTURE] ERROR: Trace file incomplete (write failed)\n");
+    }
+    
+    return failed ? HAL_ERROR : HAL_OK;
+}
@@ -0,0 +1,238 @@
+/**
+ * @file    hal_spi_reg.c
+ * @brief   SPI Register Device Helper
+ * @details Layer above the bridge: frames are staged on the stack and run as
+ *          one hal_spi_transfer(), so the device lock of the bridge keeps a
+ *          merged read together. Parity comes from a byte table instead of a
+ *          loop over the 14 bits.
+ * @author  EswPla HAL Team
+ * @date    2026-10-15
+ */
+
+#include "yolpiya.h"
+#include "hal_spi.h"
+#include "hal_spi_reg.h"
+
+/*============================================================================*/
+/* Private Definitions                                                        */
+/*============================================================================*/
+
+#define REG_CMD_SHIFT           14U
+#define REG_ADDR_SHIFT          10U
+#define REG_DATA_SHIFT          2U
+#define REG_PARITY_BIT          1U
+
+#if HAL_SPI_REG_MERGE_MAX == 0U
+#error "HAL_SPI_REG_MERGE_MAX must be at least 1"
+#endif
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+/* Parity of every byte value, 1 for an odd number of set bits */
+#define REG_P2(n)   (n), (n) ^ 1U, (n) ^ 1U, (n)
+#define REG_P4(n)   REG_P2(n), REG_P2((n) ^ 1U), REG_P2((n) ^ 1U), REG_P2(n)
+#define REG_P6(n)   REG_P4(n), REG_P4((n) ^ 1U), REG_P4((n) ^ 1U), REG_P4(n)
+
+static const uint8_t g_reg_parity[256] = {
+    REG_P6(0U), REG_P6(1U), REG_P6(1U), REG_P6(0U)
+};
+
+/*============================================================================*/
+/* Private Helper Functions                                                   */
+/*============================================================================*/
+
+/**
+ * @brief Even parity bit over bits 15:2 of a frame
+ */
+static uint16_t reg_parity(uint16_t frame)
+{
+    return (uint16_t)(g_reg_parity[frame >> 8] ^ g_reg_parity[frame & 0xFCU]);
+}
+
+/**
+ * @brief Check a response frame: parity, and that it answers register addr
+ */
+static bool reg_response_valid(uint16_t response, uint8_t addr)
+{
+    return ((response >> REG_PARITY_BIT) & 1U) == reg_parity(response) &&
+           ((response >> REG_ADDR_SHIFT) & 0x0FU) == addr;
+}
+
+/**
+ * @brief Read up to HAL_SPI_REG_MERGE_MAX registers from the device
+ * @details count reads and one trailing frame (another read of the last
+ *          register) go out as one transfer. The response to the first frame
+ *          belongs to whatever came before and is dropped.
+ */
+static hal_status_t reg_read_frames(hal_spi_reg_dev_t* reg,
+                                    const uint8_t* addrs,
+                                    uint8_t* values,
+                                    uint16_t count)
+{
+    uint8_t tx[(HAL_SPI_REG_MERGE_MAX + 1U) * 2U];
+    uint8_t rx[(HAL_SPI_REG_MERGE_MAX + 1U) * 2U];
+    uint16_t frames = (uint16_t)(count + 1U);
+    
+    for (uint16_t i = 0; i < frames; i++) {
+        uint16_t frame = hal_spi_reg_frame(HAL_SPI_REG_CMD_READ, addrs[(i < count) ? i : count - 1U], 0U);
+        tx[2U * i] = (uint8_t)(frame >> 8);
+        tx[2U * i + 1U] = (uint8_t)(frame & 0xFFU);
+    }
+    
+    hal_status_t status = hal_spi_transfer(reg->device, tx, rx, (uint16_t)(frames * 2U), reg->timeout_ms);
+    reg->frames += frames;
+    if (status != HAL_OK) {
+        return status;
+    }
+    
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t response = (uint16_t)((rx[2U * (i + 1U)] << 8) | rx[2U * (i + 1U) + 1U]);
+        if (!reg_response_valid(response, addrs[i])) {
+            return HAL_ERROR;
+        }
+        values[i] = (uint8_t)((response >> REG_DATA_SHIFT) & 0xFFU);
+    }
+    return HAL_OK;
+}
+
+/*============================================================================*/
+/* Public API Implementation                                                  */
+/*============================================================================*/
+
+/**
+ * @brief Build a frame
+ */
+uint16_t hal_spi_reg_frame(uint8_t cmd, uint8_t addr, uint8_t data)
+{
+    uint16_t frame = (uint16_t)(((uint16_t)(cmd & 0x03U) << REG_CMD_SHIFT) |
+                                ((uint16_t)(addr & 0x0FU) << REG_ADDR_SHIFT) |
+                                ((uint16_t)data << REG_DATA_SHIFT));
+    
+    return (uint16_t)(frame | (reg_parity(frame) << REG_PARITY_BIT));
+}
+
+/**
+ * @brief Set up a register device
+ */
+hal_status_t hal_spi_reg_init(hal_spi_reg_dev_t* reg,
+                              hal_spi_device_t device,
+                              uint16_t static_mask,
+                              uint32_t timeout_ms)
+{
+    if (reg == NULL || (uint32_t)device >= HAL_SPI_MAX_INTERFACES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    reg->device = device;
+    reg->timeout_ms = timeout_ms;
+    reg->static_mask = static_mask;
+    reg->valid_mask = 0;
+    reg->frames = 0;
+    reg->cache_hits = 0;
+    
+    return HAL_OK;
+}
+
+/**
+ * @brief Read one register
+ */
+hal_status_t hal_spi_reg_read(hal_spi_reg_dev_t* reg, uint8_t addr, uint8_t* value)
+{
+    return hal_spi_reg_read_multi(reg, &addr, value, 1);
+}
+
+/**
+ * @brief Read several registers with one transfer
+ */
+hal_status_t hal_spi_reg_read_multi(hal_spi_reg_dev_t* reg,
+                                    const uint8_t* addrs,
+                                    uint8_t* values,
+                                    uint16_t count)
+{
+    if (reg == NULL || addrs == NULL || values == NULL || count == 0) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    uint8_t pending_addrs[HAL_SPI_REG_MERGE_MAX];
+    uint16_t pending_index[HAL_SPI_REG_MERGE_MAX];
+    uint8_t pending_values[HAL_SPI_REG_MERGE_MAX];
+    uint16_t pending = 0;
+    
+    for (uint16_t i = 0; i < count; i++) {
+        uint8_t addr = addrs[i];
+        
+        if (addr >= HAL_SPI_REG_COUNT) {
+            return HAL_ERROR_INVALID_PARAM;
+        }
+        
+        if ((reg->valid_mask & (1U << addr)) != 0U) {
+            values[i] = reg->shadow[addr];
+            reg->cache_hits++;
+        } else {
+            pending_addrs[pending] = addr;
+            pending_index[pending] = i;
+            pending++;
+        }
+        
+        /* Go to the device once the staging is full or the list ends */
+        if (pending == HAL_SPI_REG_MERGE_MAX || (i + 1U == count && pending > 0U)) {
+            hal_status_t status = reg_read_frames(reg, pending_addrs, pending_values, pending);
+            if (status != HAL_OK) {
+                return status;
+            }
+            
+            for (uint16_t j = 0; j < pending; j++) {
+                uint8_t read_addr = pending_addrs[j];
+                
+                values[pending_index[j]] = pending_values[j];
+                if ((reg->static_mask & (1U << read_addr)) != 0U) {
+                    reg->shadow[read_addr] = pending_values[j];
+                    reg->valid_mask |= (uint16_t)(1U << read_addr);
+                }
+            }
+            pending = 0;
+        }
+    }
+    
+    return HAL_OK;
+}
+
+/**
+ * @brief Write one register
+ */
+hal_status_t hal_spi_reg_write(hal_spi_reg_dev_t* reg, uint8_t addr, uint8_t value)
+{
+    if (reg == NULL || addr >= HAL_SPI_REG_COUNT) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    uint16_t frame = hal_spi_reg_frame(HAL_SPI_REG_CMD_WRITE, addr, value);
+    uint8_t tx[2] = {(uint8_t)(frame >> 8), (uint8_t)(frame & 0xFFU)};
+    uint8_t rx[2];
+    
+    /* The response belongs to the frame before: nothing to check */
+    hal_status_t status = hal_spi_transfer(reg->device, tx, rx, 2, reg->timeout_ms);
+    reg->frames++;
+    
+    /* Write-through; after a failed write the register is unknown */
+    if (status == HAL_OK && (reg->static_mask & (1U << addr)) != 0U) {
+        reg->shadow[addr] = value;
+        reg->valid_mask |= (uint16_t)(1U << addr);
+    } else {
+        reg->valid_mask &= (uint16_t)~(1U << addr);
+    }
+    
+    return status;
+}
+
+/**
+ * @brief Forget the shadow
+ */
+void hal_spi_reg_invalidate(hal_spi_reg_dev_t* reg)
+{
+    if (reg != NULL) {
+        reg->valid_mask = 0;
+    }
+}
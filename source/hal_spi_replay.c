@@ -0,0 +1,993 @@
+/**
+ * @file    hal_spi_replay.c
+ * @brief   SPI HAL Replay Implementation
+ * @details Concrete implementation that answers every operation from a trace
+ *          file written by hal_spi_capture.c, without a server or hardware.
+ * @note    The file is memory-mapped read-only, RX data is copied straight out
+ *          of the mapping. Each device has its own cursor and takes the next
+ *          record of that device, so the interleaving of devices need not match
+ *          the recording. An operation that differs from its record (another
+ *          TX payload, length or configuration) consumes the record and fails
+ *          with HAL_ERROR; a record of another type stays for the operation it
+ *          belongs to. Either way the mismatch is counted and logged.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#include "yolpiya.h"
+#include "hal_spi.h"
+#include "hal_spi_backend.h"
+#include "hal_spi_capture.h"
+#include "hal_atomic.h"
+#include "hal_os.h"
+#include "hal_log.h"
+#include "hal_trace.h"
+#include <stdlib.h>
+
+/* Platform-specific file mapping includes */
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+/*============================================================================*/
+/* Private Definitions                                                        */
+/*============================================================================*/
+
+#define REPLAY_ALIGN(n)     (((n) + (HAL_SPI_CAPTURE_ALIGN - 1U)) & ~(HAL_SPI_CAPTURE_ALIGN - 1U))
+
+/**
+ * @brief Mapped trace file
+ */
+typedef struct {
+    const uint8_t*      base;           /**< NULL while no file is mapped */
+    size_t              size;           /**< Mapped bytes */
+    size_t              end;            /**< End of the last complete record */
+    uint32_t            records;
+    volatile uint32_t   replayed;
+    volatile uint32_t   mismatches;
+#ifdef _WIN32
+    HANDLE              file;
+    HANDLE              mapping;
+#endif
+    
+    hal_mutex_t         lock;           /**< Serializes open/close/rewind and the lazy open */
+} replay_file_t;
+
+/**
+ * @brief Replayed SPI device state
+ */
+typedef struct {
+    bool                is_initialized; /**< As recorded */
+    hal_spi_config_t    config;
+    hal_spi_status_t    status;
+    size_t              cursor;         /**< Where the search for the next record of the device starts */
+    
+    /* Pending asynchronous completion (delivered from poll) */
+    hal_spi_callback_t  async_callback; /**< NULL if nothing pending */
+    void*               async_user_data;
+    hal_status_t        async_result;   /**< Recorded result of the transfer */
+    uint16_t            async_length;
+    uint32_t            async_start_us;
+    
+    /* Continuous receive (one recorded half per poll) */
+    hal_spi_stream_callback_t stream_callback;  /**< NULL if not streaming */
+    void*               stream_user_data;
+    uint8_t*            stream_buffer;
+    uint16_t            stream_half;
+    uint8_t             stream_next;
+    uint32_t            stream_start_us;
+} replay_spi_device_t;
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static replay_file_t g_replay = {
+    .lock = HAL_MUTEX_INIT
+};
+static replay_spi_device_t g_replay_devices[HAL_SPI_MAX_INTERFACES];
+
+/*============================================================================*/
+/* Private Helper Functions                                                   */
+/*============================================================================*/
+
+/**
+ * @brief Unmap the trace file
+ * @note Caller holds g_replay.lock
+ */
+static void replay_unmap(void)
+{
+    if (g_replay.base != NULL) {
+#ifdef _WIN32
+        UnmapViewOfFile(g_replay.base);
+        CloseHandle(g_replay.mapping);
+        CloseHandle(g_replay.file);
+        g_replay.mapping = NULL;
+        g_replay.file = NULL;
+#else
+        munmap((void*)g_replay.base, g_replay.size);
+#endif
+    }
+    g_replay.base = NULL;
+    g_replay.size = 0;
+    g_replay.end = 0;
+    g_replay.records = 0;
+}
+
+/**
+ * @brief Map a trace file and index its records
+ * @note Caller holds g_replay.lock
+ */
+static hal_status_t replay_map(const char* path)
+{
+    const uint8_t* base;
+    size_t size;
+    
+#ifdef _WIN32
+    LARGE_INTEGER file_size;
+    
+    g_replay.file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, 
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (g_replay.file == INVALID_HANDLE_VALUE) {
+        g_replay.file = NULL;
+        HAL_LOG_ERROR("[REPLAY-SPI] ERROR: Cannot open %s\n", path);
+        return HAL_ERROR;
+    }
+    if (!GetFileSizeEx(g_replay.file, &file_size) ||
+        (uint64_t)file_size.QuadPart < sizeof(hal_spi_capture_file_t)) {
+        CloseHandle(g_replay.file);
+        g_replay.file = NULL;
+        HAL_LOG_ERROR("[REPLAY-SPI] ERROR: %s is no trace file\n", path);
+        return HAL_ERROR;
+    }
+    size = (size_t)file_size.QuadPart;
+    
+    g_replay.mapping = CreateFileMappingA(g_replay.file, NULL, PAGE_READONLY, 0, 0, NULL);
+    base = (g_replay.mapping != NULL) ?
+           (const uint8_t*)MapViewOfFile(g_replay.mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (base == NULL) {
+        if (g_replay.mapping != NULL) {
+            CloseHandle(g_replay.mapping);
+        }
+        CloseHandle(g_replay.file);
+        g_replay.mapping = NULL;
+        g_replay.file = NULL;
+        HAL_LOG_ERROR("[REPLAY-SPI] ERROR: Failed to map %s\n", path);
+        return HAL_ERROR;
+    }
+#else
+    struct stat info;
+    
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        HAL_LOG_ERROR("[REPLAY-SPI] ERROR: Cannot open %s\n", path);
+        return HAL_ERROR;
+    }
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(hal_spi_capture_file_t)) {
+        close(fd);
+        HAL_LOG_ERROR("[REPLAY-SPI] ERROR: %s is no trace file\n", path);
+        return HAL_ERROR;
+    }
+    size = (size_t)info.st_size;
+    
+    void* mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        HAL_LOG_ERROR("[REPLAY-SPI] ERROR: Failed to map %s\n", path);
+        return HAL_ERROR;
+    }
+    base = (const uint8_t*)mapping;
+#endif
+    
+    g_replay.base = base;
+    g_replay.size = size;
+    
+    const hal_spi_capture_file_t* header = (const hal_spi_capture_file_t*)base;
+    if (header->magic != HAL_SPI_CAPTURE_MAGIC || header->version != HAL_SPI_CAPTURE_VERSION ||
+        header->header_size < sizeof(hal_spi_capture_file_t) || header->header_size > size ||
+        (header->header_size % HAL_SPI_CAPTURE_ALIGN) != 0U) {
+        replay_unmap();
+        HAL_LOG_ERROR("[REPLAY-SPI] ERROR: %s is no trace file (version %u supported)\n", 
+                      path, HAL_SPI_CAPTURE_VERSION);
+        return HAL_ERROR;
+    }
+    
+    /* Count the records; a capture that was not stopped ends with a partial one */
+    size_t offset = header->header_size;
+    while (size - offset >= sizeof(hal_spi_rec_header_t)) {
+        const hal_spi_rec_header_t* rec = (const hal_spi_rec_header_t*)(base + offset);
+        uint64_t record_size = REPLAY_ALIGN((uint64_t)sizeof(hal_spi_rec_header_t) +
+                                            rec->tx_length + rec->rx_length);
+        
+        if (record_size > size - offset) {
+            break;
+        }
+        offset += (size_t)record_size;
+        g_replay.records++;
+    }
+    g_replay.end = offset;
+    
+    if (offset != size) {
+        HAL_LOG_WARN("[REPLAY-SPI] WARNING: %s ends with an incomplete record, ignored\n", path);
+    }
+    
+    for (uint8_t i = 0; i < HAL_SPI_MAX_INTERFACES; i++) {
+        g_replay_devices[i].cursor = header->header_size;
+    }
+    g_replay.replayed = 0;
+    g_replay.mismatches = 0;
+    
+    HAL_LOG_INFO("[REPLAY-SPI] Mapped %s (%u records)\n", path, g_replay.records);
+    
+    return HAL_OK;
+}
+
+/**
+ * @brief Check that no device is initialized or streaming
+ * @note Caller holds g_replay.lock
+ */
+static bool replay_devices_idle(void)
+{
+    for (uint8_t i = 0; i < HAL_SPI_MAX_INTERFACES; i++) {
+        if (g_replay_devices[i].is_initialized || g_replay_devices[i].stream_callback != NULL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Map $HAL_SPI_REPLAY_FILE or the default file if nothing is mapped yet
+ */
+static hal_status_t replay_open_default(void)
+{
+    hal_status_t status = HAL_OK;
+    
+    hal_mutex_lock(&g_replay.lock);
+    if (g_replay.base == NULL) {
+        const char* path = getenv("HAL_SPI_REPLAY_FILE");
+        status = replay_map((path != NULL) ? path : HAL_SPI_CAPTURE_DEFAULT_FILE);
+    }
+    hal_mutex_unlock(&g_replay.lock);
+    
+    return status;
+}
+
+/**
+ * @brief Record after a record header
+ */
+static const hal_spi_rec_header_t* replay_skip(const hal_spi_rec_header_t* rec)
+{
+    return (const hal_spi_rec_header_t*)((const uint8_t*)rec +
+           REPLAY_ALIGN(sizeof(hal_spi_rec_header_t) + rec->tx_length + rec->rx_length));
+}
+
+/**
+ * @brief Find the next record of a device
+ * @details Moves the cursor of the device up to that record.
+ * @return The record, NULL at the end of the file
+ */
+static const hal_spi_rec_header_t* replay_peek(hal_spi_device_t device)
+{
+    replay_spi_device_t* dev = &g_replay_devices[device];
+    
+    if (g_replay.base == NULL) {
+        return NULL;
+    }
+    
+    while (dev->cursor < g_replay.end) {
+        const hal_spi_rec_header_t* rec = (const hal_spi_rec_header_t*)(g_replay.base + dev->cursor);
+        
+        if (rec->device == (uint8_t)device) {
+            return rec;
+        }
+        dev->cursor += REPLAY_ALIGN(sizeof(hal_spi_rec_header_t) + rec->tx_length + rec->rx_length);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Consume the record returned by replay_peek()
+ */
+static void replay_consume(hal_spi_device_t device, const hal_spi_rec_header_t* rec)
+{
+    g_replay_devices[device].cursor = (size_t)((const uint8_t*)replay_skip(rec) - g_replay.base);
+}
+
+/**
+ * @brief Count and log an operation that does not match the recording
+ * @param what What differs: "type", "length", "payload" or "segments"
+ */
+static hal_status_t replay_mismatch(hal_spi_device_t device, 
+                                    hal_spi_rec_type_t type, 
+                                    const hal_spi_rec_header_t* rec, 
+                                    const char* what)
+{
+    (void)device;
+    (void)type;
+    (void)what;
+    (void)HAL_ATOMIC_FETCH_ADD_U32(&g_replay.mismatches, 1U);
+    
+    if (rec == NULL) {
+        HAL_LOG_WARN("[REPLAY-SPI] WARNING: Device %d: operation 0x%02X after the end of the recording\n", 
+                     device, type);
+        return HAL_ERROR_NO_DATA;
+    }
+    HAL_LOG_WARN("[REPLAY-SPI] WARNING: Device %d: operation 0x%02X differs from record 0x%02X at %lu us in %s\n", 
+                 device, type, rec->type, (unsigned long)rec->timestamp_us, what);
+    return HAL_ERROR;
+}
+
+/**
+ * @brief Answer an operation with one TX and one RX buffer from its record
+ * @details TX (NULL: not compared) must equal the TX section. RX receives the
+ *          RX section, which holds rx_length bytes if the recorded result is
+ *          HAL_OK and none otherwise.
+ * @param rec Receives the record, NULL if there was none to consume
+ * @return Recorded result, or HAL_ERROR / HAL_ERROR_NO_DATA on a mismatch
+ */
+static hal_status_t replay_serve(hal_spi_device_t device, 
+                                 hal_spi_rec_type_t type, 
+                                 const void* tx, 
+                                 uint32_t tx_length, 
+                                 uint8_t* rx, 
+                                 uint32_t rx_length, 
+                                 const hal_spi_rec_header_t** rec_out)
+{
+    const hal_spi_rec_header_t* rec = replay_peek(device);
+    const uint8_t* payload;
+    
+    *rec_out = NULL;
+    
+    if (rec == NULL || rec->type != (uint8_t)type) {
+        return replay_mismatch(device, type, rec, "type");
+    }
+    
+    replay_consume(device, rec);
+    *rec_out = rec;
+    payload = (const uint8_t*)(rec + 1);
+    
+    bool rx_expected = (rec->status == HAL_OK) && (rx_length > 0U);
+    if (rec->tx_length != tx_length || rec->rx_length != (rx_expected ? rx_length : 0U)) {
+        return replay_mismatch(device, type, rec, "length");
+    }
+    if (tx != NULL && memcmp(tx, payload, tx_length) != 0) {
+        return replay_mismatch(device, type, rec, "payload");
+    }
+    
+    if (rx_expected && rx != NULL) {
+        memcpy(rx, payload + tx_length, rx_length);
+    }
+    
+    (void)HAL_ATOMIC_FETCH_ADD_U32(&g_replay.replayed, 1U);
+    return (hal_status_t)rec->status;
+}
+
+/**
+ * @brief Answer a batch or scatter-gather frame from its BATCH or SG record
+ * @param rec Record of that type, already peeked
+ */
+static hal_status_t replay_serve_list(hal_spi_device_t device, 
+                                      hal_spi_rec_type_t type, 
+                                      const hal_spi_rec_header_t* rec, 
+                                      const hal_spi_xfer_t* xfers, 
+                                      uint16_t count)
+{
+    const hal_spi_rec_seg_t* segs = (const hal_spi_rec_seg_t*)(rec + 1);
+    bool match = (rec->count == count);
+    uint32_t tx_length = (uint32_t)count * sizeof(hal_spi_rec_seg_t);
+    uint32_t rx_length = 0;
+    
+    replay_consume(device, rec);
+    
+    for (uint16_t i = 0; i < count && match; i++) {
+        uint8_t seg_type = (uint8_t)((xfers[i].rx_data == NULL) ? HAL_SPI_REC_SEND :
+                                     (xfers[i].tx_data == NULL) ? HAL_SPI_REC_RECEIVE : HAL_SPI_REC_TRANSFER);
+        
+        match = (segs[i].type == seg_type) && (segs[i].length == xfers[i].length);
+        tx_length += (xfers[i].tx_data != NULL) ? xfers[i].length : 0U;
+        rx_length += (xfers[i].rx_data != NULL && rec->status == HAL_OK) ? xfers[i].length : 0U;
+    }
+    
+    if (!match) {
+        return replay_mismatch(device, type, rec, "segments");
+    }
+    if (rec->tx_length != tx_length || rec->rx_length != rx_length) {
+        return replay_mismatch(device, type, rec, "length");
+    }
+    
+    /* TX data of all segments, then RX data of all segments */
+    const uint8_t* data = (const uint8_t*)&segs[count];
+    for (uint16_t i = 0; i < count; i++) {
+        if (xfers[i].tx_data != NULL) {
+            if (memcmp(xfers[i].tx_data, data, xfers[i].length) != 0) {
+                return replay_mismatch(device, type, rec, "payload");
+            }
+            data += xfers[i].length;
+        }
+    }
+    for (uint16_t i = 0; i < count && rec->status == HAL_OK; i++) {
+        if (xfers[i].rx_data != NULL) {
+            memcpy(xfers[i].rx_data, data, xfers[i].length);
+            data += xfers[i].length;
+        }
+    }
+    
+    (void)HAL_ATOMIC_FETCH_ADD_U32(&g_replay.replayed, 1U);
+    return (hal_status_t)rec->status;
+}
+
+/**
+ * @brief Answer a list that was recorded as single operations
+ * @details The capture sees a batch or scatter-gather frame as single
+ *          transfers, sends and receives when its backend lacked the operation
+ *          and the bridge fell back to one call per descriptor.
+ */
+static hal_status_t replay_serve_each(hal_spi_device_t device, 
+                                      const hal_spi_xfer_t* xfers, 
+                                      uint16_t count)
+{
+    const hal_spi_rec_header_t* rec;
+    hal_status_t status = HAL_OK;
+    
+    for (uint16_t i = 0; i < count && status == HAL_OK; i++) {
+        const hal_spi_xfer_t* xfer = &xfers[i];
+        
+        if (xfer->tx_data != NULL && xfer->rx_data != NULL) {
+            status = replay_serve(device, HAL_SPI_REC_TRANSFER, xfer->tx_data, xfer->length, 
+                                  xfer->rx_data, xfer->length, &rec);
+        } else if (xfer->tx_data != NULL) {
+            status = replay_serve(device, HAL_SPI_REC_SEND, xfer->tx_data, xfer->length, NULL, 0, &rec);
+        } else {
+            status = replay_serve(device, HAL_SPI_REC_RECEIVE, NULL, 0, xfer->rx_data, xfer->length, &rec);
+        }
+    }
+    
+    return status;
+}
+
+/**
+ * @brief Answer an INIT or SET_CONFIG from its record
+ */
+static hal_status_t replay_serve_config(hal_spi_device_t device, 
+                                        hal_spi_rec_type_t type, 
+                                        const hal_spi_config_t* config)
+{
+    const hal_spi_rec_header_t* rec;
+    hal_spi_rec_config_t expected;
+    
+    expected.baudrate = config->baudrate;
+    expected.mode = (uint8_t)config->mode;
+    expected.bit_order = (uint8_t)config->bit_order;
+    expected.data_bits = config->data_bits;
+    expected.reserved = 0;
+    
+    return replay_serve(device, type, &expected, sizeof(expected), NULL, 0, &rec);
+}
+
+/*============================================================================*/
+/* SPI Operations Implementation (Replay)                                     */
+/*============================================================================*/
+
+static hal_status_t replay_spi_init(hal_spi_device_t device, const hal_spi_config_t* config)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || config == NULL)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    if (replay_open_default() != HAL_OK) {
+        return HAL_ERROR;
+    }
+    
+    replay_spi_device_t* dev = &g_replay_devices[device];
+    hal_status_t status = replay_serve_config(device, HAL_SPI_REC_INIT, config);
+    
+    if (status == HAL_OK) {
+        dev->config = *config;
+        dev->status.state = HAL_STATE_READY;
+        dev->status.is_busy = false;
+        hal_spi_stats_reset(device, &dev->status);
+        dev->is_initialized = true;
+        
+        HAL_LOG_INFO("[REPLAY-SPI] Init device %d: %lu Hz, mode %d, %d-bit\n", 
+                     device, (unsigned long)config->baudrate, config->mode, config->data_bits);
+    }
+    
+    return status;
+}
+
+static hal_status_t replay_spi_deinit(hal_spi_device_t device)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    replay_spi_device_t* dev = &g_replay_devices[device];
+    const hal_spi_rec_header_t* rec;
+    hal_status_t status = replay_serve(device, HAL_SPI_REC_DEINIT, NULL, 0, NULL, 0, &rec);
+    
+    if (status == HAL_OK) {
+        HAL_LOG_INFO("[REPLAY-SPI] Deinit device %d (TX: %u, RX: %u, Errors: %u)\n", 
+                     device, dev->status.tx_count, dev->status.rx_count, dev->status.error_count);
+        
+        size_t cursor = dev->cursor;
+        memset(dev, 0, sizeof(replay_spi_device_t));
+        dev->cursor = cursor;
+    }
+    
+    return status;
+}
+
+static hal_status_t replay_spi_transfer(hal_spi_device_t device, 
+                                        const uint8_t* tx_data, 
+                                        uint8_t* rx_data, 
+                                        uint16_t length, 
+                                        uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    replay_spi_device_t* dev = &g_replay_devices[device];
+    const hal_spi_rec_header_t* rec;
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;  /* Replayed transfers take no bus time */
+    
+    hal_status_t status = replay_serve(device, HAL_SPI_REC_TRANSFER, tx_data, length, rx_data, length, &rec);
+    
+    if (dev->is_initialized) {
+        hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_TRANSFER, status, 
+                             (status == HAL_OK) ? length : 0U, (status == HAL_OK) ? length : 0U, start_us);
+    }
+    HAL_TRACE(HAL_TRACE_EV_TRANSFER, device, length);
+    
+    return status;
+}
+
+static hal_status_t replay_spi_send(hal_spi_device_t device, 
+                                    const uint8_t* data, 
+                                    uint16_t length, 
+                                    uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    replay_spi_device_t* dev = &g_replay_devices[device];
+    const hal_spi_rec_header_t* rec;
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;  /* Replayed transfers take no bus time */
+    
+    hal_status_t status = replay_serve(device, HAL_SPI_REC_SEND, data, length, NULL, 0, &rec);
+    
+    if (dev->is_initialized) {
+        hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_SEND, status, 
+                             (status == HAL_OK) ? length : 0U, 0, start_us);
+    }
+    HAL_TRACE(HAL_TRACE_EV_SEND, device, length);
+    
+    return status;
+}
+
+static hal_status_t replay_spi_receive(hal_spi_device_t device, 
+                                       uint8_t* data, 
+                                       uint16_t length, 
+                                       uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    replay_spi_device_t* dev = &g_replay_devices[device];
+    const hal_spi_rec_header_t* rec;
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;  /* Replayed transfers take no bus time */
+    
+    hal_status_t status = replay_serve(device, HAL_SPI_REC_RECEIVE, NULL, 0, data, length, &rec);
+    
+    if (dev->is_initialized) {
+        hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_RECEIVE, status, 
+                             0, (status == HAL_OK) ? length : 0U, start_us);
+    }
+    HAL_TRACE(HAL_TRACE_EV_RECEIVE, device, length);
+    
+    return status;
+}
+
+static hal_status_t replay_spi_set_config(hal_spi_device_t device, 
+                                          const hal_spi_config_t* config)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || config == NULL)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    replay_spi_device_t* dev = &g_replay_devices[device];
+    hal_status_t status = replay_serve_config(device, HAL_SPI_REC_SET_CONFIG, config);
+    
+    if (status == HAL_OK) {
+        dev->config = *config;
+        HAL_LOG_INFO("[REPLAY-SPI] Reconfigured device %d: %lu Hz, mode %d\n", 
+                     device, (unsigned long)config->baudrate, config->mode);
+    }
+    
+    return status;
+}
+
+static hal_status_t replay_spi_get_status(hal_spi_device_t device, 
+                                          hal_spi_status_t* status)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || status == NULL)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    replay_spi_device_t* dev = &g_replay_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    *status = dev->status;
+    return HAL_OK;
+}
+
+static hal_status_t replay_spi_transfer_async(hal_spi_device_t device, 
+                                              const uint8_t* tx_data, 
+                                              uint8_t* rx_data, 
+                                              uint16_t length, 
+                                              uint32_t timeout_ms, 
+                                              hal_spi_callback_t callback, 
+                                              void* user_data)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || callback == NULL)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    replay_spi_device_t* dev = &g_replay_devices[device];
+    const hal_spi_rec_header_t* rec;
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;  /* Replayed transfers take no bus time */
+    
+    hal_status_t status = replay_serve(device, HAL_SPI_REC_TRANSFER, tx_data, length, rx_data, length, &rec);
+    
+    /* Recorded without the flag and failed: rejected at submission */
+    if (rec == NULL || (status != HAL_OK && (rec->flags & HAL_SPI_REC_FLAG_ASYNC) == 0U)) {
+        return status;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    
+    /* Data has moved, the recorded result is delivered from replay_spi_poll() */
+    dev->async_user_data = user_data;
+    dev->async_result = status;
+    dev->async_length = length;
+    dev->async_start_us = start_us;
+    dev->async_callback = callback;
+    
+    return HAL_OK;
+}
+
+/**
+ * @brief Hand out the next recorded stream half
+ */
+static hal_status_t replay_stream_poll(hal_spi_device_t device, replay_spi_device_t* dev)
+{
+    hal_spi_stream_callback_t callback = dev->stream_callback;
+    uint16_t length = dev->stream_half;
+    uint8_t* data = dev->stream_buffer + (dev->stream_next * length);
+    const hal_spi_rec_header_t* rec;
+    
+    hal_status_t status = replay_serve(device, HAL_SPI_REC_STREAM, NULL, 0, data, length, &rec);
+    
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_RECEIVE, status, 
+                         0, (status == HAL_OK) ? length : 0U, dev->stream_start_us);
+    HAL_TRACE(HAL_TRACE_EV_RECEIVE, device, length);
+    
+    if (status != HAL_OK) {
+        /* Recorded error, or the recording has no more halves: the stream ends */
+        dev->stream_callback = NULL;
+        dev->stream_buffer = NULL;
+        hal_spi_release(&dev->status);
+    } else {
+        dev->stream_next ^= 1U;
+        dev->stream_start_us = hal_time_now_us();
+    }
+    
+    callback(device, status, data, length, dev->stream_user_data);
+    
+    return (dev->stream_callback != NULL) ? HAL_ERROR_BUSY : HAL_OK;
+}
+
+static hal_status_t replay_spi_poll(hal_spi_device_t device)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    replay_spi_device_t* dev = &g_replay_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (dev->stream_callback != NULL) {
+        return replay_stream_poll(device, dev);
+    }
+    
+    if (dev->async_callback == NULL) {
+        return HAL_OK;
+    }
+    
+    /* Release the device before the callback so it can submit the next transfer */
+    hal_spi_callback_t callback = dev->async_callback;
+    void* user_data = dev->async_user_data;
+    hal_status_t result = dev->async_result;
+    uint16_t length = (result == HAL_OK) ? dev->async_length : 0U;
+    
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_TRANSFER, result, 
+                         length, length, dev->async_start_us);
+    dev->async_callback = NULL;
+    hal_spi_release(&dev->status);
+    
+    callback(device, result, user_data);
+    
+    return HAL_OK;
+}
+
+static hal_status_t replay_spi_submit_batch(hal_spi_device_t device, 
+                                            const hal_spi_xfer_t* xfers, 
+                                            uint16_t count, 
+                                            uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    replay_spi_device_t* dev = &g_replay_devices[device];
+    const hal_spi_rec_header_t* rec = replay_peek(device);
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;  /* Replayed transfers take no bus time */
+    
+    hal_status_t status = (rec != NULL && rec->type == (uint8_t)HAL_SPI_REC_BATCH) ?
+                          replay_serve_list(device, HAL_SPI_REC_BATCH, rec, xfers, count) :
+                          replay_serve_each(device, xfers, count);
+    
+    if (dev->is_initialized) {
+        uint32_t frame_bytes;
+        uint32_t tx_bytes;
+        uint32_t rx_bytes;
+        (void)hal_spi_sg_classify(xfers, count, &frame_bytes, &tx_bytes, &rx_bytes);
+        hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_BATCH, status, 
+                             tx_bytes, (status == HAL_OK) ? rx_bytes : 0U, start_us);
+    }
+    HAL_TRACE(HAL_TRACE_EV_BATCH, device, count);
+    
+    return status;
+}
+
+static hal_status_t replay_spi_transfer_sg(hal_spi_device_t device, 
+                                           const hal_spi_xfer_t* segs, 
+                                           uint16_t count, 
+                                           uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    replay_spi_device_t* dev = &g_replay_devices[device];
+    const hal_spi_rec_header_t* rec = replay_peek(device);
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;  /* Replayed transfers take no bus time */
+    
+    uint32_t frame_bytes;
+    uint32_t tx_bytes;
+    uint32_t rx_bytes;
+    hal_spi_op_t op = hal_spi_sg_classify(segs, count, &frame_bytes, &tx_bytes, &rx_bytes);
+    
+    hal_status_t status = (rec != NULL && rec->type == (uint8_t)HAL_SPI_REC_SG) ?
+                          replay_serve_list(device, HAL_SPI_REC_SG, rec, segs, count) :
+                          replay_serve_each(device, segs, count);
+    
+    if (dev->is_initialized) {
+        hal_spi_stats_record(device, &dev->status, op, status, 
+                             tx_bytes, (status == HAL_OK) ? rx_bytes : 0U, start_us);
+    }
+    HAL_TRACE(HAL_TRACE_EV_FROM_OP(op), device, frame_bytes);
+    
+    return status;
+}
+
+static hal_status_t replay_spi_transfer_large(hal_spi_device_t device, 
+                                              const uint8_t* tx_data, 
+                                              uint8_t* rx_data, 
+                                              uint32_t length, 
+                                              uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    replay_spi_device_t* dev = &g_replay_devices[device];
+    const hal_spi_rec_header_t* rec;
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;  /* Replayed transfers take no bus time */
+    
+    /* A large frame is recorded like any other frame: 32-bit sections */
+    hal_spi_op_t op = hal_spi_large_classify(tx_data, rx_data);
+    hal_spi_rec_type_t type = (op == HAL_SPI_OP_SEND) ? HAL_SPI_REC_SEND :
+                              (op == HAL_SPI_OP_RECEIVE) ? HAL_SPI_REC_RECEIVE : HAL_SPI_REC_TRANSFER;
+    hal_status_t status = replay_serve(device, type, 
+                                       tx_data, (tx_data != NULL) ? length : 0U, 
+                                       rx_data, (rx_data != NULL) ? length : 0U, 
+                                       &rec);
+    
+    if (dev->is_initialized) {
+        hal_spi_stats_record(device, &dev->status, op, status, 
+                             (status == HAL_OK && tx_data != NULL) ? length : 0U, 
+                             (status == HAL_OK && rx_data != NULL) ? length : 0U, 
+                             start_us);
+    }
+    HAL_TRACE(HAL_TRACE_EV_FROM_OP(op), device, length);
+    
+    return status;
+}
+
+static hal_status_t replay_spi_stream_start(hal_spi_device_t device, 
+                                            uint8_t* buffer, 
+                                            uint16_t length, 
+                                            hal_spi_stream_callback_t callback, 
+                                            void* user_data)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || callback == NULL)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    replay_spi_device_t* dev = &g_replay_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    /* The device stays claimed until replay_spi_stream_stop() */
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    
+    dev->stream_user_data = user_data;
+    dev->stream_buffer = buffer;
+    dev->stream_half = length / 2U;
+    dev->stream_next = 0;
+    dev->stream_start_us = hal_time_now_us();
+    dev->stream_callback = callback;
+    
+    return HAL_OK;
+}
+
+static hal_status_t replay_spi_stream_stop(hal_spi_device_t device)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    replay_spi_device_t* dev = &g_replay_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (dev->stream_callback == NULL) {
+        return HAL_OK;
+    }
+    
+    dev->stream_callback = NULL;
+    dev->stream_buffer = NULL;
+    hal_spi_release(&dev->status);
+    
+    return HAL_OK;
+}
+
+/*============================================================================*/
+/* Replay Control (hal_spi_capture.h)                                         */
+/*============================================================================*/
+
+hal_status_t hal_spi_replay_open(const char* path)
+{
+    if (path == NULL) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    hal_mutex_lock(&g_replay.lock);
+    
+    if (!replay_devices_idle()) {
+        hal_mutex_unlock(&g_replay.lock);
+        return HAL_ERROR_BUSY;
+    }
+    
+    replay_unmap();
+    hal_status_t status = replay_map(path);
+    
+    hal_mutex_unlock(&g_replay.lock);
+    
+    return status;
+}
+
+void hal_spi_replay_close(void)
+{
+    hal_mutex_lock(&g_replay.lock);
+    replay_unmap();
+    hal_mutex_unlock(&g_replay.lock);
+}
+
+hal_status_t hal_spi_replay_rewind(void)
+{
+    hal_status_t status = HAL_OK;
+    
+    hal_mutex_lock(&g_replay.lock);
+    
+    if (g_replay.base == NULL) {
+        status = HAL_ERROR_NOT_INIT;
+    } else if (!replay_devices_idle()) {
+        status = HAL_ERROR_BUSY;
+    } else {
+        size_t first = ((const hal_spi_capture_file_t*)g_replay.base)->header_size;
+        
+        for (uint8_t i = 0; i < HAL_SPI_MAX_INTERFACES; i++) {
+            g_replay_devices[i].cursor = first;
+        }
+        g_replay.replayed = 0;
+        g_replay.mismatches = 0;
+    }
+    
+    hal_mutex_unlock(&g_replay.lock);
+    
+    return status;
+}
+
+hal_status_t hal_spi_replay_get_info(hal_spi_replay_info_t* info)
+{
+    if (info == NULL) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    hal_mutex_lock(&g_replay.lock);
+    
+    if (g_replay.base == NULL) {
+        hal_mutex_unlock(&g_replay.lock);
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    info->records = g_replay.records;
+    info->replayed = HAL_ATOMIC_LOAD_U32(&g_replay.replayed);
+    info->mismatches = HAL_ATOMIC_LOAD_U32(&g_replay.mismatches);
+    
+    hal_mutex_unlock(&g_replay.lock);
+    
+    return HAL_OK;
+}
+
+/*============================================================================*/
+/* Public Operations Structure (Export)                                       */
+/*============================================================================*/
+
+const hal_spi_ops_t hal_spi_replay_ops = {
+    .init           = replay_spi_init,
+    .deinit         = replay_spi_deinit,
+    .transfer       = replay_spi_transfer,
+    .send           = replay_spi_send,
+    .receive        = replay_spi_receive,
+    .set_config     = replay_spi_set_config,
+    .get_status     = replay_spi_get_status,
+    .transfer_async = replay_spi_transfer_async,
+    .poll           = replay_spi_poll,
+    .submit_batch   = replay_spi_submit_batch,
+    .transfer_sg    = replay_spi_transfer_sg,
+    .stream_start   = replay_spi_stream_start,
+    .stream_stop    = replay_spi_stream_stop,
+    .transfer_large = replay_spi_transfer_large
+};
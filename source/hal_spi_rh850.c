@@ -10,6 +10,9 @@
 
 #include "yolpiya.h"
 #include "hal_spi.h"
+#include "hal_spi_backend.h"
+#include "hal_log.h"
+#include "hal_trace.h"
 
 /*============================================================================*/
 /* RH850 Hardware Specific Includes (conditional compilation)                */
@@ -24,14 +27,92 @@
 /* Private Definitions                                                        */
 /*============================================================================*/
 
-/* Simulated device state for when not on actual hardware */
+#ifdef RH850_TARGET
+/**
+ * @brief CSIH communication clock (PCLK), divided by the CTL2 prescaler and BRS
+ */
+#ifndef RH850_CSIH_PCLK_HZ
+#define RH850_CSIH_PCLK_HZ      40000000U
+#endif
+
+/**
+ * @brief Register images kept per device (a shared bus toggles between a few)
+ */
+#ifndef RH850_CSIH_CONFIG_SLOTS
+#define RH850_CSIH_CONFIG_SLOTS 2U
+#endif
+
+/**
+ * @brief Frames in flight in the CSIH buffer in FIFO mode (CSIHnMCTL0.MMS = 01)
+ * @details A frame costs one interrupt per this many bytes instead of one per byte.
+ */
+#ifndef RH850_CSIH_FIFO_DEPTH
+#define RH850_CSIH_FIFO_DEPTH   128U
+#endif
+
+/**
+ * @brief Blocking frames up to this length are waited for without halting the core
+ */
+#ifndef RH850_CSIH_SLEEP_MIN
+#define RH850_CSIH_SLEEP_MIN    16U
+#endif
+
+#define RH850_CSIH_CTL2_PRS_POS 13U
+#define RH850_CSIH_PRS_MAX      7U
+#define RH850_CSIH_BRS_MAX      0x0FFFU
+
+/**
+ * @brief Register image of a configuration
+ */
+typedef struct {
+    hal_spi_config_t    config;     /**< Configuration it was computed from */
+    uint16_t            ctl2;       /**< CSIHnCTL2: PRS[15:13], BRS[11:0] */
+    uint8_t             ckp;        /**< CSIHnCFGx fields */
+    uint8_t             dap;
+    uint8_t             dir;
+    uint8_t             dls;        /**< Data length, 0 = 16 bits */
+} rh850_csih_regs_t;
+#endif
+
+/**
+ * @brief Device state
+ * @details Hot fields (touched by every operation and the interrupts) come
+ *          first with the small ones packed together; the configuration and
+ *          its register images, only read by init and set_config, come last.
+ */
 typedef struct {
+    hal_spi_status_t    status;
     bool                is_initialized;
+    uint8_t volatile    stream_next;                 /**< Half the DMA fills next (0 or 1) */
+    uint16_t            stream_half;                 /**< Bytes per half */
+    uint16_t            async_length;
+    uint16_t volatile   async_index;                 /**< Next byte to receive */
+    uint16_t            async_sent;                  /**< Next byte to write to the FIFO */
+    uint8_t volatile    wait_done;                   /**< Blocking operation finished by the interrupt */
+    
+    /* FIFO job in flight (advanced by the CSIH interrupt): asynchronous
+     * transfer with async_callback, blocking operation without */
+    hal_status_t volatile wait_status;               /**< Result of the blocking operation */
+    hal_spi_callback_t volatile async_callback;  /**< NULL if nothing pending */
+    void*               async_user_data;
+    const uint8_t*      async_tx;
+    uint8_t*            async_rx;
+    uint32_t            async_start_us;              /**< hal_time_now_us() at submission */
+    
+    /* Continuous receive (DMA with reload, halves handed out from the DMA interrupts) */
+    hal_spi_stream_callback_t volatile stream_callback;  /**< NULL if not streaming */
+    void*               stream_user_data;
+    uint8_t*            stream_buffer;
+    uint32_t            stream_start_us;             /**< hal_time_now_us() when that half started */
+    
+    /* Read by init and set_config only */
     hal_spi_config_t    config;
-    hal_spi_status_t    status;
 #ifdef RH850_TARGET
     /* uint32_t csih_base_addr; */  /* CSIH peripheral base address */
     /* uint8_t  csih_channel;    */  /* CSIH channel (0-3) */
+    uint8_t             regs_count;
+    uint8_t             regs_next;                   /**< Slot the next new image replaces */
+    rh850_csih_regs_t   regs[RH850_CSIH_CONFIG_SLOTS];  /**< Images of recent configurations */
 #endif
 } rh850_spi_device_t;
 
@@ -47,38 +128,335 @@ static rh850_spi_device_t g_rh850_spi_devices[HAL_SPI_MAX_INTERFACES] = {0};
 
 #ifdef RH850_TARGET
 /**
- * @brief Map HAL config to RH850 CSIH parameters
- * @note This would configure actual RH850 CSIH peripheral registers
+ * @brief Compute the CSIH register image of a configuration
+ * @details Frames of up to 16 bits: 32-bit words go out as two frames.
+ */
+static void rh850_csih_compute_regs(const hal_spi_config_t* config, rh850_csih_regs_t* regs)
+{
+    uint32_t baudrate = (config->baudrate > 0U) ? config->baudrate : 1U;
+    uint32_t prs = 0;
+    uint32_t brs;
+    
+    /* Smallest prescaler 2^PRS whose BRS (f = PCLK / 2^PRS / (2 * BRS)) fits */
+    for (;;) {
+        uint32_t clock = RH850_CSIH_PCLK_HZ >> prs;
+        brs = (clock + 2U * baudrate - 1U) / (2U * baudrate);
+        if (brs <= RH850_CSIH_BRS_MAX || prs == RH850_CSIH_PRS_MAX) {
+            break;
+        }
+        prs++;
+    }
+    if (brs == 0U) {
+        brs = 1U;
+    } else if (brs > RH850_CSIH_BRS_MAX) {
+        brs = RH850_CSIH_BRS_MAX;
+    }
+    
+    regs->config = *config;
+    regs->ctl2 = (uint16_t)((prs << RH850_CSIH_CTL2_PRS_POS) | brs);
+    regs->ckp = ((config->mode & 0x02) != 0) ? 1U : 0U;
+    regs->dap = ((config->mode & 0x01) != 0) ? 1U : 0U;
+    regs->dir = (config->bit_order == HAL_SPI_BIT_ORDER_LSB_FIRST) ? 1U : 0U;
+    regs->dls = (config->data_bits >= 16U) ? 0U : config->data_bits;
+}
+
+/**
+ * @brief Register image of a configuration, computed once per slot
+ */
+static const rh850_csih_regs_t* rh850_csih_regs_for(rh850_spi_device_t* dev, const hal_spi_config_t* config)
+{
+    for (uint8_t i = 0; i < dev->regs_count; i++) {
+        if (hal_spi_config_equal(&dev->regs[i].config, config)) {
+            return &dev->regs[i];
+        }
+    }
+    
+    rh850_csih_regs_t* regs = &dev->regs[dev->regs_next];
+    dev->regs_next = (uint8_t)((dev->regs_next + 1U) % RH850_CSIH_CONFIG_SLOTS);
+    if (dev->regs_count < RH850_CSIH_CONFIG_SLOTS) {
+        dev->regs_count++;
+    }
+    rh850_csih_compute_regs(config, regs);
+    return regs;
+}
+
+/**
+ * @brief Apply a configuration to the RH850 CSIH peripheral
+ * @details A configuration seen before costs a few register writes.
  */
 static void rh850_configure_csih_peripheral(hal_spi_device_t device, 
                                             const hal_spi_config_t* config)
 {
-    /* Example mapping (when on real hardware):
-     * 
-     * // Map device to CSIH channel (CSIH0, CSIH1, etc.)
-     * volatile struct st_csih* csih = get_csih_peripheral(device);
+    const rh850_csih_regs_t* regs = rh850_csih_regs_for(&g_rh850_spi_devices[device], config);
+    
+    /* On real hardware (CTL2 and CFGx may only change while PWR is 0):
      * 
-     * // Disable CSIH for configuration
+     * volatile struct st_csih* csih = get_csih_peripheral(device);  // CSIH0, CSIH1, etc.
      * csih->CTL0.BIT.PWR = 0;
+     * csih->CTL2.UINT16 = regs->ctl2;
+     * csih->CFG0.BIT.CKP = regs->ckp;
+     * csih->CFG0.BIT.DAP = regs->dap;
+     * csih->CFG0.BIT.DIR = regs->dir;
+     * csih->CFG0.BIT.DLS = regs->dls;
+     * csih->CTL0.BIT.PWR = 1;
+     */
+    
+    (void)regs;  /* Suppress unused warning for now */
+    
+    HAL_LOG_INFO("[RH850-SPI] Configured CSIH%d: %lu Hz, mode %d\n", 
+                 device, config->baudrate, config->mode);
+}
+#endif
+
+/**
+ * @brief Complete the pending asynchronous transfer of a device
+ * @note On hardware this runs in interrupt context
+ */
+static void rh850_spi_async_complete(hal_spi_device_t device, hal_status_t status)
+{
+    rh850_spi_device_t* dev = &g_rh850_spi_devices[device];
+    hal_spi_callback_t callback = dev->async_callback;
+    void* user_data = dev->async_user_data;
+    
+    if (callback == NULL) {
+        return;
+    }
+    
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_TRANSFER, status, 
+                         dev->async_length, dev->async_length, dev->async_start_us);
+    
+    /* Release the device before the callback so it can submit the next transfer */
+    dev->async_callback = NULL;
+    hal_spi_release(&dev->status);
+    
+    callback(device, status, user_data);
+}
+
+/**
+ * @brief Hand the half of the stream buffer the DMA has just filled to the application
+ * @details On an error the stream ends: the device is released and the
+ *          callback is told why.
+ * @note On hardware this runs in interrupt context
+ */
+static void rh850_spi_stream_deliver(hal_spi_device_t device, hal_status_t status)
+{
+    rh850_spi_device_t* dev = &g_rh850_spi_devices[device];
+    hal_spi_stream_callback_t callback = dev->stream_callback;
+    void* user_data = dev->stream_user_data;
+    uint16_t length = dev->stream_half;
+    uint8_t* data = dev->stream_buffer + (dev->stream_next * length);
+    
+    if (callback == NULL) {
+        return;
+    }
+    
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_RECEIVE, status, 
+                         0, (status == HAL_OK) ? length : 0U, dev->stream_start_us);
+    dev->stream_next ^= 1U;
+    dev->stream_start_us = hal_time_now_us();
+    
+    if (status != HAL_OK) {
+        /* DMA_CH(rx).DCEN = 0; DMA_CH(tx).DCEN = 0; */
+        dev->stream_callback = NULL;
+        hal_spi_release(&dev->status);
+        callback(device, status, NULL, 0, user_data);
+        return;
+    }
+    
+    HAL_TRACE(HAL_TRACE_EV_RECEIVE, device, length);
+    callback(device, HAL_OK, data, length, user_data);
+}
+
+#ifdef RH850_TARGET
+void hal_spi_rh850_csih_isr(hal_spi_device_t device);
+void hal_spi_rh850_stream_isr(hal_spi_device_t device);
+
+/**
+ * @brief DMA interrupt handler of the stream RX channel
+ * @details Raised twice per buffer pass: by the transfer count compare
+ *          (DTCC = half) when the first half is full and at transfer end,
+ *          where the reload registers restart the channel on the buffer start.
+ * @note Hook into the interrupt vector of the DMA channel serving CSIHnRX
+ */
+void hal_spi_rh850_stream_isr(hal_spi_device_t device)
+{
+    /* volatile struct st_csih* csih = get_csih_peripheral(device);
      * 
-     * // Configure control registers
-     * csih->CTL0.BIT.MBS = (config->bit_order == HAL_SPI_BIT_ORDER_MSB_FIRST) ? 0 : 1;
-     * csih->CTL1.BIT.CKP = (config->mode & 0x02) ? 1 : 0;  // Clock polarity
-     * csih->CTL1.BIT.DAP = (config->mode & 0x01) ? 1 : 0;  // Clock phase
-     * csih->CTL1.BIT.DLS = (config->data_bits == 8) ? 7 : 15;  // Data length
+     * if (csih->STR.BIT.OVE || DMA_CH(rx).DCST.BIT.ER) {
+     *     rh850_spi_stream_deliver(device, HAL_ERROR);  // Overrun or DMA error
+     *     return;
+     * }
+     * DMA_CH(rx).DCSTC = DMA_CLEAR_TC_CC;
+     */
+    rh850_spi_stream_deliver(device, HAL_OK);
+}
+
+/**
+ * @brief Complete the FIFO job of a device
+ * @details An asynchronous transfer goes to its callback, a blocking one back
+ *          to the caller waiting in rh850_spi_run().
+ * @note On hardware this runs in interrupt context
+ */
+static void rh850_csih_job_complete(hal_spi_device_t device, hal_status_t status)
+{
+    rh850_spi_device_t* dev = &g_rh850_spi_devices[device];
+    
+    dev->async_index = dev->async_length;  /* Ends the job for the interrupt */
+    if (dev->async_callback != NULL) {
+        rh850_spi_async_complete(device, status);
+        return;
+    }
+    dev->wait_status = status;
+    dev->wait_done = 1U;
+}
+
+/**
+ * @brief Write the next burst of the FIFO job into the CSIH buffer
+ * @details At most RH850_CSIH_FIFO_DEPTH frames are in flight, so reception
+ *          cannot overrun. Only the last frame of the job carries EOJ, so CS
+ *          stays active between bursts.
+ */
+static void rh850_csih_fifo_fill(hal_spi_device_t device)
+{
+    rh850_spi_device_t* dev = &g_rh850_spi_devices[device];
+    uint16_t left = (uint16_t)(dev->async_length - dev->async_sent);
+    uint16_t burst = (left < RH850_CSIH_FIFO_DEPTH) ? left : (uint16_t)RH850_CSIH_FIFO_DEPTH;
+    
+    /* volatile struct st_csih* csih = get_csih_peripheral(device);
      * 
-     * // Configure baud rate (calculate BRS register value)
-     * csih->CFG0.BIT.BRS = calculate_brs(config->baudrate);
+     * for (uint16_t i = dev->async_sent; i < dev->async_sent + burst; i++) {
+     *     uint16_t data = (dev->async_tx != NULL) ? dev->async_tx[i] : 0xFFU;
+     *     if (i + 1U == dev->async_length) {
+     *         csih->TX0W = CSIH_TX0W_EOJ | data;
+     *     } else {
+     *         csih->TX0H = data;
+     *     }
+     * }
+     * csih->MCTL2 = CSIH_MCTL2_BTST | burst;  // Send the burst, INTCSIHnIC once all of it is received
+     */
+    dev->async_sent = (uint16_t)(dev->async_sent + burst);
+}
+
+/**
+ * @brief Start a FIFO job, finished by hal_spi_rh850_csih_isr()
+ */
+static void rh850_csih_job_start(hal_spi_device_t device, 
+                                 const uint8_t* tx_data, 
+                                 uint8_t* rx_data, 
+                                 uint16_t length)
+{
+    rh850_spi_device_t* dev = &g_rh850_spi_devices[device];
+    
+    dev->async_tx = tx_data;
+    dev->async_rx = rx_data;
+    dev->async_length = length;
+    dev->async_index = 0;
+    dev->async_sent = 0;
+    rh850_csih_fifo_fill(device);
+}
+
+/**
+ * @brief CSIH communication status interrupt handler (INTCSIHnIC)
+ * @details Raised once per FIFO burst: collects the received frames and
+ *          sends the next burst, so the CPU is involved once per
+ *          RH850_CSIH_FIFO_DEPTH frames instead of spinning on CSIHnSTR0.
+ * @note Hook into the interrupt vector of each CSIH channel in use
+ */
+void hal_spi_rh850_csih_isr(hal_spi_device_t device)
+{
+    rh850_spi_device_t* dev = &g_rh850_spi_devices[device];
+    
+    if (dev->async_index >= dev->async_length) {
+        return;
+    }
+    
+    /* volatile struct st_csih* csih = get_csih_peripheral(device);
      * 
-     * // Enable CSIH
-     * csih->CTL0.BIT.PWR = 1;
+     * if (csih->STR0.BIT.OVE) {
+     *     rh850_csih_job_complete(device, HAL_ERROR);
+     *     return;
+     * }
      */
+    while (dev->async_index < dev->async_sent) {
+        /* uint8_t data = (uint8_t)csih->RX0H;  // Read without rx_data too, to empty the FIFO
+         * if (dev->async_rx != NULL) {
+         *     dev->async_rx[dev->async_index] = data;
+         * }
+         */
+        dev->async_index++;
+    }
+    
+    if (dev->async_sent < dev->async_length) {
+        rh850_csih_fifo_fill(device);
+    } else {
+        rh850_csih_job_complete(device, HAL_OK);
+    }
+}
+#endif
+
+/**
+ * @brief Simulate one batch descriptor or scatter-gather segment
+ */
+static void rh850_simulate_xfer(const hal_spi_xfer_t* xfer)
+{
+    if (xfer->tx_data != NULL && xfer->rx_data != NULL) {
+        memcpy(xfer->rx_data, xfer->tx_data, xfer->length);  /* Echo back */
+    } else if (xfer->rx_data != NULL) {
+        memset(xfer->rx_data, 0x55, xfer->length);  /* Dummy data */
+    }
+}
+
+#ifdef RH850_TARGET
+/**
+ * @brief Stand-in for the CSIH until the register accesses are mapped: the
+ *        job is echoed and its interrupts run at once
+ */
+static void rh850_csih_simulate_job(hal_spi_device_t device)
+{
+    rh850_spi_device_t* dev = &g_rh850_spi_devices[device];
+    hal_spi_xfer_t xfer = { .tx_data = dev->async_tx, .rx_data = dev->async_rx, .length = dev->async_length };
+    
+    rh850_simulate_xfer(&xfer);
+    while (dev->async_index < dev->async_length) {
+        hal_spi_rh850_csih_isr(device);
+    }
+}
+
+/**
+ * @brief Run a blocking transfer, send or receive as a FIFO job
+ * @details The core halts between the burst interrupts unless the frame is
+ *          at most RH850_CSIH_SLEEP_MIN bytes.
+ * @param tx_data Data to transmit, NULL to clock out dummy bytes
+ * @param rx_data Buffer for received data, NULL to drop it
+ * @return HAL_OK, HAL_ERROR_TIMEOUT, HAL_ERROR
+ */
+static hal_status_t rh850_spi_run(hal_spi_device_t device, 
+                                  const uint8_t* tx_data, 
+                                  uint8_t* rx_data, 
+                                  uint16_t length, 
+                                  uint32_t timeout_ms, 
+                                  uint32_t start_us)
+{
+    rh850_spi_device_t* dev = &g_rh850_spi_devices[device];
     
-    (void)device;  /* Suppress unused warning for now */
-    (void)config;
+    dev->wait_status = HAL_OK;
+    dev->wait_done = 0U;
+    rh850_csih_job_start(device, tx_data, rx_data, length);
     
-    printf("[RH850-SPI] Configured CSIH%d: %lu Hz, mode %d\n", 
-           device, config->baudrate, config->mode);
+    /* For now, simulate on Windows */
+    rh850_csih_simulate_job(device);
+    
+    hal_status_t result = hal_spi_wait_done(&dev->wait_done, start_us, timeout_ms, 
+                                            length > RH850_CSIH_SLEEP_MIN);
+    if (result != HAL_OK) {
+        /* volatile struct st_csih* csih = get_csih_peripheral(device);
+         * csih->CTL0.BIT.PWR = 0;  // Cancels the burst and clears the FIFO before the buffers go back
+         * csih->CTL0.BIT.PWR = 1;
+         */
+        dev->async_index = dev->async_length;
+        return result;
+    }
+    return dev->wait_status;
 }
 #endif
 
@@ -88,7 +466,7 @@ static void rh850_configure_csih_peripheral(hal_spi_device_t device,
 
 static hal_status_t rh850_spi_init(hal_spi_device_t device, const hal_spi_config_t* config)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES || config == NULL) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || config == NULL)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -101,17 +479,15 @@ static hal_status_t rh850_spi_init(hal_spi_device_t device, const hal_spi_config
     /* Store configuration */
     dev->config = *config;
     dev->status.state = HAL_STATE_READY;
-    dev->status.tx_count = 0;
-    dev->status.rx_count = 0;
-    dev->status.error_count = 0;
     dev->status.is_busy = false;
+    hal_spi_stats_reset(device, &dev->status);
     
 #ifdef RH850_TARGET
     /* Configure actual RH850 CSIH peripheral */
     rh850_configure_csih_peripheral(device, config);
 #else
     /* Simulation mode - just log */
-    printf("[RH850-SPI] Init device %d (SIMULATED)\n", device);
+    HAL_LOG_INFO("[RH850-SPI] Init device %d (SIMULATED)\n", device);
 #endif
     
     dev->is_initialized = true;
@@ -120,7 +496,7 @@ static hal_status_t rh850_spi_init(hal_spi_device_t device, const hal_spi_config
 
 static hal_status_t rh850_spi_deinit(hal_spi_device_t device)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -134,7 +510,7 @@ static hal_status_t rh850_spi_deinit(hal_spi_device_t device)
     /* volatile struct st_csih* csih = get_csih_peripheral(device);
      * csih->CTL0.BIT.PWR = 0;  // Power down CSIH */
 #else
-    printf("[RH850-SPI] Deinit device %d (SIMULATED)\n", device);
+    HAL_LOG_INFO("[RH850-SPI] Deinit device %d (SIMULATED)\n", device);
 #endif
     
     memset(dev, 0, sizeof(rh850_spi_device_t));
@@ -147,7 +523,7 @@ static hal_status_t rh850_spi_transfer(hal_spi_device_t device,
                                        uint16_t length, 
                                        uint32_t timeout_ms)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -157,55 +533,29 @@ static hal_status_t rh850_spi_transfer(hal_spi_device_t device,
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (dev->status.is_busy) {
+    if (!hal_spi_claim(&dev->status)) {
         return HAL_ERROR_BUSY;
     }
-    
-    dev->status.is_busy = true;
+    uint32_t start_us = hal_time_now_us();
     
 #ifdef RH850_TARGET
-    /* volatile struct st_csih* csih = get_csih_peripheral(device);
-     * 
-     * for (uint16_t i = 0; i < length; i++) {
-     *     // Wait for TX ready
-     *     uint32_t timeout = timeout_ms * 1000;
-     *     while (!(csih->STR.BIT.TSF) && timeout--);
-     *     if (timeout == 0) {
-     *         dev->status.error_count++;
-     *         dev->status.is_busy = false;
-     *         return HAL_ERROR_TIMEOUT;
-     *     }
-     *     
-     *     // Transmit data
-     *     csih->TX.UINT16 = tx_data[i];
-     *     
-     *     // Wait for RX ready
-     *     timeout = timeout_ms * 1000;
-     *     while (!(csih->STR.BIT.ORER) && timeout--);
-     *     if (timeout == 0) {
-     *         dev->status.error_count++;
-     *         dev->status.is_busy = false;
-     *         return HAL_ERROR_TIMEOUT;
-     *     }
-     *     
-     *     // Receive data
-     *     rx_data[i] = (uint8_t)csih->RX.UINT16;
-     * }
-     */
+    hal_status_t result = rh850_spi_run(device, tx_data, rx_data, length, timeout_ms, start_us);
     
-    /* For now, simulate on Windows */
-    (void)timeout_ms;
-    memcpy(rx_data, tx_data, length);  /* Echo back for simulation */
+    if (result != HAL_OK) {
+        hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_TRANSFER, result, 0, 0, start_us);
+        hal_spi_release(&dev->status);
+        return result;
+    }
 #else
     (void)timeout_ms;
     /* Simulation: echo data back */
     memcpy(rx_data, tx_data, length);
-    printf("[RH850-SPI] Transfer %d bytes on device %d (SIMULATED)\n", length, device);
+    HAL_LOG_DEBUG("[RH850-SPI] Transfer %d bytes on device %d (SIMULATED)\n", length, device);
 #endif
+    HAL_TRACE(HAL_TRACE_EV_TRANSFER, device, length);
     
-    dev->status.tx_count += length;
-    dev->status.rx_count += length;
-    dev->status.is_busy = false;
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_TRANSFER, HAL_OK, length, length, start_us);
+    hal_spi_release(&dev->status);
     
     return HAL_OK;
 }
@@ -215,7 +565,7 @@ static hal_status_t rh850_spi_send(hal_spi_device_t device,
                                    uint16_t length, 
                                    uint32_t timeout_ms)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -225,23 +575,28 @@ static hal_status_t rh850_spi_send(hal_spi_device_t device,
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (dev->status.is_busy) {
+    if (!hal_spi_claim(&dev->status)) {
         return HAL_ERROR_BUSY;
     }
-    
-    dev->status.is_busy = true;
+    uint32_t start_us = hal_time_now_us();
     
 #ifdef RH850_TARGET
-    /* Actual RH850 TX implementation here */
-    (void)timeout_ms;
+    hal_status_t result = rh850_spi_run(device, data, NULL, length, timeout_ms, start_us);
+    
+    if (result != HAL_OK) {
+        hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_SEND, result, 0, 0, start_us);
+        hal_spi_release(&dev->status);
+        return result;
+    }
 #else
     (void)data;
     (void)timeout_ms;
-    printf("[RH850-SPI] Send %d bytes on device %d (SIMULATED)\n", length, device);
+    HAL_LOG_DEBUG("[RH850-SPI] Send %d bytes on device %d (SIMULATED)\n", length, device);
 #endif
+    HAL_TRACE(HAL_TRACE_EV_SEND, device, length);
     
-    dev->status.tx_count += length;
-    dev->status.is_busy = false;
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_SEND, HAL_OK, length, 0, start_us);
+    hal_spi_release(&dev->status);
     
     return HAL_OK;
 }
@@ -251,7 +606,7 @@ static hal_status_t rh850_spi_receive(hal_spi_device_t device,
                                       uint16_t length, 
                                       uint32_t timeout_ms)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -261,24 +616,28 @@ static hal_status_t rh850_spi_receive(hal_spi_device_t device,
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (dev->status.is_busy) {
+    if (!hal_spi_claim(&dev->status)) {
         return HAL_ERROR_BUSY;
     }
-    
-    dev->status.is_busy = true;
+    uint32_t start_us = hal_time_now_us();
     
 #ifdef RH850_TARGET
-    /* Actual RH850 RX implementation here */
-    (void)timeout_ms;
-    memset(data, 0x55, length);  /* Dummy data */
+    hal_status_t result = rh850_spi_run(device, NULL, data, length, timeout_ms, start_us);
+    
+    if (result != HAL_OK) {
+        hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_RECEIVE, result, 0, 0, start_us);
+        hal_spi_release(&dev->status);
+        return result;
+    }
 #else
     (void)timeout_ms;
     memset(data, 0x55, length);  /* Dummy data */
-    printf("[RH850-SPI] Receive %d bytes on device %d (SIMULATED)\n", length, device);
+    HAL_LOG_DEBUG("[RH850-SPI] Receive %d bytes on device %d (SIMULATED)\n", length, device);
 #endif
+    HAL_TRACE(HAL_TRACE_EV_RECEIVE, device, length);
     
-    dev->status.rx_count += length;
-    dev->status.is_busy = false;
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_RECEIVE, HAL_OK, 0, length, start_us);
+    hal_spi_release(&dev->status);
     
     return HAL_OK;
 }
@@ -286,7 +645,7 @@ static hal_status_t rh850_spi_receive(hal_spi_device_t device,
 static hal_status_t rh850_spi_set_config(hal_spi_device_t device, 
                                          const hal_spi_config_t* config)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES || config == NULL) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || config == NULL)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -296,7 +655,7 @@ static hal_status_t rh850_spi_set_config(hal_spi_device_t device,
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (dev->status.is_busy) {
+    if (!hal_spi_claim(&dev->status)) {
         return HAL_ERROR_BUSY;
     }
     
@@ -306,16 +665,18 @@ static hal_status_t rh850_spi_set_config(hal_spi_device_t device,
 #ifdef RH850_TARGET
     rh850_configure_csih_peripheral(device, config);
 #else
-    printf("[RH850-SPI] Reconfigured device %d (SIMULATED)\n", device);
+    HAL_LOG_INFO("[RH850-SPI] Reconfigured device %d (SIMULATED)\n", device);
 #endif
     
+    hal_spi_release(&dev->status);
+    
     return HAL_OK;
 }
 
 static hal_status_t rh850_spi_get_status(hal_spi_device_t device, 
                                          hal_spi_status_t* status)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES || status == NULL) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || status == NULL)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -329,16 +690,439 @@ static hal_status_t rh850_spi_get_status(hal_spi_device_t device,
     return HAL_OK;
 }
 
+static hal_status_t rh850_spi_transfer_async(hal_spi_device_t device, 
+                                             const uint8_t* tx_data, 
+                                             uint8_t* rx_data, 
+                                             uint16_t length, 
+                                             uint32_t timeout_ms,
+                                             hal_spi_callback_t callback,
+                                             void* user_data)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || callback == NULL)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    rh850_spi_device_t* dev = &g_rh850_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    dev->async_start_us = hal_time_now_us();
+    dev->async_user_data = user_data;
+    dev->async_callback = callback;
+    (void)timeout_ms;  /* Interrupt transfers are bounded by the bus clock */
+    
+#ifdef RH850_TARGET
+    /* First burst into the FIFO, hal_spi_rh850_csih_isr() moves the rest */
+    rh850_csih_job_start(device, tx_data, rx_data, length);
+    
+    /* For now, simulate on Windows */
+    rh850_csih_simulate_job(device);
+#else
+    /* Simulation: echo data back, completion is delivered from rh850_spi_poll() */
+    dev->async_length = length;
+    memcpy(rx_data, tx_data, length);
+    HAL_LOG_DEBUG("[RH850-SPI] Transfer %d bytes on device %d started (SIMULATED)\n", length, device);
+#endif
+    HAL_TRACE(HAL_TRACE_EV_TRANSFER, device, length);
+    
+    return HAL_OK;
+}
+
+static hal_status_t rh850_spi_poll(hal_spi_device_t device)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    rh850_spi_device_t* dev = &g_rh850_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (dev->stream_callback != NULL) {
+#ifdef RH850_TARGET
+        /* return HAL_ERROR_BUSY;  // Halves are delivered by hal_spi_rh850_stream_isr() */
+#endif
+        /* Simulation: one half of dummy data per poll */
+        memset(dev->stream_buffer + (dev->stream_next * dev->stream_half), 0x55, dev->stream_half);
+        rh850_spi_stream_deliver(device, HAL_OK);
+        return (dev->stream_callback != NULL) ? HAL_ERROR_BUSY : HAL_OK;
+    }
+    
+    if (dev->async_callback == NULL) {
+        return HAL_OK;
+    }
+    
+#ifdef RH850_TARGET
+    return HAL_ERROR_BUSY;  /* Completion is delivered by hal_spi_rh850_csih_isr() */
+#else
+    rh850_spi_async_complete(device, HAL_OK);
+    return HAL_OK;
+#endif
+}
+
+static hal_status_t rh850_spi_submit_batch(hal_spi_device_t device, 
+                                           const hal_spi_xfer_t* xfers, 
+                                           uint16_t count, 
+                                           uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    rh850_spi_device_t* dev = &g_rh850_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;
+    
+#ifdef RH850_TARGET
+    /* Run the list through the CSIH FIFO (memory mode) without powering the
+     * channel down between descriptors: each one a FIFO job as in rh850_spi_run(),
+     * refilled from INTCSIHnIC. Chained DTS channels can replace the refill for long lists.
+     * 
+     * volatile struct st_csih* csih = get_csih_peripheral(device);
+     * 
+     * for (uint16_t i = 0; i < count; i++) {
+     *     const hal_spi_xfer_t* xfer = &xfers[i];
+     *     rh850_csih_fifo_run(csih, xfer->tx_data, xfer->rx_data, xfer->length);
+     * }
+     */
+#endif
+    
+    uint32_t tx_bytes = 0;
+    uint32_t rx_bytes = 0;
+    
+    /* Simulation: echo transfers, dummy data for receives */
+    for (uint16_t i = 0; i < count; i++) {
+        const hal_spi_xfer_t* xfer = &xfers[i];
+        
+        rh850_simulate_xfer(xfer);
+        
+        if (xfer->tx_data != NULL) {
+            tx_bytes += xfer->length;
+        }
+        if (xfer->rx_data != NULL) {
+            rx_bytes += xfer->length;
+        }
+    }
+    
+#ifndef RH850_TARGET
+    HAL_LOG_DEBUG("[RH850-SPI] Batch of %u transfers on device %d (SIMULATED)\n", count, device);
+#endif
+    HAL_TRACE(HAL_TRACE_EV_BATCH, device, count);
+    
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_BATCH, HAL_OK, tx_bytes, rx_bytes, start_us);
+    hal_spi_release(&dev->status);
+    
+    return HAL_OK;
+}
+
+static hal_status_t rh850_spi_transfer_sg(hal_spi_device_t device, 
+                                          const hal_spi_xfer_t* segs, 
+                                          uint16_t count, 
+                                          uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    rh850_spi_device_t* dev = &g_rh850_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;
+    
+    uint32_t frame_bytes;
+    uint32_t tx_bytes;
+    uint32_t rx_bytes;
+    hal_spi_op_t op = hal_spi_sg_classify(segs, count, &frame_bytes, &tx_bytes, &rx_bytes);
+    
+#ifdef RH850_TARGET
+    /* One CSIH job for the whole frame: every segment is a DTS transfer chained
+     * to the next one, CS stays active because only the last frame of the last
+     * segment is written with EOJ set in CSIHnTX0W. Segments without tx_data
+     * read a fixed dummy word, segments without rx_data write to a fixed sink.
+     * 
+     * volatile struct st_csih* csih = get_csih_peripheral(device);
+     * 
+     * for (uint16_t i = 0; i < count; i++) {
+     *     rh850_dts_chain(device, i, segs[i].tx_data, segs[i].rx_data, segs[i].length, 
+     *                     (i + 1U) == count);  // Last segment: EOJ on its last frame
+     * }
+     * rh850_dts_start(device);
+     */
+#endif
+    
+    /* Simulation: segments in place, no staging buffer */
+    for (uint16_t i = 0; i < count; i++) {
+        rh850_simulate_xfer(&segs[i]);
+    }
+    
+#ifndef RH850_TARGET
+    HAL_LOG_DEBUG("[RH850-SPI] Scatter-gather frame of %lu bytes in %u segments on device %d (SIMULATED)\n", 
+                  (unsigned long)frame_bytes, count, device);
+#endif
+    HAL_TRACE(HAL_TRACE_EV_FROM_OP(op), device, frame_bytes);
+    
+    hal_spi_stats_record(device, &dev->status, op, HAL_OK, tx_bytes, rx_bytes, start_us);
+    hal_spi_release(&dev->status);
+    
+    return HAL_OK;
+}
+
+static hal_status_t rh850_spi_stream_start(hal_spi_device_t device, 
+                                           uint8_t* buffer, 
+                                           uint16_t length, 
+                                           hal_spi_stream_callback_t callback, 
+                                           void* user_data)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || callback == NULL)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    rh850_spi_device_t* dev = &g_rh850_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    /* The device stays claimed until rh850_spi_stream_stop() */
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    
+    dev->stream_user_data = user_data;
+    dev->stream_buffer = buffer;
+    dev->stream_half = length / 2U;
+    dev->stream_next = 0;
+    dev->stream_start_us = hal_time_now_us();
+    dev->stream_callback = callback;
+    
+#ifdef RH850_TARGET
+    /* Two sDMAC channels with reload function 1, so both restart on their own
+     * after every pass: one writes a dummy word to CSIHnTX0H per frame to keep
+     * the clock running, the other copies CSIHnRX0H into the buffer.
+     * 
+     * volatile struct st_csih* csih = get_csih_peripheral(device);
+     * static const uint16_t dummy = 0xFFFF;
+     * 
+     * DMA_CH(rx).DSA = (uint32_t)&csih->RX0H;  DMA_CH(rx).DDA = (uint32_t)buffer;
+     * DMA_CH(rx).DRSA = DMA_CH(rx).DSA;        DMA_CH(rx).DRDA = DMA_CH(rx).DDA;
+     * DMA_CH(rx).DTC = DMA_CH(rx).DRTC = length;
+     * DMA_CH(rx).DTCC = length / 2;            // Count compare interrupt at half
+     * DMA_CH(rx).DTCT = DMA_RLD1 | DMA_SRC_FIXED | DMA_DST_INC | DMA_TCE | DMA_CCE;
+     * 
+     * DMA_CH(tx).DSA = DMA_CH(tx).DRSA = (uint32_t)&dummy;
+     * DMA_CH(tx).DDA = DMA_CH(tx).DRDA = (uint32_t)&csih->TX0H;
+     * DMA_CH(tx).DTC = DMA_CH(tx).DRTC = length;
+     * DMA_CH(tx).DTCT = DMA_RLD1 | DMA_SRC_FIXED | DMA_DST_FIXED;
+     * 
+     * DMA_CH(rx).DCEN = 1;
+     * DMA_CH(tx).DCEN = 1;  // hal_spi_rh850_stream_isr() hands out the halves
+     * return HAL_OK;
+     */
+#else
+    HAL_LOG_DEBUG("[RH850-SPI] Stream started on device %d (SIMULATED)\n", device);
+#endif
+    
+    return HAL_OK;
+}
+
+static hal_status_t rh850_spi_stream_stop(hal_spi_device_t device)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    rh850_spi_device_t* dev = &g_rh850_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (dev->stream_callback == NULL) {
+        return HAL_OK;
+    }
+    
+#ifdef RH850_TARGET
+    /* DMA_CH(tx).DCEN = 0;  // Stop the clock first, then the RX channel
+     * DMA_CH(rx).DCEN = 0;
+     */
+#endif
+    
+    dev->stream_callback = NULL;
+    hal_spi_release(&dev->status);
+    
+    return HAL_OK;
+}
+
+static hal_status_t rh850_spi_transfer_large(hal_spi_device_t device, 
+                                             const uint8_t* tx_data, 
+                                             uint8_t* rx_data, 
+                                             uint32_t length, 
+                                             uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    rh850_spi_device_t* dev = &g_rh850_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;
+    
+    hal_spi_op_t op = hal_spi_large_classify(tx_data, rx_data);
+    
+#ifdef RH850_TARGET
+    /* A CSIH job with DTS transfers of at most HAL_SPI_LARGE_CHUNK bytes
+     * chained to each other: each block's DTS transfer count is 16 bits, and
+     * only the last frame of the last block is written with EOJ set, so CS
+     * stays active for the whole frame. Blocks point into the caller's
+     * buffers; dummy word and sink stand in for a missing side.
+     * 
+     * for (uint32_t offset = 0; offset < length; offset += HAL_SPI_LARGE_CHUNK) {
+     *     rh850_dts_chain_block(device, tx_data, rx_data, offset, length);  // EOJ on the last one
+     * }
+     * rh850_dts_start(device);
+     */
+#endif
+    
+    /* Simulation: the frame in place, chunk by chunk as the DMA would move it */
+    for (uint32_t offset = 0; offset < length; offset += HAL_SPI_LARGE_CHUNK) {
+        uint32_t left = length - offset;
+        hal_spi_xfer_t chunk = {
+            .tx_data = (tx_data != NULL) ? &tx_data[offset] : NULL,
+            .rx_data = (rx_data != NULL) ? &rx_data[offset] : NULL,
+            .length = (uint16_t)((left < HAL_SPI_LARGE_CHUNK) ? left : HAL_SPI_LARGE_CHUNK)
+        };
+        rh850_simulate_xfer(&chunk);
+    }
+    
+#ifndef RH850_TARGET
+    HAL_LOG_DEBUG("[RH850-SPI] Large frame of %lu bytes on device %d (SIMULATED)\n", 
+                  (unsigned long)length, device);
+#endif
+    HAL_TRACE(HAL_TRACE_EV_FROM_OP(op), device, length);
+    
+    hal_spi_stats_record(device, &dev->status, op, HAL_OK, 
+                         (tx_data != NULL) ? length : 0U, 
+                         (rx_data != NULL) ? length : 0U, 
+                         start_us);
+    hal_spi_release(&dev->status);
+    
+    return HAL_OK;
+}
+
+static hal_status_t rh850_spi_transfer_words(hal_spi_device_t device, 
+                                             const void* tx_words, 
+                                             void* rx_words, 
+                                             uint16_t count, 
+                                             uint8_t word_size, 
+                                             uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    rh850_spi_device_t* dev = &g_rh850_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;
+    
+    uint32_t length = (uint32_t)count * word_size;
+    hal_spi_op_t op = hal_spi_large_classify((const uint8_t*)tx_words, (const uint8_t*)rx_words);
+    
+#ifdef RH850_TARGET
+    /* The CSIH frame is the word: with DLS = 15 (data_bits 16) every TX.UINT16
+     * write and RX.UINT16 read moves a whole word, half the accesses of the
+     * byte path. MBS shifts LSB-first devices in hardware. Frames end at
+     * 16 bits, so a 32-bit word is two frames under the same chip select
+     * (EOJ only after the last one), the high half first when MSB first.
+     * 
+     * volatile struct st_csih* csih = get_csih_peripheral(device);
+     * const uint16_t* tx = (const uint16_t*)tx_words;  // 16-bit words
+     * 
+     * for (uint16_t i = 0; i < count; i++) {
+     *     csih->TX.UINT16 = (tx != NULL) ? tx[i] : 0xFFFFU;
+     *     ...wait for the frame, then
+     *     if (rx_words != NULL) { ((uint16_t*)rx_words)[i] = csih->RX.UINT16; }
+     * }
+     */
+#endif
+    
+    /* Simulation: echo the words back */
+    if (tx_words != NULL && rx_words != NULL) {
+        memcpy(rx_words, tx_words, length);
+    } else if (rx_words != NULL) {
+        memset(rx_words, 0xAA, length);  /* Dummy data */
+    }
+    
+#ifndef RH850_TARGET
+    HAL_LOG_DEBUG("[RH850-SPI] %u words of %u bits on device %d (SIMULATED)\n", 
+                  count, word_size * 8U, device);
+#endif
+    HAL_TRACE(HAL_TRACE_EV_FROM_OP(op), device, length);
+    
+    hal_spi_stats_record(device, &dev->status, op, HAL_OK, 
+                         (tx_words != NULL) ? length : 0U, 
+                         (rx_words != NULL) ? length : 0U, 
+                         start_us);
+    hal_spi_release(&dev->status);
+    
+    return HAL_OK;
+}
+
 /*============================================================================*/
 /* Public Operations Structure (Export)                                       */
 /*============================================================================*/
 
 const hal_spi_ops_t hal_spi_rh850_ops = {
-    .init       = rh850_spi_init,
-    .deinit     = rh850_spi_deinit,
-    .transfer   = rh850_spi_transfer,
-    .send       = rh850_spi_send,
-    .receive    = rh850_spi_receive,
-    .set_config = rh850_spi_set_config,
-    .get_status = rh850_spi_get_status
+    .init           = rh850_spi_init,
+    .deinit         = rh850_spi_deinit,
+    .transfer       = rh850_spi_transfer,
+    .send           = rh850_spi_send,
+    .receive        = rh850_spi_receive,
+    .set_config     = rh850_spi_set_config,
+    .get_status     = rh850_spi_get_status,
+    .transfer_async = rh850_spi_transfer_async,
+    .poll           = rh850_spi_poll,
+    .submit_batch   = rh850_spi_submit_batch,
+    .transfer_sg    = rh850_spi_transfer_sg,
+    .stream_start   = rh850_spi_stream_start,
+    .stream_stop    = rh850_spi_stream_stop,
+    .transfer_large = rh850_spi_transfer_large,
+    .transfer_words = rh850_spi_transfer_words
 };
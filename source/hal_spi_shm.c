@@ -0,0 +1,1373 @@
+/**
+ * @file    hal_spi_shm.c
+ * @brief   SPI HAL Shared-Memory Implementation
+ * @details Concrete implementation that talks to a device simulator on the
+ *          same host through a memory-mapped ring pair instead of TCP.
+ * @note    Messages and region layout are defined in hal_spi_proto.h; they
+ *          are the ones of the socket backend, so a server handles both
+ *          transports with one dispatcher. The server creates the region (tools/spi_socket_server.py
+ *          --shm); each ring is single-producer/single-consumer. Waiting sides
+ *          spin briefly and then sleep on a futex (Linux) or poll (elsewhere).
+ *          All devices share the channel; one request is in flight at a time,
+ *          apart from stream refills, which stay in flight in between.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#include "yolpiya.h"
+#include "hal_spi.h"
+#include "hal_spi_backend.h"
+#include "hal_atomic.h"
+#include "hal_os.h"
+#include "hal_log.h"
+#include "hal_trace.h"
+#include "hal_spi_proto.h"
+
+/* Platform-specific shared memory includes */
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <time.h>
+    #if defined(__linux__)
+        #include <linux/futex.h>
+        #include <sys/syscall.h>
+    #endif
+#endif
+
+/*============================================================================*/
+/* Private Definitions                                                        */
+/*============================================================================*/
+
+/**
+ * @brief Time a waiting side busy-polls before it goes to sleep
+ * @details Covers the turnaround of a busy server, so back-to-back frames never
+ *          pay for a wakeup. 0 sleeps at once. On a single CPU the peer cannot
+ *          run while we spin, so the wait sleeps at once there.
+ */
+#ifndef SHM_SPIN_US
+#define SHM_SPIN_US                 50U
+#endif
+
+/**
+ * @brief Longest single sleep; bounds the cost of a missed wakeup
+ */
+#define SHM_WAIT_SLICE_MS           10U
+
+/**
+ * @brief Client side of the channel
+ * @details lock serializes requests: it is held from writing a request until
+ *          its response has been consumed. setup_lock serializes attach/detach
+ *          from init/deinit.
+ */
+typedef struct {
+    hal_spi_shm_region_t* region;       /**< NULL while detached */
+    char                name[64];
+    uint32_t            msg_sequence;   /**< Message sequence counter */
+    uint8_t             open_devices;   /**< Initialized devices using the channel */
+    uint32_t            req_head;       /**< Write position of the request being built */
+    uint32_t            rsp_tail;       /**< Read position in the response being consumed */
+    uint32_t            rsp_end;        /**< End of the response being consumed */
+    uint32_t            spin_us;        /**< SHM_SPIN_US, 0 on a single CPU */
+#ifdef _WIN32
+    HANDLE              mapping;
+#endif
+    
+    hal_mutex_t         lock;
+    hal_mutex_t         setup_lock;
+} shm_channel_t;
+
+/**
+ * @brief Shared-memory SPI device state
+ */
+typedef struct {
+    bool                is_initialized;
+    hal_spi_config_t    config;
+    hal_spi_status_t    status;
+    
+    /* Continuous receive, guarded by the channel lock */
+    hal_spi_stream_callback_t stream_callback;  /**< NULL if not streaming */
+    void*               stream_user_data;
+    uint8_t*            stream_buffer;
+    uint16_t            stream_half;            /**< Bytes per half */
+    uint8_t             stream_next;            /**< Half delivered next (0 or 1) */
+    bool                stream_pending[2];      /**< Refill of that half posted, response not read yet */
+    uint32_t            stream_sequence[2];     /**< Sequence of that refill */
+    hal_status_t        stream_result[2];       /**< Outcome of the refill, HAL_ERROR_BUSY until it is read */
+    uint32_t            stream_start_us;        /**< hal_time_now_us() when that half was due */
+} shm_spi_device_t;
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static shm_spi_device_t g_shm_spi_devices[HAL_SPI_MAX_INTERFACES] = {0};
+static shm_channel_t g_shm_channel = {
+    .lock = HAL_MUTEX_INIT,
+    .setup_lock = HAL_MUTEX_INIT
+};
+
+/*============================================================================*/
+/* Private Helper Functions                                                   */
+/*============================================================================*/
+
+/**
+ * @brief Sleep until *word changes from value, a wake arrives or wait_ms pass
+ */
+static void shm_wait_word(volatile uint32_t* word, uint32_t value, uint32_t wait_ms)
+{
+#if defined(_WIN32)
+    (void)word;
+    (void)value;
+    (void)wait_ms;
+    Sleep(0);  /* WaitOnAddress() does not work across processes */
+#elif defined(__linux__)
+    struct timespec ts;
+    ts.tv_sec = (time_t)(wait_ms / 1000U);
+    ts.tv_nsec = (long)(wait_ms % 1000U) * 1000000L;
+    (void)syscall(SYS_futex, word, FUTEX_WAIT, value, &ts, NULL, 0);
+#else
+    (void)word;
+    (void)value;
+    (void)wait_ms;
+    struct timespec ts = {0, 20000L};
+    nanosleep(&ts, NULL);
+#endif
+}
+
+/**
+ * @brief Wake the peer sleeping on *word, if it announced itself in *waiters
+ */
+static void shm_wake_word(volatile uint32_t* word, volatile uint32_t* waiters)
+{
+    if (HAL_ATOMIC_EXCHANGE_U32(waiters, 0U) != 0U) {
+#if defined(__linux__)
+        (void)syscall(SYS_futex, word, FUTEX_WAKE, 1, NULL, NULL, 0);
+#else
+        (void)word;  /* The peer polls */
+#endif
+    }
+}
+
+/**
+ * @brief Wait until *word differs from value
+ * @details Spins for SHM_SPIN_US, then sleeps in slices of SHM_WAIT_SLICE_MS.
+ *          The waiter flag is set with a full barrier before the last check,
+ *          so a producer that moves the word afterwards sees it and wakes us.
+ * @return false if timeout_ms (0: forever) expired since start_us
+ */
+static bool shm_wait_change(volatile uint32_t* word, 
+                            volatile uint32_t* waiters, 
+                            uint32_t value, 
+                            uint32_t start_us, 
+                            uint32_t timeout_ms)
+{
+    uint32_t spin_start = hal_time_now_us();
+    uint32_t spin_us = g_shm_channel.spin_us;
+    
+    while (HAL_ATOMIC_LOAD_U32(word) == value) {
+        uint32_t now = hal_time_now_us();
+        uint32_t elapsed_ms = (now - start_us) / 1000U;
+        
+        if (timeout_ms > 0 && elapsed_ms >= timeout_ms) {
+            return false;
+        }
+        if ((now - spin_start) < spin_us) {
+            continue;
+        }
+        
+        (void)HAL_ATOMIC_EXCHANGE_U32(waiters, 1U);
+        if (HAL_ATOMIC_LOAD_U32(word) == value) {
+            shm_wait_word(word, value, SHM_WAIT_SLICE_MS);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Copy into a ring at a free-running position (wraps at the end)
+ */
+static void shm_ring_put(hal_spi_shm_ring_t* ring, uint32_t pos, const uint8_t* data, uint32_t length)
+{
+    uint32_t offset = pos & (HAL_SPI_SHM_RING_SIZE - 1U);
+    uint32_t first = HAL_SPI_SHM_RING_SIZE - offset;
+    
+    if (first > length) {
+        first = length;
+    }
+    if (data != NULL) {
+        memcpy(&ring->data[offset], data, first);
+        memcpy(&ring->data[0], data + first, length - first);
+    } else {
+        memset(&ring->data[offset], 0, first);  /* Dummy TX bytes */
+        memset(&ring->data[0], 0, length - first);
+    }
+}
+
+/**
+ * @brief Copy out of a ring at a free-running position (wraps at the end)
+ */
+static void shm_ring_get(const hal_spi_shm_ring_t* ring, uint32_t pos, uint8_t* data, uint32_t length)
+{
+    uint32_t offset = pos & (HAL_SPI_SHM_RING_SIZE - 1U);
+    uint32_t first = HAL_SPI_SHM_RING_SIZE - offset;
+    
+    if (first > length) {
+        first = length;
+    }
+    memcpy(data, &ring->data[offset], first);
+    memcpy(data + first, &ring->data[0], length - first);
+}
+
+/**
+ * @brief Map the region created by the server
+ */
+static hal_status_t shm_attach(shm_channel_t* ch)
+{
+    hal_spi_shm_region_t* region = NULL;
+    
+#ifdef _WIN32
+    ch->mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, ch->name);
+    if (ch->mapping == NULL) {
+        HAL_LOG_ERROR("[SHM-SPI] ERROR: Shared memory %s not found (server running?)\n", ch->name);
+        return HAL_ERROR;
+    }
+    region = (hal_spi_shm_region_t*)MapViewOfFile(ch->mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(hal_spi_shm_region_t));
+    if (region == NULL) {
+        CloseHandle(ch->mapping);
+        ch->mapping = NULL;
+        HAL_LOG_ERROR("[SHM-SPI] ERROR: Failed to map %s\n", ch->name);
+        return HAL_ERROR;
+    }
+#else
+    char path[sizeof(ch->name) + 1];
+    struct stat info;
+    
+    snprintf(path, sizeof(path), "/%s", ch->name);
+    int fd = shm_open(path, O_RDWR, 0);
+    if (fd < 0) {
+        HAL_LOG_ERROR("[SHM-SPI] ERROR: Shared memory %s not found (server running?)\n", path);
+        return HAL_ERROR;
+    }
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(hal_spi_shm_region_t)) {
+        close(fd);
+        HAL_LOG_ERROR("[SHM-SPI] ERROR: Shared memory %s too small\n", path);
+        return HAL_ERROR;
+    }
+    
+    void* mapping = mmap(NULL, sizeof(hal_spi_shm_region_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        HAL_LOG_ERROR("[SHM-SPI] ERROR: Failed to map %s\n", path);
+        return HAL_ERROR;
+    }
+    region = (hal_spi_shm_region_t*)mapping;
+#endif
+    
+    if (HAL_ATOMIC_LOAD_U32(&region->magic) != HAL_SPI_SHM_MAGIC ||
+        region->version != HAL_SPI_SHM_VERSION || region->ring_size != HAL_SPI_SHM_RING_SIZE) {
+        HAL_LOG_ERROR("[SHM-SPI] ERROR: Shared memory %s has an unknown layout\n", ch->name);
+#ifdef _WIN32
+        UnmapViewOfFile(region);
+        CloseHandle(ch->mapping);
+        ch->mapping = NULL;
+#else
+        munmap(region, sizeof(hal_spi_shm_region_t));
+#endif
+        return HAL_ERROR;
+    }
+    
+#ifdef _WIN32
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    ch->spin_us = (system_info.dwNumberOfProcessors > 1) ? SHM_SPIN_US : 0U;
+#else
+    ch->spin_us = (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? SHM_SPIN_US : 0U;
+#endif
+    
+    /* Drop whatever a previous client left unread */
+    HAL_ATOMIC_STORE_U32(&region->response.tail, HAL_ATOMIC_LOAD_U32(&region->response.head));
+    
+    ch->region = region;
+    HAL_LOG_INFO("[SHM-SPI] Attached to %s\n", ch->name);
+    
+    return HAL_OK;
+}
+
+/**
+ * @brief Unmap the region
+ */
+static void shm_detach(shm_channel_t* ch)
+{
+    if (ch->region != NULL) {
+#ifdef _WIN32
+        UnmapViewOfFile(ch->region);
+        CloseHandle(ch->mapping);
+        ch->mapping = NULL;
+#else
+        munmap(ch->region, sizeof(hal_spi_shm_region_t));
+#endif
+    }
+    ch->region = NULL;
+}
+
+/**
+ * @brief Start a request: reserve room for the whole message, write the header
+ * @details Caller holds ch->lock. The payload follows with shm_msg_put().
+ * @return Sequence number of the request, via *sequence
+ */
+static hal_status_t shm_msg_begin(shm_channel_t* ch, 
+                                  hal_spi_msg_type_t msg_type, 
+                                  hal_spi_device_t device, 
+                                  uint16_t payload_length, 
+                                  uint32_t* sequence, 
+                                  uint32_t start_us, 
+                                  uint32_t timeout_ms)
+{
+    hal_spi_shm_ring_t* ring = &ch->region->request;
+    uint32_t needed = sizeof(hal_spi_msg_header_t) + payload_length;
+    uint32_t head = ring->head;  /* Only this side writes it */
+    
+    /* The server drains each request before it answers, so this only waits if it lags */
+    for (;;) {
+        uint32_t tail = HAL_ATOMIC_LOAD_U32(&ring->tail);
+        if (HAL_SPI_SHM_RING_SIZE - (head - tail) >= needed) {
+            break;
+        }
+        if (!shm_wait_change(&ring->tail, &ring->tail_waiters, tail, start_us, timeout_ms)) {
+            return HAL_ERROR_TIMEOUT;
+        }
+    }
+    
+    hal_spi_msg_header_t header;
+    header.msg_type = (uint8_t)msg_type;
+    header.device_id = (uint8_t)device;
+    header.data_length = payload_length;
+    header.sequence = ch->msg_sequence++;
+    
+    shm_ring_put(ring, head, (const uint8_t*)&header, sizeof(header));
+    ch->req_head = head + sizeof(header);
+    *sequence = header.sequence;
+    
+    return HAL_OK;
+}
+
+/**
+ * @brief Append payload bytes to the request (NULL appends zeros)
+ */
+static void shm_msg_put(shm_channel_t* ch, const void* data, uint32_t length)
+{
+    shm_ring_put(&ch->region->request, ch->req_head, (const uint8_t*)data, length);
+    ch->req_head += length;
+}
+
+/**
+ * @brief Publish the request and wake the server
+ */
+static void shm_msg_end(shm_channel_t* ch)
+{
+    hal_spi_shm_ring_t* ring = &ch->region->request;
+    
+    (void)HAL_ATOMIC_EXCHANGE_U32(&ring->head, ch->req_head);
+    shm_wake_word(&ring->head, &ring->head_waiters);
+}
+
+/**
+ * @brief Hand a response to the stream refill it answers, if any
+ * @details Caller holds ch->lock. Refills stay in flight while other requests
+ *          run, so whoever reads the response ring first copies their data
+ *          into the stream half, as the DMA would write it on hardware.
+ * @param payload Ring position of the response payload
+ */
+static void shm_stream_deliver(shm_channel_t* ch, const hal_spi_msg_header_t* header, uint32_t payload)
+{
+    if (header->msg_type != HAL_SPI_MSG_RESPONSE) {
+        return;
+    }
+    
+    for (uint8_t device = 0; device < HAL_SPI_MAX_INTERFACES; device++) {
+        shm_spi_device_t* dev = &g_shm_spi_devices[device];
+        
+        for (uint8_t half = 0; half < 2U && dev->stream_callback != NULL; half++) {
+            if (dev->stream_pending[half] && dev->stream_sequence[half] == header->sequence) {
+                if (header->data_length == dev->stream_half) {
+                    shm_ring_get(&ch->region->response, payload, 
+                                 dev->stream_buffer + (half * dev->stream_half), dev->stream_half);
+                    dev->stream_result[half] = HAL_OK;
+                } else {
+                    dev->stream_result[half] = HAL_ERROR;
+                }
+                dev->stream_pending[half] = false;
+                return;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Read the responses that have arrived, without waiting
+ * @details Caller holds ch->lock. Every request but a stream refill holds the
+ *          lock until its response is read, so any other response found here
+ *          is left over from a timeout and skipped.
+ */
+static void shm_rsp_drain(shm_channel_t* ch)
+{
+    hal_spi_shm_ring_t* ring = &ch->region->response;
+    uint32_t tail = ring->tail;  /* Only this side writes it */
+    uint32_t head = HAL_ATOMIC_LOAD_U32(&ring->head);
+    
+    while (head - tail >= sizeof(hal_spi_msg_header_t)) {
+        hal_spi_msg_header_t header;
+        shm_ring_get(ring, tail, (uint8_t*)&header, sizeof(header));
+        if (head - tail < sizeof(header) + header.data_length) {
+            break;  /* Corrupt ring, the next request reports it */
+        }
+        
+        shm_stream_deliver(ch, &header, tail + sizeof(header));
+        tail += sizeof(header) + header.data_length;
+    }
+    
+    if (tail != ring->tail) {
+        (void)HAL_ATOMIC_EXCHANGE_U32(&ring->tail, tail);
+        shm_wake_word(&ring->tail, &ring->tail_waiters);
+    }
+}
+
+/**
+ * @brief End the stream of a device, late responses are skipped
+ * @details Caller holds the channel lock.
+ */
+static void shm_stream_end(shm_spi_device_t* dev)
+{
+    dev->stream_pending[0] = false;
+    dev->stream_pending[1] = false;
+    dev->stream_callback = NULL;
+    dev->stream_buffer = NULL;
+    hal_spi_release(&dev->status);
+}
+
+/**
+ * @brief Wait for the response to sequence
+ * @details Responses to other sequences (left over from a request that timed
+ *          out) are skipped. On success the payload is read with
+ *          shm_rsp_get() and released with shm_rsp_end().
+ * @param length Receives the payload length
+ */
+static hal_status_t shm_rsp_begin(shm_channel_t* ch, 
+                                  uint32_t sequence, 
+                                  uint16_t* length, 
+                                  uint32_t start_us, 
+                                  uint32_t timeout_ms)
+{
+    hal_spi_shm_ring_t* ring = &ch->region->response;
+    uint32_t tail = ring->tail;  /* Only this side writes it */
+    
+    for (;;) {
+        uint32_t head = HAL_ATOMIC_LOAD_U32(&ring->head);
+        
+        if (head == tail) {
+            if (!shm_wait_change(&ring->head, &ring->head_waiters, head, start_us, timeout_ms)) {
+                return HAL_ERROR_TIMEOUT;
+            }
+            continue;
+        }
+        
+        /* The server publishes whole messages, so the payload is there too */
+        hal_spi_msg_header_t header;
+        shm_ring_get(ring, tail, (uint8_t*)&header, sizeof(header));
+        if (head - tail < sizeof(header) + header.data_length) {
+            return HAL_ERROR;  /* Corrupt ring */
+        }
+        
+        if (header.msg_type == HAL_SPI_MSG_RESPONSE && header.sequence == sequence) {
+            ch->rsp_tail = tail + sizeof(header);
+            ch->rsp_end = ch->rsp_tail + header.data_length;
+            *length = header.data_length;
+            return HAL_OK;
+        }
+        
+        shm_stream_deliver(ch, &header, tail + sizeof(header));
+        tail += sizeof(header) + header.data_length;
+        HAL_ATOMIC_STORE_U32(&ring->tail, tail);
+    }
+}
+
+/**
+ * @brief Copy the next length bytes of the response (NULL skips them)
+ */
+static void shm_rsp_get(shm_channel_t* ch, uint8_t* data, uint32_t length)
+{
+    if (data != NULL) {
+        shm_ring_get(&ch->region->response, ch->rsp_tail, data, length);
+    }
+    ch->rsp_tail += length;
+}
+
+/**
+ * @brief Release the response to the server
+ */
+static void shm_rsp_end(shm_channel_t* ch)
+{
+    hal_spi_shm_ring_t* ring = &ch->region->response;
+    
+    (void)HAL_ATOMIC_EXCHANGE_U32(&ring->tail, ch->rsp_end);
+    shm_wake_word(&ring->tail, &ring->tail_waiters);
+}
+
+/**
+ * @brief Run one request whose payload is a list of segments
+ * @details TX bytes are copied straight from the segments into the ring
+ *          (segments without tx_data contribute zeros when tx_all is set,
+ *          nothing otherwise); the response is copied straight into the RX
+ *          segments (segments without rx_data are skipped when rx_all is set).
+ * @param prefix Bytes put before the segments (NULL if none)
+ * @param expected_length Required response length
+ */
+static hal_status_t shm_request(shm_channel_t* ch, 
+                                hal_spi_msg_type_t msg_type, 
+                                hal_spi_device_t device, 
+                                const void* prefix, 
+                                uint16_t prefix_length, 
+                                const hal_spi_xfer_t* segs, 
+                                uint16_t count, 
+                                bool tx_all, 
+                                bool rx_all, 
+                                uint32_t expected_length, 
+                                uint32_t timeout_ms)
+{
+    uint32_t start_us = hal_time_now_us();
+    uint32_t payload_length = prefix_length;
+    uint32_t sequence;
+    uint16_t length;
+    
+    for (uint16_t i = 0; i < count; i++) {
+        if (segs[i].tx_data != NULL || tx_all) {
+            payload_length += segs[i].length;
+        }
+    }
+    if (payload_length > HAL_SPI_MSG_MAX_PAYLOAD) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    hal_mutex_lock(&ch->lock);
+    
+    if (ch->region == NULL) {
+        hal_mutex_unlock(&ch->lock);
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    hal_status_t status = shm_msg_begin(ch, msg_type, device, (uint16_t)payload_length, 
+                                        &sequence, start_us, timeout_ms);
+    if (status == HAL_OK) {
+        if (prefix != NULL) {
+            shm_msg_put(ch, prefix, prefix_length);
+        }
+        for (uint16_t i = 0; i < count; i++) {
+            if (segs[i].tx_data != NULL || tx_all) {
+                shm_msg_put(ch, segs[i].tx_data, segs[i].length);
+            }
+        }
+        shm_msg_end(ch);
+        
+        status = shm_rsp_begin(ch, sequence, &length, start_us, timeout_ms);
+    }
+    
+    if (status == HAL_OK) {
+        uint32_t remaining = length;
+        
+        for (uint16_t i = 0; i < count && remaining > 0; i++) {
+            if (segs[i].rx_data != NULL || rx_all) {
+                uint32_t chunk = (remaining < segs[i].length) ? remaining : segs[i].length;
+                shm_rsp_get(ch, segs[i].rx_data, chunk);
+                remaining -= chunk;
+            }
+        }
+        shm_rsp_end(ch);
+        
+        status = (length == expected_length) ? HAL_OK : HAL_ERROR;
+    }
+    
+    hal_mutex_unlock(&ch->lock);
+    return status;
+}
+
+/**
+ * @brief Run one request with one payload buffer
+ * @param rx_data Buffer for a response of payload_length bytes, NULL if none is expected
+ */
+static hal_status_t shm_request_single(shm_channel_t* ch, 
+                                       hal_spi_msg_type_t msg_type, 
+                                       hal_spi_device_t device, 
+                                       const void* payload, 
+                                       uint16_t payload_length, 
+                                       uint8_t* rx_data, 
+                                       uint32_t timeout_ms)
+{
+    hal_spi_xfer_t seg;
+    
+    seg.tx_data = (const uint8_t*)payload;
+    seg.rx_data = rx_data;
+    seg.length = payload_length;
+    
+    return shm_request(ch, msg_type, device, NULL, 0, &seg, 1, false, false, 
+                       (rx_data != NULL) ? payload_length : 0U, timeout_ms);
+}
+
+/**
+ * @brief Timeout for the control messages (INIT, DEINIT, SET_CONFIG)
+ */
+#define SHM_CONTROL_TIMEOUT_MS      1000U
+
+/*============================================================================*/
+/* SPI Operations Implementation                                              */
+/*============================================================================*/
+
+static hal_status_t shm_spi_init(hal_spi_device_t device, const hal_spi_config_t* config)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || config == NULL)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    shm_spi_device_t* dev = &g_shm_spi_devices[device];
+    shm_channel_t* ch = &g_shm_channel;
+    
+    if (dev->is_initialized) {
+        return HAL_ERROR_BUSY;
+    }
+    
+    /* Store configuration */
+    dev->config = *config;
+    dev->status.state = HAL_STATE_RESET;
+    dev->status.is_busy = false;
+    hal_spi_stats_reset(device, &dev->status);
+    
+    /* The first device maps the shared region */
+    hal_mutex_lock(&ch->setup_lock);
+    if (ch->open_devices == 0 && ch->region == NULL) {
+        /* Region name can be overridden via environment variable */
+        const char* name_env = getenv("HAL_SPI_SHM_NAME");
+        
+        strncpy(ch->name, name_env ? name_env : HAL_SPI_SHM_DEFAULT_NAME, sizeof(ch->name) - 1);
+        
+        if (shm_attach(ch) != HAL_OK) {
+            HAL_LOG_WARN("[SHM-SPI] WARNING: Running in detached mode\n");
+        }
+    }
+    ch->open_devices++;
+    hal_mutex_unlock(&ch->setup_lock);
+    
+    /* Announce the device to the server */
+    if (ch->region != NULL) {
+        (void)shm_request_single(ch, HAL_SPI_MSG_INIT, device, config, sizeof(hal_spi_config_t), 
+                                 NULL, SHM_CONTROL_TIMEOUT_MS);
+    }
+    
+    dev->is_initialized = true;
+    dev->status.state = HAL_STATE_READY;
+    
+    HAL_LOG_INFO("[SHM-SPI] Init device %d via shared memory\n", device);
+    
+    return HAL_OK;
+}
+
+static hal_status_t shm_spi_deinit(hal_spi_device_t device)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    shm_spi_device_t* dev = &g_shm_spi_devices[device];
+    shm_channel_t* ch = &g_shm_channel;
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    /* A running stream ends here, its late responses are skipped */
+    hal_mutex_lock(&ch->lock);
+    if (dev->stream_callback != NULL) {
+        shm_stream_end(dev);
+    }
+    hal_mutex_unlock(&ch->lock);
+    
+    if (ch->region != NULL) {
+        (void)shm_request_single(ch, HAL_SPI_MSG_DEINIT, device, NULL, 0, NULL, SHM_CONTROL_TIMEOUT_MS);
+    }
+    
+    /* The last device unmaps the region */
+    hal_mutex_lock(&ch->setup_lock);
+    ch->open_devices--;
+    if (ch->open_devices == 0) {
+        hal_mutex_lock(&ch->lock);
+        shm_detach(ch);
+        hal_mutex_unlock(&ch->lock);
+    }
+    hal_mutex_unlock(&ch->setup_lock);
+    
+    HAL_LOG_INFO("[SHM-SPI] Deinit device %d\n", device);
+    
+    memset(dev, 0, sizeof(shm_spi_device_t));
+    
+    return HAL_OK;
+}
+
+static hal_status_t shm_spi_transfer(hal_spi_device_t device, 
+                                     const uint8_t* tx_data, 
+                                     uint8_t* rx_data, 
+                                     uint16_t length, 
+                                     uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    shm_spi_device_t* dev = &g_shm_spi_devices[device];
+    
+    if (!dev->is_initialized || g_shm_channel.region == NULL) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    
+    hal_status_t status = shm_request_single(&g_shm_channel, HAL_SPI_MSG_TRANSFER, device, 
+                                             tx_data, length, rx_data, timeout_ms);
+    
+    if (status != HAL_OK) {
+        hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_TRANSFER, status, 0, 0, start_us);
+        hal_spi_release(&dev->status);
+        return status;
+    }
+    
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_TRANSFER, HAL_OK, length, length, start_us);
+    hal_spi_release(&dev->status);
+    
+    HAL_LOG_DEBUG("[SHM-SPI] Transferred %d bytes on device %d\n", length, device);
+    HAL_TRACE(HAL_TRACE_EV_TRANSFER, device, length);
+    
+    return HAL_OK;
+}
+
+static hal_status_t shm_spi_send(hal_spi_device_t device, 
+                                 const uint8_t* data, 
+                                 uint16_t length, 
+                                 uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    shm_spi_device_t* dev = &g_shm_spi_devices[device];
+    
+    if (!dev->is_initialized || g_shm_channel.region == NULL) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    
+    /* Send data and wait for the (empty) acknowledgment */
+    hal_status_t status = shm_request_single(&g_shm_channel, HAL_SPI_MSG_SEND, device, 
+                                             data, length, NULL, timeout_ms);
+    
+    if (status != HAL_OK) {
+        hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_SEND, status, 0, 0, start_us);
+        hal_spi_release(&dev->status);
+        return status;
+    }
+    
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_SEND, HAL_OK, length, 0, start_us);
+    hal_spi_release(&dev->status);
+    
+    HAL_LOG_DEBUG("[SHM-SPI] Sent %d bytes on device %d\n", length, device);
+    HAL_TRACE(HAL_TRACE_EV_SEND, device, length);
+    
+    return HAL_OK;
+}
+
+static hal_status_t shm_spi_receive(hal_spi_device_t device, 
+                                    uint8_t* data, 
+                                    uint16_t length, 
+                                    uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    shm_spi_device_t* dev = &g_shm_spi_devices[device];
+    
+    if (!dev->is_initialized || g_shm_channel.region == NULL) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    
+    /* Send receive request and wait for the data */
+    uint8_t req_data[2] = {(uint8_t)(length >> 8), (uint8_t)(length & 0xFF)};
+    hal_spi_xfer_t seg = {NULL, data, length};
+    hal_status_t status = shm_request(&g_shm_channel, HAL_SPI_MSG_RECEIVE, device, req_data, 2, 
+                                      &seg, 1, false, false, length, timeout_ms);
+    
+    if (status != HAL_OK) {
+        hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_RECEIVE, status, 0, 0, start_us);
+        hal_spi_release(&dev->status);
+        return status;
+    }
+    
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_RECEIVE, HAL_OK, 0, length, start_us);
+    hal_spi_release(&dev->status);
+    
+    HAL_LOG_DEBUG("[SHM-SPI] Received %d bytes on device %d\n", length, device);
+    HAL_TRACE(HAL_TRACE_EV_RECEIVE, device, length);
+    
+    return HAL_OK;
+}
+
+static hal_status_t shm_spi_set_config(hal_spi_device_t device, 
+                                       const hal_spi_config_t* config)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || config == NULL)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    shm_spi_device_t* dev = &g_shm_spi_devices[device];
+    
+    if (!dev->is_initialized || g_shm_channel.region == NULL) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    
+    /* Update local configuration */
+    dev->config = *config;
+    
+    /* Send config update to server */
+    (void)shm_request_single(&g_shm_channel, HAL_SPI_MSG_SET_CONFIG, device, config, 
+                             sizeof(hal_spi_config_t), NULL, SHM_CONTROL_TIMEOUT_MS);
+    
+    HAL_LOG_INFO("[SHM-SPI] Reconfigured device %d\n", device);
+    
+    hal_spi_release(&dev->status);
+    
+    return HAL_OK;
+}
+
+static hal_status_t shm_spi_get_status(hal_spi_device_t device, 
+                                       hal_spi_status_t* status)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || status == NULL)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    shm_spi_device_t* dev = &g_shm_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    *status = dev->status;
+    return HAL_OK;
+}
+
+/**
+ * @brief Run one batch message: as many descriptors as fit into one payload
+ * @return Number of descriptors processed (0 on error, status in *result)
+ */
+static uint16_t shm_run_batch_chunk(shm_channel_t* ch, 
+                                    hal_spi_device_t device, 
+                                    const hal_spi_xfer_t* xfers, 
+                                    uint16_t count, 
+                                    uint32_t timeout_ms, 
+                                    hal_status_t* result)
+{
+    uint32_t start_us = hal_time_now_us();
+    uint32_t payload_length = 0;
+    uint32_t response_length = 0;
+    uint16_t n = 0;
+    
+    /* Size the chunk */
+    while (n < count) {
+        const hal_spi_xfer_t* xfer = &xfers[n];
+        uint32_t entry_length = sizeof(hal_spi_batch_entry_t) +
+                                ((xfer->tx_data != NULL) ? xfer->length : 0U);
+        
+        if (payload_length + entry_length > HAL_SPI_MSG_MAX_PAYLOAD ||
+            response_length + ((xfer->rx_data != NULL) ? xfer->length : 0U) > HAL_SPI_MSG_MAX_PAYLOAD) {
+            break;
+        }
+        payload_length += entry_length;
+        response_length += (xfer->rx_data != NULL) ? xfer->length : 0U;
+        n++;
+    }
+    
+    if (n == 0) {
+        *result = HAL_ERROR_INVALID_PARAM;  /* Single descriptor exceeds the message size */
+        return 0;
+    }
+    
+    uint32_t sequence;
+    uint16_t length;
+    
+    hal_mutex_lock(&ch->lock);
+    
+    if (ch->region == NULL) {
+        hal_mutex_unlock(&ch->lock);
+        *result = HAL_ERROR_NOT_INIT;
+        return 0;
+    }
+    
+    /* Entries and TX data go straight from the descriptors into the ring */
+    *result = shm_msg_begin(ch, HAL_SPI_MSG_BATCH, device, (uint16_t)payload_length,
+                            &sequence, start_us, timeout_ms);
+    if (*result == HAL_OK) {
+        for (uint16_t i = 0; i < n; i++) {
+            const hal_spi_xfer_t* xfer = &xfers[i];
+            hal_spi_batch_entry_t entry;
+            
+            if (xfer->tx_data != NULL && xfer->rx_data != NULL) {
+                entry.msg_type = HAL_SPI_MSG_TRANSFER;
+            } else if (xfer->tx_data != NULL) {
+                entry.msg_type = HAL_SPI_MSG_SEND;
+            } else {
+                entry.msg_type = HAL_SPI_MSG_RECEIVE;
+            }
+            entry.length = xfer->length;
+            
+            shm_msg_put(ch, &entry, sizeof(entry));
+            if (xfer->tx_data != NULL) {
+                shm_msg_put(ch, xfer->tx_data, xfer->length);
+            }
+        }
+        shm_msg_end(ch);
+        
+        *result = shm_rsp_begin(ch, sequence, &length, start_us, timeout_ms);
+    }
+    
+    /* The response is the RX data of all descriptors, concatenated */
+    if (*result == HAL_OK) {
+        uint32_t remaining = length;
+        
+        for (uint16_t i = 0; i < n && remaining > 0; i++) {
+            if (xfers[i].rx_data != NULL) {
+                uint32_t chunk = (remaining < xfers[i].length) ? remaining : xfers[i].length;
+                shm_rsp_get(ch, xfers[i].rx_data, chunk);
+                remaining -= chunk;
+            }
+        }
+        shm_rsp_end(ch);
+        
+        *result = (length == response_length) ? HAL_OK : HAL_ERROR;
+    }
+    
+    hal_mutex_unlock(&ch->lock);
+    return (*result == HAL_OK) ? n : 0;
+}
+
+static hal_status_t shm_spi_submit_batch(hal_spi_device_t device, 
+                                         const hal_spi_xfer_t* xfers, 
+                                         uint16_t count, 
+                                         uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    shm_spi_device_t* dev = &g_shm_spi_devices[device];
+    
+    if (!dev->is_initialized || g_shm_channel.region == NULL) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    
+    /* One round trip per chunk, normally one for the whole batch */
+    hal_status_t status = HAL_OK;
+    uint16_t done = 0;
+    uint32_t tx_bytes = 0;
+    uint32_t rx_bytes = 0;
+    
+    while (done < count) {
+        uint16_t n = shm_run_batch_chunk(&g_shm_channel, device, &xfers[done], 
+                                         (uint16_t)(count - done), timeout_ms, &status);
+        if (n == 0) {
+            break;
+        }
+        
+        for (uint16_t i = done; i < done + n; i++) {
+            if (xfers[i].tx_data != NULL) {
+                tx_bytes += xfers[i].length;
+            }
+            if (xfers[i].rx_data != NULL) {
+                rx_bytes += xfers[i].length;
+            }
+        }
+        done = (uint16_t)(done + n);
+    }
+    
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_BATCH, status, tx_bytes, rx_bytes, start_us);
+    hal_spi_release(&dev->status);
+    
+    HAL_LOG_DEBUG("[SHM-SPI] Batch of %u transfers on device %d\n", done, device);
+    HAL_TRACE(HAL_TRACE_EV_BATCH, device, done);
+    
+    return status;
+}
+
+static hal_status_t shm_spi_transfer_sg(hal_spi_device_t device, 
+                                        const hal_spi_xfer_t* segs, 
+                                        uint16_t count, 
+                                        uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    shm_spi_device_t* dev = &g_shm_spi_devices[device];
+    
+    if (!dev->is_initialized || g_shm_channel.region == NULL) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    
+    uint32_t frame_bytes;
+    uint32_t tx_bytes;
+    uint32_t rx_bytes;
+    hal_spi_op_t op = hal_spi_sg_classify(segs, count, &frame_bytes, &tx_bytes, &rx_bytes);
+    hal_status_t status;
+    
+    /* The frame travels as a plain TRANSFER, SEND or RECEIVE message */
+    if (op == HAL_SPI_OP_SEND) {
+        status = shm_request(&g_shm_channel, HAL_SPI_MSG_SEND, device, NULL, 0, 
+                             segs, count, false, false, 0, timeout_ms);
+    } else if (op == HAL_SPI_OP_RECEIVE) {
+        uint8_t req_data[2] = {(uint8_t)(frame_bytes >> 8), (uint8_t)(frame_bytes & 0xFF)};
+        status = shm_request(&g_shm_channel, HAL_SPI_MSG_RECEIVE, device, req_data, 2, 
+                             segs, count, false, false, frame_bytes, timeout_ms);
+    } else {
+        status = shm_request(&g_shm_channel, HAL_SPI_MSG_TRANSFER, device, NULL, 0, 
+                             segs, count, true, true, frame_bytes, timeout_ms);
+    }
+    
+    if (status != HAL_OK) {
+        hal_spi_stats_record(device, &dev->status, op, status, 0, 0, start_us);
+        hal_spi_release(&dev->status);
+        return status;
+    }
+    
+    hal_spi_stats_record(device, &dev->status, op, HAL_OK, tx_bytes, rx_bytes, start_us);
+    hal_spi_release(&dev->status);
+    
+    HAL_LOG_DEBUG("[SHM-SPI] Scatter-gather frame of %lu bytes in %u segments on device %d\n", 
+                  (unsigned long)frame_bytes, count, device);
+    HAL_TRACE(HAL_TRACE_EV_FROM_OP(op), device, frame_bytes);
+    
+    return HAL_OK;
+}
+
+static hal_status_t shm_spi_transfer_large(hal_spi_device_t device, 
+                                           const uint8_t* tx_data, 
+                                           uint8_t* rx_data, 
+                                           uint32_t length, 
+                                           uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    shm_spi_device_t* dev = &g_shm_spi_devices[device];
+    
+    if (!dev->is_initialized || g_shm_channel.region == NULL) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    
+    hal_spi_op_t op = hal_spi_large_classify(tx_data, rx_data);
+    uint8_t msg_type = (op == HAL_SPI_OP_SEND) ? HAL_SPI_MSG_SEND :
+                       (op == HAL_SPI_OP_RECEIVE) ? HAL_SPI_MSG_RECEIVE : HAL_SPI_MSG_TRANSFER;
+    hal_status_t status = HAL_OK;
+    
+    /* One message per chunk, copied straight between the caller's buffers and
+     * the rings; HAL_SPI_MSG_FLAG_MORE keeps the frame open up to the last one */
+    for (uint32_t offset = 0; offset < length && status == HAL_OK; offset += HAL_SPI_LARGE_CHUNK) {
+        uint32_t left = length - offset;
+        uint16_t chunk = (uint16_t)((left < HAL_SPI_LARGE_CHUNK) ? left : HAL_SPI_LARGE_CHUNK);
+        uint8_t chunk_type = (left > chunk) ? (uint8_t)(msg_type | HAL_SPI_MSG_FLAG_MORE) : msg_type;
+        uint32_t left_ms = 0;
+        
+        /* One deadline for the whole frame */
+        if (timeout_ms > 0) {
+            uint32_t elapsed_ms = (hal_time_now_us() - start_us) / 1000U;
+            if (elapsed_ms >= timeout_ms) {
+                status = HAL_ERROR_TIMEOUT;
+                break;
+            }
+            left_ms = timeout_ms - elapsed_ms;
+        }
+        
+        hal_spi_xfer_t seg = {
+            .tx_data = (tx_data != NULL) ? &tx_data[offset] : NULL,
+            .rx_data = (rx_data != NULL) ? &rx_data[offset] : NULL,
+            .length = chunk
+        };
+        
+        if (op == HAL_SPI_OP_RECEIVE) {
+            uint8_t req_data[2] = {(uint8_t)(chunk >> 8), (uint8_t)(chunk & 0xFF)};
+            status = shm_request(&g_shm_channel, (hal_spi_msg_type_t)chunk_type, device, req_data, 2, 
+                                 &seg, 1, false, false, chunk, left_ms);
+        } else {
+            status = shm_request(&g_shm_channel, (hal_spi_msg_type_t)chunk_type, device, NULL, 0, 
+                                 &seg, 1, false, false, 
+                                 (op == HAL_SPI_OP_SEND) ? 0U : chunk, left_ms);
+        }
+    }
+    
+    if (status != HAL_OK) {
+        hal_spi_stats_record(device, &dev->status, op, status, 0, 0, start_us);
+        hal_spi_release(&dev->status);
+        return status;
+    }
+    
+    hal_spi_stats_record(device, &dev->status, op, HAL_OK, 
+                         (tx_data != NULL) ? length : 0U, 
+                         (rx_data != NULL) ? length : 0U, 
+                         start_us);
+    hal_spi_release(&dev->status);
+    
+    HAL_LOG_DEBUG("[SHM-SPI] Large frame of %lu bytes on device %d\n", 
+                  (unsigned long)length, device);
+    HAL_TRACE(HAL_TRACE_EV_FROM_OP(op), device, length);
+    
+    return HAL_OK;
+}
+
+/**
+ * @brief Ask the server for the next fill of one half of the stream buffer
+ * @details Caller holds the channel lock. Only the request is written; the
+ *          response is picked up by shm_stream_deliver().
+ */
+static hal_status_t shm_stream_post(shm_channel_t* ch, hal_spi_device_t device, uint8_t half)
+{
+    shm_spi_device_t* dev = &g_shm_spi_devices[device];
+    uint16_t length = dev->stream_half;
+    uint8_t req_data[2] = {(uint8_t)(length >> 8), (uint8_t)(length & 0xFF)};
+    uint32_t sequence;
+    
+    /* Only waits if the server lags behind the request ring */
+    hal_status_t status = shm_msg_begin(ch, HAL_SPI_MSG_RECEIVE, device, sizeof(req_data), 
+                                        &sequence, hal_time_now_us(), SHM_CONTROL_TIMEOUT_MS);
+    if (status != HAL_OK) {
+        return status;
+    }
+    shm_msg_put(ch, req_data, sizeof(req_data));
+    shm_msg_end(ch);
+    
+    dev->stream_sequence[half] = sequence;
+    dev->stream_result[half] = HAL_ERROR_BUSY;
+    dev->stream_pending[half] = true;
+    return HAL_OK;
+}
+
+/**
+ * @brief Deliver the next stream half if its data has arrived
+ * @return HAL_ERROR_BUSY while the stream runs, HAL_OK once it has ended (or
+ *         if none was running)
+ */
+static hal_status_t shm_spi_poll(hal_spi_device_t device)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    shm_spi_device_t* dev = &g_shm_spi_devices[device];
+    shm_channel_t* ch = &g_shm_channel;
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    hal_mutex_lock(&ch->lock);
+    
+    if (dev->stream_callback == NULL) {
+        hal_mutex_unlock(&ch->lock);
+        return HAL_OK;
+    }
+    
+    uint8_t half = dev->stream_next;
+    if (dev->stream_pending[half] && ch->region != NULL) {
+        shm_rsp_drain(ch);
+    }
+    if (dev->stream_pending[half]) {
+        hal_mutex_unlock(&ch->lock);
+        return HAL_ERROR_BUSY;
+    }
+    
+    hal_spi_stream_callback_t callback = dev->stream_callback;
+    void* user_data = dev->stream_user_data;
+    hal_status_t status = dev->stream_result[half];
+    uint16_t length = dev->stream_half;
+    uint8_t* data = dev->stream_buffer + (half * length);
+    uint32_t start_us = dev->stream_start_us;
+    
+    if (status != HAL_OK) {
+        shm_stream_end(dev);
+        hal_mutex_unlock(&ch->lock);
+        
+        hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_RECEIVE, status, 0, 0, start_us);
+        callback(device, status, NULL, 0, user_data);
+        return HAL_OK;
+    }
+    
+    dev->stream_result[half] = HAL_ERROR_BUSY;  /* With the application until the callback returns */
+    dev->stream_next ^= 1U;
+    dev->stream_start_us = hal_time_now_us();
+    hal_mutex_unlock(&ch->lock);
+    
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_RECEIVE, HAL_OK, 0, length, start_us);
+    HAL_TRACE(HAL_TRACE_EV_RECEIVE, device, length);
+    
+    callback(device, HAL_OK, data, length, user_data);
+    
+    /* Refill the half just handed out, unless the callback stopped (or restarted) the stream */
+    hal_mutex_lock(&ch->lock);
+    if (dev->stream_callback != NULL && 
+        !dev->stream_pending[half] && dev->stream_result[half] == HAL_ERROR_BUSY) {
+        status = (ch->region != NULL) ? shm_stream_post(ch, device, half) : HAL_ERROR_NOT_INIT;
+        if (status != HAL_OK) {
+            callback = dev->stream_callback;
+            user_data = dev->stream_user_data;
+            shm_stream_end(dev);
+            hal_mutex_unlock(&ch->lock);
+            
+            hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_RECEIVE, status, 0, 0, 
+                                 dev->stream_start_us);
+            callback(device, status, NULL, 0, user_data);
+            return HAL_OK;
+        }
+    }
+    bool streaming = (dev->stream_callback != NULL);
+    hal_mutex_unlock(&ch->lock);
+    
+    return streaming ? HAL_ERROR_BUSY : HAL_OK;
+}
+
+static hal_status_t shm_spi_stream_start(hal_spi_device_t device, 
+                                         uint8_t* buffer, 
+                                         uint16_t length, 
+                                         hal_spi_stream_callback_t callback, 
+                                         void* user_data)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || callback == NULL)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    shm_spi_device_t* dev = &g_shm_spi_devices[device];
+    shm_channel_t* ch = &g_shm_channel;
+    
+    if (!dev->is_initialized || ch->region == NULL) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    /* The device stays claimed until shm_spi_stream_stop() */
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    
+    hal_mutex_lock(&ch->lock);
+    
+    dev->stream_user_data = user_data;
+    dev->stream_buffer = buffer;
+    dev->stream_half = length / 2U;
+    dev->stream_next = 0;
+    dev->stream_start_us = hal_time_now_us();
+    dev->stream_callback = callback;
+    
+    /* Both halves are requested up front, so the server is always one half ahead */
+    hal_status_t status = (ch->region != NULL) ? shm_stream_post(ch, device, 0) : HAL_ERROR_NOT_INIT;
+    if (status == HAL_OK) {
+        status = shm_stream_post(ch, device, 1);
+    }
+    if (status != HAL_OK) {
+        shm_stream_end(dev);
+    }
+    
+    hal_mutex_unlock(&ch->lock);
+    
+    if (status != HAL_OK) {
+        return status;
+    }
+    
+    HAL_LOG_DEBUG("[SHM-SPI] Stream started on device %d (%u byte halves)\n", 
+                  device, dev->stream_half);
+    
+    return HAL_OK;
+}
+
+static hal_status_t shm_spi_stream_stop(hal_spi_device_t device)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    shm_spi_device_t* dev = &g_shm_spi_devices[device];
+    shm_channel_t* ch = &g_shm_channel;
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    hal_mutex_lock(&ch->lock);
+    bool streaming = (dev->stream_callback != NULL);
+    if (streaming) {
+        shm_stream_end(dev);
+    }
+    hal_mutex_unlock(&ch->lock);
+    
+    if (streaming) {
+        HAL_LOG_DEBUG("[SHM-SPI] Stream stopped on device %d\n", device);
+    }
+    
+    return HAL_OK;
+}
+
+/*============================================================================*/
+/* Operations Table                                                           */
+/*============================================================================*/
+
+const hal_spi_ops_t hal_spi_shm_ops = {
+    .init           = shm_spi_init,
+    .deinit         = shm_spi_deinit,
+    .transfer       = shm_spi_transfer,
+    .send           = shm_spi_send,
+    .receive        = shm_spi_receive,
+    .set_config     = shm_spi_set_config,
+    .get_status     = shm_spi_get_status,
+    .poll           = shm_spi_poll,
+    .submit_batch   = shm_spi_submit_batch,
+    .transfer_sg    = shm_spi_transfer_sg,
+    .stream_start   = shm_spi_stream_start,
+    .stream_stop    = shm_spi_stream_stop,
+    .transfer_large = shm_spi_transfer_large
+};
@@ -2,34 +2,75 @@
  * @file    hal_spi_sim.c
  * @brief   SPI HAL Simulation Implementation
  * @details Concrete implementation for PC-based simulation (no hardware required)
- * @note    Uses in-memory buffers to simulate SPI communication
+ * @note    Uses in-memory buffers to simulate SPI communication, or a device
+ *          model attached with hal_sim_attach_model() (hal_spi_sim.h)
  * @author  EswPla HAL Team
  * @date    2026-02-21
  */
 
 #include "yolpiya.h"
 #include "hal_spi.h"
+#include "hal_spi_sim.h"
+#include "hal_spi_backend.h"
+#include "hal_log.h"
+#include "hal_trace.h"
+#include "hal_probe.h"
 #include <time.h>
 
+#ifdef _WIN32
+    #include <windows.h>
+#endif
+
 /*============================================================================*/
 /* Private Definitions                                                        */
 /*============================================================================*/
 
-#define SIM_RX_BUFFER_SIZE  1024
+#if (HAL_SIM_RX_BUFFER_SIZE & (HAL_SIM_RX_BUFFER_SIZE - 1U)) != 0U
+#error "HAL_SIM_RX_BUFFER_SIZE must be a power of two"
+#endif
+
+#define SIM_RX_BUFFER_MASK  (HAL_SIM_RX_BUFFER_SIZE - 1U)
+
+#if (HAL_SIM_RX_POOL_SLOTS < 1) || (HAL_SIM_RX_POOL_SLOTS > 32)
+#error "HAL_SIM_RX_POOL_SLOTS must be 1 to 32"
+#endif
 
 /**
  * @brief Simulated SPI device state
+ * @details The small fields are packed together after the status. The
+ *          RX ring is taken from g_sim_rx_pool at init.
  */
 typedef struct {
-    bool                is_initialized;
-    hal_spi_config_t    config;
     hal_spi_status_t    status;
+    bool                is_initialized;
+    uint8_t             stream_next;                    /**< Half filled next (0 or 1) */
+    uint16_t            stream_half;                    /**< Bytes per half */
+    uint16_t            async_length;
+    const hal_sim_model_t* model;                       /**< NULL: loopback/random, kept across deinit */
+    hal_spi_config_t    config;                         /**< Clock and word size of the bus timing */
+    hal_sim_timing_t    timing;                         /**< Bus timing, kept across deinit */
+    hal_sim_bus_time_t  bus_time;                       /**< Accounted bus time */
+    uint64_t            bus_free_ns;                    /**< Real time: sim_clock_ns() when the bus is idle again */
     
     /* Simulation-specific data */
-    uint8_t             rx_buffer[SIM_RX_BUFFER_SIZE];  /**< Simulated RX data */
-    uint16_t            rx_buffer_head;                 /**< RX buffer write position */
-    uint16_t            rx_buffer_tail;                 /**< RX buffer read position */
+    uint8_t*            rx_buffer;                      /**< Simulated RX data (SPSC ring) */
+    volatile uint32_t   rx_head;                        /**< Bytes ever queued (producer) */
+    volatile uint32_t   rx_tail;                        /**< Bytes ever received (consumer) */
+    volatile uint32_t   rx_dropped;                     /**< Bytes lost to a full ring */
     uint32_t            last_transfer_ms;               /**< Timestamp of last transfer */
+    
+    /* Pending asynchronous completion (delivered from poll) */
+    hal_spi_callback_t  async_callback;                 /**< NULL if nothing pending */
+    void*               async_user_data;
+    uint32_t            async_start_us;                 /**< hal_time_now_us() at submission */
+    uint64_t            async_done_ns;                  /**< Real time: sim_clock_ns() at completion */
+    
+    /* Continuous receive (one half filled per poll) */
+    hal_spi_stream_callback_t stream_callback;          /**< NULL if not streaming */
+    void*               stream_user_data;
+    uint8_t*            stream_buffer;
+    uint32_t            stream_start_us;                /**< hal_time_now_us() when that half started */
+    uint64_t            stream_done_ns;                 /**< Real time: sim_clock_ns() when that half is full */
 } sim_spi_device_t;
 
 /*============================================================================*/
@@ -37,6 +78,12 @@ typedef struct {
 /*============================================================================*/
 
 static sim_spi_device_t g_sim_spi_devices[HAL_SPI_MAX_INTERFACES] = {0};
+
+/**
+ * @brief RX rings, handed to devices at init
+ */
+static uint8_t g_sim_rx_storage[HAL_SIM_RX_POOL_SLOTS][HAL_SIM_RX_BUFFER_SIZE];
+static hal_spi_pool_t g_sim_rx_pool = HAL_SPI_POOL_INIT(g_sim_rx_storage, HAL_SIM_RX_POOL_SLOTS, HAL_SIM_RX_BUFFER_SIZE);
 static bool g_sim_initialized = false;
 
 /*============================================================================*/
@@ -51,54 +98,272 @@ static void sim_initialize_environment(void)
     if (!g_sim_initialized) {
         srand((unsigned int)time(NULL));
         g_sim_initialized = true;
-        printf("[SIM-SPI] Simulation environment initialized\n");
+        HAL_LOG_INFO("[SIM-SPI] Simulation environment initialized\n");
     }
 }
 
 /**
- * @brief Add data to simulated RX buffer
+ * @brief Add data to simulated RX buffer (producer side)
+ * @details Copies what fits in at most two blocks, then publishes it with one
+ *          store of rx_head. The rest is dropped and counted.
+ * @return Number of bytes queued
  */
-static void sim_add_rx_data(sim_spi_device_t* dev, const uint8_t* data, uint16_t length)
+static uint16_t sim_add_rx_data(sim_spi_device_t* dev, const uint8_t* data, uint16_t length)
 {
-    for (uint16_t i = 0; i < length && dev->rx_buffer_head < SIM_RX_BUFFER_SIZE; i++) {
-        dev->rx_buffer[dev->rx_buffer_head++] = data[i];
+    uint32_t head = dev->rx_head;
+    uint32_t space = HAL_SIM_RX_BUFFER_SIZE - (head - HAL_ATOMIC_LOAD_U32(&dev->rx_tail));
+    uint32_t count = (length < space) ? length : space;
+    uint32_t offset = head & SIM_RX_BUFFER_MASK;
+    uint32_t first = (count < HAL_SIM_RX_BUFFER_SIZE - offset) ? count : HAL_SIM_RX_BUFFER_SIZE - offset;
+    
+    memcpy(&dev->rx_buffer[offset], data, first);
+    memcpy(&dev->rx_buffer[0], &data[first], count - first);
+    HAL_ATOMIC_STORE_U32(&dev->rx_head, head + count);
+    
+    if (count < length) {
+        (void)HAL_ATOMIC_FETCH_ADD_U32(&dev->rx_dropped, length - count);
     }
+    
+    return (uint16_t)count;
 }
 
 /**
- * @brief Get data from simulated RX buffer
+ * @brief Get data from simulated RX buffer (consumer side)
+ * @return Number of bytes read
  */
 static uint16_t sim_get_rx_data(sim_spi_device_t* dev, uint8_t* data, uint16_t length)
 {
-    uint16_t bytes_read = 0;
+    uint32_t tail = dev->rx_tail;
+    uint32_t pending = HAL_ATOMIC_LOAD_U32(&dev->rx_head) - tail;
+    uint32_t count = (length < pending) ? length : pending;
+    uint32_t offset = tail & SIM_RX_BUFFER_MASK;
+    uint32_t first = (count < HAL_SIM_RX_BUFFER_SIZE - offset) ? count : HAL_SIM_RX_BUFFER_SIZE - offset;
+    
+    memcpy(data, &dev->rx_buffer[offset], first);
+    memcpy(&data[first], &dev->rx_buffer[0], count - first);
+    HAL_ATOMIC_STORE_U32(&dev->rx_tail, tail + count);
     
-    while (bytes_read < length && dev->rx_buffer_tail < dev->rx_buffer_head) {
-        data[bytes_read++] = dev->rx_buffer[dev->rx_buffer_tail++];
+    return (uint16_t)count;
+}
+
+/**
+ * @brief Host clock for real-time pacing, in nanoseconds
+ */
+static uint64_t sim_clock_ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER frequency = {0};
+    LARGE_INTEGER counter;
+    
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000000ULL + 
+           ((uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000000ULL) / (uint64_t)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Bus time of one frame of length bytes (see hal_sim_timing_t)
+ */
+static uint64_t sim_frame_ns(const sim_spi_device_t* dev, uint32_t length)
+{
+    /* 64-bit throughout: 64 KiB at 8 bits is 5.2e14 bit-nanoseconds */
+    uint64_t bits = (uint64_t)length * 8U;
+    uint64_t word_bits = (dev->config.data_bits > 0U) ? dev->config.data_bits : 8U;
+    uint64_t words = (bits + word_bits - 1U) / word_bits;
+    uint64_t time_ns = (uint64_t)dev->timing.cs_setup_ns + dev->timing.cs_hold_ns;
+    
+    if (dev->config.baudrate > 0U) {
+        time_ns += (bits * 1000000000ULL + dev->config.baudrate - 1U) / dev->config.baudrate;
+    }
+    if (words > 1U) {
+        time_ns += (words - 1U) * dev->timing.word_gap_ns;
     }
     
-    /* Reset buffer positions if empty */
-    if (dev->rx_buffer_tail >= dev->rx_buffer_head) {
-        dev->rx_buffer_head = 0;
-        dev->rx_buffer_tail = 0;
+    return time_ns;
+}
+
+/**
+ * @brief Simulate the bus time of one frame
+ * @details Virtual and real time both account the frame. In real time the
+ *          frame starts once the previous one and its gap are over and, if
+ *          wait is set, the caller is held until it has ended.
+ * @param wait false for operations completed later from sim_spi_poll()
+ * @return sim_clock_ns() at the end of the frame in real time, 0 otherwise
+ */
+static uint64_t sim_transfer_delay(sim_spi_device_t* dev, uint32_t length, bool wait)
+{
+    if (dev->timing.mode == HAL_SIM_TIMING_OFF) {
+        return 0;
     }
     
-    return bytes_read;
+    uint64_t frame_ns = sim_frame_ns(dev, length);
+    
+    dev->bus_time.busy_ns += frame_ns;
+    dev->bus_time.clock_ns += frame_ns + dev->timing.frame_gap_ns;
+    dev->bus_time.frames++;
+    
+    if (dev->timing.mode != HAL_SIM_TIMING_REALTIME) {
+        return 0;
+    }
+    
+    uint64_t now = sim_clock_ns();
+    uint64_t end = ((now > dev->bus_free_ns) ? now : dev->bus_free_ns) + frame_ns;
+    
+    dev->bus_free_ns = end + dev->timing.frame_gap_ns;
+    
+    /* Busy-wait: sleeping is far coarser than a frame */
+    while (wait && sim_clock_ns() < end) {
+        /* Spin */
+    }
+    
+    return end;
+}
+
+/**
+ * @brief Whether a frame that ends at done_ns (sim_transfer_delay()) is still on the bus
+ */
+static bool sim_frame_pending(uint64_t done_ns)
+{
+    return (done_ns != 0U) && (sim_clock_ns() < done_ns);
+}
+
+/**
+ * @brief Simulate the data exchange of a full-duplex transfer
+ */
+static void sim_exchange(sim_spi_device_t* dev, const uint8_t* tx_data, uint8_t* rx_data, uint16_t length)
+{
+    if (dev->model != NULL) {
+        dev->model->transfer(dev->model->context, tx_data, rx_data, length);
+        return;
+    }
+    
+    /* In simulation, echo back the transmitted data with optional modification */
+    for (uint16_t i = 0; i < length; i++) {
+        /* Add some variation to simulate real device response */
+        rx_data[i] = tx_data[i] ^ 0x00;  /* For now, just echo */
+    }
+}
+
+/**
+ * @brief Simulate a send: loop the data back to the next receive
+ */
+static void sim_send_data(sim_spi_device_t* dev, const uint8_t* data, uint16_t length)
+{
+    if (dev->model != NULL) {
+        dev->model->transfer(dev->model->context, data, NULL, length);
+        return;
+    }
+    
+    (void)sim_add_rx_data(dev, data, length);
+}
+
+/**
+ * @brief Simulate a receive: drain the RX buffer, then ask the model or fill
+ *        with random data
+ */
+static void sim_receive_data(sim_spi_device_t* dev, uint8_t* data, uint16_t length)
+{
+    /* Get data from simulated RX buffer */
+    uint16_t bytes_read = sim_get_rx_data(dev, data, length);
+    
+    if (dev->model != NULL) {
+        if (bytes_read < length) {
+            dev->model->transfer(dev->model->context, NULL, &data[bytes_read], 
+                                 (uint16_t)(length - bytes_read));
+        }
+        return;
+    }
+    
+    /* Fill remaining with random data if buffer was empty */
+    for (uint16_t i = bytes_read; i < length; i++) {
+        data[i] = (uint8_t)(rand() & 0xFF);
+    }
+}
+
+/**
+ * @brief Simulate the data of one batch descriptor or scatter-gather segment
+ */
+static void sim_run_xfer(sim_spi_device_t* dev, const hal_spi_xfer_t* xfer)
+{
+    if (xfer->tx_data != NULL && xfer->rx_data != NULL) {
+        sim_exchange(dev, xfer->tx_data, xfer->rx_data, xfer->length);
+    } else if (xfer->tx_data != NULL) {
+        sim_send_data(dev, xfer->tx_data, xfer->length);
+    } else {
+        sim_receive_data(dev, xfer->rx_data, xfer->length);
+    }
 }
 
 /**
- * @brief Simulate SPI transfer delay based on baudrate
+ * @brief Clock a scatter-gather frame through the attached model
+ * @details The segments are one chip-select frame, so the model sees them as
+ *          one stream, staged in HAL_SIM_MODEL_CHUNK pieces: dummy zeros
+ *          stand in for missing TX data, RX data of send-only segments is
+ *          dropped, as on the socket and shared-memory backends.
  */
-static void sim_transfer_delay(const hal_spi_config_t* config, uint16_t length)
+static void sim_model_run_sg(sim_spi_device_t* dev, 
+                             const hal_spi_xfer_t* segs, 
+                             uint16_t count, 
+                             hal_spi_op_t op)
 {
-    /* Calculate transfer time in microseconds */
-    /* Time = (bits / baudrate) * 1,000,000 */
-    if (config->baudrate > 0) {
-        uint32_t bits = length * config->data_bits;
-        uint32_t time_us = (bits * 1000000UL) / config->baudrate;
+    uint8_t tx[HAL_SIM_MODEL_CHUNK];
+    uint8_t rx[HAL_SIM_MODEL_CHUNK];
+    uint16_t seg = 0;
+    uint16_t seg_offset = 0;
+    
+    while (seg < count) {
+        /* Gather the next chunk, remembering where it starts */
+        uint16_t first_seg = seg;
+        uint16_t first_offset = seg_offset;
+        uint16_t chunk = 0;
+        
+        while (seg < count && chunk < HAL_SIM_MODEL_CHUNK) {
+            uint16_t n = (uint16_t)(segs[seg].length - seg_offset);
+            if (n > HAL_SIM_MODEL_CHUNK - chunk) {
+                n = (uint16_t)(HAL_SIM_MODEL_CHUNK - chunk);
+            }
+            if (segs[seg].tx_data != NULL) {
+                memcpy(&tx[chunk], &segs[seg].tx_data[seg_offset], n);
+            } else {
+                memset(&tx[chunk], 0, n);
+            }
+            chunk = (uint16_t)(chunk + n);
+            seg_offset = (uint16_t)(seg_offset + n);
+            if (seg_offset == segs[seg].length) {
+                seg++;
+                seg_offset = 0;
+            }
+        }
+        
+        dev->model->transfer(dev->model->context, 
+                             (op == HAL_SPI_OP_RECEIVE) ? NULL : tx, 
+                             (op == HAL_SPI_OP_SEND) ? NULL : rx, 
+                             chunk);
         
-        /* For simulation purposes, we don't actually delay */
-        /* but we could add: usleep(time_us); on POSIX systems */
-        (void)time_us;
+        if (op == HAL_SPI_OP_SEND) {
+            continue;
+        }
+        
+        /* Scatter the response back over the same segments */
+        uint16_t done = 0;
+        for (uint16_t i = first_seg; done < chunk; i++) {
+            uint16_t offset = (i == first_seg) ? first_offset : 0U;
+            uint16_t n = (uint16_t)(segs[i].length - offset);
+            if (n > chunk - done) {
+                n = (uint16_t)(chunk - done);
+            }
+            if (segs[i].rx_data != NULL) {
+                memcpy(&segs[i].rx_data[offset], &rx[done], n);
+            }
+            done = (uint16_t)(done + n);
+        }
     }
 }
 
@@ -108,7 +373,7 @@ static void sim_transfer_delay(const hal_spi_config_t* config, uint16_t length)
 
 static hal_status_t sim_spi_init(hal_spi_device_t device, const hal_spi_config_t* config)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES || config == NULL) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || config == NULL)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -120,31 +385,41 @@ static hal_status_t sim_spi_init(hal_spi_device_t device, const hal_spi_config_t
         return HAL_ERROR_BUSY;
     }
     
+    dev->rx_buffer = hal_spi_pool_take(&g_sim_rx_pool);
+    if (dev->rx_buffer == NULL) {
+        HAL_LOG_ERROR("[SIM-SPI] ERROR: No RX ring left for device %d (HAL_SIM_RX_POOL_SLOTS)\n", device);
+        return HAL_ERROR_BUSY;
+    }
+    
     /* Store configuration */
     dev->config = *config;
     dev->status.state = HAL_STATE_READY;
-    dev->status.tx_count = 0;
-    dev->status.rx_count = 0;
-    dev->status.error_count = 0;
     dev->status.is_busy = false;
+    hal_spi_stats_reset(device, &dev->status);
     
     /* Initialize simulation buffers */
-    dev->rx_buffer_head = 0;
-    dev->rx_buffer_tail = 0;
-    memset(dev->rx_buffer, 0, SIM_RX_BUFFER_SIZE);
+    dev->rx_head = 0;
+    dev->rx_tail = 0;
+    dev->rx_dropped = 0;
     dev->last_transfer_ms = 0;
+    memset(&dev->bus_time, 0, sizeof(dev->bus_time));
+    dev->bus_free_ns = 0;
+    
+    if (dev->model != NULL && dev->model->reset != NULL) {
+        dev->model->reset(dev->model->context);
+    }
     
     dev->is_initialized = true;
     
-    printf("[SIM-SPI] Init device %d: %lu Hz, mode %d, %d-bit\n", 
-           device, config->baudrate, config->mode, config->data_bits);
+    HAL_LOG_INFO("[SIM-SPI] Init device %d: %lu Hz, mode %d, %d-bit\n", 
+                 device, config->baudrate, config->mode, config->data_bits);
     
     return HAL_OK;
 }
 
 static hal_status_t sim_spi_deinit(hal_spi_device_t device)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -154,10 +429,16 @@ static hal_status_t sim_spi_deinit(hal_spi_device_t device)
         return HAL_ERROR_NOT_INIT;
     }
     
-    printf("[SIM-SPI] Deinit device %d (TX: %u, RX: %u, Errors: %u)\n", 
-           device, dev->status.tx_count, dev->status.rx_count, dev->status.error_count);
+    HAL_LOG_INFO("[SIM-SPI] Deinit device %d (TX: %u, RX: %u, Errors: %u)\n", 
+                 device, dev->status.tx_count, dev->status.rx_count, dev->status.error_count);
     
+    hal_spi_pool_give(&g_sim_rx_pool, dev->rx_buffer);
+    
+    const hal_sim_model_t* model = dev->model;
+    hal_sim_timing_t timing = dev->timing;
     memset(dev, 0, sizeof(sim_spi_device_t));
+    dev->model = model;
+    dev->timing = timing;
     return HAL_OK;
 }
 
@@ -167,7 +448,7 @@ static hal_status_t sim_spi_transfer(hal_spi_device_t device,
                                      uint16_t length, 
                                      uint32_t timeout_ms)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -177,28 +458,24 @@ static hal_status_t sim_spi_transfer(hal_spi_device_t device,
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (dev->status.is_busy) {
+    if (!hal_spi_claim(&dev->status)) {
         return HAL_ERROR_BUSY;
     }
-    
-    dev->status.is_busy = true;
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;  /* Simulated transfers cannot time out */
     
     /* Simulate transfer delay */
-    sim_transfer_delay(&dev->config, length);
+    (void)sim_transfer_delay(dev, length, true);
     
-    /* In simulation, echo back the transmitted data with optional modification */
-    for (uint16_t i = 0; i < length; i++) {
-        /* Add some variation to simulate real device response */
-        rx_data[i] = tx_data[i] ^ 0x00;  /* For now, just echo */
-    }
+    sim_exchange(dev, tx_data, rx_data, length);
     
-    dev->status.tx_count += length;
-    dev->status.rx_count += length;
-    dev->status.is_busy = false;
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_TRANSFER, HAL_OK, length, length, start_us);
+    hal_spi_release(&dev->status);
     dev->last_transfer_ms = (uint32_t)time(NULL);
     
-    printf("[SIM-SPI] Transferred %d bytes on device %d (timeout=%u ms)\n", 
-           length, device, timeout_ms);
+    HAL_LOG_DEBUG("[SIM-SPI] Transferred %d bytes on device %d (timeout=%u ms)\n", 
+                  length, device, timeout_ms);
+    HAL_TRACE(HAL_TRACE_EV_TRANSFER, device, length);
     
     return HAL_OK;
 }
@@ -208,7 +485,7 @@ static hal_status_t sim_spi_send(hal_spi_device_t device,
                                  uint16_t length, 
                                  uint32_t timeout_ms)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -218,24 +495,25 @@ static hal_status_t sim_spi_send(hal_spi_device_t device,
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (dev->status.is_busy) {
+    if (!hal_spi_claim(&dev->status)) {
         return HAL_ERROR_BUSY;
     }
-    
-    dev->status.is_busy = true;
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;  /* Simulated transfers cannot time out */
     
     /* Simulate transfer delay */
-    sim_transfer_delay(&dev->config, length);
+    (void)sim_transfer_delay(dev, length, true);
     
-    /* In simulation mode, store sent data as potential RX data (loopback) */
-    sim_add_rx_data(dev, data, length);
+    /* Without a model, sent data becomes the next RX data (loopback) */
+    sim_send_data(dev, data, length);
     
-    dev->status.tx_count += length;
-    dev->status.is_busy = false;
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_SEND, HAL_OK, length, 0, start_us);
+    hal_spi_release(&dev->status);
     dev->last_transfer_ms = (uint32_t)time(NULL);
     
-    printf("[SIM-SPI] Sent %d bytes on device %d (timeout=%u ms)\n", 
-           length, device, timeout_ms);
+    HAL_LOG_DEBUG("[SIM-SPI] Sent %d bytes on device %d (timeout=%u ms)\n", 
+                  length, device, timeout_ms);
+    HAL_TRACE(HAL_TRACE_EV_SEND, device, length);
     
     return HAL_OK;
 }
@@ -245,7 +523,7 @@ static hal_status_t sim_spi_receive(hal_spi_device_t device,
                                     uint16_t length, 
                                     uint32_t timeout_ms)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -255,29 +533,24 @@ static hal_status_t sim_spi_receive(hal_spi_device_t device,
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (dev->status.is_busy) {
+    if (!hal_spi_claim(&dev->status)) {
         return HAL_ERROR_BUSY;
     }
-    
-    dev->status.is_busy = true;
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;  /* Simulated transfers cannot time out */
     
     /* Simulate transfer delay */
-    sim_transfer_delay(&dev->config, length);
+    (void)sim_transfer_delay(dev, length, true);
     
-    /* Get data from simulated RX buffer */
-    uint16_t bytes_read = sim_get_rx_data(dev, data, length);
+    sim_receive_data(dev, data, length);
     
-    /* Fill remaining with random data if buffer was empty */
-    for (uint16_t i = bytes_read; i < length; i++) {
-        data[i] = (uint8_t)(rand() & 0xFF);
-    }
-    
-    dev->status.rx_count += length;
-    dev->status.is_busy = false;
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_RECEIVE, HAL_OK, 0, length, start_us);
+    hal_spi_release(&dev->status);
     dev->last_transfer_ms = (uint32_t)time(NULL);
     
-    printf("[SIM-SPI] Received %d bytes on device %d (timeout=%u ms)\n", 
-           length, device, timeout_ms);
+    HAL_LOG_DEBUG("[SIM-SPI] Received %d bytes on device %d (timeout=%u ms)\n", 
+                  length, device, timeout_ms);
+    HAL_TRACE(HAL_TRACE_EV_RECEIVE, device, length);
     
     return HAL_OK;
 }
@@ -285,7 +558,7 @@ static hal_status_t sim_spi_receive(hal_spi_device_t device,
 static hal_status_t sim_spi_set_config(hal_spi_device_t device, 
                                        const hal_spi_config_t* config)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES || config == NULL) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || config == NULL)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -295,15 +568,17 @@ static hal_status_t sim_spi_set_config(hal_spi_device_t device,
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (dev->status.is_busy) {
+    if (!hal_spi_claim(&dev->status)) {
         return HAL_ERROR_BUSY;
     }
     
     /* Update configuration */
     dev->config = *config;
     
-    printf("[SIM-SPI] Reconfigured device %d: %lu Hz, mode %d\n", 
-           device, config->baudrate, config->mode);
+    HAL_LOG_INFO("[SIM-SPI] Reconfigured device %d: %lu Hz, mode %d\n", 
+                 device, config->baudrate, config->mode);
+    
+    hal_spi_release(&dev->status);
     
     return HAL_OK;
 }
@@ -311,7 +586,7 @@ static hal_status_t sim_spi_set_config(hal_spi_device_t device,
 static hal_status_t sim_spi_get_status(hal_spi_device_t device, 
                                        hal_spi_status_t* status)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES || status == NULL) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || status == NULL)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -325,16 +600,437 @@ static hal_status_t sim_spi_get_status(hal_spi_device_t device,
     return HAL_OK;
 }
 
+static hal_status_t sim_spi_transfer_async(hal_spi_device_t device, 
+                                           const uint8_t* tx_data, 
+                                           uint8_t* rx_data, 
+                                           uint16_t length, 
+                                           uint32_t timeout_ms,
+                                           hal_spi_callback_t callback,
+                                           void* user_data)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || callback == NULL)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    sim_spi_device_t* dev = &g_sim_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    dev->async_start_us = hal_time_now_us();
+    (void)timeout_ms;  /* Simulated transfers always complete once their bus time is over */
+    
+    /* Data moves immediately, completion is deferred to sim_spi_poll() */
+    dev->async_done_ns = sim_transfer_delay(dev, length, false);
+    sim_exchange(dev, tx_data, rx_data, length);
+    
+    dev->async_callback = callback;
+    dev->async_user_data = user_data;
+    dev->async_length = length;
+    HAL_PROBE(HAL_PROBE_QUEUE_SUBMIT, device, length);
+    
+    return HAL_OK;
+}
+
+static hal_status_t sim_spi_poll(hal_spi_device_t device)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    sim_spi_device_t* dev = &g_sim_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (dev->stream_callback != NULL) {
+        /* Stand in for the circular DMA: fill the next half and hand it out */
+        hal_spi_stream_callback_t callback = dev->stream_callback;
+        uint16_t length = dev->stream_half;
+        uint8_t* data = dev->stream_buffer + (dev->stream_next * length);
+        
+        if (sim_frame_pending(dev->stream_done_ns)) {
+            return HAL_ERROR_BUSY;
+        }
+        
+        sim_receive_data(dev, data, length);
+        
+        hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_RECEIVE, HAL_OK, 
+                             0, length, dev->stream_start_us);
+        dev->stream_next ^= 1U;
+        dev->stream_start_us = hal_time_now_us();
+        dev->stream_done_ns = sim_transfer_delay(dev, length, false);
+        dev->last_transfer_ms = (uint32_t)time(NULL);
+        HAL_TRACE(HAL_TRACE_EV_RECEIVE, device, length);
+        
+        callback(device, HAL_OK, data, length, dev->stream_user_data);
+        
+        return (dev->stream_callback != NULL) ? HAL_ERROR_BUSY : HAL_OK;
+    }
+    
+    if (dev->async_callback == NULL) {
+        return HAL_OK;
+    }
+    
+    if (sim_frame_pending(dev->async_done_ns)) {
+        return HAL_ERROR_BUSY;
+    }
+    
+    /* Release the device before the callback so it can submit the next transfer */
+    hal_spi_callback_t callback = dev->async_callback;
+    void* user_data = dev->async_user_data;
+    
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_TRANSFER, HAL_OK, 
+                         dev->async_length, dev->async_length, dev->async_start_us);
+    dev->async_callback = NULL;
+    hal_spi_release(&dev->status);
+    dev->last_transfer_ms = (uint32_t)time(NULL);
+    HAL_PROBE(HAL_PROBE_QUEUE_COMPLETE, device, dev->async_length);
+    
+    callback(device, HAL_OK, user_data);
+    
+    return HAL_OK;
+}
+
+static hal_status_t sim_spi_submit_batch(hal_spi_device_t device, 
+                                         const hal_spi_xfer_t* xfers, 
+                                         uint16_t count, 
+                                         uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    sim_spi_device_t* dev = &g_sim_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;  /* Simulated transfers cannot time out */
+    
+    uint32_t tx_bytes = 0;
+    uint32_t rx_bytes = 0;
+    
+    /* One tight loop, descriptors were validated by the bridge */
+    for (uint16_t i = 0; i < count; i++) {
+        const hal_spi_xfer_t* xfer = &xfers[i];
+        
+        (void)sim_transfer_delay(dev, xfer->length, true);
+        sim_run_xfer(dev, xfer);
+        
+        if (xfer->tx_data != NULL) {
+            tx_bytes += xfer->length;
+        }
+        if (xfer->rx_data != NULL) {
+            rx_bytes += xfer->length;
+        }
+    }
+    
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_BATCH, HAL_OK, tx_bytes, rx_bytes, start_us);
+    hal_spi_release(&dev->status);
+    dev->last_transfer_ms = (uint32_t)time(NULL);
+    
+    HAL_LOG_DEBUG("[SIM-SPI] Batch of %u transfers on device %d (timeout=%u ms)\n", 
+                  count, device, timeout_ms);
+    HAL_TRACE(HAL_TRACE_EV_BATCH, device, count);
+    
+    return HAL_OK;
+}
+
+static hal_status_t sim_spi_transfer_sg(hal_spi_device_t device, 
+                                        const hal_spi_xfer_t* segs, 
+                                        uint16_t count, 
+                                        uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    sim_spi_device_t* dev = &g_sim_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;  /* Simulated transfers cannot time out */
+    
+    uint32_t frame_bytes;
+    uint32_t tx_bytes;
+    uint32_t rx_bytes;
+    hal_spi_op_t op = hal_spi_sg_classify(segs, count, &frame_bytes, &tx_bytes, &rx_bytes);
+    
+    /* One chip-select frame on the bus, however it is split in memory */
+    (void)sim_transfer_delay(dev, frame_bytes, true);
+    
+    if (dev->model != NULL) {
+        sim_model_run_sg(dev, segs, count, op);
+    } else {
+        /* Segments are simulated in place, nothing is staged */
+        for (uint16_t i = 0; i < count; i++) {
+            sim_run_xfer(dev, &segs[i]);
+        }
+    }
+    
+    hal_spi_stats_record(device, &dev->status, op, HAL_OK, tx_bytes, rx_bytes, start_us);
+    hal_spi_release(&dev->status);
+    dev->last_transfer_ms = (uint32_t)time(NULL);
+    
+    HAL_LOG_DEBUG("[SIM-SPI] Scatter-gather frame of %lu bytes in %u segments on device %d\n", 
+                  (unsigned long)frame_bytes, count, device);
+    HAL_TRACE(HAL_TRACE_EV_FROM_OP(op), device, frame_bytes);
+    
+    return HAL_OK;
+}
+
+static hal_status_t sim_spi_transfer_large(hal_spi_device_t device, 
+                                           const uint8_t* tx_data, 
+                                           uint8_t* rx_data, 
+                                           uint32_t length, 
+                                           uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    sim_spi_device_t* dev = &g_sim_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;  /* Simulated transfers cannot time out */
+    
+    hal_spi_op_t op = hal_spi_large_classify(tx_data, rx_data);
+    
+    /* Bus time of the whole frame, data in place in chunks the model accepts */
+    (void)sim_transfer_delay(dev, length, true);
+    
+    for (uint32_t offset = 0; offset < length; offset += HAL_SPI_LARGE_CHUNK) {
+        uint32_t left = length - offset;
+        hal_spi_xfer_t chunk = {
+            .tx_data = (tx_data != NULL) ? &tx_data[offset] : NULL,
+            .rx_data = (rx_data != NULL) ? &rx_data[offset] : NULL,
+            .length = (uint16_t)((left < HAL_SPI_LARGE_CHUNK) ? left : HAL_SPI_LARGE_CHUNK)
+        };
+        sim_run_xfer(dev, &chunk);
+    }
+    
+    hal_spi_stats_record(device, &dev->status, op, HAL_OK, 
+                         (tx_data != NULL) ? length : 0U, 
+                         (rx_data != NULL) ? length : 0U, 
+                         start_us);
+    hal_spi_release(&dev->status);
+    dev->last_transfer_ms = (uint32_t)time(NULL);
+    
+    HAL_LOG_DEBUG("[SIM-SPI] Large frame of %lu bytes on device %d\n", 
+                  (unsigned long)length, device);
+    HAL_TRACE(HAL_TRACE_EV_FROM_OP(op), device, length);
+    
+    return HAL_OK;
+}
+
+static hal_status_t sim_spi_stream_start(hal_spi_device_t device, 
+                                         uint8_t* buffer, 
+                                         uint16_t length, 
+                                         hal_spi_stream_callback_t callback, 
+                                         void* user_data)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || callback == NULL)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    sim_spi_device_t* dev = &g_sim_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    /* The device stays claimed until sim_spi_stream_stop() */
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    
+    dev->stream_user_data = user_data;
+    dev->stream_buffer = buffer;
+    dev->stream_half = length / 2U;
+    dev->stream_next = 0;
+    dev->stream_start_us = hal_time_now_us();
+    dev->stream_done_ns = sim_transfer_delay(dev, dev->stream_half, false);
+    dev->stream_callback = callback;
+    
+    HAL_LOG_DEBUG("[SIM-SPI] Stream started on device %d (%u byte halves)\n", 
+                  device, dev->stream_half);
+    
+    return HAL_OK;
+}
+
+static hal_status_t sim_spi_stream_stop(hal_spi_device_t device)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    sim_spi_device_t* dev = &g_sim_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (dev->stream_callback == NULL) {
+        return HAL_OK;
+    }
+    
+    dev->stream_callback = NULL;
+    dev->stream_buffer = NULL;
+    hal_spi_release(&dev->status);
+    
+    HAL_LOG_DEBUG("[SIM-SPI] Stream stopped on device %d\n", device);
+    
+    return HAL_OK;
+}
+
+/*============================================================================*/
+/* Simulation Extensions (hal_spi_sim.h)                                      */
+/*============================================================================*/
+
+hal_status_t hal_sim_attach_model(hal_spi_device_t device, const hal_sim_model_t* model)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES || (model != NULL && model->transfer == NULL)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    sim_spi_device_t* dev = &g_sim_spi_devices[device];
+    
+    /* Never swap the model under a running operation or stream */
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    
+    dev->model = model;
+    if (model != NULL && model->reset != NULL) {
+        model->reset(model->context);
+    }
+    
+    hal_spi_release(&dev->status);
+    
+    HAL_LOG_INFO("[SIM-SPI] Device %d: model %s\n", 
+                 device, (model != NULL) ? model->name : "none");
+    
+    return HAL_OK;
+}
+
+hal_status_t hal_sim_set_timing(hal_spi_device_t device, const hal_sim_timing_t* timing)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES || 
+        (timing != NULL && timing->mode > HAL_SIM_TIMING_REALTIME)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    sim_spi_device_t* dev = &g_sim_spi_devices[device];
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    
+    if (timing != NULL) {
+        dev->timing = *timing;
+    } else {
+        memset(&dev->timing, 0, sizeof(dev->timing));
+    }
+    dev->bus_free_ns = 0;
+    
+    hal_spi_release(&dev->status);
+    
+    return HAL_OK;
+}
+
+hal_status_t hal_sim_get_bus_time(hal_spi_device_t device, hal_sim_bus_time_t* bus_time)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES || bus_time == NULL) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    sim_spi_device_t* dev = &g_sim_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    *bus_time = dev->bus_time;
+    return HAL_OK;
+}
+
+hal_status_t hal_sim_inject_rx(hal_spi_device_t device, const uint8_t* data, uint16_t length)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES || data == NULL || length == 0) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    sim_spi_device_t* dev = &g_sim_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    /* No claim: the injector runs alongside the receiving application */
+    return (sim_add_rx_data(dev, data, length) == length) ? HAL_OK : HAL_ERROR_BUSY;
+}
+
+hal_status_t hal_sim_get_rx_info(hal_spi_device_t device, hal_sim_rx_info_t* info)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES || info == NULL) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    sim_spi_device_t* dev = &g_sim_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    uint32_t tail = HAL_ATOMIC_LOAD_U32(&dev->rx_tail);
+    info->pending = HAL_ATOMIC_LOAD_U32(&dev->rx_head) - tail;
+    info->capacity = HAL_SIM_RX_BUFFER_SIZE;
+    info->dropped = HAL_ATOMIC_LOAD_U32(&dev->rx_dropped);
+    
+    return HAL_OK;
+}
+
 /*============================================================================*/
 /* Public Operations Structure (Export)                                       */
 /*============================================================================*/
 
 const hal_spi_ops_t hal_spi_sim_ops = {
-    .init       = sim_spi_init,
-    .deinit     = sim_spi_deinit,
-    .transfer   = sim_spi_transfer,
-    .send       = sim_spi_send,
-    .receive    = sim_spi_receive,
-    .set_config = sim_spi_set_config,
-    .get_status = sim_spi_get_status
+    .init           = sim_spi_init,
+    .deinit         = sim_spi_deinit,
+    .transfer       = sim_spi_transfer,
+    .send           = sim_spi_send,
+    .receive        = sim_spi_receive,
+    .set_config     = sim_spi_set_config,
+    .get_status     = sim_spi_get_status,
+    .transfer_async = sim_spi_transfer_async,
+    .poll           = sim_spi_poll,
+    .submit_batch   = sim_spi_submit_batch,
+    .transfer_sg    = sim_spi_transfer_sg,
+    .stream_start   = sim_spi_stream_start,
+    .stream_stop    = sim_spi_stream_stop,
+    .transfer_large = sim_spi_transfer_large
 };
@@ -2,13 +2,21 @@
  * @file    hal_spi_socket.c
  * @brief   SPI HAL Socket Implementation
  * @details Concrete implementation using TCP/IP socket for remote/HIL testing
- * @note    Connects to external socket server (Python/C++) to feed/receive SPI data
+ * @note    Connects to external socket server (Python/C++) to feed/receive SPI data.
+ *          All devices share one connection; requests are pipelined and matched
+ *          to their responses by sequence number.
  * @author  EswPla HAL Team
  * @date    2026-02-21
  */
 
 #include "yolpiya.h"
 #include "hal_spi.h"
+#include "hal_spi_backend.h"
+#include "hal_os.h"
+#include "hal_log.h"
+#include "hal_trace.h"
+#include "hal_probe.h"
+#include "hal_spi_proto.h"
 
 /* Platform-specific socket includes */
 #ifdef _WIN32
@@ -16,18 +24,42 @@
     #include <ws2tcpip.h>
     #pragma comment(lib, "ws2_32.lib")
     typedef SOCKET socket_t;
+    typedef WSABUF socket_iovec_t;
     #define SOCKET_INVALID INVALID_SOCKET
     #define socket_close closesocket
     #define socket_error() WSAGetLastError()
+    #define SOCKET_EINTR WSAEINTR
+    #define SOCKET_EINPROGRESS WSAEWOULDBLOCK
+    #define socket_poll WSAPoll
+    typedef WSAPOLLFD socket_pollfd_t;
 #else
     #include <sys/socket.h>
+    #include <sys/select.h>
+    #include <sys/uio.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <poll.h>
     #include <arpa/inet.h>
+    #include <netdb.h>
     #include <unistd.h>
+    #include <fcntl.h>
     #include <errno.h>
     typedef int socket_t;
+    typedef struct iovec socket_iovec_t;
     #define SOCKET_INVALID -1
     #define socket_close close
     #define socket_error() errno
+    #define SOCKET_EINTR EINTR
+    #define SOCKET_EINPROGRESS EINPROGRESS
+    #define socket_poll poll
+    typedef struct pollfd socket_pollfd_t;
+#endif
+
+/* A server that went away must fail the call, not raise SIGPIPE */
+#ifdef MSG_NOSIGNAL
+    #define SOCKET_SEND_FLAGS MSG_NOSIGNAL
+#else
+    #define SOCKET_SEND_FLAGS 0
 #endif
 
 /*============================================================================*/
@@ -36,49 +68,208 @@
 
 #define SOCKET_SERVER_DEFAULT_HOST  "127.0.0.1"
 #define SOCKET_SERVER_DEFAULT_PORT  "9000"
-#define SOCKET_RX_BUFFER_SIZE       4096
-#define SOCKET_CONNECT_RETRY_COUNT  3
-#define SOCKET_CONNECT_RETRY_DELAY_MS 1000
 
 /**
- * @brief SPI protocol message types
+ * @brief Longest a connection attempt may take before it counts as failed
+ * @details Also the wait for the connection of operations without a timeout.
+ */
+#ifndef SOCKET_CONNECT_TIMEOUT_MS
+#define SOCKET_CONNECT_TIMEOUT_MS   1000U
+#endif
+
+/**
+ * @brief Delay before the next attempt after a failed one, doubled per failure
+ */
+#ifndef SOCKET_RETRY_MIN_MS
+#define SOCKET_RETRY_MIN_MS         50U
+#endif
+#ifndef SOCKET_RETRY_MAX_MS
+#define SOCKET_RETRY_MAX_MS         2000U
+#endif
+
+/**
+ * @brief Longest stall tolerated inside a frame once it has started
+ * @details Set once per connection as SO_RCVTIMEO/SO_SNDTIMEO. Waiting for a
+ *          response to start is bounded by the caller's timeout with poll().
+ */
+#ifndef SOCKET_IO_TIMEOUT_MS
+#define SOCKET_IO_TIMEOUT_MS        2000U
+#endif
+
+/**
+ * @brief Maximum number of requests in flight on the shared connection
+ */
+#ifndef SOCKET_PIPELINE_DEPTH
+#define SOCKET_PIPELINE_DEPTH       8
+#endif
+
+/**
+ * @brief Chunks of one hal_spi_transfer_large() frame in flight at a time
+ * @details Leaves the rest of the pipeline to the other devices.
+ */
+#ifndef SOCKET_LARGE_WINDOW
+#define SOCKET_LARGE_WINDOW         4U
+#endif
+
+#if SOCKET_LARGE_WINDOW > SOCKET_PIPELINE_DEPTH
+#error "SOCKET_LARGE_WINDOW must not exceed SOCKET_PIPELINE_DEPTH"
+#endif
+
+/**
+ * @brief Buffers handed to one sendmsg()/WSASend() call, and the room for
+ *        small items (headers, batch entries) copied alongside them
+ */
+#define SOCKET_GATHER_MAX_IOV       32
+#define SOCKET_GATHER_SCRATCH       256
+
+/**
+ * @brief Run the socket I/O on a thread of its own
+ * @details Without threads (HAL_OS_NONE) the callers run the I/O loop
+ *          themselves, whenever they wait or poll; only one caller may use
+ *          the backend at a time then.
+ */
+#ifndef SOCKET_IO_THREAD
+#ifdef HAL_OS_NONE
+#define SOCKET_IO_THREAD            0
+#else
+#define SOCKET_IO_THREAD            1
+#endif
+#endif
+
+/**
+ * @brief Sink for response payload without a destination (excess bytes,
+ *        TX-only segments); several I/O vector entries may share it
+ */
+#define SOCKET_DISCARD_SINK         256
+
+/**
+ * @brief How the I/O thread encodes the payload of a request
  */
 typedef enum {
-    SOCKET_MSG_INIT         = 0x01,
-    SOCKET_MSG_DEINIT       = 0x02,
-    SOCKET_MSG_TRANSFER     = 0x03,
-    SOCKET_MSG_SEND         = 0x04,
-    SOCKET_MSG_RECEIVE      = 0x05,
-    SOCKET_MSG_SET_CONFIG   = 0x06,
-    SOCKET_MSG_GET_STATUS   = 0x07,
-    SOCKET_MSG_RESPONSE     = 0x80
-} socket_msg_type_t;
+    SOCKET_TX_PAYLOAD,      /**< tx_length bytes at tx_data */
+    SOCKET_TX_BATCH,        /**< Batch entries built from xfers */
+    SOCKET_TX_SEGMENTS      /**< TX sides of xfers, dummy bytes for receive-only ones */
+} socket_tx_kind_t;
 
 /**
- * @brief Socket message header
+ * @brief Request waiting for its response on the shared connection
+ * @details The caller describes the message, the I/O thread encodes it
+ *          straight from the caller's buffers and scatters the response
+ *          payload into the rx_data buffers of xfers.
  */
-typedef struct __attribute__((packed)) {
-    uint8_t     msg_type;       /**< Message type */
-    uint8_t     device_id;      /**< SPI device ID */
-    uint16_t    data_length;    /**< Payload length */
-    uint32_t    sequence;       /**< Sequence number */
-} socket_msg_header_t;
+typedef struct {
+    bool                    in_use;
+    bool                    done;           /**< Response received (or connection lost) */
+    bool                    queued;         /**< Submitted, not yet written by the I/O thread */
+    bool                    receiving;      /**< Payload is being copied by the I/O thread */
+    bool                    rx_spans_all;   /**< Response also covers xfers without rx_data (dropped) */
+    bool                    detached;       /**< Nobody waits: the slot is freed by the response */
+    uint8_t                 msg_type;
+    uint8_t                 tx_kind;        /**< socket_tx_kind_t */
+    uint16_t                tx_length;      /**< Payload length on the wire */
+    uint32_t                sequence;       /**< Sequence number of the request */
+    uint32_t                tx_next;        /**< Submission queue link (slot index + 1, 0 = none) */
+    hal_spi_device_t        device;
+    const uint8_t*          tx_data;        /**< SOCKET_TX_PAYLOAD source */
+    uint8_t                 tx_inline[sizeof(hal_spi_config_t)];  /**< Copied payload (length word, configuration) */
+    hal_spi_xfer_t          single;         /**< Storage for single-buffer requests */
+    const hal_spi_xfer_t*   xfers;          /**< TX sources (batch, segments) and RX destinations */
+    uint16_t                xfer_count;
+    uint32_t                expected_length;/**< Expected response payload length */
+    uint32_t                rx_length;      /**< Actual response payload length */
+    hal_status_t            status;
+} socket_request_t;
 
 /**
- * @brief Socket SPI device state
+ * @brief Shared connection to the socket server
+ * @details One I/O thread, running from the first init to the last deinit,
+ *          owns the socket: it connects (and reconnects after a lost
+ *          connection, with an exponential backoff once an attempt has
+ *          failed, sending every initialized device its INIT again), writes
+ *          the requests and reads the responses.
+ *          Application threads never touch the socket:
+ *          - A request is pushed onto tx_head, a lock-free stack linked
+ *            through the request slots. The I/O thread takes the whole stack
+ *            at once and writes it, in submission order, with one sendmsg().
+ *            A caller only makes a system call (one datagram on wake_fd) if
+ *            the thread sleeps in poll().
+ *          - The I/O thread completes a request by setting done under lock
+ *            and broadcasting response_cv; callers wait there, or poll done.
+ *            lock guards the request table, the connection state and the
+ *            sequence counter. It is never held across socket I/O.
+ *          - setup_lock serializes init and deinit (thread start and stop).
+ *          Without threads (SOCKET_IO_THREAD 0) the same loop runs on the
+ *          callers, from hal_spi_poll() and while they wait.
  */
 typedef struct {
-    bool                is_initialized;
-    hal_spi_config_t    config;
-    hal_spi_status_t    status;
-    
-    /* Socket-specific data */
     socket_t            socket_fd;      /**< Socket file descriptor */
     bool                is_connected;   /**< Connection state */
+    bool                is_connecting;  /**< Attempt in progress on socket_fd */
+    uint32_t            attempt_us;     /**< hal_time_now_us() when the attempt (or the backoff) started */
+    uint32_t            retry_ms;       /**< Backoff before the next attempt, 0 = none */
     uint32_t            msg_sequence;   /**< Message sequence counter */
-    uint8_t             rx_buffer[SOCKET_RX_BUFFER_SIZE];
+    uint8_t             open_devices;   /**< Initialized devices using the connection */
     char                server_host[64];
     char                server_port[8];
+    socket_request_t    requests[SOCKET_PIPELINE_DEPTH];
+    
+    /* Submission queue and I/O thread */
+    volatile uint32_t   tx_head;        /**< Slot index + 1 of the request submitted last, 0 = empty */
+    volatile uint32_t   io_sleeping;    /**< I/O thread is (about to be) blocked in poll() */
+    volatile uint32_t   io_stop;        /**< Asks the I/O thread to write what is queued and exit */
+    socket_t            wake_fd;        /**< Loopback datagram socket connected to itself */
+#if SOCKET_IO_THREAD
+    hal_thread_t        io_thread;
+#endif
+    
+    hal_mutex_t         lock;
+    hal_mutex_t         setup_lock;
+    hal_cond_t          response_cv;
+} socket_connection_t;
+
+/**
+ * @brief Messages being assembled for one vectored send
+ * @details Payload buffers are referenced, small items are copied into
+ *          scratch. The vector goes out when it is full and at the end, so
+ *          everything the I/O thread takes from the queue at once normally
+ *          costs one system call. Used by the I/O thread only.
+ */
+typedef struct {
+    socket_connection_t* conn;
+    socket_iovec_t      iov[SOCKET_GATHER_MAX_IOV];
+    uint32_t            iov_count;
+    uint8_t             scratch[SOCKET_GATHER_SCRATCH];
+    uint32_t            scratch_used;
+    hal_status_t        status;
+} socket_gather_t;
+
+/**
+ * @brief Socket SPI device state
+ * @details Hot fields first, the small ones packed together; the
+ *          configuration last.
+ */
+typedef struct {
+    hal_spi_status_t    status;
+    bool                is_initialized;
+    uint8_t             stream_next;            /**< Half delivered next (0 or 1) */
+    uint16_t            stream_half;            /**< Bytes per half */
+    
+    /* Pending asynchronous transfer (completed from poll) */
+    hal_spi_callback_t  async_callback;     /**< NULL if nothing pending */
+    void*               async_user_data;
+    socket_request_t*   async_request;
+    uint32_t            async_timeout_ms;
+    uint32_t            async_start_us;
+    
+    /* Continuous receive: one RECEIVE request in flight per half (completed from poll) */
+    hal_spi_stream_callback_t stream_callback;  /**< NULL if not streaming */
+    void*               stream_user_data;
+    uint8_t*            stream_buffer;
+    socket_request_t*   stream_requests[2];     /**< Pending refill of each half */
+    uint32_t            stream_start_us;        /**< hal_time_now_us() when that half was due */
+    
+    /* Read by init, set_config and a reconnect only */
+    hal_spi_config_t    config;
 } socket_spi_device_t;
 
 /*============================================================================*/
@@ -86,6 +277,13 @@ typedef struct {
 /*============================================================================*/
 
 static socket_spi_device_t g_socket_spi_devices[HAL_SPI_MAX_INTERFACES] = {0};
+static socket_connection_t g_socket_conn = {
+    .socket_fd = SOCKET_INVALID,
+    .wake_fd = SOCKET_INVALID,
+    .lock = HAL_MUTEX_INIT,
+    .setup_lock = HAL_MUTEX_INIT,
+    .response_cv = HAL_COND_INIT
+};
 static bool g_socket_initialized = false;
 
 /*============================================================================*/
@@ -101,147 +299,1494 @@ static hal_status_t socket_initialize_subsystem(void)
 #ifdef _WIN32
         WSADATA wsa_data;
         if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0) {
-            printf("[SOCKET-SPI] ERROR: WSAStartup failed\n");
+            HAL_LOG_ERROR("[SOCKET-SPI] ERROR: WSAStartup failed\n");
             return HAL_ERROR;
         }
 #endif
         g_socket_initialized = true;
-        printf("[SOCKET-SPI] Socket subsystem initialized\n");
+        HAL_LOG_INFO("[SOCKET-SPI] Socket subsystem initialized\n");
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief Set the per-connection socket options
+ * @details TCP_NODELAY sends every frame at once: with Nagle enabled a small
+ *          request waits for the delayed ACK of the previous one (about 40 ms
+ *          on Linux). The I/O timeouts only bound stalls inside a frame, so
+ *          they are set here once instead of before every message.
+ */
+static void socket_configure(socket_connection_t* conn)
+{
+    int no_delay = 1;
+    
+    if (setsockopt(conn->socket_fd, IPPROTO_TCP, TCP_NODELAY, (const char*)&no_delay, sizeof(no_delay)) != 0) {
+        HAL_LOG_WARN("[SOCKET-SPI] WARNING: TCP_NODELAY not available\n");
+    }
+    
+#ifdef _WIN32
+    DWORD timeout = SOCKET_IO_TIMEOUT_MS;
+    setsockopt(conn->socket_fd, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout, sizeof(timeout));
+    setsockopt(conn->socket_fd, SOL_SOCKET, SO_SNDTIMEO, (const char*)&timeout, sizeof(timeout));
+#else
+    struct timeval tv;
+    tv.tv_sec = SOCKET_IO_TIMEOUT_MS / 1000U;
+    tv.tv_usec = (SOCKET_IO_TIMEOUT_MS % 1000U) * 1000U;
+    setsockopt(conn->socket_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(conn->socket_fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+#endif
+}
+
+/**
+ * @brief Close the shared connection and fail all requests in flight
+ * @details Requests still queued are failed by the I/O thread when it takes
+ *          them. Runs on the I/O thread.
+ */
+static void socket_disconnect(socket_connection_t* conn)
+{
+    socket_t fd = conn->socket_fd;
+    
+    hal_mutex_lock(&conn->lock);
+    conn->socket_fd = SOCKET_INVALID;
+    conn->is_connected = false;
+    conn->is_connecting = false;
+    for (uint16_t i = 0; i < SOCKET_PIPELINE_DEPTH; i++) {
+        socket_request_t* req = &conn->requests[i];
+        if (!req->in_use || req->done || req->queued) {
+            continue;
+        }
+        if (req->detached) {
+            req->in_use = false;
+        } else {
+            req->status = HAL_ERROR;
+            req->done = true;
+        }
+    }
+    hal_cond_broadcast(&conn->response_cv);
+    hal_mutex_unlock(&conn->lock);
+    
+    if (fd != SOCKET_INVALID) {
+        socket_close(fd);
+    }
+}
+
+/**
+ * @brief Receive exactly length bytes
+ * @details TCP may split a frame anywhere, so short reads are continued
+ *          until the frame is complete or SO_RCVTIMEO expires.
+ */
+static hal_status_t socket_recv_all(socket_connection_t* conn, uint8_t* data, uint32_t length)
+{
+    while (length > 0) {
+        int bytes_received = recv(conn->socket_fd, (char*)data, (int)length, MSG_WAITALL);
+        if (bytes_received < 0 && socket_error() == SOCKET_EINTR) {
+            continue;
+        }
+        if (bytes_received <= 0) {
+            return (bytes_received < 0) ? HAL_ERROR_TIMEOUT : HAL_ERROR;
+        }
+        data += bytes_received;
+        length -= (uint32_t)bytes_received;
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief Point an I/O vector entry at a buffer
+ */
+static void socket_iov_set(socket_iovec_t* iov, const void* data, uint32_t length)
+{
+#ifdef _WIN32
+    iov->buf = (char*)data;
+    iov->len = (ULONG)length;
+#else
+    iov->iov_base = (void*)data;
+    iov->iov_len = (size_t)length;
+#endif
+}
+
+/**
+ * @brief Send a list of buffers completely, one system call if the socket takes it all
+ */
+static hal_status_t socket_send_vector(socket_connection_t* conn, socket_iovec_t* iov, uint32_t count)
+{
+    while (count > 0) {
+#ifdef _WIN32
+        DWORD sent = 0;
+        if (WSASend(conn->socket_fd, iov, (DWORD)count, &sent, 0, NULL, NULL) != 0) {
+            if (socket_error() == SOCKET_EINTR) {
+                continue;
+            }
+            return HAL_ERROR;
+        }
+        uint32_t bytes_sent = (uint32_t)sent;
+#else
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        
+        ssize_t sent = sendmsg(conn->socket_fd, &msg, SOCKET_SEND_FLAGS);
+        if (sent < 0 && socket_error() == SOCKET_EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            return HAL_ERROR;
+        }
+        uint32_t bytes_sent = (uint32_t)sent;
+#endif
+        
+        /* Partial send: skip what went out and resume inside the current buffer */
+        while (count > 0) {
+#ifdef _WIN32
+            uint32_t length = (uint32_t)iov->len;
+            const uint8_t* data = (const uint8_t*)iov->buf;
+#else
+            uint32_t length = (uint32_t)iov->iov_len;
+            const uint8_t* data = (const uint8_t*)iov->iov_base;
+#endif
+            if (bytes_sent < length) {
+                socket_iov_set(iov, data + bytes_sent, length - bytes_sent);
+                break;
+            }
+            bytes_sent -= length;
+            iov++;
+            count--;
+        }
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief Receive into a list of buffers until all are full
+ * @details MSG_WAITALL lets the kernel fill the whole list in one call; a
+ *          short read (signal, SO_RCVTIMEO) resumes inside the current buffer.
+ */
+static hal_status_t socket_recv_vector(socket_connection_t* conn, socket_iovec_t* iov, uint32_t count)
+{
+    while (count > 0) {
+#ifdef _WIN32
+        DWORD received = 0;
+        DWORD flags = MSG_WAITALL;
+        if (WSARecv(conn->socket_fd, iov, (DWORD)count, &received, &flags, NULL, NULL) != 0) {
+            if (socket_error() == SOCKET_EINTR) {
+                continue;
+            }
+            return HAL_ERROR_TIMEOUT;
+        }
+        if (received == 0) {
+            return HAL_ERROR;
+        }
+        uint32_t bytes_received = (uint32_t)received;
+#else
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        
+        ssize_t received = recvmsg(conn->socket_fd, &msg, MSG_WAITALL);
+        if (received < 0 && socket_error() == SOCKET_EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return (received < 0) ? HAL_ERROR_TIMEOUT : HAL_ERROR;
+        }
+        uint32_t bytes_received = (uint32_t)received;
+#endif
+        
+        while (count > 0) {
+#ifdef _WIN32
+            uint32_t length = (uint32_t)iov->len;
+            uint8_t* data = (uint8_t*)iov->buf;
+#else
+            uint32_t length = (uint32_t)iov->iov_len;
+            uint8_t* data = (uint8_t*)iov->iov_base;
+#endif
+            if (bytes_received < length) {
+                socket_iov_set(iov, data + bytes_received, length - bytes_received);
+                break;
+            }
+            bytes_received -= length;
+            iov++;
+            count--;
+        }
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief Hand the assembled buffers to the socket
+ */
+static hal_status_t socket_gather_flush(socket_gather_t* gather)
+{
+    if (gather->status == HAL_OK && gather->iov_count > 0) {
+        HAL_PROBE(HAL_PROBE_WIRE_SEND, HAL_PROBE_NO_DEVICE, gather->iov_count);
+        gather->status = socket_send_vector(gather->conn, gather->iov, gather->iov_count);
+        HAL_PROBE(HAL_PROBE_WIRE_SENT, HAL_PROBE_NO_DEVICE, gather->status);
+        if (gather->status != HAL_OK) {
+            HAL_LOG_ERROR("[SOCKET-SPI] ERROR: Failed to send message\n");
+        }
+    }
+    gather->iov_count = 0;
+    gather->scratch_used = 0;
+    return gather->status;
+}
+
+/**
+ * @brief Append a buffer by reference, it must stay valid until the flush
+ */
+static void socket_gather_add(socket_gather_t* gather, const uint8_t* data, uint32_t length)
+{
+    if (gather->iov_count == SOCKET_GATHER_MAX_IOV) {
+        (void)socket_gather_flush(gather);
+    }
+    if (gather->status == HAL_OK && length > 0) {
+        socket_iov_set(&gather->iov[gather->iov_count++], data, length);
+    }
+}
+
+/**
+ * @brief Append a small item by copy (header, batch entry)
+ */
+static void socket_gather_copy(socket_gather_t* gather, const void* data, uint32_t length)
+{
+    if (gather->scratch_used + length > SOCKET_GATHER_SCRATCH || 
+        gather->iov_count == SOCKET_GATHER_MAX_IOV) {
+        (void)socket_gather_flush(gather);
+    }
+    
+    uint8_t* copy = &gather->scratch[gather->scratch_used];
+    memcpy(copy, data, length);
+    gather->scratch_used += length;
+    socket_gather_add(gather, copy, length);
+}
+
+/**
+ * @brief Append length dummy bytes (TX side of receive-only segments)
+ */
+static void socket_gather_fill(socket_gather_t* gather, uint32_t length)
+{
+    static const uint8_t zeros[64] = {0};
+    
+    while (length > 0 && gather->status == HAL_OK) {
+        uint32_t chunk = (length < sizeof(zeros)) ? length : (uint32_t)sizeof(zeros);
+        socket_gather_add(gather, zeros, chunk);
+        length -= chunk;
+    }
+}
+
+/**
+ * @brief Start assembling messages on the shared connection
+ */
+static void socket_gather_init(socket_gather_t* gather, socket_connection_t* conn)
+{
+    gather->conn = conn;
+    gather->iov_count = 0;
+    gather->scratch_used = 0;
+    gather->status = conn->is_connected ? HAL_OK : HAL_ERROR_NOT_INIT;
+}
+
+/**
+ * @brief Start a message: header first
+ */
+static void socket_gather_header(socket_gather_t* gather, 
+                                 uint8_t msg_type, 
+                                 hal_spi_device_t device, 
+                                 uint32_t sequence, 
+                                 uint16_t payload_length)
+{
+    hal_spi_msg_header_t header;
+    header.msg_type = msg_type;
+    header.device_id = (uint8_t)device;
+    header.data_length = payload_length;
+    header.sequence = sequence;
+    
+    socket_gather_copy(gather, &header, sizeof(header));
+}
+
+/**
+ * @brief Receive message header from socket server
+ * @details Called once the socket is readable; the socket itself keeps
+ *          SOCKET_IO_TIMEOUT_MS.
+ */
+static hal_status_t socket_receive_header(socket_connection_t* conn, hal_spi_msg_header_t* header)
+{
+    /* A header cut short leaves the stream out of step, no retry possible */
+    return (socket_recv_all(conn, (uint8_t*)header, sizeof(*header)) == HAL_OK) ? HAL_OK : HAL_ERROR;
+}
+
+/**
+ * @brief Read one response and hand it to the request with the same sequence
+ * @details Payload goes straight into the request's RX buffers, with one
+ *          recvmsg() for up to SOCKET_GATHER_MAX_IOV pieces. Bytes beyond the
+ *          buffers and responses nobody waits for are drained into a sink;
+ *          a length other than expected fails the request. The buffers stay
+ *          pinned (receiving) until the copy is done, so a request that times
+ *          out meanwhile cannot hand them back to its caller. Runs on the I/O
+ *          thread.
+ */
+static hal_status_t socket_dispatch_response(socket_connection_t* conn)
+{
+    hal_spi_msg_header_t header;
+    HAL_PROBE(HAL_PROBE_WIRE_RECV, HAL_PROBE_NO_DEVICE, 0U);
+    hal_status_t status = socket_receive_header(conn, &header);
+    
+    if (status != HAL_OK) {
+        socket_disconnect(conn);  /* Server closed the connection */
+        return status;
+    }
+    
+    socket_request_t* req = NULL;
+    
+    hal_mutex_lock(&conn->lock);
+    for (uint16_t i = 0; i < SOCKET_PIPELINE_DEPTH; i++) {
+        if (conn->requests[i].in_use && !conn->requests[i].done &&
+            conn->requests[i].sequence == header.sequence) {
+            req = &conn->requests[i];
+            req->receiving = true;  /* Pins the RX buffers until the copy is done */
+            break;
+        }
+    }
+    hal_mutex_unlock(&conn->lock);
+    
+    /* Scatter the payload straight into the RX buffers of the request, at
+       most header.data_length bytes; whatever they do not take goes to the
+       sink, so the stream stays in step */
+    socket_iovec_t iov[SOCKET_GATHER_MAX_IOV];
+    uint8_t sink[SOCKET_DISCARD_SINK];
+    uint32_t iov_count = 0;
+    uint32_t remaining = header.data_length;
+    uint16_t index = 0;
+    uint32_t offset = 0;    /* Position in xfers[index] */
+    
+    while (remaining > 0 && status == HAL_OK) {
+        uint8_t* target = sink;
+        uint32_t chunk = sizeof(sink);
+        
+        if (req != NULL && index < req->xfer_count) {
+            const hal_spi_xfer_t* xfer = &req->xfers[index];
+            if (offset == xfer->length || (xfer->rx_data == NULL && !req->rx_spans_all)) {
+                index++;    /* Done, or not part of the response */
+                offset = 0;
+                continue;
+            }
+            chunk = xfer->length - offset;
+            if (xfer->rx_data != NULL) {
+                target = &xfer->rx_data[offset];
+            } else if (chunk > sizeof(sink)) {
+                chunk = sizeof(sink);   /* TX-only segment */
+            }
+        }
+        if (chunk > remaining) {
+            chunk = remaining;
+        }
+        
+        socket_iov_set(&iov[iov_count++], target, chunk);
+        offset += chunk;
+        remaining -= chunk;
+        
+        if (iov_count == SOCKET_GATHER_MAX_IOV || remaining == 0) {
+            status = socket_recv_vector(conn, iov, iov_count);
+            iov_count = 0;
+        }
+    }
+    
+    HAL_PROBE(HAL_PROBE_WIRE_RECEIVED, header.device_id, header.data_length);
+    
+    hal_mutex_lock(&conn->lock);
+    if (req != NULL) {
+        req->receiving = false;
+        HAL_PROBE(HAL_PROBE_QUEUE_COMPLETE, req->device, req->sequence);
+        if (status == HAL_OK && req->detached) {
+            req->in_use = false;
+        } else if (status == HAL_OK) {
+            req->rx_length = header.data_length;
+            req->status = (header.data_length == req->expected_length) ? HAL_OK : HAL_ERROR;
+            req->done = true;
+        }
+    }
+    hal_cond_broadcast(&conn->response_cv);
+    hal_mutex_unlock(&conn->lock);
+    
+    if (status != HAL_OK) {
+        socket_disconnect(conn);  /* Stream position is lost */
+        return HAL_ERROR;
     }
+    
     return HAL_OK;
 }
 
 /**
- * @brief Connect to socket server
+ * @brief Milliseconds left of a timeout started at start_us
+ * @param left_ms Receives the time left, or 0 (forever) if timeout_ms is 0
+ * @return false once the timeout has expired
+ */
+static bool socket_time_left(uint32_t start_us, uint32_t timeout_ms, uint32_t* left_ms)
+{
+    *left_ms = 0;
+    if (timeout_ms == 0) {
+        return true;
+    }
+    
+    uint32_t elapsed_ms = (hal_time_now_us() - start_us) / 1000U;
+    if (elapsed_ms >= timeout_ms) {
+        return false;
+    }
+    *left_ms = timeout_ms - elapsed_ms;
+    return true;
+}
+
+/**
+ * @brief Switch a socket between blocking and non-blocking mode
+ */
+static void socket_set_blocking(socket_t fd, bool blocking)
+{
+#ifdef _WIN32
+    u_long mode = blocking ? 0U : 1U;
+    ioctlsocket(fd, FIONBIO, &mode);
+#else
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, blocking ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK));
+#endif
+}
+
+/**
+ * @brief Close a failed attempt and back off before the next
+ */
+static void socket_connect_fail(socket_connection_t* conn)
+{
+    socket_t fd = conn->socket_fd;
+    
+    hal_mutex_lock(&conn->lock);
+    conn->socket_fd = SOCKET_INVALID;
+    conn->is_connecting = false;
+    hal_cond_broadcast(&conn->response_cv);  /* Waiters give up */
+    hal_mutex_unlock(&conn->lock);
+    
+    if (fd != SOCKET_INVALID) {
+        socket_close(fd);
+    }
+    
+    if (conn->retry_ms == 0U) {
+        HAL_LOG_WARN("[SOCKET-SPI] WARNING: Server %s:%s not reachable, retrying\n", 
+                     conn->server_host, conn->server_port);
+        conn->retry_ms = SOCKET_RETRY_MIN_MS;
+    } else if (conn->retry_ms < SOCKET_RETRY_MAX_MS) {
+        conn->retry_ms = (conn->retry_ms * 2U < SOCKET_RETRY_MAX_MS) ? conn->retry_ms * 2U : SOCKET_RETRY_MAX_MS;
+    }
+    conn->attempt_us = hal_time_now_us();
+}
+
+/**
+ * @brief Start a connection attempt without waiting for it
+ * @note Runs on the I/O thread, once by the first init before it starts
  */
-static hal_status_t socket_connect(socket_spi_device_t* dev)
+static void socket_connect_start(socket_connection_t* conn)
 {
     struct addrinfo hints, *result = NULL, *ptr = NULL;
-    int connect_result;
     
     memset(&hints, 0, sizeof(hints));
     hints.ai_family = AF_INET;
     hints.ai_socktype = SOCK_STREAM;
     hints.ai_protocol = IPPROTO_TCP;
     
+    conn->attempt_us = hal_time_now_us();
+    
     /* Resolve server address */
-    if (getaddrinfo(dev->server_host, dev->server_port, &hints, &result) != 0) {
-        printf("[SOCKET-SPI] ERROR: Failed to resolve %s:%s\n", 
-               dev->server_host, dev->server_port);
-        return HAL_ERROR;
+    if (getaddrinfo(conn->server_host, conn->server_port, &hints, &result) != 0) {
+        if (conn->retry_ms == 0U) {
+            HAL_LOG_ERROR("[SOCKET-SPI] ERROR: Failed to resolve %s:%s\n", 
+                          conn->server_host, conn->server_port);
+        }
+        socket_connect_fail(conn);
+        return;
     }
     
-    /* Attempt to connect to an address until one succeeds */
+    /* Take the first address that accepts or starts the connection */
     for (ptr = result; ptr != NULL; ptr = ptr->ai_next) {
-        /* Create socket */
-        dev->socket_fd = socket(ptr->ai_family, ptr->ai_socktype, ptr->ai_protocol);
-        if (dev->socket_fd == SOCKET_INVALID) {
+        conn->socket_fd = socket(ptr->ai_family, ptr->ai_socktype, ptr->ai_protocol);
+        if (conn->socket_fd == SOCKET_INVALID) {
             continue;
         }
         
-        /* Connect to server */
-        connect_result = connect(dev->socket_fd, ptr->ai_addr, (int)ptr->ai_addrlen);
-        if (connect_result == 0) {
-            break;  /* Success */
+        socket_set_blocking(conn->socket_fd, false);
+        if (connect(conn->socket_fd, ptr->ai_addr, (int)ptr->ai_addrlen) == 0 || 
+            socket_error() == SOCKET_EINPROGRESS) {
+            break;
         }
         
-        socket_close(dev->socket_fd);
-        dev->socket_fd = SOCKET_INVALID;
+        socket_close(conn->socket_fd);
+        conn->socket_fd = SOCKET_INVALID;
     }
     
     freeaddrinfo(result);
     
-    if (dev->socket_fd == SOCKET_INVALID) {
-        printf("[SOCKET-SPI] ERROR: Unable to connect to server\n");
+    if (conn->socket_fd == SOCKET_INVALID) {
+        socket_connect_fail(conn);
+        return;
+    }
+    
+    hal_mutex_lock(&conn->lock);
+    conn->is_connecting = true;
+    hal_mutex_unlock(&conn->lock);
+}
+
+/**
+ * @brief Complete an attempt whose socket became writable
+ * @details The server keeps no state across connections: every device
+ *          initialized meanwhile is sent its INIT now, ahead of anything
+ *          queued. Devices initialized later send their own.
+ * @note Runs on the I/O thread
+ */
+static void socket_connect_finish(socket_connection_t* conn)
+{
+    int error = 0;
+    socklen_t error_length = sizeof(error);
+    
+    if (getsockopt(conn->socket_fd, SOL_SOCKET, SO_ERROR, (char*)&error, &error_length) != 0 || error != 0) {
+        socket_connect_fail(conn);
+        return;
+    }
+    
+    socket_set_blocking(conn->socket_fd, true);
+    socket_configure(conn);
+    conn->retry_ms = 0;
+    
+    uint8_t devices[HAL_SPI_MAX_INTERFACES];
+    uint8_t count = 0;
+    
+    hal_mutex_lock(&conn->lock);
+    conn->is_connecting = false;
+    conn->is_connected = true;
+    for (uint8_t device = 0; device < HAL_SPI_MAX_INTERFACES; device++) {
+        if (g_socket_spi_devices[device].is_initialized) {
+            devices[count++] = device;
+        }
+    }
+    uint32_t sequence = conn->msg_sequence;
+    conn->msg_sequence += count;
+    hal_cond_broadcast(&conn->response_cv);
+    hal_mutex_unlock(&conn->lock);
+    
+    HAL_LOG_INFO("[SOCKET-SPI] Connected to %s:%s\n", conn->server_host, conn->server_port);
+    
+    /* Answers match no request and are dropped */
+    socket_gather_t gather;
+    socket_gather_init(&gather, conn);
+    for (uint8_t i = 0; i < count; i++) {
+        socket_gather_header(&gather, HAL_SPI_MSG_INIT, (hal_spi_device_t)devices[i], sequence + i, 
+                             sizeof(hal_spi_config_t));
+        socket_gather_copy(&gather, &g_socket_spi_devices[devices[i]].config, sizeof(hal_spi_config_t));
+    }
+    if (socket_gather_flush(&gather) != HAL_OK) {
+        socket_disconnect(conn);
+    }
+}
+
+/**
+ * @brief Open the wake socket of the I/O thread
+ * @details A datagram socket connected to itself on the loopback interface:
+ *          unlike a pipe, poll() and WSAPoll() both accept it.
+ */
+static bool socket_wake_open(socket_connection_t* conn)
+{
+    struct sockaddr_in addr;
+    socklen_t addr_length = sizeof(addr);
+    
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    
+    conn->wake_fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (conn->wake_fd == SOCKET_INVALID) {
+        return false;
+    }
+    
+    if (bind(conn->wake_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || 
+        getsockname(conn->wake_fd, (struct sockaddr*)&addr, &addr_length) != 0 || 
+        connect(conn->wake_fd, (struct sockaddr*)&addr, addr_length) != 0) {
+        socket_close(conn->wake_fd);
+        conn->wake_fd = SOCKET_INVALID;
+        return false;
+    }
+    
+    socket_set_blocking(conn->wake_fd, false);
+    return true;
+}
+
+/**
+ * @brief Make the I/O thread return from poll()
+ */
+static void socket_wake(socket_connection_t* conn)
+{
+    (void)send(conn->wake_fd, "", 1, 0);
+}
+
+/**
+ * @brief Write everything submitted since the last call
+ * @details The whole stack is taken with one exchange and written, oldest
+ *          request first, as one vector. Without a connection the requests
+ *          fail with HAL_ERROR_NOT_INIT.
+ */
+static void socket_io_send_queued(socket_connection_t* conn)
+{
+    socket_request_t* taken[SOCKET_PIPELINE_DEPTH];
+    uint32_t count = 0;
+    uint32_t head = HAL_ATOMIC_EXCHANGE_U32(&conn->tx_head, 0U);
+    
+    /* Every slot is queued at most once, so the stack holds at most all of them */
+    while (head != 0U && count < SOCKET_PIPELINE_DEPTH) {
+        taken[count] = &conn->requests[head - 1U];
+        head = taken[count]->tx_next;
+        count++;
+    }
+    if (count == 0U) {
+        return;
+    }
+    
+    socket_gather_t gather;
+    socket_gather_init(&gather, conn);
+    
+    /* Newest first on the stack: encode from the bottom up */
+    for (uint32_t i = count; i-- > 0U;) {
+        const socket_request_t* req = taken[i];
+        
+        socket_gather_header(&gather, req->msg_type, req->device, req->sequence, req->tx_length);
+        if (req->tx_kind == SOCKET_TX_BATCH) {
+            for (uint16_t j = 0; j < req->xfer_count; j++) {
+                const hal_spi_xfer_t* xfer = &req->xfers[j];
+                hal_spi_batch_entry_t entry;
+                
+                if (xfer->tx_data != NULL && xfer->rx_data != NULL) {
+                    entry.msg_type = HAL_SPI_MSG_TRANSFER;
+                } else if (xfer->tx_data != NULL) {
+                    entry.msg_type = HAL_SPI_MSG_SEND;
+                } else {
+                    entry.msg_type = HAL_SPI_MSG_RECEIVE;
+                }
+                entry.length = xfer->length;
+                
+                socket_gather_copy(&gather, &entry, sizeof(entry));
+                if (xfer->tx_data != NULL) {
+                    socket_gather_add(&gather, xfer->tx_data, xfer->length);
+                }
+            }
+        } else if (req->tx_kind == SOCKET_TX_SEGMENTS) {
+            for (uint16_t j = 0; j < req->xfer_count; j++) {
+                if (req->xfers[j].tx_data != NULL) {
+                    socket_gather_add(&gather, req->xfers[j].tx_data, req->xfers[j].length);
+                } else {
+                    socket_gather_fill(&gather, req->xfers[j].length);
+                }
+            }
+        } else if (req->tx_data != NULL) {
+            socket_gather_add(&gather, req->tx_data, req->tx_length);
+        }
+    }
+    hal_status_t status = socket_gather_flush(&gather);
+    
+    /* The caller's TX buffers are free again */
+    hal_mutex_lock(&conn->lock);
+    for (uint32_t i = 0; i < count; i++) {
+        socket_request_t* req = taken[i];
+        
+        req->queued = false;
+        if (status != HAL_OK && req->detached) {
+            req->in_use = false;
+        } else if (status != HAL_OK && !req->done) {
+            req->status = status;
+            req->done = true;
+        }
+    }
+    hal_cond_broadcast(&conn->response_cv);
+    hal_mutex_unlock(&conn->lock);
+    
+    if (status != HAL_OK && conn->is_connected) {
+        socket_disconnect(conn);
+    }
+}
+
+/**
+ * @brief Sleep in poll() until the socket, a caller or a connection deadline
+ *        needs the I/O thread, then serve it
+ * @details A response is dispatched at a time, so requests submitted
+ *          meanwhile go out between two responses.
+ * @param limit_ms Longest sleep, -1 for none
+ */
+static void socket_io_wait(socket_connection_t* conn, int limit_ms)
+{
+    socket_pollfd_t pfd[2];
+    uint32_t count = 1;
+    int wait_ms = -1;
+    uint32_t elapsed_ms = (hal_time_now_us() - conn->attempt_us) / 1000U;
+    
+    if (!conn->is_connected && !conn->is_connecting) {
+        if (elapsed_ms >= conn->retry_ms) {
+            socket_connect_start(conn);
+            elapsed_ms = 0;
+        } else {
+            wait_ms = (int)(conn->retry_ms - elapsed_ms);
+        }
+    }
+    
+    pfd[0].fd = conn->wake_fd;
+    pfd[0].events = POLLIN;
+    pfd[0].revents = 0;
+    if (conn->is_connected || conn->is_connecting) {
+        pfd[1].fd = conn->socket_fd;
+        pfd[1].events = conn->is_connected ? POLLIN : POLLOUT;
+        pfd[1].revents = 0;
+        count = 2;
+    }
+    if (conn->is_connecting) {
+        wait_ms = (elapsed_ms < SOCKET_CONNECT_TIMEOUT_MS) ? (int)(SOCKET_CONNECT_TIMEOUT_MS - elapsed_ms) : 0;
+    }
+    if (limit_ms >= 0 && (wait_ms < 0 || wait_ms > limit_ms)) {
+        wait_ms = limit_ms;
+    }
+    
+    /* Announce the sleep, then look at the queue once more: whoever submits
+       after this sees the flag and sends the wake datagram */
+    (void)HAL_ATOMIC_EXCHANGE_U32(&conn->io_sleeping, 1U);
+    if (HAL_ATOMIC_LOAD_U32(&conn->tx_head) != 0U || HAL_ATOMIC_LOAD_U32(&conn->io_stop) != 0U) {
+        wait_ms = 0;
+    }
+    
+    int ready;
+    do {
+        ready = socket_poll(pfd, count, wait_ms);
+    } while (ready < 0 && socket_error() == SOCKET_EINTR);
+    (void)HAL_ATOMIC_EXCHANGE_U32(&conn->io_sleeping, 0U);
+    
+    if (ready > 0 && pfd[0].revents != 0) {
+        char drain[16];
+        while (recv(conn->wake_fd, drain, sizeof(drain), 0) > 0) {
+        }
+    }
+    
+    if (count == 2U && ready > 0 && pfd[1].revents != 0) {
+        if (conn->is_connected) {
+            (void)socket_dispatch_response(conn);
+        } else {
+            socket_connect_finish(conn);
+        }
+    } else if (conn->is_connecting && 
+               (hal_time_now_us() - conn->attempt_us) / 1000U >= SOCKET_CONNECT_TIMEOUT_MS) {
+        socket_connect_fail(conn);
+    }
+}
+
+/**
+ * @brief One turn of the I/O loop: write what is queued, then wait for the next event
+ */
+static void socket_io_step(socket_connection_t* conn, int limit_ms)
+{
+    socket_io_send_queued(conn);
+    socket_io_wait(conn, limit_ms);
+}
+
+#if SOCKET_IO_THREAD
+/**
+ * @brief I/O thread: runs the loop until stopped
+ */
+static void socket_io_thread(void* arg)
+{
+    socket_connection_t* conn = (socket_connection_t*)arg;
+    
+    while (HAL_ATOMIC_LOAD_U32(&conn->io_stop) == 0U) {
+        socket_io_step(conn, -1);
+    }
+    
+    /* Messages queued before the stop (the DEINIT of the last device) still go out */
+    socket_io_send_queued(conn);
+    socket_disconnect(conn);
+}
+#endif
+
+/**
+ * @brief Without an I/O thread, run the loop once without blocking
+ */
+static void socket_io_service(socket_connection_t* conn)
+{
+#if SOCKET_IO_THREAD
+    (void)conn;
+#else
+    socket_io_step(conn, 0);
+#endif
+}
+
+/**
+ * @brief Wait with lock held until the I/O thread has made progress
+ * @details Without an I/O thread the caller runs the loop itself meanwhile.
+ * @param wait_ms Longest wait, 0 for no limit
+ */
+static void socket_io_yield(socket_connection_t* conn, uint32_t wait_ms)
+{
+#if SOCKET_IO_THREAD
+    (void)hal_cond_wait_ms(&conn->response_cv, &conn->lock, wait_ms);
+#else
+    hal_mutex_unlock(&conn->lock);
+    socket_io_step(conn, (wait_ms > 0U && wait_ms < SOCKET_IO_TIMEOUT_MS) ? (int)wait_ms : (int)SOCKET_IO_TIMEOUT_MS);
+    hal_mutex_lock(&conn->lock);
+#endif
+}
+
+/**
+ * @brief Start the I/O thread with a first connection attempt under way
+ * @note Caller holds setup_lock
+ */
+static hal_status_t socket_io_start(socket_connection_t* conn)
+{
+    if (!socket_wake_open(conn)) {
+        HAL_LOG_ERROR("[SOCKET-SPI] ERROR: Failed to open the wake socket\n");
+        return HAL_ERROR;
+    }
+    
+    HAL_ATOMIC_STORE_U32(&conn->io_stop, 0U);
+    conn->retry_ms = 0;
+    socket_connect_start(conn);
+    
+#if SOCKET_IO_THREAD
+    if (!hal_thread_create(&conn->io_thread, socket_io_thread, conn)) {
+        HAL_LOG_ERROR("[SOCKET-SPI] ERROR: Failed to start the I/O thread\n");
+        socket_disconnect(conn);
+        socket_close(conn->wake_fd);
+        conn->wake_fd = SOCKET_INVALID;
         return HAL_ERROR;
     }
+#endif
+    return HAL_OK;
+}
+
+/**
+ * @brief Stop the I/O thread once it has written what is queued, and close the connection
+ * @note Caller holds setup_lock
+ */
+static void socket_io_stop(socket_connection_t* conn)
+{
+#if SOCKET_IO_THREAD
+    HAL_ATOMIC_STORE_U32(&conn->io_stop, 1U);
+    socket_wake(conn);
+    hal_thread_join(&conn->io_thread);
+#else
+    socket_io_send_queued(conn);
+    socket_disconnect(conn);
+#endif
+    
+    socket_close(conn->wake_fd);
+    conn->wake_fd = SOCKET_INVALID;
+    conn->retry_ms = 0;
+}
+
+/**
+ * @brief Reserve a free request slot and assign the next sequence number
+ * @note Caller holds lock
+ * @return Request slot, NULL if the pipeline is full
+ */
+static socket_request_t* socket_request_claim(socket_connection_t* conn, 
+                                              hal_spi_device_t device, 
+                                              const hal_spi_xfer_t* xfers, 
+                                              uint16_t xfer_count, 
+                                              uint32_t expected_length)
+{
+    for (uint16_t i = 0; i < SOCKET_PIPELINE_DEPTH; i++) {
+        socket_request_t* req = &conn->requests[i];
+        
+        if (!req->in_use) {
+            req->in_use = true;
+            req->done = false;
+            req->queued = false;
+            req->receiving = false;
+            req->rx_spans_all = false;
+            req->detached = false;
+            req->sequence = conn->msg_sequence++;
+            req->device = device;
+            req->xfers = xfers;
+            req->xfer_count = xfer_count;
+            req->expected_length = expected_length;
+            req->rx_length = 0;
+            req->status = HAL_OK;
+            return req;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Reserve a request slot and assign the next sequence number
+ * @details While the pipeline is full (slots held by other devices), waits
+ *          for a slot to come back until timeout_ms, counted from start_us,
+ *          has passed. Without wait it returns at once.
+ * @param timeout_ms Budget of the operation (0 = no timeout)
+ * @return Request slot, NULL if none became free
+ */
+static socket_request_t* socket_request_open(socket_connection_t* conn, 
+                                             hal_spi_device_t device, 
+                                             const hal_spi_xfer_t* xfers, 
+                                             uint16_t xfer_count, 
+                                             uint32_t expected_length, 
+                                             uint32_t start_us, 
+                                             uint32_t timeout_ms, 
+                                             bool wait)
+{
+    uint32_t left_ms;
+    socket_request_t* req;
+    
+    hal_mutex_lock(&conn->lock);
+    while ((req = socket_request_claim(conn, device, xfers, xfer_count, expected_length)) == NULL) {
+        if (!wait || !socket_time_left(start_us, timeout_ms, &left_ms)) {
+            break;
+        }
+        socket_io_yield(conn, left_ms);
+    }
+    hal_mutex_unlock(&conn->lock);
+    
+    return req;
+}
+
+/**
+ * @brief Reserve a request slot for a single RX buffer (may be NULL)
+ * @details As socket_request_open().
+ */
+static socket_request_t* socket_request_open_single(socket_connection_t* conn, 
+                                                    hal_spi_device_t device, 
+                                                    uint8_t* rx_data, 
+                                                    uint16_t expected_length, 
+                                                    uint32_t start_us, 
+                                                    uint32_t timeout_ms, 
+                                                    bool wait)
+{
+    socket_request_t* req = socket_request_open(conn, device, NULL, 1, expected_length, 
+                                                start_us, timeout_ms, wait);
+    
+    if (req != NULL) {
+        req->single.tx_data = NULL;
+        req->single.rx_data = rx_data;
+        req->single.length = expected_length;
+        req->xfers = &req->single;
+    }
+    return req;
+}
+
+/**
+ * @brief Release a request slot, a late response is then discarded
+ * @details Waits while the I/O thread still reads from the request's TX
+ *          buffers or writes into its RX buffers, so the caller may reuse
+ *          them as soon as this returns.
+ */
+static void socket_request_close(socket_connection_t* conn, socket_request_t* req)
+{
+    hal_mutex_lock(&conn->lock);
+    while (req->queued || req->receiving) {
+        socket_io_yield(conn, 0);
+    }
+    req->in_use = false;
+    hal_cond_broadcast(&conn->response_cv);  /* A post may wait for the slot */
+    hal_mutex_unlock(&conn->lock);
+}
+
+/**
+ * @brief Store the length word of a RECEIVE payload in the request itself
+ * @return The two bytes, valid while the request is open
+ */
+static const uint8_t* socket_request_length(socket_request_t* req, uint32_t length)
+{
+    req->tx_inline[0] = (uint8_t)(length >> 8);
+    req->tx_inline[1] = (uint8_t)(length & 0xFF);
+    return req->tx_inline;
+}
+
+/**
+ * @brief Hand a request to the I/O thread
+ * @details Lock-free push onto the submission stack. The TX buffers must
+ *          stay valid until the request is closed. A system call is made
+ *          only to wake the thread from poll(); while it is busy, it picks
+ *          the request up with the next batch.
+ * @param tx_kind How the payload of tx_length bytes is encoded;
+ *        tx_data is the source of SOCKET_TX_PAYLOAD (may be NULL if empty)
+ */
+static void socket_request_submit(socket_connection_t* conn, 
+                                  socket_request_t* req, 
+                                  uint8_t msg_type, 
+                                  socket_tx_kind_t tx_kind, 
+                                  const uint8_t* tx_data, 
+                                  uint16_t tx_length)
+{
+    uint32_t index = (uint32_t)(req - conn->requests) + 1U;
+    uint32_t head = HAL_ATOMIC_LOAD_U32(&conn->tx_head);
+    
+    req->msg_type = msg_type;
+    req->tx_kind = (uint8_t)tx_kind;
+    req->tx_data = tx_data;
+    req->tx_length = tx_length;
+    req->queued = true;
+    HAL_PROBE(HAL_PROBE_QUEUE_SUBMIT, req->device, req->sequence);
+    
+    do {
+        req->tx_next = head;
+    } while (!HAL_ATOMIC_CAS_U32(&conn->tx_head, &head, index));
+    
+    if (HAL_ATOMIC_EXCHANGE_U32(&conn->io_sleeping, 0U) != 0U) {
+        socket_wake(conn);
+    }
+}
+
+/**
+ * @brief Queue a message whose response is not awaited
+ * @details The payload (at most a configuration) is copied, so the caller's
+ *          buffer may go at once. The server still answers; the I/O thread
+ *          drops the answer and frees the slot. If the pipeline is full,
+ *          waits up to SOCKET_IO_TIMEOUT_MS for a slot.
+ * @return HAL_OK, HAL_ERROR_BUSY if no slot became free
+ */
+static hal_status_t socket_post_message(socket_connection_t* conn, 
+                                        hal_spi_msg_type_t msg_type, 
+                                        hal_spi_device_t device, 
+                                        const uint8_t* payload, 
+                                        uint16_t payload_length)
+{
+    uint32_t start_us = hal_time_now_us();
+    uint32_t left_ms;
+    socket_request_t* req;
+    
+    if (payload_length > sizeof(req->tx_inline)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    hal_mutex_lock(&conn->lock);
+    while ((req = socket_request_claim(conn, device, NULL, 0, 0)) == NULL) {
+        if (!socket_time_left(start_us, SOCKET_IO_TIMEOUT_MS, &left_ms)) {
+            break;
+        }
+        socket_io_yield(conn, left_ms);
+    }
+    if (req != NULL) {
+        req->detached = true;
+    }
+    hal_mutex_unlock(&conn->lock);
+    
+    if (req == NULL) {
+        HAL_LOG_ERROR("[SOCKET-SPI] ERROR: Pipeline full, message 0x%02X of device %d dropped\n", 
+                      msg_type, device);
+        return HAL_ERROR_BUSY;
+    }
+    
+    if (payload != NULL) {
+        memcpy(req->tx_inline, payload, payload_length);
+    }
+    socket_request_submit(conn, req, (uint8_t)msg_type, SOCKET_TX_PAYLOAD, 
+                          (payload != NULL) ? req->tx_inline : NULL, payload_length);
+    return HAL_OK;
+}
+
+/**
+ * @brief Wait for the shared connection within an operation's budget
+ * @details The I/O thread makes the attempts; the backoff after a failed
+ *          attempt is not waited out.
+ * @param timeout_ms Budget of the operation (0 = no timeout: at most one
+ *        attempt), reduced by the time spent here
+ * @return HAL_OK once connected, HAL_ERROR_TIMEOUT if the budget ran out,
+ *         HAL_ERROR_NOT_INIT while the server is not reachable
+ */
+static hal_status_t socket_await_connection(socket_connection_t* conn, uint32_t* timeout_ms)
+{
+    uint32_t start_us = hal_time_now_us();
+    uint32_t left_ms;
+    hal_status_t status = HAL_OK;
+    
+    socket_io_service(conn);
+    
+    hal_mutex_lock(&conn->lock);
+    while (!conn->is_connected && status == HAL_OK) {
+        if (!conn->is_connecting) {
+            status = HAL_ERROR_NOT_INIT;  /* Backing off */
+        } else if (!socket_time_left(start_us, *timeout_ms, &left_ms)) {
+            status = HAL_ERROR_TIMEOUT;
+        } else {
+            socket_io_yield(conn, left_ms);
+        }
+    }
+    hal_mutex_unlock(&conn->lock);
+    
+    if (status == HAL_OK && *timeout_ms > 0) {
+        uint32_t elapsed_ms = (hal_time_now_us() - start_us) / 1000U;
+        if (elapsed_ms >= *timeout_ms) {
+            return HAL_ERROR_TIMEOUT;
+        }
+        *timeout_ms -= elapsed_ms;
+    }
+    return status;
+}
+
+/**
+ * @brief Wait for the response of a request
+ * @details Sleeps until the I/O thread has dispatched it.
+ * @param start_us hal_time_now_us() when the operation started
+ * @param timeout_ms Budget of the whole operation (0 = no timeout)
+ */
+static hal_status_t socket_request_wait(socket_connection_t* conn, 
+                                        socket_request_t* req, 
+                                        uint32_t start_us, 
+                                        uint32_t timeout_ms)
+{
+    hal_status_t status = HAL_OK;
+    uint32_t left_ms;
+    
+    hal_mutex_lock(&conn->lock);
+    while (!req->done) {
+        if (!socket_time_left(start_us, timeout_ms, &left_ms)) {
+            status = HAL_ERROR_TIMEOUT;
+            break;
+        }
+        socket_io_yield(conn, left_ms);
+    }
+    
+    if (req->done) {
+        status = req->status;
+    }
+    hal_mutex_unlock(&conn->lock);
+    
+    return status;
+}
+
+/**
+ * @brief Check without blocking whether the response of req has arrived
+ */
+static bool socket_request_poll(socket_connection_t* conn, socket_request_t* req)
+{
+    socket_io_service(conn);
+    
+    hal_mutex_lock(&conn->lock);
+    bool done = req->done;
+    hal_mutex_unlock(&conn->lock);
+    
+    return done;
+}
+
+/**
+ * @brief Send a request and wait for its response
+ */
+static hal_status_t socket_request_run(socket_connection_t* conn, 
+                                       hal_spi_msg_type_t msg_type, 
+                                       hal_spi_device_t device, 
+                                       const uint8_t* payload, 
+                                       uint16_t payload_length, 
+                                       uint8_t* rx_data, 
+                                       uint16_t expected_length, 
+                                       uint32_t timeout_ms)
+{
+    uint32_t start_us = hal_time_now_us();
+    socket_request_t* req = socket_request_open_single(conn, device, rx_data, expected_length, 
+                                                       start_us, timeout_ms, true);
+    if (req == NULL) {
+        return HAL_ERROR_TIMEOUT;  /* Pipeline stayed full */
+    }
+    
+    socket_request_submit(conn, req, (uint8_t)msg_type, SOCKET_TX_PAYLOAD, payload, payload_length);
+    hal_status_t status = socket_request_wait(conn, req, start_us, timeout_ms);
+    
+    socket_request_close(conn, req);
+    return status;
+}
+
+/**
+ * @brief Submit one chunk of a large frame without waiting for its response
+ * @details TX data is referenced, the response goes straight to rx_data.
+ * @param more Chip select stays asserted after the chunk
+ * @param wait Wait for a slot within the frame's budget if the pipeline is full
+ * @param out Receives the request, to be waited for and closed by the caller
+ * @return HAL_OK, HAL_ERROR_BUSY if the pipeline is full (without wait),
+ *         HAL_ERROR_TIMEOUT if it stayed full
+ */
+static hal_status_t socket_large_post(socket_connection_t* conn, 
+                                      hal_spi_device_t device, 
+                                      const uint8_t* tx_data, 
+                                      uint8_t* rx_data, 
+                                      uint16_t length, 
+                                      bool more, 
+                                      uint32_t start_us, 
+                                      uint32_t timeout_ms, 
+                                      bool wait, 
+                                      socket_request_t** out)
+{
+    uint8_t msg_type = (tx_data == NULL) ? HAL_SPI_MSG_RECEIVE :
+                       (rx_data == NULL) ? HAL_SPI_MSG_SEND : HAL_SPI_MSG_TRANSFER;
+    
+    socket_request_t* req = socket_request_open_single(conn, device, rx_data, 
+                                                       (rx_data != NULL) ? length : 0U, 
+                                                       start_us, timeout_ms, wait);
+    if (req == NULL) {
+        return wait ? HAL_ERROR_TIMEOUT : HAL_ERROR_BUSY;
+    }
+    
+    if (more) {
+        msg_type |= HAL_SPI_MSG_FLAG_MORE;
+    }
+    socket_request_submit(conn, req, msg_type, SOCKET_TX_PAYLOAD, 
+                          (tx_data != NULL) ? tx_data : socket_request_length(req, length), 
+                          (tx_data != NULL) ? length : 2U);
+    
+    *out = req;
+    return HAL_OK;
+}
+
+/**
+ * @brief Run a large frame as a pipeline of chunk messages
+ * @details Up to SOCKET_LARGE_WINDOW chunks are in flight: while the server
+ *          answers one, the next ones are already queued, so the link stays
+ *          busy. Each response is scattered straight into rx_data.
+ */
+static hal_status_t socket_run_large(socket_connection_t* conn, 
+                                     hal_spi_device_t device, 
+                                     const uint8_t* tx_data, 
+                                     uint8_t* rx_data, 
+                                     uint32_t length, 
+                                     uint32_t timeout_ms)
+{
+    socket_request_t* window[SOCKET_LARGE_WINDOW];
+    uint32_t posted = 0;        /* Chunks sent */
+    uint32_t completed = 0;     /* Chunks answered */
+    uint32_t offset = 0;
+    uint32_t start_us = hal_time_now_us();
+    uint32_t left_ms;
+    hal_status_t status = HAL_OK;
+    
+    while (status == HAL_OK && (offset < length || completed != posted)) {
+        if (offset < length && posted - completed < SOCKET_LARGE_WINDOW) {
+            uint32_t chunk = length - offset;
+            if (chunk > HAL_SPI_LARGE_CHUNK) {
+                chunk = HAL_SPI_LARGE_CHUNK;
+            }
+            
+            /* With chunks of its own in flight the frame does not wait for a
+               slot: the oldest chunk's slot comes back below */
+            status = socket_large_post(conn, device, 
+                                       (tx_data != NULL) ? &tx_data[offset] : NULL, 
+                                       (rx_data != NULL) ? &rx_data[offset] : NULL, 
+                                       (uint16_t)chunk, 
+                                       (offset + chunk < length), 
+                                       start_us, timeout_ms, (completed == posted), 
+                                       &window[posted % SOCKET_LARGE_WINDOW]);
+            if (status == HAL_OK) {
+                posted++;
+                offset += chunk;
+                continue;
+            }
+            if (status != HAL_ERROR_BUSY) {
+                break;  /* Pipeline stayed full, or connection lost */
+            }
+            status = HAL_OK;  /* Retry once the oldest chunk has its slot back */
+        }
+        
+        /* One deadline for the whole frame */
+        if (!socket_time_left(start_us, timeout_ms, &left_ms)) {
+            status = HAL_ERROR_TIMEOUT;
+            break;
+        }
+        socket_request_t* req = window[completed % SOCKET_LARGE_WINDOW];
+        status = socket_request_wait(conn, req, start_us, timeout_ms);
+        socket_request_close(conn, req);
+        completed++;
+    }
+    
+    /* Late responses of abandoned chunks are discarded */
+    while (completed != posted) {
+        socket_request_close(conn, window[completed % SOCKET_LARGE_WINDOW]);
+        completed++;
+    }
+    
+    return status;
+}
+
+/**
+ * @brief Maximum encoded size of a batch message payload
+ */
+#define SOCKET_BATCH_MAX_PAYLOAD    HAL_SPI_MSG_MAX_PAYLOAD
+
+/**
+ * @brief Run one batch message: as many descriptors as fit into one payload
+ * @param start_us hal_time_now_us() when the batch started
+ * @param timeout_ms Budget of the whole batch (0 = no timeout)
+ * @return Number of descriptors processed (0 on error, status in *result)
+ */
+static uint16_t socket_run_batch_chunk(socket_connection_t* conn, 
+                                       hal_spi_device_t device, 
+                                       const hal_spi_xfer_t* xfers, 
+                                       uint16_t count, 
+                                       uint32_t start_us, 
+                                       uint32_t timeout_ms, 
+                                       hal_status_t* result)
+{
+    uint32_t payload_length = 0;
+    uint32_t response_length = 0;
+    uint16_t n = 0;
+    
+    /* Size the chunk */
+    while (n < count) {
+        const hal_spi_xfer_t* xfer = &xfers[n];
+        uint32_t entry_length = sizeof(hal_spi_batch_entry_t) +
+                                ((xfer->tx_data != NULL) ? xfer->length : 0U);
+        
+        if (payload_length + entry_length > SOCKET_BATCH_MAX_PAYLOAD ||
+            response_length + ((xfer->rx_data != NULL) ? xfer->length : 0U) > SOCKET_BATCH_MAX_PAYLOAD) {
+            break;
+        }
+        payload_length += entry_length;
+        response_length += (xfer->rx_data != NULL) ? xfer->length : 0U;
+        n++;
+    }
+    
+    if (n == 0) {
+        *result = HAL_ERROR_INVALID_PARAM;  /* Single descriptor exceeds the message size */
+        return 0;
+    }
+    
+    socket_request_t* req = socket_request_open(conn, device, xfers, n, response_length, 
+                                                start_us, timeout_ms, true);
+    if (req == NULL) {
+        *result = HAL_ERROR_TIMEOUT;  /* Pipeline stayed full */
+        return 0;
+    }
+    
+    /* One message for the whole chunk, gathered straight from the descriptors;
+       the response is scattered into them by the dispatcher */
+    socket_request_submit(conn, req, HAL_SPI_MSG_BATCH, SOCKET_TX_BATCH, NULL, (uint16_t)payload_length);
+    *result = socket_request_wait(conn, req, start_us, timeout_ms);
+    
+    socket_request_close(conn, req);
+    return (*result == HAL_OK) ? n : 0;
+}
+
+/**
+ * @brief Complete the pending asynchronous transfer of a device
+ */
+static void socket_async_complete(hal_spi_device_t device, hal_status_t status)
+{
+    socket_spi_device_t* dev = &g_socket_spi_devices[device];
+    hal_spi_callback_t callback = dev->async_callback;
+    void* user_data = dev->async_user_data;
+    uint16_t length = (status == HAL_OK) ? dev->async_request->single.length : 0U;
+    
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_TRANSFER, status, 
+                         length, length, dev->async_start_us);
     
-    dev->is_connected = true;
-    printf("[SOCKET-SPI] Connected to %s:%s\n", dev->server_host, dev->server_port);
+    /* Release the device before the callback so it can submit the next transfer */
+    socket_request_close(&g_socket_conn, dev->async_request);
+    dev->async_request = NULL;
+    dev->async_callback = NULL;
+    hal_spi_release(&dev->status);
     
-    return HAL_OK;
+    callback(device, status, user_data);
 }
 
 /**
- * @brief Send message to socket server
+ * @brief Ask the server for the next fill of one half of the stream buffer
+ * @details The response is scattered straight into the half, as the DMA
+ *          would write it on hardware.
  */
-static hal_status_t socket_send_message(socket_spi_device_t* dev, 
-                                        socket_msg_type_t msg_type,
-                                        const uint8_t* payload, 
-                                        uint16_t payload_length)
+static hal_status_t socket_stream_post(hal_spi_device_t device, uint8_t half)
 {
-    if (!dev->is_connected) {
-        return HAL_ERROR_NOT_INIT;
+    socket_spi_device_t* dev = &g_socket_spi_devices[device];
+    socket_connection_t* conn = &g_socket_conn;
+    uint16_t length = dev->stream_half;
+    
+    /* Waits for a slot as long as a detached message does */
+    socket_request_t* req = socket_request_open_single(conn, device, 
+                                                       dev->stream_buffer + (half * length), length, 
+                                                       hal_time_now_us(), SOCKET_IO_TIMEOUT_MS, true);
+    if (req == NULL) {
+        return HAL_ERROR_BUSY;  /* Pipeline stayed full */
     }
     
-    /* Prepare message header */
-    socket_msg_header_t header;
-    header.msg_type = msg_type;
-    header.device_id = 0;  /* Will be set by caller if needed */
-    header.data_length = payload_length;
-    header.sequence = dev->msg_sequence++;
+    socket_request_submit(conn, req, HAL_SPI_MSG_RECEIVE, SOCKET_TX_PAYLOAD, 
+                          socket_request_length(req, length), 2);
     
-    /* Send header */
-    int bytes_sent = send(dev->socket_fd, (const char*)&header, sizeof(header), 0);
-    if (bytes_sent != sizeof(header)) {
-        printf("[SOCKET-SPI] ERROR: Failed to send header\n");
-        return HAL_ERROR;
-    }
+    dev->stream_requests[half] = req;
+    return HAL_OK;
+}
+
+/**
+ * @brief End the stream of a device, late responses are discarded
+ */
+static void socket_stream_end(hal_spi_device_t device)
+{
+    socket_spi_device_t* dev = &g_socket_spi_devices[device];
     
-    /* Send payload if present */
-    if (payload_length > 0 && payload != NULL) {
-        bytes_sent = send(dev->socket_fd, (const char*)payload, payload_length, 0);
-        if (bytes_sent != payload_length) {
-            printf("[SOCKET-SPI] ERROR: Failed to send payload\n");
-            return HAL_ERROR;
+    for (uint8_t half = 0; half < 2U; half++) {
+        if (dev->stream_requests[half] != NULL) {
+            socket_request_close(&g_socket_conn, dev->stream_requests[half]);
+            dev->stream_requests[half] = NULL;
         }
     }
     
-    return HAL_OK;
+    dev->stream_callback = NULL;
+    dev->stream_buffer = NULL;
+    hal_spi_release(&dev->status);
 }
 
 /**
- * @brief Receive message from socket server
+ * @brief End the stream of a device on an error and tell the application
  */
-static hal_status_t socket_receive_message(socket_spi_device_t* dev, 
-                                           uint8_t* data, 
-                                           uint16_t* length,
-                                           uint32_t timeout_ms)
+static void socket_stream_fail(hal_spi_device_t device, hal_status_t status)
 {
-    if (!dev->is_connected) {
-        return HAL_ERROR_NOT_INIT;
+    socket_spi_device_t* dev = &g_socket_spi_devices[device];
+    hal_spi_stream_callback_t callback = dev->stream_callback;
+    void* user_data = dev->stream_user_data;
+    
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_RECEIVE, status, 0, 0, dev->stream_start_us);
+    socket_stream_end(device);
+    
+    callback(device, status, NULL, 0, user_data);
+}
+
+/**
+ * @brief Deliver the next stream half if its data has arrived
+ * @return HAL_ERROR_BUSY while the stream runs, HAL_OK once it has ended
+ */
+static hal_status_t socket_stream_poll(hal_spi_device_t device)
+{
+    socket_spi_device_t* dev = &g_socket_spi_devices[device];
+    socket_connection_t* conn = &g_socket_conn;
+    uint8_t half = dev->stream_next;
+    socket_request_t* req = dev->stream_requests[half];
+    
+    if (!socket_request_poll(conn, req)) {
+        if (!conn->is_connected) {
+            socket_stream_fail(device, HAL_ERROR);
+            return HAL_OK;
+        }
+        return HAL_ERROR_BUSY;
     }
     
-    /* Set receive timeout */
-#ifdef _WIN32
-    DWORD timeout = timeout_ms;
-    setsockopt(dev->socket_fd, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout, sizeof(timeout));
-#else
-    struct timeval tv;
-    tv.tv_sec = timeout_ms / 1000;
-    tv.tv_usec = (timeout_ms % 1000) * 1000;
-    setsockopt(dev->socket_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
-#endif
+    hal_status_t status = req->status;
+    uint16_t length = dev->stream_half;
+    uint8_t* data = req->single.rx_data;
+    
+    socket_request_close(conn, req);
+    dev->stream_requests[half] = NULL;
     
-    /* Receive header */
-    socket_msg_header_t header;
-    int bytes_received = recv(dev->socket_fd, (char*)&header, sizeof(header), 0);
-    if (bytes_received != sizeof(header)) {
-        return HAL_ERROR_TIMEOUT;
+    if (status != HAL_OK) {
+        socket_stream_fail(device, status);
+        return HAL_OK;
     }
     
-    /* Receive payload */
-    if (header.data_length > 0 && data != NULL) {
-        bytes_received = recv(dev->socket_fd, (char*)data, header.data_length, 0);
-        if (bytes_received != header.data_length) {
-            return HAL_ERROR;
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_RECEIVE, HAL_OK, 0, length, dev->stream_start_us);
+    dev->stream_next ^= 1U;
+    dev->stream_start_us = hal_time_now_us();
+    HAL_TRACE(HAL_TRACE_EV_RECEIVE, device, length);
+    
+    dev->stream_callback(device, HAL_OK, data, length, dev->stream_user_data);
+    
+    /* Refill the half just handed out, unless the callback stopped (or restarted) the stream */
+    if (dev->stream_callback != NULL && dev->stream_requests[half] == NULL) {
+        status = socket_stream_post(device, half);
+        if (status != HAL_OK) {
+            socket_stream_fail(device, status);
         }
-        *length = header.data_length;
-    } else {
-        *length = 0;
     }
     
-    return HAL_OK;
+    return (dev->stream_callback != NULL) ? HAL_ERROR_BUSY : HAL_OK;
 }
 
 /*============================================================================*/
@@ -250,81 +1795,114 @@ static hal_status_t socket_receive_message(socket_spi_device_t* dev,
 
 static hal_status_t socket_spi_init(hal_spi_device_t device, const hal_spi_config_t* config)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES || config == NULL) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || config == NULL)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
-    if (socket_initialize_subsystem() != HAL_OK) {
-        return HAL_ERROR;
-    }
-    
     socket_spi_device_t* dev = &g_socket_spi_devices[device];
+    socket_connection_t* conn = &g_socket_conn;
     
     if (dev->is_initialized) {
         return HAL_ERROR_BUSY;
     }
     
+    hal_mutex_lock(&conn->setup_lock);
+    
+    if (socket_initialize_subsystem() != HAL_OK) {
+        hal_mutex_unlock(&conn->setup_lock);
+        return HAL_ERROR;
+    }
+    
     /* Store configuration */
     dev->config = *config;
     dev->status.state = HAL_STATE_RESET;
-    dev->status.tx_count = 0;
-    dev->status.rx_count = 0;
-    dev->status.error_count = 0;
     dev->status.is_busy = false;
-    dev->socket_fd = SOCKET_INVALID;
-    dev->is_connected = false;
-    dev->msg_sequence = 0;
+    hal_spi_stats_reset(device, &dev->status);
     
-    /* Set default server address (can be overridden via environment variables) */
-    const char* host_env = getenv("HAL_SPI_SOCKET_HOST");
-    const char* port_env = getenv("HAL_SPI_SOCKET_PORT");
+    /* The first device sets up the shared connection and its I/O thread */
+    if (conn->open_devices == 0) {
+        /* Set default server address (can be overridden via environment variables) */
+        const char* host_env = getenv("HAL_SPI_SOCKET_HOST");
+        const char* port_env = getenv("HAL_SPI_SOCKET_PORT");
+        
+        strncpy(conn->server_host, host_env ? host_env : SOCKET_SERVER_DEFAULT_HOST, 
+                sizeof(conn->server_host) - 1);
+        strncpy(conn->server_port, port_env ? port_env : SOCKET_SERVER_DEFAULT_PORT, 
+                sizeof(conn->server_port) - 1);
+        
+        /* Only start connecting; the first operation that needs the server
+           waits for it */
+        if (socket_io_start(conn) != HAL_OK) {
+            hal_mutex_unlock(&conn->setup_lock);
+            return HAL_ERROR;
+        }
+    }
+    conn->open_devices++;
+    dev->status.state = HAL_STATE_READY;
     
-    strncpy(dev->server_host, host_env ? host_env : SOCKET_SERVER_DEFAULT_HOST, 
-            sizeof(dev->server_host) - 1);
-    strncpy(dev->server_port, port_env ? port_env : SOCKET_SERVER_DEFAULT_PORT, 
-            sizeof(dev->server_port) - 1);
+    /* Either the I/O thread sees the device when it connects, or the
+       connection is already up and the INIT is sent from here */
+    hal_mutex_lock(&conn->lock);
+    dev->is_initialized = true;
+    bool connected = conn->is_connected;
+    hal_mutex_unlock(&conn->lock);
     
-    /* Connect to server */
-    if (socket_connect(dev) != HAL_OK) {
-        printf("[SOCKET-SPI] WARNING: Running in disconnected mode\n");
-        /* Continue anyway - can retry connection later */
-    }
+    hal_mutex_unlock(&conn->setup_lock);
     
     /* Send init message to server */
-    if (dev->is_connected) {
-        socket_send_message(dev, SOCKET_MSG_INIT, (uint8_t*)config, sizeof(hal_spi_config_t));
+    if (connected) {
+        socket_post_message(conn, HAL_SPI_MSG_INIT, device, (uint8_t*)config, sizeof(hal_spi_config_t));
     }
     
-    dev->is_initialized = true;
-    dev->status.state = HAL_STATE_READY;
-    
-    printf("[SOCKET-SPI] Init device %d via socket\n", device);
+    HAL_LOG_INFO("[SOCKET-SPI] Init device %d via socket\n", device);
     
     return HAL_OK;
 }
 
 static hal_status_t socket_spi_deinit(hal_spi_device_t device)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
     socket_spi_device_t* dev = &g_socket_spi_devices[device];
+    socket_connection_t* conn = &g_socket_conn;
     
     if (!dev->is_initialized) {
         return HAL_ERROR_NOT_INIT;
     }
     
+    /* Abandon a pending asynchronous transfer, its response will be discarded */
+    if (dev->async_request != NULL) {
+        socket_request_close(conn, dev->async_request);
+    }
+    for (uint8_t half = 0; half < 2U; half++) {
+        if (dev->stream_requests[half] != NULL) {
+            socket_request_close(conn, dev->stream_requests[half]);
+        }
+    }
+    
     /* Send deinit message */
-    if (dev->is_connected) {
-        socket_send_message(dev, SOCKET_MSG_DEINIT, NULL, 0);
-        socket_close(dev->socket_fd);
+    hal_mutex_lock(&conn->lock);
+    dev->is_initialized = false;
+    bool connected = conn->is_connected;
+    hal_mutex_unlock(&conn->lock);
+    
+    if (connected) {
+        socket_post_message(conn, HAL_SPI_MSG_DEINIT, device, NULL, 0);
+    }
+    
+    /* The last device stops the I/O thread, which closes the shared connection */
+    hal_mutex_lock(&conn->setup_lock);
+    conn->open_devices--;
+    if (conn->open_devices == 0) {
+        socket_io_stop(conn);
     }
+    hal_mutex_unlock(&conn->setup_lock);
     
-    printf("[SOCKET-SPI] Deinit device %d\n", device);
+    HAL_LOG_INFO("[SOCKET-SPI] Deinit device %d\n", device);
     
     memset(dev, 0, sizeof(socket_spi_device_t));
-    dev->socket_fd = SOCKET_INVALID;
     
     return HAL_OK;
 }
@@ -335,49 +1913,43 @@ static hal_status_t socket_spi_transfer(hal_spi_device_t device,
                                         uint16_t length, 
                                         uint32_t timeout_ms)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
     socket_spi_device_t* dev = &g_socket_spi_devices[device];
+    socket_connection_t* conn = &g_socket_conn;
     
     if (!dev->is_initialized) {
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (!dev->is_connected) {
-        printf("[SOCKET-SPI] ERROR: Not connected to server\n");
-        return HAL_ERROR_NOT_INIT;
+    hal_status_t connected = socket_await_connection(conn, &timeout_ms);
+    if (connected != HAL_OK) {
+        return connected;
     }
     
-    if (dev->status.is_busy) {
+    if (!hal_spi_claim(&dev->status)) {
         return HAL_ERROR_BUSY;
     }
+    uint32_t start_us = hal_time_now_us();
     
-    dev->status.is_busy = true;
-    
-    /* Send transfer request */
-    if (socket_send_message(dev, SOCKET_MSG_TRANSFER, tx_data, length) != HAL_OK) {
-        dev->status.error_count++;
-        dev->status.is_busy = false;
-        return HAL_ERROR;
-    }
-    
-    /* Receive response */
-    uint16_t rx_length = 0;
-    hal_status_t status = socket_receive_message(dev, rx_data, &rx_length, timeout_ms);
+    /* Send transfer request and wait for the matching response */
+    hal_status_t status = socket_request_run(conn, HAL_SPI_MSG_TRANSFER, device, 
+                                             tx_data, length, rx_data, length, timeout_ms);
     
-    if (status != HAL_OK || rx_length != length) {
-        dev->status.error_count++;
-        dev->status.is_busy = false;
-        return (status == HAL_ERROR_TIMEOUT) ? HAL_ERROR_TIMEOUT : HAL_ERROR;
+    if (status != HAL_OK) {
+        status = (status == HAL_ERROR_TIMEOUT || status == HAL_ERROR_BUSY) ? status : HAL_ERROR;
+        hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_TRANSFER, status, 0, 0, start_us);
+        hal_spi_release(&dev->status);
+        return status;
     }
     
-    dev->status.tx_count += length;
-    dev->status.rx_count += length;
-    dev->status.is_busy = false;
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_TRANSFER, HAL_OK, length, length, start_us);
+    hal_spi_release(&dev->status);
     
-    printf("[SOCKET-SPI] Transferred %d bytes on device %d\n", length, device);
+    HAL_LOG_DEBUG("[SOCKET-SPI] Transferred %d bytes on device %d\n", length, device);
+    HAL_TRACE(HAL_TRACE_EV_TRANSFER, device, length);
     
     return HAL_OK;
 }
@@ -387,39 +1959,42 @@ static hal_status_t socket_spi_send(hal_spi_device_t device,
                                     uint16_t length, 
                                     uint32_t timeout_ms)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
     socket_spi_device_t* dev = &g_socket_spi_devices[device];
+    socket_connection_t* conn = &g_socket_conn;
     
-    if (!dev->is_initialized || !dev->is_connected) {
+    if (!dev->is_initialized) {
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (dev->status.is_busy) {
-        return HAL_ERROR_BUSY;
+    hal_status_t connected = socket_await_connection(conn, &timeout_ms);
+    if (connected != HAL_OK) {
+        return connected;
     }
     
-    dev->status.is_busy = true;
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
     
-    /* Send data */
-    hal_status_t status = socket_send_message(dev, SOCKET_MSG_SEND, data, length);
+    /* Send data and wait for the (empty) acknowledgment */
+    hal_status_t status = socket_request_run(conn, HAL_SPI_MSG_SEND, device, 
+                                             data, length, NULL, 0, timeout_ms);
     
     if (status != HAL_OK) {
-        dev->status.error_count++;
-        dev->status.is_busy = false;
+        hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_SEND, status, 0, 0, start_us);
+        hal_spi_release(&dev->status);
         return status;
     }
     
-    /* Wait for acknowledgment */
-    uint16_t rx_length = 0;
-    status = socket_receive_message(dev, NULL, &rx_length, timeout_ms);
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_SEND, HAL_OK, length, 0, start_us);
+    hal_spi_release(&dev->status);
     
-    dev->status.tx_count += length;
-    dev->status.is_busy = false;
-    
-    printf("[SOCKET-SPI] Sent %d bytes on device %d\n", length, device);
+    HAL_LOG_DEBUG("[SOCKET-SPI] Sent %d bytes on device %d\n", length, device);
+    HAL_TRACE(HAL_TRACE_EV_SEND, device, length);
     
     return status;
 }
@@ -429,44 +2004,43 @@ static hal_status_t socket_spi_receive(hal_spi_device_t device,
                                        uint16_t length, 
                                        uint32_t timeout_ms)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
     socket_spi_device_t* dev = &g_socket_spi_devices[device];
+    socket_connection_t* conn = &g_socket_conn;
     
-    if (!dev->is_initialized || !dev->is_connected) {
+    if (!dev->is_initialized) {
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (dev->status.is_busy) {
-        return HAL_ERROR_BUSY;
+    hal_status_t connected = socket_await_connection(conn, &timeout_ms);
+    if (connected != HAL_OK) {
+        return connected;
     }
     
-    dev->status.is_busy = true;
-    
-    /* Send receive request */
-    uint8_t req_data[2] = {(uint8_t)(length >> 8), (uint8_t)(length & 0xFF)};
-    if (socket_send_message(dev, SOCKET_MSG_RECEIVE, req_data, 2) != HAL_OK) {
-        dev->status.error_count++;
-        dev->status.is_busy = false;
-        return HAL_ERROR;
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
     }
+    uint32_t start_us = hal_time_now_us();
     
-    /* Receive data */
-    uint16_t rx_length = 0;
-    hal_status_t status = socket_receive_message(dev, data, &rx_length, timeout_ms);
+    /* Send receive request and wait for the data */
+    uint8_t req_data[2] = {(uint8_t)(length >> 8), (uint8_t)(length & 0xFF)};
+    hal_status_t status = socket_request_run(conn, HAL_SPI_MSG_RECEIVE, device, 
+                                             req_data, 2, data, length, timeout_ms);
     
     if (status != HAL_OK) {
-        dev->status.error_count++;
-        dev->status.is_busy = false;
+        hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_RECEIVE, status, 0, 0, start_us);
+        hal_spi_release(&dev->status);
         return status;
     }
     
-    dev->status.rx_count += rx_length;
-    dev->status.is_busy = false;
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_RECEIVE, HAL_OK, 0, length, start_us);
+    hal_spi_release(&dev->status);
     
-    printf("[SOCKET-SPI] Received %d bytes on device %d\n", rx_length, device);
+    HAL_LOG_DEBUG("[SOCKET-SPI] Received %d bytes on device %d\n", length, device);
+    HAL_TRACE(HAL_TRACE_EV_RECEIVE, device, length);
     
     return HAL_OK;
 }
@@ -474,27 +2048,33 @@ static hal_status_t socket_spi_receive(hal_spi_device_t device,
 static hal_status_t socket_spi_set_config(hal_spi_device_t device, 
                                           const hal_spi_config_t* config)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES || config == NULL) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || config == NULL)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
     socket_spi_device_t* dev = &g_socket_spi_devices[device];
+    socket_connection_t* conn = &g_socket_conn;
     
-    if (!dev->is_initialized || !dev->is_connected) {
+    if (!dev->is_initialized) {
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (dev->status.is_busy) {
+    if (!hal_spi_claim(&dev->status)) {
         return HAL_ERROR_BUSY;
     }
     
     /* Update local configuration */
     dev->config = *config;
     
-    /* Send config update to server */
-    socket_send_message(dev, SOCKET_MSG_SET_CONFIG, (uint8_t*)config, sizeof(hal_spi_config_t));
+    /* Send config update to server; while disconnected it goes out with the
+       INIT of the next connection */
+    if (conn->is_connected) {
+        socket_post_message(conn, HAL_SPI_MSG_SET_CONFIG, device, (uint8_t*)config, sizeof(hal_spi_config_t));
+    }
+    
+    HAL_LOG_INFO("[SOCKET-SPI] Reconfigured device %d\n", device);
     
-    printf("[SOCKET-SPI] Reconfigured device %d\n", device);
+    hal_spi_release(&dev->status);
     
     return HAL_OK;
 }
@@ -502,7 +2082,7 @@ static hal_status_t socket_spi_set_config(hal_spi_device_t device,
 static hal_status_t socket_spi_get_status(hal_spi_device_t device, 
                                           hal_spi_status_t* status)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES || status == NULL) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || status == NULL)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -516,16 +2096,368 @@ static hal_status_t socket_spi_get_status(hal_spi_device_t device,
     return HAL_OK;
 }
 
+static hal_status_t socket_spi_transfer_async(hal_spi_device_t device, 
+                                              const uint8_t* tx_data, 
+                                              uint8_t* rx_data, 
+                                              uint16_t length, 
+                                              uint32_t timeout_ms, 
+                                              hal_spi_callback_t callback, 
+                                              void* user_data)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || callback == NULL)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    socket_spi_device_t* dev = &g_socket_spi_devices[device];
+    socket_connection_t* conn = &g_socket_conn;
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    hal_status_t connected = socket_await_connection(conn, &timeout_ms);
+    if (connected != HAL_OK) {
+        return connected;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    
+    /* The wait for a slot counts against the transfer's timeout */
+    dev->async_start_us = hal_time_now_us();
+    socket_request_t* req = socket_request_open_single(conn, device, rx_data, length, 
+                                                       dev->async_start_us, timeout_ms, true);
+    if (req == NULL) {
+        hal_spi_release(&dev->status);
+        return HAL_ERROR_TIMEOUT;  /* Pipeline stayed full */
+    }
+    
+    /* Only the request goes out now, the response is collected by socket_spi_poll() */
+    socket_request_submit(conn, req, HAL_SPI_MSG_TRANSFER, SOCKET_TX_PAYLOAD, tx_data, length);
+    
+    dev->async_callback = callback;
+    dev->async_user_data = user_data;
+    dev->async_request = req;
+    dev->async_timeout_ms = timeout_ms;
+    
+    return HAL_OK;
+}
+
+static hal_status_t socket_spi_poll(hal_spi_device_t device)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    socket_spi_device_t* dev = &g_socket_spi_devices[device];
+    socket_connection_t* conn = &g_socket_conn;
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    /* Without an I/O thread, a pending connection attempt advances here */
+    socket_io_service(conn);
+    
+    if (dev->stream_callback != NULL) {
+        return socket_stream_poll(device);
+    }
+    
+    if (dev->async_callback == NULL) {
+        return HAL_OK;
+    }
+    
+    /* Completed by the I/O thread */
+    if (socket_request_poll(conn, dev->async_request)) {
+        socket_async_complete(device, dev->async_request->status);
+        return HAL_OK;
+    }
+    
+    if (!conn->is_connected) {
+        socket_async_complete(device, HAL_ERROR);
+        return HAL_OK;
+    }
+    
+    uint32_t elapsed_ms = (hal_time_now_us() - dev->async_start_us) / 1000U;
+    if (dev->async_timeout_ms > 0 && elapsed_ms >= dev->async_timeout_ms) {
+        socket_async_complete(device, HAL_ERROR_TIMEOUT);
+        return HAL_OK;
+    }
+    
+    return HAL_ERROR_BUSY;
+}
+
+static hal_status_t socket_spi_submit_batch(hal_spi_device_t device, 
+                                            const hal_spi_xfer_t* xfers, 
+                                            uint16_t count, 
+                                            uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    socket_spi_device_t* dev = &g_socket_spi_devices[device];
+    socket_connection_t* conn = &g_socket_conn;
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    hal_status_t connected = socket_await_connection(conn, &timeout_ms);
+    if (connected != HAL_OK) {
+        return connected;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    
+    /* One round trip per chunk, normally one for the whole batch */
+    hal_status_t status = HAL_OK;
+    uint16_t done = 0;
+    uint32_t tx_bytes = 0;
+    uint32_t rx_bytes = 0;
+    
+    while (done < count) {
+        uint16_t n = socket_run_batch_chunk(conn, device, &xfers[done], (uint16_t)(count - done), 
+                                            start_us, timeout_ms, &status);
+        if (n == 0) {
+            break;
+        }
+        
+        for (uint16_t i = done; i < done + n; i++) {
+            if (xfers[i].tx_data != NULL) {
+                tx_bytes += xfers[i].length;
+            }
+            if (xfers[i].rx_data != NULL) {
+                rx_bytes += xfers[i].length;
+            }
+        }
+        done = (uint16_t)(done + n);
+    }
+    
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_BATCH, status, tx_bytes, rx_bytes, start_us);
+    hal_spi_release(&dev->status);
+    
+    HAL_LOG_DEBUG("[SOCKET-SPI] Batch of %u transfers on device %d\n", done, device);
+    HAL_TRACE(HAL_TRACE_EV_BATCH, device, done);
+    
+    return status;
+}
+
+static hal_status_t socket_spi_transfer_sg(hal_spi_device_t device, 
+                                           const hal_spi_xfer_t* segs, 
+                                           uint16_t count, 
+                                           uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    socket_spi_device_t* dev = &g_socket_spi_devices[device];
+    socket_connection_t* conn = &g_socket_conn;
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    hal_status_t connected = socket_await_connection(conn, &timeout_ms);
+    if (connected != HAL_OK) {
+        return connected;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    
+    uint32_t frame_bytes;
+    uint32_t tx_bytes;
+    uint32_t rx_bytes;
+    hal_spi_op_t op = hal_spi_sg_classify(segs, count, &frame_bytes, &tx_bytes, &rx_bytes);
+    
+    /* The frame travels as a plain TRANSFER, SEND or RECEIVE message */
+    hal_spi_msg_type_t msg_type = (op == HAL_SPI_OP_SEND) ? HAL_SPI_MSG_SEND :
+                                 (op == HAL_SPI_OP_RECEIVE) ? HAL_SPI_MSG_RECEIVE : HAL_SPI_MSG_TRANSFER;
+    hal_status_t status = HAL_ERROR_TIMEOUT;  /* Pipeline stayed full */
+    
+    socket_request_t* req = socket_request_open(conn, device, segs, count, 
+                                                (op == HAL_SPI_OP_SEND) ? 0U : frame_bytes, 
+                                                start_us, timeout_ms, true);
+    if (req != NULL) {
+        req->rx_spans_all = (msg_type == HAL_SPI_MSG_TRANSFER);
+        
+        /* Payload is gathered from the segments by the I/O thread, nothing is staged */
+        if (msg_type == HAL_SPI_MSG_RECEIVE) {
+            socket_request_submit(conn, req, msg_type, SOCKET_TX_PAYLOAD, 
+                                  socket_request_length(req, frame_bytes), 2);
+        } else {
+            socket_request_submit(conn, req, msg_type, SOCKET_TX_SEGMENTS, NULL, (uint16_t)frame_bytes);
+        }
+        
+        status = socket_request_wait(conn, req, start_us, timeout_ms);
+        socket_request_close(conn, req);
+    }
+    
+    if (status != HAL_OK) {
+        status = (status == HAL_ERROR_TIMEOUT || status == HAL_ERROR_BUSY) ? status : HAL_ERROR;
+        hal_spi_stats_record(device, &dev->status, op, status, 0, 0, start_us);
+        hal_spi_release(&dev->status);
+        return status;
+    }
+    
+    hal_spi_stats_record(device, &dev->status, op, HAL_OK, tx_bytes, rx_bytes, start_us);
+    hal_spi_release(&dev->status);
+    
+    HAL_LOG_DEBUG("[SOCKET-SPI] Scatter-gather frame of %lu bytes in %u segments on device %d\n", 
+                  (unsigned long)frame_bytes, count, device);
+    HAL_TRACE(HAL_TRACE_EV_FROM_OP(op), device, frame_bytes);
+    
+    return HAL_OK;
+}
+
+static hal_status_t socket_spi_transfer_large(hal_spi_device_t device, 
+                                              const uint8_t* tx_data, 
+                                              uint8_t* rx_data, 
+                                              uint32_t length, 
+                                              uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    socket_spi_device_t* dev = &g_socket_spi_devices[device];
+    socket_connection_t* conn = &g_socket_conn;
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    hal_status_t connected = socket_await_connection(conn, &timeout_ms);
+    if (connected != HAL_OK) {
+        return connected;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    
+    hal_spi_op_t op = hal_spi_large_classify(tx_data, rx_data);
+    hal_status_t status = socket_run_large(conn, device, tx_data, rx_data, length, timeout_ms);
+    
+    if (status != HAL_OK) {
+        status = (status == HAL_ERROR_TIMEOUT || status == HAL_ERROR_BUSY) ? status : HAL_ERROR;
+        hal_spi_stats_record(device, &dev->status, op, status, 0, 0, start_us);
+        hal_spi_release(&dev->status);
+        return status;
+    }
+    
+    hal_spi_stats_record(device, &dev->status, op, HAL_OK, 
+                         (tx_data != NULL) ? length : 0U, 
+                         (rx_data != NULL) ? length : 0U, 
+                         start_us);
+    hal_spi_release(&dev->status);
+    
+    HAL_LOG_DEBUG("[SOCKET-SPI] Large frame of %lu bytes on device %d\n", 
+                  (unsigned long)length, device);
+    HAL_TRACE(HAL_TRACE_EV_FROM_OP(op), device, length);
+    
+    return HAL_OK;
+}
+
+static hal_status_t socket_spi_stream_start(hal_spi_device_t device, 
+                                            uint8_t* buffer, 
+                                            uint16_t length, 
+                                            hal_spi_stream_callback_t callback, 
+                                            void* user_data)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || callback == NULL)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    socket_spi_device_t* dev = &g_socket_spi_devices[device];
+    socket_connection_t* conn = &g_socket_conn;
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    /* No timeout of its own: waits for at most one connection attempt */
+    uint32_t connect_ms = 0;
+    hal_status_t connected = socket_await_connection(conn, &connect_ms);
+    if (connected != HAL_OK) {
+        return connected;
+    }
+    
+    /* The device stays claimed until socket_spi_stream_stop() */
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    
+    dev->stream_user_data = user_data;
+    dev->stream_buffer = buffer;
+    dev->stream_half = length / 2U;
+    dev->stream_next = 0;
+    dev->stream_start_us = hal_time_now_us();
+    dev->stream_callback = callback;
+    
+    /* Both halves are requested up front, so the server is always one half ahead */
+    hal_status_t status = socket_stream_post(device, 0);
+    if (status == HAL_OK) {
+        status = socket_stream_post(device, 1);
+    }
+    
+    if (status != HAL_OK) {
+        socket_stream_end(device);
+        return status;
+    }
+    
+    HAL_LOG_DEBUG("[SOCKET-SPI] Stream started on device %d (%u byte halves)\n", 
+                  device, dev->stream_half);
+    
+    return HAL_OK;
+}
+
+static hal_status_t socket_spi_stream_stop(hal_spi_device_t device)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    socket_spi_device_t* dev = &g_socket_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (dev->stream_callback != NULL) {
+        socket_stream_end(device);
+        HAL_LOG_DEBUG("[SOCKET-SPI] Stream stopped on device %d\n", device);
+    }
+    
+    return HAL_OK;
+}
+
 /*============================================================================*/
 /* Public Operations Structure (Export)                                       */
 /*============================================================================*/
 
 const hal_spi_ops_t hal_spi_socket_ops = {
-    .init       = socket_spi_init,
-    .deinit     = socket_spi_deinit,
-    .transfer   = socket_spi_transfer,
-    .send       = socket_spi_send,
-    .receive    = socket_spi_receive,
-    .set_config = socket_spi_set_config,
-    .get_status = socket_spi_get_status
+    .init           = socket_spi_init, 
+    .deinit         = socket_spi_deinit, 
+    .transfer       = socket_spi_transfer, 
+    .send           = socket_spi_send, 
+    .receive        = socket_spi_receive, 
+    .set_config     = socket_spi_set_config, 
+    .get_status     = socket_spi_get_status, 
+    .transfer_async = socket_spi_transfer_async, 
+    .poll           = socket_spi_poll, 
+    .submit_batch   = socket_spi_submit_batch,
+    .transfer_sg    = socket_spi_transfer_sg,
+    .stream_start   = socket_spi_stream_start,
+    .stream_stop    = socket_spi_stream_stop,
+    .transfer_large = socket_spi_transfer_large
 };
@@ -0,0 +1,150 @@
+/**
+ * @file    hal_spi_stats.c
+ * @brief   SPI HAL Extended Statistics
+ * @details One statistics block per device, shared by whichever backend is
+ *          registered. Writers use relaxed atomic adds only, so accounting
+ *          never blocks and readers on other threads or ISRs see every
+ *          counter whole.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#include "yolpiya.h"
+#include "hal_spi_backend.h"
+#include "hal_atomic.h"
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static hal_spi_stats_t g_spi_stats[HAL_SPI_MAX_INTERFACES];
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+/**
+ * @brief Histogram bucket of a latency (log2 of microseconds)
+ */
+static uint32_t stats_bucket(uint32_t latency_us)
+{
+    uint32_t bucket;
+    
+    if (latency_us == 0U) {
+        return 0U;
+    }
+
+#if defined(__GNUC__) || defined(__clang__)
+    bucket = 32U - (uint32_t)__builtin_clz(latency_us);
+#else
+    bucket = 0U;
+    while (latency_us != 0U) {
+        latency_us >>= 1;
+        bucket++;
+    }
+#endif
+    
+    return (bucket < HAL_SPI_STATS_BUCKETS) ? bucket : (HAL_SPI_STATS_BUCKETS - 1U);
+}
+
+/**
+ * @brief Raise a maximum without locking
+ */
+static void stats_update_max(uint32_t* max, uint32_t value)
+{
+    uint32_t current = HAL_ATOMIC_LOAD_U32(max);
+    
+    while (value > current) {
+        if (HAL_ATOMIC_CAS_U32(max, &current, value)) {
+            break;
+        }
+    }
+}
+
+/*============================================================================*/
+/* Backend Helper Implementation                                              */
+/*============================================================================*/
+
+void hal_spi_stats_reset(hal_spi_device_t device, hal_spi_status_t* status)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES) {
+        return;
+    }
+    
+    hal_spi_stats_t* stats = &g_spi_stats[device];
+    
+    HAL_ATOMIC_STORE_U64(&stats->tx_bytes, 0U);
+    HAL_ATOMIC_STORE_U64(&stats->rx_bytes, 0U);
+    HAL_ATOMIC_STORE_U64(&stats->error_count, 0U);
+    HAL_ATOMIC_STORE_U64(&stats->timeout_count, 0U);
+    
+    for (uint32_t op = 0; op < HAL_SPI_OP_COUNT; op++) {
+        HAL_ATOMIC_STORE_U64(&stats->op_count[op], 0U);
+        HAL_ATOMIC_STORE_U32(&stats->latency_max_us[op], 0U);
+        for (uint32_t b = 0; b < HAL_SPI_STATS_BUCKETS; b++) {
+            HAL_ATOMIC_STORE_U32(&stats->latency_hist[op][b], 0U);
+        }
+    }
+    
+    if (status != NULL) {
+        status->tx_count = 0;
+        status->rx_count = 0;
+        status->error_count = 0;
+    }
+}
+
+void hal_spi_stats_record(hal_spi_device_t device, 
+                          hal_spi_status_t* status, 
+                          hal_spi_op_t op, 
+                          hal_status_t result, 
+                          uint32_t tx_bytes, 
+                          uint32_t rx_bytes, 
+                          uint32_t start_us)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES || op >= HAL_SPI_OP_COUNT) {
+        return;
+    }
+    
+    hal_spi_stats_t* stats = &g_spi_stats[device];
+    uint32_t latency_us = hal_time_now_us() - start_us;
+    
+    HAL_ATOMIC_FETCH_ADD_U64(&stats->tx_bytes, (uint64_t)tx_bytes);
+    HAL_ATOMIC_FETCH_ADD_U64(&stats->rx_bytes, (uint64_t)rx_bytes);
+    status->tx_count += tx_bytes;
+    status->rx_count += rx_bytes;
+    
+    if (result == HAL_OK) {
+        HAL_ATOMIC_FETCH_ADD_U64(&stats->op_count[op], 1U);
+    } else {
+        HAL_ATOMIC_FETCH_ADD_U64(&stats->error_count, 1U);
+        if (result == HAL_ERROR_TIMEOUT) {
+            HAL_ATOMIC_FETCH_ADD_U64(&stats->timeout_count, 1U);
+        }
+        status->error_count++;
+    }
+    
+    HAL_ATOMIC_FETCH_ADD_U32(&stats->latency_hist[op][stats_bucket(latency_us)], 1U);
+    stats_update_max(&stats->latency_max_us[op], latency_us);
+}
+
+void hal_spi_stats_read(hal_spi_device_t device, hal_spi_stats_t* stats)
+{
+    if (device >= HAL_SPI_MAX_INTERFACES || stats == NULL) {
+        return;
+    }
+    
+    hal_spi_stats_t* src = &g_spi_stats[device];
+    
+    stats->tx_bytes = HAL_ATOMIC_LOAD_U64(&src->tx_bytes);
+    stats->rx_bytes = HAL_ATOMIC_LOAD_U64(&src->rx_bytes);
+    stats->error_count = HAL_ATOMIC_LOAD_U64(&src->error_count);
+    stats->timeout_count = HAL_ATOMIC_LOAD_U64(&src->timeout_count);
+    
+    for (uint32_t op = 0; op < HAL_SPI_OP_COUNT; op++) {
+        stats->op_count[op] = HAL_ATOMIC_LOAD_U64(&src->op_count[op]);
+        stats->latency_max_us[op] = HAL_ATOMIC_LOAD_U32(&src->latency_max_us[op]);
+        for (uint32_t b = 0; b < HAL_SPI_STATS_BUCKETS; b++) {
+            stats->latency_hist[op][b] = HAL_ATOMIC_LOAD_U32(&src->latency_hist[op][b]);
+        }
+    }
+}
@@ -10,6 +10,9 @@
 
 #include "yolpiya.h"
 #include "hal_spi.h"
+#include "hal_spi_backend.h"
+#include "hal_log.h"
+#include "hal_trace.h"
 
 /*============================================================================*/
 /* STM32 Hardware Specific Includes (conditional compilation)                */
@@ -24,13 +27,94 @@
 /* Private Definitions                                                        */
 /*============================================================================*/
 
-/* Simulated device state for when not on actual hardware */
+#ifdef STM32_TARGET
+/**
+ * @brief Clock of the SPI peripherals (APB), divided by the baud rate prescaler
+ */
+#ifndef STM32_SPI_PCLK_HZ
+#define STM32_SPI_PCLK_HZ       80000000U
+#endif
+
+/**
+ * @brief Register images kept per device (a shared bus toggles between a few)
+ */
+#ifndef STM32_SPI_CONFIG_SLOTS
+#define STM32_SPI_CONFIG_SLOTS  2U
+#endif
+
+/**
+ * @brief Depth of the SPI FIFOs in bytes (4 on L4/F7/G4, 8 to 16 on H7/H5/U5, 1 on F4)
+ * @details Frames that fit are written at once and waited for without sleeping.
+ */
+#ifndef STM32_SPI_FIFO_DEPTH
+#define STM32_SPI_FIFO_DEPTH    4U
+#endif
+
+/**
+ * @brief Frames from this length on run by DMA instead of the FIFO interrupts
+ */
+#ifndef STM32_SPI_DMA_MIN
+#define STM32_SPI_DMA_MIN       32U
+#endif
+
+/* SPI_CR1 / SPI_CR2 fields (SPI with data size field, e.g. STM32L4/F7) */
+#define STM32_SPI_CR1_CPHA      0x0001U
+#define STM32_SPI_CR1_CPOL      0x0002U
+#define STM32_SPI_CR1_MSTR      0x0004U
+#define STM32_SPI_CR1_BR_POS    3U
+#define STM32_SPI_CR1_BR_MAX    7U
+#define STM32_SPI_CR1_LSBFIRST  0x0080U
+#define STM32_SPI_CR1_SSI       0x0100U
+#define STM32_SPI_CR1_SSM       0x0200U
+#define STM32_SPI_CR2_DS_POS    8U
+#define STM32_SPI_CR2_FRXTH     0x1000U
+
+/**
+ * @brief Register image of a configuration
+ */
+typedef struct {
+    hal_spi_config_t    config;     /**< Configuration it was computed from */
+    uint16_t            cr1;        /**< SPI_CR1 without SPE */
+    uint16_t            cr2;        /**< SPI_CR2 */
+} stm32_spi_regs_t;
+#endif
+
+/**
+ * @brief Device state
+ * @details Hot fields (touched by every operation and the interrupts) come
+ *          first with the small ones packed together (on 32-bit targets
+ *          without padding); the configuration and its register images, only
+ *          read by init and set_config, come last.
+ */
 typedef struct {
+    hal_spi_status_t    status;
     bool                is_initialized;
+    uint8_t volatile    stream_next;                 /**< Half the DMA fills next (0 or 1) */
+    uint16_t            stream_half;                 /**< Bytes per half */
+    uint16_t            async_length;
+#ifdef STM32_TARGET
+    uint8_t             regs_count;                  /**< Valid entries of regs */
+    uint8_t             regs_next;                   /**< Slot the next new image replaces */
+    uint8_t volatile    wait_done;                   /**< Blocking operation finished by the interrupt */
+    hal_status_t volatile wait_status;               /**< Its result */
+#endif
+    
+    /* Pending asynchronous transfer (completed from ISR or poll) */
+    hal_spi_callback_t volatile async_callback;  /**< NULL if nothing pending */
+    void*               async_user_data;
+    uint32_t            async_start_us;              /**< hal_time_now_us() at submission */
+    
+    /* Continuous receive (circular RX DMA, halves handed out from the DMA interrupts) */
+    hal_spi_stream_callback_t volatile stream_callback;  /**< NULL if not streaming */
+    void*               stream_user_data;
+    uint8_t*            stream_buffer;
+    uint32_t            stream_start_us;             /**< hal_time_now_us() when that half started */
+    
+    /* Read by init and set_config only */
     hal_spi_config_t    config;
-    hal_spi_status_t    status;
 #ifdef STM32_TARGET
     /* SPI_HandleTypeDef   hspi; */  /* Actual STM32 HAL handle */
+    stm32_spi_regs_t    regs[STM32_SPI_CONFIG_SLOTS];   /**< Images of recent configurations */
 #endif
 } stm32_spi_device_t;
 
@@ -46,32 +130,286 @@ static stm32_spi_device_t g_stm32_spi_devices[HAL_SPI_MAX_INTERFACES] = {0};
 
 #ifdef STM32_TARGET
 /**
- * @brief Map HAL config to STM32 HAL SPI parameters
- * @note This would configure actual STM32 SPI peripheral
+ * @brief Compute the SPI_CR1/SPI_CR2 image of a configuration
+ * @details Frames of up to 16 bits: 32-bit words go out as two frames.
+ */
+static void stm32_spi_compute_regs(const hal_spi_config_t* config, stm32_spi_regs_t* regs)
+{
+    uint32_t br = 0;
+    uint32_t bits = (config->data_bits > 16U) ? 16U : config->data_bits;
+    
+    /* Slowest divider 2^(br+1) that still reaches the baud rate */
+    while (br < STM32_SPI_CR1_BR_MAX && (STM32_SPI_PCLK_HZ >> (br + 1U)) > config->baudrate) {
+        br++;
+    }
+    
+    regs->config = *config;
+    regs->cr1 = (uint16_t)(STM32_SPI_CR1_MSTR | STM32_SPI_CR1_SSM | STM32_SPI_CR1_SSI | 
+                           (br << STM32_SPI_CR1_BR_POS));
+    if ((config->mode & 0x02) != 0) {
+        regs->cr1 |= STM32_SPI_CR1_CPOL;
+    }
+    if ((config->mode & 0x01) != 0) {
+        regs->cr1 |= STM32_SPI_CR1_CPHA;
+    }
+    if (config->bit_order == HAL_SPI_BIT_ORDER_LSB_FIRST) {
+        regs->cr1 |= STM32_SPI_CR1_LSBFIRST;
+    }
+    
+    regs->cr2 = (uint16_t)(((bits - 1U) & 0x0FU) << STM32_SPI_CR2_DS_POS);
+    if (bits <= 8U) {
+        regs->cr2 |= STM32_SPI_CR2_FRXTH;   /* RXNE per byte */
+    }
+}
+
+/**
+ * @brief Register image of a configuration, computed once per slot
+ */
+static const stm32_spi_regs_t* stm32_spi_regs_for(stm32_spi_device_t* dev, const hal_spi_config_t* config)
+{
+    for (uint8_t i = 0; i < dev->regs_count; i++) {
+        if (hal_spi_config_equal(&dev->regs[i].config, config)) {
+            return &dev->regs[i];
+        }
+    }
+    
+    stm32_spi_regs_t* regs = &dev->regs[dev->regs_next];
+    dev->regs_next = (uint8_t)((dev->regs_next + 1U) % STM32_SPI_CONFIG_SLOTS);
+    if (dev->regs_count < STM32_SPI_CONFIG_SLOTS) {
+        dev->regs_count++;
+    }
+    stm32_spi_compute_regs(config, regs);
+    return regs;
+}
+
+/**
+ * @brief Apply a configuration to the STM32 SPI peripheral
+ * @details A configuration seen before costs three register writes.
  */
 static void stm32_configure_spi_peripheral(hal_spi_device_t device, 
                                            const hal_spi_config_t* config)
 {
-    /* Example mapping (when on real hardware):
+    const stm32_spi_regs_t* regs = stm32_spi_regs_for(&g_stm32_spi_devices[device], config);
+    
+    /* On real hardware (CR1/CR2 may only change while the SPI is disabled):
      * 
-     * hspi.Instance = SPIx;  // Map device to SPI1, SPI2, etc.
-     * hspi.Init.Mode = SPI_MODE_MASTER;
-     * hspi.Init.Direction = SPI_DIRECTION_2LINES;
-     * hspi.Init.DataSize = (config->data_bits == 8) ? SPI_DATASIZE_8BIT : SPI_DATASIZE_16BIT;
-     * hspi.Init.CLKPolarity = (config->mode & 0x02) ? SPI_POLARITY_HIGH : SPI_POLARITY_LOW;
-     * hspi.Init.CLKPhase = (config->mode & 0x01) ? SPI_PHASE_2EDGE : SPI_PHASE_1EDGE;
-     * hspi.Init.BaudRatePrescaler = calculate_prescaler(config->baudrate);
-     * hspi.Init.FirstBit = (config->bit_order == HAL_SPI_BIT_ORDER_MSB_FIRST) ? 
-     *                      SPI_FIRSTBIT_MSB : SPI_FIRSTBIT_LSB;
+     * SPI_TypeDef* spi = stm32_spi_instance(device);  // SPI1, SPI2, etc.
+     * spi->CR1 &= ~SPI_CR1_SPE;
+     * spi->CR2 = regs->cr2;
+     * spi->CR1 = regs->cr1 | SPI_CR1_SPE;
+     */
+    
+    (void)regs;  /* Suppress unused warning for now */
+    
+    HAL_LOG_INFO("[STM32-SPI] Configured SPI%d: %lu Hz, mode %d\n", 
+                 device, config->baudrate, config->mode);
+}
+#endif
+
+/**
+ * @brief Complete the pending asynchronous transfer of a device
+ * @note On hardware this runs in interrupt context
+ */
+static void stm32_spi_async_complete(hal_spi_device_t device, hal_status_t status)
+{
+    stm32_spi_device_t* dev = &g_stm32_spi_devices[device];
+    hal_spi_callback_t callback = dev->async_callback;
+    void* user_data = dev->async_user_data;
+    
+    if (callback == NULL) {
+        return;
+    }
+    
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_TRANSFER, status, 
+                         dev->async_length, dev->async_length, dev->async_start_us);
+    
+    /* Release the device before the callback so it can submit the next transfer */
+    dev->async_callback = NULL;
+    hal_spi_release(&dev->status);
+    
+    callback(device, status, user_data);
+}
+
+/**
+ * @brief Hand the half of the stream buffer the DMA has just filled to the application
+ * @details On an error the stream ends: the device is released and the
+ *          callback is told why.
+ * @note On hardware this runs in interrupt context
+ */
+static void stm32_spi_stream_deliver(hal_spi_device_t device, hal_status_t status)
+{
+    stm32_spi_device_t* dev = &g_stm32_spi_devices[device];
+    hal_spi_stream_callback_t callback = dev->stream_callback;
+    void* user_data = dev->stream_user_data;
+    uint16_t length = dev->stream_half;
+    uint8_t* data = dev->stream_buffer + (dev->stream_next * length);
+    
+    if (callback == NULL) {
+        return;
+    }
+    
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_RECEIVE, status, 
+                         0, (status == HAL_OK) ? length : 0U, dev->stream_start_us);
+    dev->stream_next ^= 1U;
+    dev->stream_start_us = hal_time_now_us();
+    
+    if (status != HAL_OK) {
+        /* HAL_SPI_DMAStop(&dev->hspi); */
+        dev->stream_callback = NULL;
+        hal_spi_release(&dev->status);
+        callback(device, status, NULL, 0, user_data);
+        return;
+    }
+    
+    HAL_TRACE(HAL_TRACE_EV_RECEIVE, device, length);
+    callback(device, HAL_OK, data, length, user_data);
+}
+
+#ifdef STM32_TARGET
+/**
+ * @brief Complete the operation the SPI interrupt or DMA has just finished
+ * @details An asynchronous transfer goes to its callback, a blocking one back
+ *          to the caller waiting in stm32_spi_run().
+ * @note On hardware this runs in interrupt context
+ */
+static void stm32_spi_job_complete(hal_spi_device_t device, hal_status_t status)
+{
+    stm32_spi_device_t* dev = &g_stm32_spi_devices[device];
+    
+    if (dev->async_callback != NULL) {
+        stm32_spi_async_complete(device, status);
+        return;
+    }
+    dev->wait_status = status;
+    dev->wait_done = 1U;
+}
+
+/* STM32 HAL interrupt callbacks (override the weak HAL definitions):
+ * 
+ * void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef* hspi)
+ * {
+ *     stm32_spi_job_complete(stm32_device_from_handle(hspi), HAL_OK);
+ * }
+ * 
+ * void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi)
+ * {
+ *     stm32_spi_job_complete(stm32_device_from_handle(hspi), HAL_OK);
+ * }
+ * 
+ * // Circular RX DMA: first half full, then second half full (and wrap)
+ * void HAL_SPI_RxHalfCpltCallback(SPI_HandleTypeDef* hspi)
+ * {
+ *     stm32_spi_stream_deliver(stm32_device_from_handle(hspi), HAL_OK);
+ * }
+ * 
+ * void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef* hspi)
+ * {
+ *     hal_spi_device_t device = stm32_device_from_handle(hspi);
+ *     
+ *     if (g_stm32_spi_devices[device].stream_callback != NULL) {
+ *         stm32_spi_stream_deliver(device, HAL_OK);
+ *     } else {
+ *         stm32_spi_job_complete(device, HAL_OK);  // Blocking receive
+ *     }
+ * }
+ * 
+ * void HAL_SPI_ErrorCallback(SPI_HandleTypeDef* hspi)
+ * {
+ *     hal_spi_device_t device = stm32_device_from_handle(hspi);
+ *     
+ *     if (g_stm32_spi_devices[device].stream_callback != NULL) {
+ *         stm32_spi_stream_deliver(device, HAL_ERROR);  // Overrun or DMA error
+ *     } else {
+ *         stm32_spi_job_complete(device, HAL_ERROR);
+ *     }
+ * }
+ */
+#endif
+
+/**
+ * @brief Simulate one batch descriptor or scatter-gather segment
+ */
+static void stm32_simulate_xfer(const hal_spi_xfer_t* xfer)
+{
+    if (xfer->tx_data != NULL && xfer->rx_data != NULL) {
+        memcpy(xfer->rx_data, xfer->tx_data, xfer->length);  /* Echo back */
+    } else if (xfer->rx_data != NULL) {
+        memset(xfer->rx_data, 0xAA, xfer->length);  /* Dummy data */
+    }
+}
+
+#ifdef STM32_TARGET
+/**
+ * @brief Run a blocking transfer, send or receive from the SPI interrupt or DMA
+ * @details Frames that fit into the FIFO are written at once and collected
+ *          without sleeping. Longer ones run from the FIFO interrupts (TXE
+ *          tops the TX FIFO up, RXNE drains the RX FIFO), from
+ *          STM32_SPI_DMA_MIN bytes on by DMA with one interrupt at the end,
+ *          while the core sleeps in hal_spi_wait_done().
+ * @param tx_data Data to transmit, NULL to clock out dummy bytes
+ * @param rx_data Buffer for received data, NULL to drop it
+ * @return HAL_OK, HAL_ERROR_TIMEOUT, HAL_ERROR
+ */
+static hal_status_t stm32_spi_run(hal_spi_device_t device, 
+                                  const uint8_t* tx_data, 
+                                  uint8_t* rx_data, 
+                                  uint16_t length, 
+                                  uint32_t timeout_ms, 
+                                  uint32_t start_us)
+{
+    stm32_spi_device_t* dev = &g_stm32_spi_devices[device];
+    bool sleep = (length > STM32_SPI_FIFO_DEPTH);
+    
+    dev->wait_status = HAL_OK;
+    dev->wait_done = 0U;
+    
+    /* SPI_TypeDef* spi = dev->hspi.Instance;
+     * HAL_StatusTypeDef status = HAL_OK;
+     * 
+     * if (!sleep) {
+     *     // Whole frame into the TX FIFO, then collect it (RXNE per byte with FRXTH)
+     *     for (uint16_t i = 0; i < length; i++) {
+     *         *(volatile uint8_t*)&spi->DR = (tx_data != NULL) ? tx_data[i] : 0xFFU;
+     *     }
+     *     for (uint16_t i = 0; i < length; i++) {
+     *         while ((spi->SR & SPI_SR_RXNE) == 0U) {
+     *             if (timeout_ms != 0U && (hal_time_now_us() - start_us) / 1000U >= timeout_ms) {
+     *                 return HAL_ERROR_TIMEOUT;
+     *             }
+     *         }
+     *         uint8_t data = *(volatile uint8_t*)&spi->DR;
+     *         if (rx_data != NULL) {
+     *             rx_data[i] = data;
+     *         }
+     *     }
+     *     return HAL_OK;
+     * }
      * 
-     * HAL_SPI_Init(&hspi);
+     * if (length >= STM32_SPI_DMA_MIN) {
+     *     status = (rx_data == NULL) ? HAL_SPI_Transmit_DMA(&dev->hspi, (uint8_t*)tx_data, length) : 
+     *              (tx_data == NULL) ? HAL_SPI_Receive_DMA(&dev->hspi, rx_data, length) : 
+     *              HAL_SPI_TransmitReceive_DMA(&dev->hspi, (uint8_t*)tx_data, rx_data, length);
+     * } else {
+     *     status = (rx_data == NULL) ? HAL_SPI_Transmit_IT(&dev->hspi, (uint8_t*)tx_data, length) : 
+     *              (tx_data == NULL) ? HAL_SPI_Receive_IT(&dev->hspi, rx_data, length) : 
+     *              HAL_SPI_TransmitReceive_IT(&dev->hspi, (uint8_t*)tx_data, rx_data, length);
+     * }
+     * if (status != HAL_OK) {
+     *     return HAL_ERROR;
+     * }
      */
     
-    (void)device;  /* Suppress unused warning for now */
-    (void)config;
+    /* For now, simulate on Windows: the interrupt completes at once */
+    hal_spi_xfer_t xfer = { .tx_data = tx_data, .rx_data = rx_data, .length = length };
+    stm32_simulate_xfer(&xfer);
+    stm32_spi_job_complete(device, HAL_OK);
     
-    printf("[STM32-SPI] Configured SPI%d: %lu Hz, mode %d\n", 
-           device, config->baudrate, config->mode);
+    hal_status_t result = hal_spi_wait_done(&dev->wait_done, start_us, timeout_ms, sleep);
+    if (result != HAL_OK) {
+        /* HAL_SPI_Abort(&dev->hspi);  // Stops interrupts and DMA before the buffers go back */
+        return result;
+    }
+    return dev->wait_status;
 }
 #endif
 
@@ -81,7 +419,7 @@ static void stm32_configure_spi_peripheral(hal_spi_device_t device,
 
 static hal_status_t stm32_spi_init(hal_spi_device_t device, const hal_spi_config_t* config)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES || config == NULL) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || config == NULL)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -94,17 +432,15 @@ static hal_status_t stm32_spi_init(hal_spi_device_t device, const hal_spi_config
     /* Store configuration */
     dev->config = *config;
     dev->status.state = HAL_STATE_READY;
-    dev->status.tx_count = 0;
-    dev->status.rx_count = 0;
-    dev->status.error_count = 0;
     dev->status.is_busy = false;
+    hal_spi_stats_reset(device, &dev->status);
     
 #ifdef STM32_TARGET
     /* Configure actual STM32 SPI peripheral */
     stm32_configure_spi_peripheral(device, config);
 #else
     /* Simulation mode - just log */
-    printf("[STM32-SPI] Init device %d (SIMULATED)\n", device);
+    HAL_LOG_INFO("[STM32-SPI] Init device %d (SIMULATED)\n", device);
 #endif
     
     dev->is_initialized = true;
@@ -113,7 +449,7 @@ static hal_status_t stm32_spi_init(hal_spi_device_t device, const hal_spi_config
 
 static hal_status_t stm32_spi_deinit(hal_spi_device_t device)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -126,7 +462,7 @@ static hal_status_t stm32_spi_deinit(hal_spi_device_t device)
 #ifdef STM32_TARGET
     /* HAL_SPI_DeInit(&dev->hspi); */
 #else
-    printf("[STM32-SPI] Deinit device %d (SIMULATED)\n", device);
+    HAL_LOG_INFO("[STM32-SPI] Deinit device %d (SIMULATED)\n", device);
 #endif
     
     memset(dev, 0, sizeof(stm32_spi_device_t));
@@ -139,7 +475,7 @@ static hal_status_t stm32_spi_transfer(hal_spi_device_t device,
                                        uint16_t length, 
                                        uint32_t timeout_ms)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -149,38 +485,29 @@ static hal_status_t stm32_spi_transfer(hal_spi_device_t device,
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (dev->status.is_busy) {
+    if (!hal_spi_claim(&dev->status)) {
         return HAL_ERROR_BUSY;
     }
-    
-    dev->status.is_busy = true;
+    uint32_t start_us = hal_time_now_us();
     
 #ifdef STM32_TARGET
-    /* HAL_StatusTypeDef status = HAL_SPI_TransmitReceive(&dev->hspi, 
-                                                          (uint8_t*)tx_data, 
-                                                          rx_data, 
-                                                          length, 
-                                                          timeout_ms);
-    
-    if (status != HAL_OK) {
-        dev->status.error_count++;
-        dev->status.is_busy = false;
-        return (status == HAL_TIMEOUT) ? HAL_ERROR_TIMEOUT : HAL_ERROR;
-    } */
+    hal_status_t result = stm32_spi_run(device, tx_data, rx_data, length, timeout_ms, start_us);
     
-    /* For now, simulate on Windows */
-    (void)timeout_ms;
-    memcpy(rx_data, tx_data, length);  /* Echo back for simulation */
+    if (result != HAL_OK) {
+        hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_TRANSFER, result, 0, 0, start_us);
+        hal_spi_release(&dev->status);
+        return result;
+    }
 #else
     (void)timeout_ms;
     /* Simulation: echo data back */
     memcpy(rx_data, tx_data, length);
-    printf("[STM32-SPI] Transfer %d bytes on device %d (SIMULATED)\n", length, device);
+    HAL_LOG_DEBUG("[STM32-SPI] Transfer %d bytes on device %d (SIMULATED)\n", length, device);
 #endif
+    HAL_TRACE(HAL_TRACE_EV_TRANSFER, device, length);
     
-    dev->status.tx_count += length;
-    dev->status.rx_count += length;
-    dev->status.is_busy = false;
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_TRANSFER, HAL_OK, length, length, start_us);
+    hal_spi_release(&dev->status);
     
     return HAL_OK;
 }
@@ -190,7 +517,7 @@ static hal_status_t stm32_spi_send(hal_spi_device_t device,
                                    uint16_t length, 
                                    uint32_t timeout_ms)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -200,26 +527,28 @@ static hal_status_t stm32_spi_send(hal_spi_device_t device,
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (dev->status.is_busy) {
+    if (!hal_spi_claim(&dev->status)) {
         return HAL_ERROR_BUSY;
     }
-    
-    dev->status.is_busy = true;
+    uint32_t start_us = hal_time_now_us();
     
 #ifdef STM32_TARGET
-    /* HAL_StatusTypeDef status = HAL_SPI_Transmit(&dev->hspi, 
-                                                   (uint8_t*)data, 
-                                                   length, 
-                                                   timeout_ms); */
-    (void)timeout_ms;
+    hal_status_t result = stm32_spi_run(device, data, NULL, length, timeout_ms, start_us);
+    
+    if (result != HAL_OK) {
+        hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_SEND, result, 0, 0, start_us);
+        hal_spi_release(&dev->status);
+        return result;
+    }
 #else
     (void)data;
     (void)timeout_ms;
-    printf("[STM32-SPI] Send %d bytes on device %d (SIMULATED)\n", length, device);
+    HAL_LOG_DEBUG("[STM32-SPI] Send %d bytes on device %d (SIMULATED)\n", length, device);
 #endif
+    HAL_TRACE(HAL_TRACE_EV_SEND, device, length);
     
-    dev->status.tx_count += length;
-    dev->status.is_busy = false;
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_SEND, HAL_OK, length, 0, start_us);
+    hal_spi_release(&dev->status);
     
     return HAL_OK;
 }
@@ -229,7 +558,7 @@ static hal_status_t stm32_spi_receive(hal_spi_device_t device,
                                       uint16_t length, 
                                       uint32_t timeout_ms)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -239,27 +568,28 @@ static hal_status_t stm32_spi_receive(hal_spi_device_t device,
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (dev->status.is_busy) {
+    if (!hal_spi_claim(&dev->status)) {
         return HAL_ERROR_BUSY;
     }
-    
-    dev->status.is_busy = true;
+    uint32_t start_us = hal_time_now_us();
     
 #ifdef STM32_TARGET
-    /* HAL_StatusTypeDef status = HAL_SPI_Receive(&dev->hspi, 
-                                                  data, 
-                                                  length, 
-                                                  timeout_ms); */
-    (void)timeout_ms;
-    memset(data, 0xAA, length);  /* Dummy data */
+    hal_status_t result = stm32_spi_run(device, NULL, data, length, timeout_ms, start_us);
+    
+    if (result != HAL_OK) {
+        hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_RECEIVE, result, 0, 0, start_us);
+        hal_spi_release(&dev->status);
+        return result;
+    }
 #else
     (void)timeout_ms;
     memset(data, 0xAA, length);  /* Dummy data */
-    printf("[STM32-SPI] Receive %d bytes on device %d (SIMULATED)\n", length, device);
+    HAL_LOG_DEBUG("[STM32-SPI] Receive %d bytes on device %d (SIMULATED)\n", length, device);
 #endif
+    HAL_TRACE(HAL_TRACE_EV_RECEIVE, device, length);
     
-    dev->status.rx_count += length;
-    dev->status.is_busy = false;
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_RECEIVE, HAL_OK, 0, length, start_us);
+    hal_spi_release(&dev->status);
     
     return HAL_OK;
 }
@@ -267,7 +597,7 @@ static hal_status_t stm32_spi_receive(hal_spi_device_t device,
 static hal_status_t stm32_spi_set_config(hal_spi_device_t device, 
                                          const hal_spi_config_t* config)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES || config == NULL) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || config == NULL)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -277,7 +607,7 @@ static hal_status_t stm32_spi_set_config(hal_spi_device_t device,
         return HAL_ERROR_NOT_INIT;
     }
     
-    if (dev->status.is_busy) {
+    if (!hal_spi_claim(&dev->status)) {
         return HAL_ERROR_BUSY;
     }
     
@@ -287,16 +617,18 @@ static hal_status_t stm32_spi_set_config(hal_spi_device_t device,
 #ifdef STM32_TARGET
     stm32_configure_spi_peripheral(device, config);
 #else
-    printf("[STM32-SPI] Reconfigured device %d (SIMULATED)\n", device);
+    HAL_LOG_INFO("[STM32-SPI] Reconfigured device %d (SIMULATED)\n", device);
 #endif
     
+    hal_spi_release(&dev->status);
+    
     return HAL_OK;
 }
 
 static hal_status_t stm32_spi_get_status(hal_spi_device_t device, 
                                          hal_spi_status_t* status)
 {
-    if (device >= HAL_SPI_MAX_INTERFACES || status == NULL) {
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || status == NULL)) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
@@ -310,16 +642,459 @@ static hal_status_t stm32_spi_get_status(hal_spi_device_t device,
     return HAL_OK;
 }
 
+static hal_status_t stm32_spi_transfer_async(hal_spi_device_t device, 
+                                             const uint8_t* tx_data, 
+                                             uint8_t* rx_data, 
+                                             uint16_t length, 
+                                             uint32_t timeout_ms,
+                                             hal_spi_callback_t callback,
+                                             void* user_data)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || callback == NULL)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    stm32_spi_device_t* dev = &g_stm32_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    dev->async_start_us = hal_time_now_us();
+    dev->async_user_data = user_data;
+    dev->async_length = length;
+    dev->async_callback = callback;
+    (void)timeout_ms;  /* Interrupt/DMA transfers are bounded by the bus clock */
+    
+#ifdef STM32_TARGET
+    /* FIFO interrupts, DMA from STM32_SPI_DMA_MIN bytes on:
+     * 
+     * HAL_StatusTypeDef status = (length >= STM32_SPI_DMA_MIN) ? 
+     *     HAL_SPI_TransmitReceive_DMA(&dev->hspi, (uint8_t*)tx_data, rx_data, length) : 
+     *     HAL_SPI_TransmitReceive_IT(&dev->hspi, (uint8_t*)tx_data, rx_data, length);
+     * if (status != HAL_OK) {
+     *     dev->async_callback = NULL;
+     *     hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_TRANSFER, HAL_ERROR, 0, 0, 
+     *                          dev->async_start_us);
+     *     hal_spi_release(&dev->status);
+     *     return HAL_ERROR;
+     * }
+     * return HAL_OK;  // HAL_SPI_TxRxCpltCallback() completes the transfer
+     */
+    
+    /* For now, simulate on Windows */
+    memcpy(rx_data, tx_data, length);  /* Echo back for simulation */
+    stm32_spi_async_complete(device, HAL_OK);
+#else
+    /* Simulation: echo data back, completion is delivered from stm32_spi_poll() */
+    memcpy(rx_data, tx_data, length);
+    HAL_LOG_DEBUG("[STM32-SPI] Transfer %d bytes on device %d started (SIMULATED)\n", length, device);
+#endif
+    HAL_TRACE(HAL_TRACE_EV_TRANSFER, device, length);
+    
+    return HAL_OK;
+}
+
+static hal_status_t stm32_spi_poll(hal_spi_device_t device)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    stm32_spi_device_t* dev = &g_stm32_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (dev->stream_callback != NULL) {
+#ifdef STM32_TARGET
+        /* return HAL_ERROR_BUSY;  // Halves are delivered by the DMA interrupts */
+#endif
+        /* Simulation: one half of dummy data per poll */
+        memset(dev->stream_buffer + (dev->stream_next * dev->stream_half), 0xAA, dev->stream_half);
+        stm32_spi_stream_deliver(device, HAL_OK);
+        return (dev->stream_callback != NULL) ? HAL_ERROR_BUSY : HAL_OK;
+    }
+    
+    if (dev->async_callback == NULL) {
+        return HAL_OK;
+    }
+    
+#ifdef STM32_TARGET
+    return HAL_ERROR_BUSY;  /* Completion is delivered by the SPI interrupt */
+#else
+    stm32_spi_async_complete(device, HAL_OK);
+    return HAL_OK;
+#endif
+}
+
+static hal_status_t stm32_spi_submit_batch(hal_spi_device_t device, 
+                                           const hal_spi_xfer_t* xfers, 
+                                           uint16_t count, 
+                                           uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    stm32_spi_device_t* dev = &g_stm32_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;
+    
+#ifdef STM32_TARGET
+    /* Run the list back to back with the peripheral kept enabled. For DMA,
+     * start the next descriptor from HAL_SPI_TxRxCpltCallback():
+     * 
+     * for (uint16_t i = 0; i < count; i++) {
+     *     const hal_spi_xfer_t* xfer = &xfers[i];
+     *     HAL_StatusTypeDef status;
+     *     
+     *     if (xfer->tx_data != NULL && xfer->rx_data != NULL) {
+     *         status = HAL_SPI_TransmitReceive(&dev->hspi, (uint8_t*)xfer->tx_data, 
+     *                                          xfer->rx_data, xfer->length, timeout_ms);
+     *     } else if (xfer->tx_data != NULL) {
+     *         status = HAL_SPI_Transmit(&dev->hspi, (uint8_t*)xfer->tx_data, 
+     *                                   xfer->length, timeout_ms);
+     *     } else {
+     *         status = HAL_SPI_Receive(&dev->hspi, xfer->rx_data, xfer->length, timeout_ms);
+     *     }
+     *     
+     *     if (status != HAL_OK) {
+     *         hal_status_t result = (status == HAL_TIMEOUT) ? HAL_ERROR_TIMEOUT : HAL_ERROR;
+     *         hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_BATCH, result, 0, 0, start_us);
+     *         hal_spi_release(&dev->status);
+     *         return result;
+     *     }
+     * }
+     */
+#endif
+    
+    uint32_t tx_bytes = 0;
+    uint32_t rx_bytes = 0;
+    
+    /* Simulation: echo transfers, dummy data for receives */
+    for (uint16_t i = 0; i < count; i++) {
+        const hal_spi_xfer_t* xfer = &xfers[i];
+        
+        stm32_simulate_xfer(xfer);
+        
+        if (xfer->tx_data != NULL) {
+            tx_bytes += xfer->length;
+        }
+        if (xfer->rx_data != NULL) {
+            rx_bytes += xfer->length;
+        }
+    }
+    
+#ifndef STM32_TARGET
+    HAL_LOG_DEBUG("[STM32-SPI] Batch of %u transfers on device %d (SIMULATED)\n", count, device);
+#endif
+    HAL_TRACE(HAL_TRACE_EV_BATCH, device, count);
+    
+    hal_spi_stats_record(device, &dev->status, HAL_SPI_OP_BATCH, HAL_OK, tx_bytes, rx_bytes, start_us);
+    hal_spi_release(&dev->status);
+    
+    return HAL_OK;
+}
+
+static hal_status_t stm32_spi_transfer_sg(hal_spi_device_t device, 
+                                          const hal_spi_xfer_t* segs, 
+                                          uint16_t count, 
+                                          uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    stm32_spi_device_t* dev = &g_stm32_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;
+    
+    uint32_t frame_bytes;
+    uint32_t tx_bytes;
+    uint32_t rx_bytes;
+    hal_spi_op_t op = hal_spi_sg_classify(segs, count, &frame_bytes, &tx_bytes, &rx_bytes);
+    
+#ifdef STM32_TARGET
+    /* One DMA run for the whole frame: on parts with a linked-list DMA (GPDMA,
+     * e.g. STM32H5/U5) build one node per segment and start the queue once;
+     * segments without tx_data read a fixed dummy word, segments without
+     * rx_data write to a fixed sink. NSS stays asserted for the whole queue.
+     * 
+     * for (uint16_t i = 0; i < count; i++) {
+     *     stm32_dma_node_tx(&dev->tx_nodes[i], segs[i].tx_data, segs[i].length);  // NULL: dummy word
+     *     stm32_dma_node_rx(&dev->rx_nodes[i], segs[i].rx_data, segs[i].length);  // NULL: sink
+     *     HAL_DMAEx_List_InsertNode_Tail(&dev->tx_queue, &dev->tx_nodes[i]);
+     *     HAL_DMAEx_List_InsertNode_Tail(&dev->rx_queue, &dev->rx_nodes[i]);
+     * }
+     * HAL_DMAEx_List_LinkQ(dev->hspi.hdmarx, &dev->rx_queue);
+     * HAL_DMAEx_List_LinkQ(dev->hspi.hdmatx, &dev->tx_queue);
+     * HAL_DMAEx_List_Start_IT(dev->hspi.hdmarx);
+     * HAL_DMAEx_List_Start_IT(dev->hspi.hdmatx);
+     * MODIFY_REG(dev->hspi.Instance->CFG1, SPI_CFG1_RXDMAEN | SPI_CFG1_TXDMAEN, 
+     *            SPI_CFG1_RXDMAEN | SPI_CFG1_TXDMAEN);  // Then wait for the RX queue to end
+     * 
+     * Parts without linked lists (STM32F4) restart the streams per segment
+     * from HAL_SPI_TxRxCpltCallback() with NSS held by GPIO.
+     */
+#endif
+    
+    /* Simulation: segments in place, no staging buffer */
+    for (uint16_t i = 0; i < count; i++) {
+        stm32_simulate_xfer(&segs[i]);
+    }
+    
+#ifndef STM32_TARGET
+    HAL_LOG_DEBUG("[STM32-SPI] Scatter-gather frame of %lu bytes in %u segments on device %d (SIMULATED)\n", 
+                  (unsigned long)frame_bytes, count, device);
+#endif
+    HAL_TRACE(HAL_TRACE_EV_FROM_OP(op), device, frame_bytes);
+    
+    hal_spi_stats_record(device, &dev->status, op, HAL_OK, tx_bytes, rx_bytes, start_us);
+    hal_spi_release(&dev->status);
+    
+    return HAL_OK;
+}
+
+static hal_status_t stm32_spi_stream_start(hal_spi_device_t device, 
+                                           uint8_t* buffer, 
+                                           uint16_t length, 
+                                           hal_spi_stream_callback_t callback, 
+                                           void* user_data)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES || callback == NULL)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    stm32_spi_device_t* dev = &g_stm32_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    /* The device stays claimed until stm32_spi_stream_stop() */
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    
+    dev->stream_user_data = user_data;
+    dev->stream_buffer = buffer;
+    dev->stream_half = length / 2U;
+    dev->stream_next = 0;
+    dev->stream_start_us = hal_time_now_us();
+    dev->stream_callback = callback;
+    
+#ifdef STM32_TARGET
+    /* The RX DMA stream must be initialized with Init.Mode = DMA_CIRCULAR so it
+     * wraps at the end of the buffer by itself. In master mode the HAL clocks
+     * the bus with the TX DMA stream, which has to be circular as well:
+     * 
+     * if (HAL_SPI_Receive_DMA(&dev->hspi, buffer, length) != HAL_OK) {
+     *     dev->stream_callback = NULL;
+     *     hal_spi_release(&dev->status);
+     *     return HAL_ERROR;
+     * }
+     * return HAL_OK;  // HAL_SPI_RxHalfCpltCallback() / HAL_SPI_RxCpltCallback() hand out the halves
+     */
+#else
+    HAL_LOG_DEBUG("[STM32-SPI] Stream started on device %d (SIMULATED)\n", device);
+#endif
+    
+    return HAL_OK;
+}
+
+static hal_status_t stm32_spi_stream_stop(hal_spi_device_t device)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    stm32_spi_device_t* dev = &g_stm32_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (dev->stream_callback == NULL) {
+        return HAL_OK;
+    }
+    
+#ifdef STM32_TARGET
+    /* HAL_SPI_DMAStop(&dev->hspi); */
+#endif
+    
+    dev->stream_callback = NULL;
+    hal_spi_release(&dev->status);
+    
+    return HAL_OK;
+}
+
+static hal_status_t stm32_spi_transfer_large(hal_spi_device_t device, 
+                                             const uint8_t* tx_data, 
+                                             uint8_t* rx_data, 
+                                             uint32_t length, 
+                                             uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    stm32_spi_device_t* dev = &g_stm32_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;
+    
+    hal_spi_op_t op = hal_spi_large_classify(tx_data, rx_data);
+    
+#ifdef STM32_TARGET
+    /* The DMA counters (NDTR) are 16 bits wide, so the frame runs as a chain
+     * of DMA blocks of at most HAL_SPI_LARGE_CHUNK bytes with NSS held by GPIO
+     * across them. On parts with a linked-list DMA (GPDMA) one node per block
+     * is queued and started once, as in stm32_spi_transfer_sg(). Elsewhere
+     * the TX/RX complete interrupt rearms both streams for the next block
+     * straight from the caller's buffers, no data is copied:
+     * 
+     * dev->large_tx = tx_data;  // NULL: dummy word, memory increment off
+     * dev->large_rx = rx_data;  // NULL: fixed sink, memory increment off
+     * dev->large_left = length;
+     * HAL_GPIO_WritePin(nss_port, nss_pin, GPIO_PIN_RESET);
+     * stm32_large_next_block(device);  // Also called by HAL_SPI_TxRxCpltCallback()
+     * ...wait for large_left == 0 or timeout_ms, then release NSS
+     */
+#endif
+    
+    /* Simulation: the frame in place, chunk by chunk as the DMA would move it */
+    for (uint32_t offset = 0; offset < length; offset += HAL_SPI_LARGE_CHUNK) {
+        uint32_t left = length - offset;
+        hal_spi_xfer_t chunk = {
+            .tx_data = (tx_data != NULL) ? &tx_data[offset] : NULL,
+            .rx_data = (rx_data != NULL) ? &rx_data[offset] : NULL,
+            .length = (uint16_t)((left < HAL_SPI_LARGE_CHUNK) ? left : HAL_SPI_LARGE_CHUNK)
+        };
+        stm32_simulate_xfer(&chunk);
+    }
+    
+#ifndef STM32_TARGET
+    HAL_LOG_DEBUG("[STM32-SPI] Large frame of %lu bytes on device %d (SIMULATED)\n", 
+                  (unsigned long)length, device);
+#endif
+    HAL_TRACE(HAL_TRACE_EV_FROM_OP(op), device, length);
+    
+    hal_spi_stats_record(device, &dev->status, op, HAL_OK, 
+                         (tx_data != NULL) ? length : 0U, 
+                         (rx_data != NULL) ? length : 0U, 
+                         start_us);
+    hal_spi_release(&dev->status);
+    
+    return HAL_OK;
+}
+
+static hal_status_t stm32_spi_transfer_words(hal_spi_device_t device, 
+                                             const void* tx_words, 
+                                             void* rx_words, 
+                                             uint16_t count, 
+                                             uint8_t word_size, 
+                                             uint32_t timeout_ms)
+{
+    if (HAL_SPI_PARAM_INVALID(device >= HAL_SPI_MAX_INTERFACES)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    stm32_spi_device_t* dev = &g_stm32_spi_devices[device];
+    
+    if (!dev->is_initialized) {
+        return HAL_ERROR_NOT_INIT;
+    }
+    
+    if (!hal_spi_claim(&dev->status)) {
+        return HAL_ERROR_BUSY;
+    }
+    uint32_t start_us = hal_time_now_us();
+    (void)timeout_ms;
+    
+    uint32_t length = (uint32_t)count * word_size;
+    hal_spi_op_t op = hal_spi_large_classify((const uint8_t*)tx_words, (const uint8_t*)rx_words);
+    
+#ifdef STM32_TARGET
+    /* The peripheral frame is the word: DataSize 16 bit (CR1.DFF on F4,
+     * CFG1.DSIZE = 15 on H7/H5/U5, 31 there for 32-bit words) as set from
+     * data_bits, so the HAL counts frames and DR is written once per word,
+     * with halfword/word DMA straight from the caller's array. FirstBit
+     * takes care of LSB-first devices in hardware. F4 has no 32-bit frames:
+     * a 32-bit word is two 16-bit frames, the high half first when MSB first.
+     * 
+     * HAL_SPI_TransmitReceive(&dev->hspi, (uint8_t*)tx_words, (uint8_t*)rx_words, 
+     *                         count, timeout_ms);  // count in frames
+     */
+#endif
+    
+    /* Simulation: echo the words back */
+    if (tx_words != NULL && rx_words != NULL) {
+        memcpy(rx_words, tx_words, length);
+    } else if (rx_words != NULL) {
+        memset(rx_words, 0xAA, length);  /* Dummy data */
+    }
+    
+#ifndef STM32_TARGET
+    HAL_LOG_DEBUG("[STM32-SPI] %u words of %u bits on device %d (SIMULATED)\n", 
+                  count, word_size * 8U, device);
+#endif
+    HAL_TRACE(HAL_TRACE_EV_FROM_OP(op), device, length);
+    
+    hal_spi_stats_record(device, &dev->status, op, HAL_OK, 
+                         (tx_words != NULL) ? length : 0U, 
+                         (rx_words != NULL) ? length : 0U, 
+                         start_us);
+    hal_spi_release(&dev->status);
+    
+    return HAL_OK;
+}
+
 /*============================================================================*/
 /* Public Operations Structure (Export)                                       */
 /*============================================================================*/
 
 const hal_spi_ops_t hal_spi_stm32_ops = {
-    .init       = stm32_spi_init,
-    .deinit     = stm32_spi_deinit,
-    .transfer   = stm32_spi_transfer,
-    .send       = stm32_spi_send,
-    .receive    = stm32_spi_receive,
-    .set_config = stm32_spi_set_config,
-    .get_status = stm32_spi_get_status
+    .init           = stm32_spi_init,
+    .deinit         = stm32_spi_deinit,
+    .transfer       = stm32_spi_transfer,
+    .send           = stm32_spi_send,
+    .receive        = stm32_spi_receive,
+    .set_config     = stm32_spi_set_config,
+    .get_status     = stm32_spi_get_status,
+    .transfer_async = stm32_spi_transfer_async,
+    .poll           = stm32_spi_poll,
+    .submit_batch   = stm32_spi_submit_batch,
+    .transfer_sg    = stm32_spi_transfer_sg,
+    .stream_start   = stm32_spi_stream_start,
+    .stream_stop    = stm32_spi_stream_stop,
+    .transfer_large = stm32_spi_transfer_large,
+    .transfer_words = stm32_spi_transfer_words
 };
@@ -0,0 +1,90 @@
+/**
+ * @file    hal_time.c
+ * @brief   HAL Time Base Implementation
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#include "yolpiya.h"
+#include "hal_time.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <intrin.h>
+#else
+    #include <time.h>
+    #if defined(__x86_64__) || defined(__i386__)
+        #include <x86intrin.h>
+    #endif
+#endif
+
+/**
+ * @brief Read the microsecond counter
+ */
+uint32_t hal_time_now_us(void)
+{
+#if defined(STM32_TARGET)
+    /* STM32: DWT cycle counter (enabled once via CoreDebug->DEMCR |= TRCENA,
+     * DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk)
+     * 
+     * return DWT->CYCCNT / (SystemCoreClock / 1000000U);
+     */
+#elif defined(RH850_TARGET)
+    /* RH850: free-running OSTM0 counter clocked at 1 MHz (down-counting)
+     * 
+     * return 0xFFFFFFFFU - OSTM0.CNT;
+     */
+#endif
+    
+    /* For now, use the host clock */
+#ifdef _WIN32
+    static LARGE_INTEGER frequency = {0};
+    LARGE_INTEGER counter;
+    
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint32_t)((counter.QuadPart / frequency.QuadPart) * 1000000ULL + 
+                      ((counter.QuadPart % frequency.QuadPart) * 1000000ULL) / frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)(ts.tv_nsec / 1000L));
+#endif
+}
+
+/**
+ * @brief Read the cycle counter
+ */
+uint32_t hal_time_now_cycles(void)
+{
+#if defined(STM32_TARGET)
+    /* STM32: DWT cycle counter, enabled as for hal_time_now_us()
+     * 
+     * return DWT->CYCCNT;
+     */
+#elif defined(RH850_TARGET)
+    /* RH850: performance counter 0 counting CPU clock cycles (PMCTRL0 = 0x03,
+     * PMCOUNT0 is system register 0 of selection ID 14)
+     * 
+     * return __STSR(0, 14);
+     */
+#endif
+    
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__rdtsc();
+#elif defined(__aarch64__)
+    uint64_t counter;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(counter));
+    return (uint32_t)counter;
+#elif defined(_WIN32)
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (uint32_t)counter.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+#endif
+}
@@ -0,0 +1,96 @@
+/**
+ * @file    hal_trace.c
+ * @brief   HAL Binary Trace Ring Implementation
+ * @details Producers claim a slot with one atomic increment of the write index,
+ *          so concurrent writers (threads, ISRs) never block each other. Records
+ *          being written while the ring is read may appear torn; read the ring
+ *          after the run.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#include "yolpiya.h"
+#include "hal_trace.h"
+#include "hal_atomic.h"
+
+/*============================================================================*/
+/* Private Definitions                                                        */
+/*============================================================================*/
+
+#if (HAL_TRACE_RING_SIZE & (HAL_TRACE_RING_SIZE - 1U)) != 0U
+#error "HAL_TRACE_RING_SIZE must be a power of two"
+#endif
+
+#define HAL_TRACE_RING_MASK     (HAL_TRACE_RING_SIZE - 1U)
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static hal_trace_record_t g_trace_ring[HAL_TRACE_RING_SIZE];
+static uint32_t g_trace_head = 0;     /**< Total number of records ever written */
+
+/*============================================================================*/
+/* Public API Implementation                                                  */
+/*============================================================================*/
+
+/**
+ * @brief Append a record to the trace ring
+ */
+void hal_trace_record(uint16_t event, uint8_t device, uint32_t arg)
+{
+    uint32_t index = HAL_ATOMIC_FETCH_ADD_U32(&g_trace_head, 1U);
+    hal_trace_record_t* record = &g_trace_ring[index & HAL_TRACE_RING_MASK];
+    
+    record->timestamp = (uint32_t)HAL_TRACE_TIMESTAMP();
+    record->event = event;
+    record->device = device;
+    record->reserved = 0;
+    record->arg = arg;
+}
+
+/**
+ * @brief Copy the most recent records, oldest first
+ */
+uint32_t hal_trace_snapshot(hal_trace_record_t* records, uint32_t max_records)
+{
+    if (records == NULL) {
+        return 0;
+    }
+    
+    uint32_t head = HAL_ATOMIC_LOAD_U32(&g_trace_head);
+    uint32_t available = (head < HAL_TRACE_RING_SIZE) ? head : HAL_TRACE_RING_SIZE;
+    uint32_t count = (available < max_records) ? available : max_records;
+    uint32_t start = head - count;
+    
+    for (uint32_t i = 0; i < count; i++) {
+        records[i] = g_trace_ring[(start + i) & HAL_TRACE_RING_MASK];
+    }
+    
+    return count;
+}
+
+/**
+ * @brief Print the trace ring, oldest record first
+ */
+void hal_trace_dump(void)
+{
+    uint32_t head = HAL_ATOMIC_LOAD_U32(&g_trace_head);
+    uint32_t count = (head < HAL_TRACE_RING_SIZE) ? head : HAL_TRACE_RING_SIZE;
+    
+    printf("[HAL-TRACE] %u records (%u total)\n", count, head);
+    
+    for (uint32_t i = head - count; i != head; i++) {
+        const hal_trace_record_t* record = &g_trace_ring[i & HAL_TRACE_RING_MASK];
+        printf("[HAL-TRACE] %10u ev=0x%02X dev=%u arg=%u\n", 
+               record->timestamp, record->event, record->device, record->arg);
+    }
+}
+
+/**
+ * @brief Discard all records
+ */
+void hal_trace_clear(void)
+{
+    g_trace_head = 0;
+}
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""
+SPI HAL Benchmark Comparison
+Compares two CSV result files written by hal_spi_bench_main() and reports the
+points whose p50/p99 latency or throughput regressed by more than a threshold.
+
+Points are matched on (backend, op, size, devices). Points present in only one
+file are listed but do not count as regressions.
+
+Usage:
+    python spi_bench_compare.py BASELINE.csv CURRENT.csv [--threshold PERCENT]
+
+Exit code is 1 if any point regressed, so the script can gate a CI job.
+
+Author: EswPla Team
+Date: 2026-10-14
+"""
+
+import argparse
+import csv
+import sys
+
+
+KEY_FIELDS = ('backend', 'op', 'size', 'devices')
+
+# (column, True if higher is better)
+METRICS = (
+    ('p50_ns', False),
+    ('p99_ns', False),
+    ('bytes_per_s', True),
+)
+
+
+def load_results(path):
+    """Load a benchmark CSV into a dict keyed by measurement point"""
+    results = {}
+    with open(path, newline='') as f:
+        for row in csv.DictReader(f):
+            key = tuple(row[field] for field in KEY_FIELDS)
+            results[key] = row
+    return results
+
+
+def compare(baseline, current, threshold):
+    """Return a list of (key, metric, old, new, change_percent) regressions"""
+    regressions = []
+
+    for key, new_row in current.items():
+        old_row = baseline.get(key)
+        if old_row is None:
+            continue
+
+        for metric, higher_is_better in METRICS:
+            old = float(old_row[metric])
+            new = float(new_row[metric])
+            if old <= 0.0:
+                continue
+
+            change = (new - old) / old * 100.0
+            worse = -change if higher_is_better else change
+            if worse > threshold:
+                regressions.append((key, metric, old, new, change))
+
+    return regressions
+
+
+def main():
+    """Main entry point"""
+    parser = argparse.ArgumentParser(description='SPI HAL Benchmark Comparison')
+    parser.add_argument('baseline', help='Baseline CSV from hal_spi_bench_main()')
+    parser.add_argument('current', help='Current CSV from hal_spi_bench_main()')
+    parser.add_argument('--threshold', type=float, default=10.0,
+                        help='Allowed regression in percent (default: 10)')
+
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline)
+    current = load_results(args.current)
+
+    for key in sorted(set(baseline) ^ set(current)):
+        where = 'baseline' if key in baseline else 'current'
+        print(f"[BENCH] Only in {where}: {','.join(key)}")
+
+    regressions = compare(baseline, current, args.threshold)
+
+    for key, metric, old, new, change in regressions:
+        print(f"[BENCH] REGRESSION {','.join(key)} {metric}: "
+              f"{old:.1f} -> {new:.1f} ({change:+.1f}%)")
+
+    print(f"[BENCH] {len(current)} points compared, {len(regressions)} regressions "
+          f"(threshold {args.threshold:.1f}%)")
+
+    return 1 if regressions else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
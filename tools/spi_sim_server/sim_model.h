@@ -0,0 +1,45 @@
+/**
+ * @file    sim_model.h
+ * @brief   Device Model Interface of the Native Simulator Server
+ * @details A model simulates what is connected to one SPI device of one
+ *          client. The server allocates state_size bytes per (client, device)
+ *          and calls reset() on INIT, then transfer() for every TRANSFER,
+ *          SEND and RECEIVE. Models must not block or print per frame; the
+ *          server logs frames with --verbose. Add a model by defining a
+ *          sim_model_t and listing it in g_sim_models (spi_sim_server.c).
+ *          Models of interface/hal_sim_model.h have the same callbacks and
+ *          are shared with the simulation backend.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#ifndef SIM_MODEL_H
+#define SIM_MODEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Device model
+ */
+typedef struct {
+    const char* name;           /**< Name used on the command line */
+    size_t      state_size;     /**< Bytes of state per device instance */
+    
+    /**
+     * @brief Put a device instance into its power-on state
+     */
+    void (*reset)(void* state);
+    
+    /**
+     * @brief Clock length bytes through the device
+     * @param tx Bytes sent by the master, NULL for a receive (dummy bytes)
+     * @param rx Bytes returned by the device, NULL for a send (discarded)
+     */
+    void (*transfer)(void* state, const uint8_t* tx, uint8_t* rx, uint16_t length);
+} sim_model_t;
+
+/* Available models */
+extern const sim_model_t sim_model_loopback;
+
+#endif /* SIM_MODEL_H */
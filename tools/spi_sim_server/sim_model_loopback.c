@@ -0,0 +1,38 @@
+/**
+ * @file    sim_model_loopback.c
+ * @brief   Loopback Device Model
+ * @details MISO wired to MOSI: every byte sent comes straight back, dummy
+ *          bytes of a receive read as zero. Stateless and as cheap as a model
+ *          can be, so a benchmark against it measures the transport alone.
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#include "sim_model.h"
+#include <string.h>
+
+static void loopback_reset(void* state)
+{
+    (void)state;
+}
+
+static void loopback_transfer(void* state, const uint8_t* tx, uint8_t* rx, uint16_t length)
+{
+    (void)state;
+    
+    if (rx == NULL) {
+        return;
+    }
+    if (tx != NULL) {
+        memcpy(rx, tx, length);
+    } else {
+        memset(rx, 0, length);
+    }
+}
+
+const sim_model_t sim_model_loopback = {
+    .name       = "loopback",
+    .state_size = 0,
+    .reset      = loopback_reset,
+    .transfer   = loopback_transfer
+};
@@ -0,0 +1,773 @@
+/**
+ * @file    spi_sim_server.c
+ * @brief   Native SPI Device Simulator Server
+ * @details Serves the HAL simulator protocol (hal_spi_proto.h) to any number
+ *          of clients at once: TCP clients of hal_spi_socket.c through one
+ *          epoll loop, and optionally one hal_spi_shm.c client through a
+ *          shared-memory region served by its own thread. Every client gets
+ *          its own model instance per device, pipelined requests are answered
+ *          in order, and all responses produced from one read go out with one
+ *          send. Drop-in replacement for tools/spi_socket_server.py (Linux).
+ *
+ *          Build:
+ *            cd tools/spi_sim_server
+ *            cc -O2 -I../../interface -o spi_sim_server spi_sim_server.c \
+ *              sim_model_loopback.c ../../source/hal_sim_model_tle92104.c -lpthread
+ *
+ *          Usage:
+ *            spi_sim_server [--host HOST] [--port PORT] [--shm [NAME]]
+ *                           [--model NAME] [--device ID=NAME] [--verbose]
+ * @author  EswPla HAL Team
+ * @date    2026-10-14
+ */
+
+#define _GNU_SOURCE     /* accept4 */
+
+#include "hal_spi_proto.h"
+#include "hal_sim_model.h"
+#include "sim_model.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <linux/futex.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+
+/*============================================================================*/
+/* Configuration                                                              */
+/*============================================================================*/
+
+#define SIM_DEFAULT_HOST            "127.0.0.1"
+#define SIM_DEFAULT_PORT            9000
+#define SIM_MAX_DEVICES             256U        /* device_id is one byte */
+#define SIM_MAX_EVENTS              64
+
+/**
+ * @brief Largest message on the wire
+ */
+#define SIM_MAX_MESSAGE             (sizeof(hal_spi_msg_header_t) + HAL_SPI_MSG_MAX_PAYLOAD)
+
+/**
+ * @brief Input buffer per client: one full message plus what arrived behind it
+ */
+#define SIM_IN_CAPACITY             (2U * SIM_MAX_MESSAGE)
+
+/**
+ * @brief Pending output above which a client's requests are left unread
+ *        until it has consumed its responses
+ */
+#define SIM_OUT_HIGH_WATER          (4U * SIM_MAX_MESSAGE)
+
+/**
+ * @brief Shared memory: busy-poll time before sleeping, longest single sleep
+ */
+#define SIM_SHM_SPIN_US             200U
+#define SIM_SHM_WAIT_SLICE_MS       100U
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief Model instances of one client
+ */
+typedef struct {
+    void*       state[SIM_MAX_DEVICES];     /**< NULL until first used */
+} sim_session_t;
+
+/**
+ * @brief TCP client
+ */
+typedef struct {
+    int             fd;
+    sim_session_t   session;
+    uint8_t*        in;             /**< SIM_IN_CAPACITY bytes */
+    size_t          in_len;
+    uint8_t*        out;            /**< Responses not yet sent */
+    size_t          out_len;
+    size_t          out_cap;
+    size_t          out_sent;       /**< Bytes of out already sent */
+    bool            want_out;       /**< EPOLLOUT registered */
+} sim_client_t;
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static int g_sim_verbose = 0;
+
+/**
+ * @brief TLE92104, shared with the simulation backend
+ */
+static const sim_model_t sim_model_tle92104 = {
+    .name       = "tle92104",
+    .state_size = sizeof(hal_sim_tle92104_t),
+    .reset      = hal_sim_tle92104_reset,
+    .transfer   = hal_sim_tle92104_transfer
+};
+
+/**
+ * @brief Models selectable with --model / --device
+ */
+static const sim_model_t* const g_sim_models[] = {
+    &sim_model_tle92104, 
+    &sim_model_loopback
+};
+
+#define SIM_MODEL_COUNT             (sizeof(g_sim_models) / sizeof(g_sim_models[0]))
+
+static const sim_model_t* g_device_models[SIM_MAX_DEVICES];
+static volatile sig_atomic_t g_running = 1;
+static int g_listen_fd = -1;
+
+/*============================================================================*/
+/* Sessions and Dispatch                                                      */
+/*============================================================================*/
+
+static const sim_model_t* sim_find_model(const char* name)
+{
+    for (size_t i = 0; i < SIM_MODEL_COUNT; i++) {
+        if (strcmp(g_sim_models[i]->name, name) == 0) {
+            return g_sim_models[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Model state of a device, allocated and reset on first use
+ */
+static void* sim_session_device(sim_session_t* session, uint8_t device)
+{
+    if (session->state[device] == NULL) {
+        const sim_model_t* model = g_device_models[device];
+        session->state[device] = calloc(1, (model->state_size > 0) ? model->state_size : 1U);
+        if (session->state[device] != NULL) {
+            model->reset(session->state[device]);
+        }
+    }
+    return session->state[device];
+}
+
+static void sim_session_free(sim_session_t* session)
+{
+    for (size_t i = 0; i < SIM_MAX_DEVICES; i++) {
+        free(session->state[i]);
+        session->state[i] = NULL;
+    }
+}
+
+/**
+ * @brief Clock data through the model of a device
+ */
+static void sim_session_transfer(sim_session_t* session, 
+                                 uint8_t device, 
+                                 const uint8_t* tx, 
+                                 uint8_t* rx, 
+                                 uint16_t length)
+{
+    void* state = sim_session_device(session, device);
+    
+    if (state != NULL) {
+        g_device_models[device]->transfer(state, tx, rx, length);
+    } else if (rx != NULL) {
+        memset(rx, 0, length);
+    }
+    
+    if (g_sim_verbose) {
+        printf("[SIM-SERVER] Device %u:", device);
+        for (uint16_t i = 0; i < length && i < 16U; i++) {
+            printf((tx != NULL) ? " %02X" : " --", (tx != NULL) ? tx[i] : 0U);
+            printf((rx != NULL) ? "/%02X" : "/--", (rx != NULL) ? rx[i] : 0U);
+        }
+        printf((length > 16U) ? " ... (%u bytes)\n" : "\n", length);
+    }
+}
+
+/**
+ * @brief Handle one request
+ * @param out Receives the response payload (HAL_SPI_MSG_MAX_PAYLOAD bytes)
+ * @return Response payload length
+ */
+static uint16_t sim_dispatch(sim_session_t* session, 
+                             const hal_spi_msg_header_t* header, 
+                             const uint8_t* payload, 
+                             uint8_t* out)
+{
+    uint8_t device = header->device_id;
+    uint16_t length = header->data_length;
+    
+    /* The models keep their state between messages, so a frame continued with
+     * HAL_SPI_MSG_FLAG_MORE just clocks on through the same model */
+    switch (header->msg_type & (uint8_t)~HAL_SPI_MSG_FLAG_MORE) {
+        case HAL_SPI_MSG_INIT: {
+            void* state = sim_session_device(session, device);
+            if (state != NULL) {
+                g_device_models[device]->reset(state);
+            }
+            if (g_sim_verbose) {
+                printf("[SIM-SERVER] Device %u initialized (%s)\n", device, g_device_models[device]->name);
+            }
+            return 0;
+        }
+        
+        case HAL_SPI_MSG_DEINIT:
+        case HAL_SPI_MSG_SET_CONFIG:
+            return 0;
+        
+        case HAL_SPI_MSG_TRANSFER:
+            sim_session_transfer(session, device, payload, out, length);
+            return length;
+        
+        case HAL_SPI_MSG_SEND:
+            sim_session_transfer(session, device, payload, NULL, length);
+            return 0;
+        
+        case HAL_SPI_MSG_RECEIVE: {
+            uint16_t requested = (length >= 2U) ? (uint16_t)((payload[0] << 8) | payload[1]) : 0U;
+            sim_session_transfer(session, device, NULL, out, requested);
+            return requested;
+        }
+        
+        case HAL_SPI_MSG_GET_STATUS:
+            out[0] = 1;     /* Ready */
+            out[1] = 0;     /* No error */
+            return 2;
+        
+        case HAL_SPI_MSG_BATCH: {
+            uint32_t offset = 0;
+            uint32_t produced = 0;
+            
+            while (offset + sizeof(hal_spi_batch_entry_t) <= length) {
+                hal_spi_batch_entry_t entry;
+                memcpy(&entry, &payload[offset], sizeof(entry));
+                offset += sizeof(entry);
+                
+                bool has_tx = (entry.msg_type != HAL_SPI_MSG_RECEIVE);
+                bool has_rx = (entry.msg_type != HAL_SPI_MSG_SEND);
+                if ((has_tx && offset + entry.length > length) ||
+                    (has_rx && produced + entry.length > HAL_SPI_MSG_MAX_PAYLOAD)) {
+                    break;  /* Malformed */
+                }
+                
+                sim_session_transfer(session, device, has_tx ? &payload[offset] : NULL, 
+                                     has_rx ? &out[produced] : NULL, entry.length);
+                offset += has_tx ? entry.length : 0U;
+                produced += has_rx ? entry.length : 0U;
+            }
+            return (uint16_t)produced;
+        }
+        
+        default:
+            printf("[SIM-SERVER] Unknown message type 0x%02X\n", header->msg_type);
+            return 0;
+    }
+}
+
+/*============================================================================*/
+/* TCP Clients                                                                */
+/*============================================================================*/
+
+static void sim_client_close(int epoll_fd, sim_client_t* client)
+{
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, client->fd, NULL);
+    close(client->fd);
+    sim_session_free(&client->session);
+    free(client->in);
+    free(client->out);
+    free(client);
+    printf("[SIM-SERVER] Client disconnected\n");
+}
+
+static void sim_client_watch(int epoll_fd, sim_client_t* client)
+{
+    struct epoll_event event;
+    bool want_out = (client->out_sent < client->out_len);
+    
+    if (want_out != client->want_out) {
+        event.events = EPOLLIN | (want_out ? EPOLLOUT : 0U);
+        event.data.ptr = client;
+        epoll_ctl(epoll_fd, EPOLL_CTL_MOD, client->fd, &event);
+        client->want_out = want_out;
+    }
+}
+
+/**
+ * @brief Send pending responses, without blocking
+ * @return false if the connection failed
+ */
+static bool sim_client_flush(sim_client_t* client)
+{
+    while (client->out_sent < client->out_len) {
+        ssize_t sent = send(client->fd, client->out + client->out_sent, 
+                            client->out_len - client->out_sent, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return (errno == EAGAIN || errno == EWOULDBLOCK);
+        }
+        client->out_sent += (size_t)sent;
+    }
+    client->out_len = 0;
+    client->out_sent = 0;
+    return true;
+}
+
+/**
+ * @brief Answer every complete request in the input buffer
+ * @details Stops early if too much output is pending; the rest is handled
+ *          once the client has read its responses.
+ * @return false on a protocol or memory error
+ */
+static bool sim_client_process(sim_client_t* client)
+{
+    size_t offset = 0;
+    
+    while (client->in_len - offset >= sizeof(hal_spi_msg_header_t) &&
+           client->out_len < SIM_OUT_HIGH_WATER) {
+        hal_spi_msg_header_t header;
+        memcpy(&header, &client->in[offset], sizeof(header));
+        
+        size_t message_length = sizeof(header) + header.data_length;
+        if (client->in_len - offset < message_length) {
+            break;
+        }
+        
+        if (client->out_cap - client->out_len < SIM_MAX_MESSAGE) {
+            size_t capacity = client->out_len + SIM_MAX_MESSAGE;
+            uint8_t* out = (uint8_t*)realloc(client->out, capacity);
+            if (out == NULL) {
+                return false;
+            }
+            client->out = out;
+            client->out_cap = capacity;
+        }
+        
+        /* Response payload is built in place behind its header */
+        uint8_t* response = &client->out[client->out_len];
+        uint16_t response_length = sim_dispatch(&client->session, &header, 
+                                                &client->in[offset + sizeof(header)], 
+                                                response + sizeof(header));
+        
+        header.msg_type = HAL_SPI_MSG_RESPONSE;
+        header.data_length = response_length;
+        memcpy(response, &header, sizeof(header));
+        client->out_len += sizeof(header) + response_length;
+        
+        offset += message_length;
+    }
+    
+    memmove(client->in, &client->in[offset], client->in_len - offset);
+    client->in_len -= offset;
+    return true;
+}
+
+/**
+ * @brief Read what arrived, answer it, send the answers
+ * @return false if the client is gone
+ */
+static bool sim_client_readable(sim_client_t* client)
+{
+    for (;;) {
+        if (client->in_len == SIM_IN_CAPACITY) {
+            break;  /* Backlogged on output, read again once it drained */
+        }
+        
+        ssize_t received = recv(client->fd, &client->in[client->in_len], 
+                                SIM_IN_CAPACITY - client->in_len, 0);
+        if (received == 0) {
+            return false;
+        }
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            return false;
+        }
+        client->in_len += (size_t)received;
+        
+        if (!sim_client_process(client)) {
+            return false;
+        }
+    }
+    return sim_client_flush(client);
+}
+
+static void sim_accept(int epoll_fd)
+{
+    for (;;) {
+        int fd = accept4(g_listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        
+        /* Responses are small; do not let Nagle hold them back */
+        int no_delay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+        
+        sim_client_t* client = (sim_client_t*)calloc(1, sizeof(sim_client_t));
+        if (client != NULL) {
+            client->in = (uint8_t*)malloc(SIM_IN_CAPACITY);
+        }
+        if (client == NULL || client->in == NULL) {
+            free(client);
+            close(fd);
+            continue;
+        }
+        client->fd = fd;
+        
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = client;
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+        
+        printf("[SIM-SERVER] Client connected\n");
+    }
+}
+
+/**
+ * @brief Serve all TCP clients until stopped
+ */
+static int sim_serve_tcp(const char* host, int port)
+{
+    struct sockaddr_in addr;
+    int reuse = 1;
+    
+    g_listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (g_listen_fd < 0) {
+        perror("[SIM-SERVER] socket");
+        return 1;
+    }
+    setsockopt(g_listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    if (inet_pton(AF_INET, host, &addr.sin_addr) != 1 ||
+        bind(g_listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(g_listen_fd, SOMAXCONN) != 0) {
+        perror("[SIM-SERVER] bind/listen");
+        close(g_listen_fd);
+        return 1;
+    }
+    
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = NULL;  /* The listener */
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, g_listen_fd, &event);
+    
+    printf("[SIM-SERVER] Listening on %s:%d\n", host, port);
+    
+    struct epoll_event events[SIM_MAX_EVENTS];
+    while (g_running) {
+        int count = epoll_wait(epoll_fd, events, SIM_MAX_EVENTS, -1);
+        
+        for (int i = 0; i < count; i++) {
+            sim_client_t* client = (sim_client_t*)events[i].data.ptr;
+            
+            if (client == NULL) {
+                sim_accept(epoll_fd);
+                continue;
+            }
+            
+            bool alive = !(events[i].events & (EPOLLERR | EPOLLHUP)) || (events[i].events & EPOLLIN);
+            if (alive && (events[i].events & EPOLLOUT)) {
+                /* Output drained: answer what was held back, then read on */
+                alive = sim_client_flush(client) && sim_client_process(client);
+            }
+            if (alive && (events[i].events & (EPOLLIN | EPOLLOUT))) {
+                alive = sim_client_readable(client);
+            }
+            
+            if (alive) {
+                sim_client_watch(epoll_fd, client);
+            } else {
+                sim_client_close(epoll_fd, client);
+            }
+        }
+    }
+    
+    close(epoll_fd);
+    close(g_listen_fd);
+    return 0;
+}
+
+/*============================================================================*/
+/* Shared Memory Client                                                       */
+/*============================================================================*/
+
+static uint32_t sim_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)(ts.tv_nsec / 1000L));
+}
+
+/**
+ * @brief Wait until the ring word differs from value (see hal_spi_shm.c)
+ * @return false once the server is stopping
+ */
+static bool sim_shm_wait(volatile uint32_t* word, volatile uint32_t* waiters, uint32_t value, uint32_t spin_us)
+{
+    uint32_t spin_start = sim_now_us();
+    
+    while (__atomic_load_n(word, __ATOMIC_ACQUIRE) == value) {
+        if (!g_running) {
+            return false;
+        }
+        if ((sim_now_us() - spin_start) < spin_us) {
+            continue;
+        }
+        
+        struct timespec ts = {0, (long)SIM_SHM_WAIT_SLICE_MS * 1000000L};
+        (void)__atomic_exchange_n(waiters, 1U, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(word, __ATOMIC_ACQUIRE) == value) {
+            (void)syscall(SYS_futex, word, FUTEX_WAIT, value, &ts, NULL, 0);
+        }
+    }
+    return true;
+}
+
+static void sim_shm_wake(volatile uint32_t* word, volatile uint32_t* waiters)
+{
+    if (__atomic_exchange_n(waiters, 0U, __ATOMIC_SEQ_CST) != 0U) {
+        (void)syscall(SYS_futex, word, FUTEX_WAKE, 1, NULL, NULL, 0);
+    }
+}
+
+static void sim_shm_copy_out(const hal_spi_shm_ring_t* ring, uint32_t pos, uint8_t* data, uint32_t length)
+{
+    uint32_t offset = pos & (HAL_SPI_SHM_RING_SIZE - 1U);
+    uint32_t first = (HAL_SPI_SHM_RING_SIZE - offset < length) ? HAL_SPI_SHM_RING_SIZE - offset : length;
+    
+    memcpy(data, &ring->data[offset], first);
+    memcpy(data + first, &ring->data[0], length - first);
+}
+
+static void sim_shm_copy_in(hal_spi_shm_ring_t* ring, uint32_t pos, const uint8_t* data, uint32_t length)
+{
+    uint32_t offset = pos & (HAL_SPI_SHM_RING_SIZE - 1U);
+    uint32_t first = (HAL_SPI_SHM_RING_SIZE - offset < length) ? HAL_SPI_SHM_RING_SIZE - offset : length;
+    
+    memcpy(&ring->data[offset], data, first);
+    memcpy(&ring->data[0], data + first, length - first);
+}
+
+typedef struct {
+    const char*             name;
+    hal_spi_shm_region_t*   region;
+} sim_shm_t;
+
+/**
+ * @brief Serve the shared-memory client until stopped
+ */
+static void* sim_serve_shm(void* arg)
+{
+    sim_shm_t* shm = (sim_shm_t*)arg;
+    hal_spi_shm_ring_t* request = &shm->region->request;
+    hal_spi_shm_ring_t* response = &shm->region->response;
+    uint32_t spin_us = (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? SIM_SHM_SPIN_US : 0U;
+    sim_session_t session;
+    uint8_t* in = (uint8_t*)malloc(SIM_MAX_MESSAGE);
+    uint8_t* out = (uint8_t*)malloc(SIM_MAX_MESSAGE);
+    
+    memset(&session, 0, sizeof(session));
+    
+    while (in != NULL && out != NULL && g_running) {
+        /* Next request: header first, the payload is published with it */
+        uint32_t tail = request->tail;
+        if (!sim_shm_wait(&request->head, &request->head_waiters, tail, spin_us)) {
+            break;
+        }
+        
+        hal_spi_msg_header_t header;
+        sim_shm_copy_out(request, tail, (uint8_t*)&header, sizeof(header));
+        sim_shm_copy_out(request, tail + sizeof(header), in, header.data_length);
+        __atomic_store_n(&request->tail, tail + sizeof(header) + header.data_length, __ATOMIC_SEQ_CST);
+        sim_shm_wake(&request->tail, &request->tail_waiters);
+        
+        uint16_t response_length = sim_dispatch(&session, &header, in, out + sizeof(header));
+        header.msg_type = HAL_SPI_MSG_RESPONSE;
+        header.data_length = response_length;
+        memcpy(out, &header, sizeof(header));
+        
+        /* The client drains every response before its next request */
+        uint32_t head = response->head;
+        uint32_t needed = sizeof(header) + response_length;
+        for (;;) {
+            uint32_t consumed = __atomic_load_n(&response->tail, __ATOMIC_ACQUIRE);
+            if (HAL_SPI_SHM_RING_SIZE - (head - consumed) >= needed) {
+                break;
+            }
+            if (!sim_shm_wait(&response->tail, &response->tail_waiters, consumed, spin_us)) {
+                break;
+            }
+        }
+        
+        sim_shm_copy_in(response, head, out, needed);
+        __atomic_exchange_n(&response->head, head + needed, __ATOMIC_SEQ_CST);
+        sim_shm_wake(&response->head, &response->head_waiters);
+    }
+    
+    sim_session_free(&session);
+    free(in);
+    free(out);
+    return NULL;
+}
+
+/**
+ * @brief Create and lay out the shared region
+ */
+static bool sim_shm_create(sim_shm_t* shm)
+{
+    char path[80];
+    
+    snprintf(path, sizeof(path), "/%s", shm->name);
+    shm_unlink(path);  /* Left over from a server that did not shut down cleanly */
+    
+    int fd = shm_open(path, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 || ftruncate(fd, sizeof(hal_spi_shm_region_t)) != 0) {
+        perror("[SIM-SERVER] shm_open");
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+    
+    void* mapping = mmap(NULL, sizeof(hal_spi_shm_region_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        perror("[SIM-SERVER] mmap");
+        shm_unlink(path);
+        return false;
+    }
+    
+    shm->region = (hal_spi_shm_region_t*)mapping;
+    shm->region->version = HAL_SPI_SHM_VERSION;
+    shm->region->ring_size = HAL_SPI_SHM_RING_SIZE;
+    __atomic_store_n(&shm->region->magic, HAL_SPI_SHM_MAGIC, __ATOMIC_RELEASE);  /* Last: ready */
+    
+    printf("[SIM-SERVER] Serving shared memory '%s'\n", shm->name);
+    return true;
+}
+
+static void sim_shm_destroy(sim_shm_t* shm)
+{
+    char path[80];
+    
+    snprintf(path, sizeof(path), "/%s", shm->name);
+    munmap(shm->region, sizeof(hal_spi_shm_region_t));
+    shm_unlink(path);
+}
+
+/*============================================================================*/
+/* Entry Point                                                                */
+/*============================================================================*/
+
+static void sim_stop(int signal_number)
+{
+    (void)signal_number;
+    g_running = 0;
+}
+
+static void sim_usage(void)
+{
+    printf("Usage: spi_sim_server [--host HOST] [--port PORT] [--shm [NAME]]\n"
+           "                      [--model NAME] [--device ID=NAME] [--verbose]\n"
+           "Models:");
+    for (size_t i = 0; i < SIM_MODEL_COUNT; i++) {
+        printf(" %s", g_sim_models[i]->name);
+    }
+    printf(" (default %s)\n", g_sim_models[0]->name);
+}
+
+int main(int argc, char** argv)
+{
+    const char* host = SIM_DEFAULT_HOST;
+    int port = SIM_DEFAULT_PORT;
+    sim_shm_t shm = {NULL, NULL};
+    
+    for (size_t i = 0; i < SIM_MAX_DEVICES; i++) {
+        g_device_models[i] = g_sim_models[0];
+    }
+    
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        
+        if (strcmp(arg, "--host") == 0 && value != NULL) {
+            host = value;
+            i++;
+        } else if (strcmp(arg, "--port") == 0 && value != NULL) {
+            port = atoi(value);
+            i++;
+        } else if (strcmp(arg, "--shm") == 0) {
+            shm.name = HAL_SPI_SHM_DEFAULT_NAME;
+            if (value != NULL && value[0] != '-') {
+                shm.name = value;
+                i++;
+            }
+        } else if (strcmp(arg, "--model") == 0 && value != NULL && sim_find_model(value) != NULL) {
+            for (size_t d = 0; d < SIM_MAX_DEVICES; d++) {
+                g_device_models[d] = sim_find_model(value);
+            }
+            i++;
+        } else if (strcmp(arg, "--device") == 0 && value != NULL && strchr(value, '=') != NULL &&
+                   sim_find_model(strchr(value, '=') + 1) != NULL) {
+            g_device_models[(uint8_t)atoi(value)] = sim_find_model(strchr(value, '=') + 1);
+            i++;
+        } else if (strcmp(arg, "--verbose") == 0) {
+            g_sim_verbose = 1;
+        } else {
+            sim_usage();
+            return 2;
+        }
+    }
+    
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = sim_stop;   /* No SA_RESTART: epoll_wait returns EINTR */
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+    
+    pthread_t shm_thread;
+    bool shm_running = false;
+    if (shm.name != NULL) {
+        if (!sim_shm_create(&shm)) {
+            return 1;
+        }
+        shm_running = (pthread_create(&shm_thread, NULL, sim_serve_shm, &shm) == 0);
+    }
+    
+    int result = sim_serve_tcp(host, port);
+    
+    g_running = 0;
+    if (shm_running) {
+        pthread_join(shm_thread, NULL);
+    }
+    if (shm.region != NULL) {
+        sim_shm_destroy(&shm);
+    }
+    
+    printf("[SIM-SERVER] Server stopped\n");
+    return result;
+}
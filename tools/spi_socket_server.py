@@ -2,6 +2,10 @@
 """
 SPI HAL Socket Server - TLE92104 Simulation
 A TCP socket server simulating the Infineon TLE92104 4-channel high-side switch.
+Serves any number of clients from one selector loop; every (connection,
+device_id) gets its own TLE92104, and pipelined requests are answered in
+order. For benchmarks use the native server in tools/spi_sim_server/, which
+speaks the same protocol (interface/hal_spi_proto.h).
 
 Simulates:
  - Register reads/writes via SPI 16-bit frames
@@ -22,19 +26,41 @@ Protocol over socket (per HAL socket implementation):
   RX Header: [0x80(1) | device_id(1) | data_length(2) | sequence(4)]  = 8 bytes
   RX Payload: data_length bytes
 
+  BATCH payload: repeated [msg_type(1) | length(2) | TX data (TRANSFER/SEND only)]
+  BATCH response: RX data of all TRANSFER and RECEIVE entries, concatenated
+
+  msg_type | 0x40 (MORE): TRANSFER/SEND/RECEIVE whose frame continues in the
+  next message of the device; 16-bit frames stay aligned as chunks are even
+
+Shared memory (--shm, HAL_IMPLEMENTATION=SHM, hal_spi_shm.c):
+  The same messages travel through a ring pair in a shared memory region the
+  server creates. Layout (hal_spi_shm_region_t):
+    0x00  magic(4) = 'MSHM' | version(4) = 1 | ring_size(4) | reserved to 64
+    0x40  request ring  (client -> server)
+          head(4) | head_waiters(4) | pad to 64 | tail(4) | tail_waiters(4) |
+          pad to 128 | data[ring_size]
+    ...   response ring (server -> client), same layout
+  head/tail are free-running byte counters; a whole message is published by
+  a single store of head. A side about to sleep sets its *_waiters word and
+  waits on the futex at head (consumer) or tail (producer).
+
 Usage:
-    python spi_socket_server.py [--host HOST] [--port PORT]
+    python spi_socket_server.py [--host HOST] [--port PORT] [--quiet]
+    python spi_socket_server.py --shm [NAME] [--quiet]
 
 Author: EswPla Team
 Date: 2026-02-21
 """
 
 import socket
+import selectors
 import struct
 import argparse
-import threading
 import time
 import sys
+import os
+import ctypes
+import signal
 from enum import IntEnum
 
 class SpiMessageType(IntEnum):
@@ -46,9 +72,15 @@ class SpiMessageType(IntEnum):
     RECEIVE      = 0x05
     SET_CONFIG   = 0x06
     GET_STATUS   = 0x07
+    BATCH        = 0x08
     RESPONSE     = 0x80
 
 
+# ORed onto TRANSFER/SEND/RECEIVE: the frame continues in the next message
+# (hal_spi_transfer_large() chunks), chip select stays asserted
+MSG_FLAG_MORE = 0x40
+
+
 class TLE92104Simulator:
     """Simulates the TLE92104 register file and SPI behavior"""
 
@@ -71,8 +103,9 @@ class TLE92104Simulator:
     DATA_SHIFT = 2
     PARITY_BIT = 1
 
-    def __init__(self):
+    def __init__(self, quiet=False):
         """Initialize with default register values"""
+        self.quiet = quiet
         self.registers = {
             self.REG_CTRL1: 0x00,
             self.REG_CTRL2: 0x00,
@@ -87,7 +120,12 @@ class TLE92104Simulator:
         self.wdg_count = 0
         self.last_response_data = 0x00
         self.last_response_addr = 0x00
-        print(f"[TLE92104-SIM] Initialized. Device ID=0x{self.DEVICE_ID:02X}")
+        self.log(f"[TLE92104-SIM] Initialized. Device ID=0x{self.DEVICE_ID:02X}")
+
+    def log(self, text):
+        """Per-frame output, off in quiet mode"""
+        if not self.quiet:
+            print(text)
 
     def process_spi_frame(self, frame_16bit):
         """
@@ -104,22 +142,22 @@ class TLE92104Simulator:
         if cmd == 0x00:  # READ
             self.last_response_data = self.registers.get(addr, 0x00)
             self.last_response_addr = addr
-            print(f"[TLE92104-SIM] READ  reg[0x{addr:X}] -> 0x{self.last_response_data:02X}")
+            self.log(f"[TLE92104-SIM] READ  reg[0x{addr:X}] -> 0x{self.last_response_data:02X}")
         elif cmd == 0x01:  # WRITE
             if addr != self.REG_DEVID:
                 old_val = self.registers.get(addr, 0x00)
                 self.registers[addr] = data
-                print(f"[TLE92104-SIM] WRITE reg[0x{addr:X}] = 0x{data:02X} (was 0x{old_val:02X})")
+                self.log(f"[TLE92104-SIM] WRITE reg[0x{addr:X}] = 0x{data:02X} (was 0x{old_val:02X})")
                 if addr == self.REG_WDG:
                     self.wdg_count += 1
                     if self.wdg_count % 10 == 0:
-                        print(f"[TLE92104-SIM] Watchdog serviced {self.wdg_count} times")
+                        self.log(f"[TLE92104-SIM] Watchdog serviced {self.wdg_count} times")
             else:
-                print(f"[TLE92104-SIM] WRITE to read-only DEVID register ignored")
+                self.log(f"[TLE92104-SIM] WRITE to read-only DEVID register ignored")
             self.last_response_data = self.registers.get(addr, 0x00)
             self.last_response_addr = addr
         else:
-            print(f"[TLE92104-SIM] Unknown CMD=0x{cmd:X}")
+            self.log(f"[TLE92104-SIM] Unknown CMD=0x{cmd:X}")
             self.last_response_data = 0x00
             self.last_response_addr = 0x00
 
@@ -137,104 +175,32 @@ class TLE92104Simulator:
         return resp_frame
 
 
-class SpiSocketServer:
-    """SPI HAL Socket Server with TLE92104 simulation"""
+class SpiSession:
+    """SPI state of one client: its devices, each with its own TLE92104"""
 
-    def __init__(self, host='127.0.0.1', port=9000):
-        self.host = host
-        self.port = port
-        self.server_socket = None
-        self.client_socket = None
-        self.running = False
-        self.tle92104 = TLE92104Simulator()
+    def __init__(self, quiet=False):
+        self.quiet = quiet
         self.spi_devices = {}
+        self.simulators = {}
 
-    def start(self):
-        """Start the socket server"""
-        self.server_socket = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
-        self.server_socket.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
-
-        try:
-            self.server_socket.bind((self.host, self.port))
-            self.server_socket.listen(1)
-            self.running = True
-            print(f"[SPI-SERVER] Listening on {self.host}:{self.port}")
-
-            while self.running:
-                print("[SPI-SERVER] Waiting for connection...")
-                self.client_socket, client_addr = self.server_socket.accept()
-                print(f"[SPI-SERVER] Client connected from {client_addr}")
-
-                client_thread = threading.Thread(target=self.handle_client)
-                client_thread.start()
-                client_thread.join()
-
-        except KeyboardInterrupt:
-            print("\n[SPI-SERVER] Shutting down...")
-        except Exception as e:
-            print(f"[SPI-SERVER] ERROR: {e}")
-        finally:
-            self.stop()
+    def log(self, text):
+        """Per-message output, off in quiet mode"""
+        if not self.quiet:
+            print(text)
 
-    def stop(self):
-        """Stop the server"""
-        self.running = False
-        if self.client_socket:
-            self.client_socket.close()
-        if self.server_socket:
-            self.server_socket.close()
-        print("[SPI-SERVER] Server stopped")
-
-    def handle_client(self):
-        """Handle client connection"""
-        try:
-            while self.running:
-                header_data = self.receive_all(8)
-                if not header_data:
-                    break
-
-                msg_type, device_id, data_length, sequence = struct.unpack('<BBHI', header_data)
-
-                payload = None
-                if data_length > 0:
-                    payload = self.receive_all(data_length)
-                    if not payload:
-                        break
-
-                response = self.process_message(msg_type, device_id, payload)
-
-                if response is not None:
-                    self.send_response(msg_type, device_id, sequence, response)
-
-        except Exception as e:
-            print(f"[SPI-SERVER] Client error: {e}")
-        finally:
-            if self.client_socket:
-                self.client_socket.close()
-                self.client_socket = None
-            print("[SPI-SERVER] Client disconnected")
-
-    def receive_all(self, length):
-        """Receive exact number of bytes"""
-        data = b''
-        while len(data) < length:
-            chunk = self.client_socket.recv(length - len(data))
-            if not chunk:
-                return None
-            data += chunk
-        return data
-
-    def send_response(self, msg_type, device_id, sequence, data):
-        """Send response message"""
-        response_type = SpiMessageType.RESPONSE
-        data_length = len(data) if data else 0
-        header = struct.pack('<BBHI', response_type, device_id, data_length, sequence)
-        self.client_socket.sendall(header)
-        if data:
-            self.client_socket.sendall(data)
+    def simulator(self, device_id):
+        """TLE92104 of a device, created on first use"""
+        sim = self.simulators.get(device_id)
+        if sim is None:
+            sim = TLE92104Simulator(self.quiet)
+            self.simulators[device_id] = sim
+        return sim
 
     def process_message(self, msg_type, device_id, payload):
         """Process received message and generate response"""
+        # The TLE92104 frames are 16 bits and chunks have even lengths, so a
+        # continued frame is handled message by message
+        msg_type &= ~MSG_FLAG_MORE
 
         if msg_type == SpiMessageType.INIT:
             if payload and len(payload) >= 7:
@@ -246,23 +212,24 @@ class SpiSocketServer:
                     'data_bits': data_bits,
                     'initialized': True
                 }
-                print(f"[SPI-SERVER] Device {device_id} initialized: "
-                      f"{baudrate}Hz, mode={mode}, {data_bits}-bit")
-            self.tle92104 = TLE92104Simulator()
+                self.log(f"[SPI-SERVER] Device {device_id} initialized: "
+                         f"{baudrate}Hz, mode={mode}, {data_bits}-bit")
+            self.simulators[device_id] = TLE92104Simulator(self.quiet)
             return b''
 
         elif msg_type == SpiMessageType.DEINIT:
+            self.simulators.pop(device_id, None)
             if device_id in self.spi_devices:
                 del self.spi_devices[device_id]
-                print(f"[SPI-SERVER] Device {device_id} deinitialized")
+                self.log(f"[SPI-SERVER] Device {device_id} deinitialized")
             return b''
 
         elif msg_type == SpiMessageType.TRANSFER:
-            return self.process_spi_transfer(payload)
+            return self.process_spi_transfer(device_id, payload)
 
         elif msg_type == SpiMessageType.SEND:
             if payload:
-                self.process_spi_transfer(payload)
+                self.process_spi_transfer(device_id, payload)
             return b''
 
         elif msg_type == SpiMessageType.RECEIVE:
@@ -281,9 +248,12 @@ class SpiSocketServer:
                         'bit_order': bit_order,
                         'data_bits': data_bits
                     })
-                    print(f"[SPI-SERVER] Device {device_id} reconfigured")
+                    self.log(f"[SPI-SERVER] Device {device_id} reconfigured")
             return b''
 
+        elif msg_type == SpiMessageType.BATCH:
+            return self.process_spi_batch(device_id, payload)
+
         elif msg_type == SpiMessageType.GET_STATUS:
             return struct.pack('<BB', 1, 0)
 
@@ -291,18 +261,19 @@ class SpiSocketServer:
             print(f"[SPI-SERVER] Unknown message type: {hex(msg_type)}")
             return b''
 
-    def process_spi_transfer(self, payload):
+    def process_spi_transfer(self, device_id, payload):
         """
-        Process SPI transfer payload through TLE92104 simulator.
+        Process SPI transfer payload through the TLE92104 of the device.
         Payload contains raw SPI bytes (2 bytes = 1 x 16-bit frame).
         """
         if not payload or len(payload) < 2:
             return payload if payload else b''
 
+        sim = self.simulator(device_id)
         response = bytearray()
         for i in range(0, len(payload) - 1, 2):
             tx_frame = (payload[i] << 8) | payload[i + 1]
-            rx_frame = self.tle92104.process_spi_frame(tx_frame)
+            rx_frame = sim.process_spi_frame(tx_frame)
             response.append((rx_frame >> 8) & 0xFF)
             response.append(rx_frame & 0xFF)
 
@@ -311,6 +282,370 @@ class SpiSocketServer:
 
         return bytes(response)
 
+    def process_spi_batch(self, device_id, payload):
+        """
+        Process a batch of transfers sent in one message.
+        Each entry is [msg_type(1) | length(2)] followed by TX data for
+        TRANSFER and SEND entries.
+        """
+        response = bytearray()
+        offset = 0
+
+        while payload and offset + 3 <= len(payload):
+            entry_type, length = struct.unpack_from('<BH', payload, offset)
+            offset += 3
+
+            if entry_type == SpiMessageType.TRANSFER:
+                response += self.process_spi_transfer(device_id, payload[offset:offset + length])
+                offset += length
+            elif entry_type == SpiMessageType.SEND:
+                self.process_spi_transfer(device_id, payload[offset:offset + length])
+                offset += length
+            elif entry_type == SpiMessageType.RECEIVE:
+                response += bytes(length)
+            else:
+                print(f"[SPI-SERVER] Unknown batch entry type: {hex(entry_type)}")
+                break
+
+        return bytes(response)
+
+
+def build_response(device_id, sequence, data):
+    """Response message: header and payload in one buffer"""
+    header = struct.pack('<BBHI', SpiMessageType.RESPONSE, device_id, len(data), sequence)
+    return header + data if data else header
+
+
+class SocketConnection:
+    """Non-blocking client connection served by the selector loop"""
+
+    RECV_SIZE = 65536
+    TX_HIGH_WATER = 1024 * 1024     # Stop reading while this much is unsent
+
+    def __init__(self, sock, addr, quiet):
+        self.sock = sock
+        self.addr = addr
+        self.rx = bytearray()
+        self.tx = bytearray()
+        self.session = SpiSession(quiet)
+
+    def process(self):
+        """Answer every complete request received so far, in order"""
+        offset = 0
+        while len(self.rx) - offset >= 8:
+            msg_type, device_id, data_length, sequence = struct.unpack_from('<BBHI', self.rx, offset)
+            if len(self.rx) - offset - 8 < data_length:
+                break
+            payload = bytes(self.rx[offset + 8:offset + 8 + data_length]) if data_length else None
+            offset += 8 + data_length
+
+            response = self.session.process_message(msg_type, device_id, payload)
+            if response is not None:
+                self.tx += build_response(device_id, sequence, response)
+        del self.rx[:offset]
+
+    def flush(self):
+        """Send as much of the pending responses as the socket takes"""
+        try:
+            sent = self.sock.send(self.tx)
+        except (BlockingIOError, InterruptedError):
+            sent = 0
+        del self.tx[:sent]
+
+    def events(self):
+        """Selector events the connection waits for"""
+        events = selectors.EVENT_WRITE if self.tx else 0
+        if len(self.tx) < self.TX_HIGH_WATER:
+            events |= selectors.EVENT_READ
+        return events
+
+
+class Futex:
+    """Cross-process futex wait/wake on words of a shared buffer (Linux only)"""
+
+    SYSCALL_NUMBERS = {'x86_64': 202, 'aarch64': 98, 'i386': 240, 'i686': 240, 'armv7l': 240}
+    FUTEX_WAIT = 0
+    FUTEX_WAKE = 1
+
+    class Timespec(ctypes.Structure):
+        _fields_ = [('tv_sec', ctypes.c_long), ('tv_nsec', ctypes.c_long)]
+
+    def __init__(self, buf):
+        self.nr = None
+        if sys.platform.startswith('linux'):
+            self.nr = self.SYSCALL_NUMBERS.get(os.uname().machine)
+        if self.nr is not None:
+            self.libc = ctypes.CDLL(None, use_errno=True)
+            self.anchor = ctypes.c_char.from_buffer(buf)
+            self.base = ctypes.addressof(self.anchor)
+
+    def wait(self, offset, value, timeout_s):
+        """Sleep while the word at offset equals value (or until woken/timeout)"""
+        if self.nr is None:
+            time.sleep(0.0001)
+            return
+        ts = self.Timespec(int(timeout_s), int((timeout_s % 1) * 1e9))
+        self.libc.syscall(self.nr, ctypes.c_void_p(self.base + offset), self.FUTEX_WAIT,
+                          ctypes.c_uint(value), ctypes.byref(ts), None, 0)
+
+    def wake(self, offset):
+        if self.nr is not None:
+            self.libc.syscall(self.nr, ctypes.c_void_p(self.base + offset), self.FUTEX_WAKE,
+                              1, None, None, 0)
+
+    def close(self):
+        self.anchor = None  # Releases the export of the shared buffer
+
+
+class ShmRing:
+    """One direction of the shared memory channel (shm_ring_t)"""
+
+    HEAD = 0
+    HEAD_WAITERS = 4
+    TAIL = 64
+    TAIL_WAITERS = 68
+    DATA = 128
+    SPIN_S = 0.0002 if (os.cpu_count() or 1) > 1 else 0.0  # Busy-poll before sleeping
+    SLICE_S = 0.1           # Longest single sleep
+
+    def __init__(self, buf, futex, offset, size):
+        self.buf = buf
+        self.futex = futex
+        self.offset = offset
+        self.size = size
+
+    def _get(self, field):
+        return struct.unpack_from('<I', self.buf, self.offset + field)[0]
+
+    def _set(self, field, value):
+        struct.pack_into('<I', self.buf, self.offset + field, value & 0xFFFFFFFF)
+
+    def _wait(self, field, waiters, ready):
+        """Wait until ready() holds; spin first, then sleep on the futex at field"""
+        spin_end = time.perf_counter() + self.SPIN_S
+        while not ready():
+            if time.perf_counter() < spin_end:
+                continue
+            self._set(waiters, 1)
+            value = self._get(field)
+            if not ready():
+                self.futex.wait(self.offset + field, value, self.SLICE_S)
+
+    def _wake(self, field, waiters):
+        if self._get(waiters):
+            self._set(waiters, 0)
+            self.futex.wake(self.offset + field)
+
+    def read(self, length):
+        """Consume exactly length bytes"""
+        tail = self._get(self.TAIL)
+        self._wait(self.HEAD, self.HEAD_WAITERS,
+                   lambda: (self._get(self.HEAD) - tail) & 0xFFFFFFFF >= length)
+        start = self.offset + self.DATA
+        pos = tail % self.size
+        first = min(length, self.size - pos)
+        data = bytes(self.buf[start + pos:start + pos + first])
+        data += bytes(self.buf[start:start + length - first])
+        self._set(self.TAIL, tail + length)
+        self._wake(self.TAIL, self.TAIL_WAITERS)
+        return data
+
+    def write(self, data):
+        """Publish data as one unit"""
+        length = len(data)
+        head = self._get(self.HEAD)
+        self._wait(self.TAIL, self.TAIL_WAITERS,
+                   lambda: self.size - ((head - self._get(self.TAIL)) & 0xFFFFFFFF) >= length)
+        start = self.offset + self.DATA
+        pos = head % self.size
+        first = min(length, self.size - pos)
+        self.buf[start + pos:start + pos + first] = data[:first]
+        self.buf[start:start + length - first] = data[first:]
+        self._set(self.HEAD, head + length)
+        self._wake(self.HEAD, self.HEAD_WAITERS)
+
+
+class ShmLink:
+    """Message transport over the shared memory region used by hal_spi_shm.c"""
+
+    MAGIC = 0x4D48534D
+    VERSION = 1
+    RING_SIZE = 256 * 1024
+    HEADER_SIZE = 64
+    RING_BYTES = ShmRing.DATA + RING_SIZE
+
+    def __init__(self, name):
+        from multiprocessing import shared_memory
+        size = self.HEADER_SIZE + 2 * self.RING_BYTES
+        try:
+            self.shm = shared_memory.SharedMemory(name=name, create=True, size=size)
+        except FileExistsError:
+            # Left over from a server that did not shut down cleanly
+            stale = shared_memory.SharedMemory(name=name)
+            stale.close()
+            stale.unlink()
+            self.shm = shared_memory.SharedMemory(name=name, create=True, size=size)
+
+        buf = self.shm.buf
+        buf[:size] = bytes(size)
+        self.futex = Futex(buf)
+        self.request = ShmRing(buf, self.futex, self.HEADER_SIZE, self.RING_SIZE)
+        self.response = ShmRing(buf, self.futex, self.HEADER_SIZE + self.RING_BYTES, self.RING_SIZE)
+        struct.pack_into('<II', buf, 4, self.VERSION, self.RING_SIZE)
+        struct.pack_into('<I', buf, 0, self.MAGIC)  # Last: the region is ready
+
+    def recv_exact(self, length):
+        return self.request.read(length)
+
+    def send(self, data):
+        self.response.write(data)
+
+    def close(self):
+        self.request = None
+        self.response = None
+        self.futex.close()
+        self.shm.close()
+        self.shm.unlink()
+
+
+class SpiSocketServer:
+    """SPI HAL Socket Server with TLE92104 simulation"""
+
+    def __init__(self, host='127.0.0.1', port=9000, quiet=False):
+        self.host = host
+        self.port = port
+        self.quiet = quiet
+        self.server_socket = None
+        self.selector = None
+        self.connections = {}
+        self.link = None
+        self.running = False
+
+    def start(self):
+        """Serve all clients from one selector loop"""
+        self.server_socket = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        self.server_socket.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+
+        try:
+            self.server_socket.bind((self.host, self.port))
+            self.server_socket.listen(socket.SOMAXCONN)
+            self.server_socket.setblocking(False)
+            self.selector = selectors.DefaultSelector()
+            self.selector.register(self.server_socket, selectors.EVENT_READ, None)
+            self.running = True
+            print(f"[SPI-SERVER] Listening on {self.host}:{self.port}")
+
+            while self.running:
+                for key, mask in self.selector.select(timeout=0.5):
+                    if key.data is None:
+                        self.accept()
+                    else:
+                        self.service(key.data, mask)
+
+        except KeyboardInterrupt:
+            print("\n[SPI-SERVER] Shutting down...")
+        except Exception as e:
+            print(f"[SPI-SERVER] ERROR: {e}")
+        finally:
+            self.stop()
+
+    def accept(self):
+        """Take a new client into the loop"""
+        try:
+            client_socket, client_addr = self.server_socket.accept()
+        except (BlockingIOError, InterruptedError):
+            return
+        client_socket.setblocking(False)
+        # Responses are small; do not let Nagle hold them back
+        client_socket.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        conn = SocketConnection(client_socket, client_addr, self.quiet)
+        self.connections[client_socket] = conn
+        self.selector.register(client_socket, selectors.EVENT_READ, conn)
+        print(f"[SPI-SERVER] Client connected from {client_addr} ({len(self.connections)} active)")
+
+    def service(self, conn, mask):
+        """Read, answer and write for one client"""
+        try:
+            if mask & selectors.EVENT_READ:
+                data = conn.sock.recv(SocketConnection.RECV_SIZE)
+                if not data:
+                    self.disconnect(conn)
+                    return
+                conn.rx += data
+                conn.process()
+            if conn.tx:
+                conn.flush()
+        except (BlockingIOError, InterruptedError):
+            pass
+        except OSError as e:
+            print(f"[SPI-SERVER] Client error: {e}")
+            self.disconnect(conn)
+            return
+        self.selector.modify(conn.sock, conn.events(), conn)
+
+    def disconnect(self, conn):
+        """Drop a client and its devices"""
+        self.selector.unregister(conn.sock)
+        del self.connections[conn.sock]
+        conn.sock.close()
+        print(f"[SPI-SERVER] Client {conn.addr} disconnected ({len(self.connections)} active)")
+
+    def start_shm(self, name):
+        """Serve one client through shared memory (hal_spi_shm.c)"""
+        # The region outlives the process unless it is unlinked on the way out
+        signal.signal(signal.SIGTERM, signal.default_int_handler)
+        self.link = ShmLink(name)
+        self.running = True
+        print(f"[SPI-SERVER] Serving shared memory '{name}'")
+
+        try:
+            self.handle_client()
+        except KeyboardInterrupt:
+            print("\n[SPI-SERVER] Shutting down...")
+        finally:
+            self.stop()
+
+    def stop(self):
+        """Stop the server"""
+        self.running = False
+        for conn in list(self.connections.values()):
+            conn.sock.close()
+        self.connections = {}
+        if self.selector:
+            self.selector.close()
+            self.selector = None
+        if self.link:
+            self.link.close()
+            self.link = None
+        if self.server_socket:
+            self.server_socket.close()
+        print("[SPI-SERVER] Server stopped")
+
+    def handle_client(self):
+        """Handle the client of a blocking link (shared memory), one message at a time"""
+        session = SpiSession(self.quiet)
+        try:
+            while self.running:
+                header_data = self.link.recv_exact(8)
+                if not header_data:
+                    break
+
+                msg_type, device_id, data_length, sequence = struct.unpack('<BBHI', header_data)
+
+                payload = None
+                if data_length > 0:
+                    payload = self.link.recv_exact(data_length)
+                    if not payload:
+                        break
+
+                response = session.process_message(msg_type, device_id, payload)
+
+                if response is not None:
+                    self.link.send(build_response(device_id, sequence, response))
+
+        except Exception as e:
+            print(f"[SPI-SERVER] Client error: {e}")
+
 
 def main():
     """Main entry point"""
@@ -319,20 +654,31 @@ def main():
                         help='Server host address (default: 127.0.0.1)')
     parser.add_argument('--port', type=int, default=9000,
                         help='Server port (default: 9000)')
+    parser.add_argument('--shm', nargs='?', const='m_hal_spi', default=None, metavar='NAME',
+                        help='Serve HAL_IMPLEMENTATION=SHM clients through shared memory '
+                             'instead of TCP (default name: m_hal_spi)')
+    parser.add_argument('--quiet', action='store_true',
+                        help='No per-frame and per-message output (connections and errors only)')
 
     args = parser.parse_args()
 
     print("=" * 60)
     print("SPI HAL Socket Server - TLE92104 Simulation")
     print("=" * 60)
-    print(f"Host: {args.host}")
-    print(f"Port: {args.port}")
-    print(f"Simulated device: TLE92104 (ID=0x5A)")
+    if args.shm:
+        print(f"Shared memory: {args.shm}")
+    else:
+        print(f"Host: {args.host}")
+        print(f"Port: {args.port}")
+    print(f"Simulated device: TLE92104 (ID=0x5A), one per client and device")
     print("Press Ctrl+C to stop")
     print("=" * 60)
 
-    server = SpiSocketServer(host=args.host, port=args.port)
-    server.start()
+    server = SpiSocketServer(host=args.host, port=args.port, quiet=args.quiet)
+    if args.shm:
+        server.start_shm(args.shm)
+    else:
+        server.start()
 
 
 if __name__ == '__main__':